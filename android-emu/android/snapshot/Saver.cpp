@@ -110,15 +110,23 @@ Saver::Saver(const Snapshot& snapshot, RamLoader* loader, bool isOnExit,
     }
 
     {
+        // An earlier save of this snapshot is updated in place, so that the
+        // textures that haven't changed since then don't need to be saved
+        // again.
+        const auto texturesFile =
+                PathUtils::join(mSnapshot.dataDir(), kTexturesFileName);
+        const bool tryIncremental = System::get()->pathIsFile(texturesFile);
         const auto textures = android::base::fsopen(
-                PathUtils::join(mSnapshot.dataDir(), kTexturesFileName).c_str(),
-                "wb", android::base::FileShare::Write);
+                texturesFile.c_str(), tryIncremental ? "rb+" : "wb",
+                android::base::FileShare::Write);
         if (!textures) {
             mRamSaver.clear();
             return;
         }
         mTextureSaver = std::make_shared<TextureSaver>(
-                StdioStream(textures, StdioStream::kOwner));
+                StdioStream(textures, StdioStream::kOwner),
+                tryIncremental ? TextureSaver::Mode::Incremental
+                               : TextureSaver::Mode::Full);
     }
 
     mStatus = OperationStatus::NotStarted;
@@ -46,7 +46,8 @@ void TextureLoader::loadTexture(uint32_t texId, const loader_t& loader) {
         case 1:
             loader(&mStream);
             break;
-        case 2: {
+        case 2:
+        case 3: {
             DecompressingStream stream(mStream);
             loader(&stream);
         }
@@ -56,6 +57,15 @@ void TextureLoader::loadTexture(uint32_t texId, const loader_t& loader) {
     }
 }
 
+uint64_t TextureLoader::chunkFor(uint32_t texId) const {
+    // Version 3 is the first one to identify its files and to know the size
+    // of each texture.
+    if (mVersion < 3) {
+        return 0;
+    }
+    return (uint64_t(mStamp) << 32) | texId;
+}
+
 bool TextureLoader::readIndex() {
 #if SNAPSHOT_PROFILE > 1
     auto start = android::base::System::get()->getHighResTimeUs();
@@ -68,14 +78,21 @@ bool TextureLoader::readIndex() {
     auto indexPos = mStream.getBe64();
     HANDLE_EINTR(fseeko64(mStream.get(), static_cast<int64_t>(indexPos), SEEK_SET));
     mVersion = mStream.getBe32();
-    if (mVersion < 1 || mVersion > 2) {
+    if (mVersion < 1 || mVersion > 3) {
         return false;
     }
+    if (mVersion >= 3) {
+        mStamp = mStream.getBe32();
+    }
     uint32_t texCount = mStream.getBe32();
     mIndex.reserve(texCount);
     for (uint32_t i = 0; i < texCount; i++) {
         uint32_t tex = mStream.getBe32();
         uint64_t filePos = mStream.getBe64();
+        if (mVersion >= 3) {
+            // The size is only needed when saving incrementally.
+            mStream.getBe64();
+        }
         mIndex.emplace(tex, filePos);
     }
 #if SNAPSHOT_PROFILE > 1
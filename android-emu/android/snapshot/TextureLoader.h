@@ -41,6 +41,10 @@ public:
     virtual bool start() = 0;
     // Move file position to texId and trigger loader
     virtual void loadTexture(uint32_t texId, const loader_t& loader) = 0;
+    // Returns the reference to the data of |texId|, which lets a later save
+    // of the same snapshot reuse it while the texture is unchanged (see
+    // ITextureSaver::reuseTexture()), or 0 if the file doesn't support that.
+    virtual uint64_t chunkFor(uint32_t texId) const = 0;
     virtual void acquireLoaderThread(LoaderThreadPtr thread) = 0;
     virtual bool hasError() const = 0;
     virtual uint64_t diskSize() const = 0;
@@ -55,6 +59,7 @@ public:
 
     AEMU_EXPORT bool start() override;
     AEMU_EXPORT void loadTexture(uint32_t texId, const loader_t& loader) override;
+    AEMU_EXPORT uint64_t chunkFor(uint32_t texId) const override;
     AEMU_EXPORT bool hasError() const override { return mHasError; }
     AEMU_EXPORT uint64_t diskSize() const override { return mDiskSize; }
     AEMU_EXPORT bool compressed() const override { return mVersion > 1; }
@@ -106,6 +111,7 @@ private:
     bool mStarted = false;
     bool mHasError = false;
     int mVersion = 0;
+    uint32_t mStamp = 0;
     uint64_t mDiskSize = 0;
     LoaderThreadPtr mLoaderThread;
 
@@ -11,24 +11,116 @@
 
 #include "android/snapshot/TextureSaver.h"
 
+#include "android/base/EintrWrapper.h"
 #include "android/base/files/CompressingStream.h"
+#include "android/base/misc/FileUtils.h"
 #include "android/base/system/System.h"
+#include "android/utils/debug.h"
 
 #include <algorithm>
 #include <cassert>
+#include <errno.h>
 #include <iterator>
+#include <random>
 #include <utility>
 
+using android::base::AutoLock;
 using android::base::CompressingStream;
 using android::base::System;
 
 namespace android {
 namespace snapshot {
 
-TextureSaver::TextureSaver(android::base::StdioStream&& stream)
+namespace {
+
+// An in-memory stream that appends everything written to it to |data|, and
+// the size of each write to |writeSizes| if it's set.
+class RecordingStream : public android::base::Stream {
+public:
+    RecordingStream(std::vector<char>* data,
+                    std::vector<uint32_t>* writeSizes = nullptr)
+        : mData(data), mWriteSizes(writeSizes) {}
+
+    ssize_t read(void*, size_t) override { return -EPERM; }
+
+    ssize_t write(const void* buffer, size_t size) override {
+        if (!size) {
+            return 0;
+        }
+        const auto bytes = static_cast<const char*>(buffer);
+        mData->insert(mData->end(), bytes, bytes + size);
+        if (mWriteSizes) {
+            mWriteSizes->push_back(static_cast<uint32_t>(size));
+        }
+        return size;
+    }
+
+private:
+    std::vector<char>* mData;
+    std::vector<uint32_t>* mWriteSizes;
+};
+
+}  // namespace
+
+static constexpr int kStopMarkerSlot = -1;
+
+// How much uncompressed texture data may wait for compression and writing
+// before saveTexture() blocks.
+static constexpr int64_t kMaxPendingBytes = 64 * 1024 * 1024;
+
+// A file isn't reused once more than this part of its texture data belongs to
+// textures that are gone or were saved again since.
+static constexpr double kMaxWastedFraction = 0.30;
+
+static constexpr int64_t kHeaderSize = 8;
+
+static uint64_t makeChunk(uint32_t stamp, uint32_t texId) {
+    return (uint64_t(stamp) << 32) | texId;
+}
+
+TextureSaver::TextureSaver(android::base::StdioStream&& stream, Mode mode)
     : mStream(std::move(stream)) {
-    // Put a placeholder for the index offset right now.
+    if (mode == Mode::Incremental && readBaseIndex()) {
+        // The textures that are saved again overwrite the old index, right
+        // after the data of the ones that can be reused.
+        mWritePos = mIndex.startPosInFile;
+    } else {
+        mBaseIndex.clear();
+        mBaseStamp = 0;
+        android::setFileSize(fileno(mStream.get()), 0);
+        mWritePos = kHeaderSize;
+    }
+
+    std::random_device random;
+    do {
+        mIndex.stamp = random();
+    } while (!mIndex.stamp || mIndex.stamp == mBaseStamp);
+
+    // Put a placeholder for the index offset right now. An incremental save
+    // also needs it: the old index is about to be overwritten.
+    HANDLE_EINTR(fseeko64(mStream.get(), 0, SEEK_SET));
     mStream.putBe64(0);
+    HANDLE_EINTR(fseeko64(mStream.get(), mWritePos, SEEK_SET));
+
+    mCompressors.emplace(std::min(System::get()->getCpuCoreCount() - 1, 2),
+                         [this](PendingTexture&& texture) {
+                             compressTexture(std::move(texture));
+                         });
+    if (!mCompressors->start()) {
+        mHasError = true;
+        return;
+    }
+    mWriter.emplace([this](CompressedTexture&& texture) {
+        if (texture.slot == kStopMarkerSlot) {
+            return base::WorkerProcessingResult::Stop;
+        }
+        writeTexture(std::move(texture));
+        return base::WorkerProcessingResult::Continue;
+    });
+    if (!mWriter->start()) {
+        mHasError = true;
+        return;
+    }
 }
 
 TextureSaver::~TextureSaver() {
@@ -36,48 +128,187 @@ TextureSaver::~TextureSaver() {
 }
 
 void TextureSaver::saveTexture(uint32_t texId, const saver_t& saver) {
+    if (mHasError) {
+        return;
+    }
 
     if (!mStartTime) {
         mStartTime = System::get()->getHighResTimeUs();
     }
 
-    assert(mIndex.textures.end() ==
-           std::find_if(mIndex.textures.begin(), mIndex.textures.end(),
-                        [texId](FileIndex::Texture& tex) {
-                            return tex.texId == texId;
-                        }));
-    mIndex.textures.push_back({texId, ftello64(mStream.get())});
+    PendingTexture texture;
+    {
+        AutoLock lock(mIndexLock);
+        assert(mIndex.textures.end() ==
+               std::find_if(mIndex.textures.begin(), mIndex.textures.end(),
+                            [texId](FileIndex::Texture& tex) {
+                                return tex.texId == texId;
+                            }));
+        texture.slot = static_cast<int>(mIndex.textures.size());
+        mIndex.textures.push_back({texId, 0, 0});
+    }
+
+    // Only the readback has to happen here, on the thread that has the GL
+    // context; compression and writing overlap with the next textures.
+    {
+        RecordingStream stream(&texture.data, &texture.writeSizes);
+        saver(&stream, &mBuffer);
+    }
 
-    CompressingStream stream(mStream);
-    saver(&stream, &mBuffer);
+    const auto size = static_cast<int64_t>(texture.data.size());
+    {
+        AutoLock lock(mPendingLock);
+        mPendingCv.wait(&lock,
+                        [this] { return mPendingBytes < kMaxPendingBytes; });
+        mPendingBytes += size;
+    }
+    mCompressors->enqueue(std::move(texture));
+}
+
+bool TextureSaver::reuseTexture(uint32_t texId, uint64_t chunk) {
+    if (mHasError || mBaseIndex.empty() ||
+        static_cast<uint32_t>(chunk >> 32) != mBaseStamp) {
+        return false;
+    }
+    const auto it = mBaseIndex.find(static_cast<uint32_t>(chunk));
+    if (it == mBaseIndex.end()) {
+        return false;
+    }
+
+    if (!mStartTime) {
+        mStartTime = System::get()->getHighResTimeUs();
+    }
+
+    AutoLock lock(mIndexLock);
+    mIndex.textures.push_back({texId, it->second.filePos, it->second.size});
+    return true;
+}
+
+uint64_t TextureSaver::chunkFor(uint32_t texId) const {
+    return makeChunk(mIndex.stamp, texId);
+}
+
+void TextureSaver::compressTexture(PendingTexture&& texture) {
+    CompressedTexture compressed = {
+            texture.slot, static_cast<int64_t>(texture.data.size())};
+    {
+        // Replay the writes one by one: the loader reads with the same sizes.
+        RecordingStream output(&compressed.data);
+        CompressingStream stream(output);
+        const char* data = texture.data.data();
+        for (const uint32_t size : texture.writeSizes) {
+            stream.write(data, size);
+            data += size;
+        }
+    }
+    texture.data = {};
+    mWriter->enqueue(std::move(compressed));
+}
+
+void TextureSaver::writeTexture(CompressedTexture&& texture) {
+    const auto size = static_cast<int64_t>(texture.data.size());
+    mStream.write(texture.data.data(), texture.data.size());
+    {
+        AutoLock lock(mIndexLock);
+        auto& entry = mIndex.textures[texture.slot];
+        entry.filePos = mWritePos;
+        entry.size = size;
+    }
+    mWritePos += size;
+
+    AutoLock lock(mPendingLock);
+    mPendingBytes -= texture.rawSize;
+    mPendingCv.broadcastAndUnlock(&lock);
 }
 
 void TextureSaver::done() {
     if (mFinished) {
         return;
     }
-    mIndex.startPosInFile = ftello64(mStream.get());
+    // Drain the pipeline: all compressors have to be done before the writer
+    // gets its stop marker.
+    mCompressors.clear();
+    if (mWriter) {
+        mWriter->enqueue({kStopMarkerSlot});
+        mWriter.clear();
+    }
+
+    mIndex.startPosInFile = mWritePos;
+    HANDLE_EINTR(fseeko64(mStream.get(), mWritePos, SEEK_SET));
     writeIndex();
     mEndTime = System::get()->getHighResTimeUs();
 #if SNAPSHOT_PROFILE > 1
     printf("Texture saving time: %.03f\n",
            (mEndTime - mStartTime) / 1000.0);
 #endif
-    mHasError = ferror(mStream.get()) != 0;
+    mHasError = mHasError || ferror(mStream.get()) != 0;
     mFinished = true;
     mStream.close();
 }
 
+bool TextureSaver::readBaseIndex() {
+    base::System::FileSize size = 0;
+    if (!System::get()->fileSize(fileno(mStream.get()), &size) ||
+        size < static_cast<base::System::FileSize>(kHeaderSize)) {
+        return false;
+    }
+    HANDLE_EINTR(fseeko64(mStream.get(), 0, SEEK_SET));
+    const auto indexPos = static_cast<int64_t>(mStream.getBe64());
+    if (indexPos < kHeaderSize || indexPos >= static_cast<int64_t>(size)) {
+        return false;
+    }
+    HANDLE_EINTR(fseeko64(mStream.get(), indexPos, SEEK_SET));
+    // Older files don't store the size of each texture.
+    if (static_cast<int32_t>(mStream.getBe32()) != mIndex.version) {
+        return false;
+    }
+    mBaseStamp = mStream.getBe32();
+    const uint32_t texCount = mStream.getBe32();
+    int64_t usedSize = 0;
+    mBaseIndex.reserve(texCount);
+    for (uint32_t i = 0; i < texCount; i++) {
+        FileIndex::Texture tex;
+        tex.texId = mStream.getBe32();
+        tex.filePos = static_cast<int64_t>(mStream.getBe64());
+        tex.size = static_cast<int64_t>(mStream.getBe64());
+        if (tex.filePos < kHeaderSize || tex.size < 0 ||
+            tex.filePos + tex.size > indexPos) {
+            return false;
+        }
+        usedSize += tex.size;
+        mBaseIndex.emplace(tex.texId, tex);
+    }
+    if (ferror(mStream.get())) {
+        return false;
+    }
+
+    const int64_t wastedSize = indexPos - kHeaderSize - usedSize;
+    const bool reuse =
+            wastedSize <= (indexPos - kHeaderSize) * kMaxWastedFraction;
+    VERBOSE_PRINT(snapshot,
+                  "%s incremental texture saving (currently wasting %lld"
+                  " bytes out of %lld)",
+                  reuse ? "Enabled" : "Disabled", (long long)wastedSize,
+                  (long long)(indexPos - kHeaderSize));
+    if (!reuse) {
+        return false;
+    }
+    mIndex.startPosInFile = indexPos;
+    return true;
+}
+
 void TextureSaver::writeIndex() {
 #if SNAPSHOT_PROFILE > 1
     auto start = ftello64(mStream.get());
 #endif
 
     mStream.putBe32(static_cast<uint32_t>(mIndex.version));
+    mStream.putBe32(mIndex.stamp);
     mStream.putBe32(static_cast<uint32_t>(mIndex.textures.size()));
     for (const FileIndex::Texture& b : mIndex.textures) {
         mStream.putBe32(b.texId);
         mStream.putBe64(static_cast<uint64_t>(b.filePos));
+        mStream.putBe64(static_cast<uint64_t>(b.size));
     }
     auto end = ftello64(mStream.get());
     mDiskSize = uint64_t(end);
@@ -85,6 +316,10 @@ void TextureSaver::writeIndex() {
     printf("texture: index size: %d\n", int(end - start));
 #endif
 
+    // An incremental save can leave the tail of the old index behind.
+    fflush(mStream.get());
+    android::setFileSize(fileno(mStream.get()), end);
+
     fseeko64(mStream.get(), 0, SEEK_SET);
     mStream.putBe64(static_cast<uint64_t>(mIndex.startPosInFile));
 }
@@ -11,13 +11,20 @@
 
 #pragma once
 
+#include "android/base/Optional.h"
 #include "android/base/containers/SmallVector.h"
 #include "android/base/export.h"
 #include "android/base/files/StdioStream.h"
+#include "android/base/synchronization/ConditionVariable.h"
+#include "android/base/synchronization/Lock.h"
 #include "android/base/system/System.h"
+#include "android/base/threads/ThreadPool.h"
+#include "android/base/threads/WorkerThread.h"
 #include "android/snapshot/common.h"
 
 #include <functional>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace android {
@@ -37,6 +44,15 @@ public:
 
     // Save texture to a stream as well as update the index
     virtual void saveTexture(uint32_t texId, const saver_t& saver) = 0;
+    // Point the index entry of |texId| at texture data that is already in the
+    // file, instead of saving it again. |chunk| is what chunkFor() returned
+    // when the texture was last saved, or what ITextureLoader::chunkFor()
+    // returned when it was loaded. Returns false if that data isn't part of
+    // the file being written; the texture has to be saved then.
+    virtual bool reuseTexture(uint32_t texId, uint64_t chunk) = 0;
+    // Returns the reference to the data saved for |texId| in this file, for a
+    // later reuseTexture() call.
+    virtual uint64_t chunkFor(uint32_t texId) const = 0;
     virtual bool hasError() const = 0;
     virtual uint64_t diskSize() const = 0;
     virtual bool compressed() const = 0;
@@ -47,14 +63,27 @@ class TextureSaver final : public ITextureSaver {
     DISALLOW_COPY_AND_ASSIGN(TextureSaver);
 
 public:
-    AEMU_EXPORT TextureSaver(android::base::StdioStream&& stream);
+    enum class Mode {
+        Full,
+        // |stream| holds the textures of an earlier save of the same
+        // snapshot. Textures that haven't changed since then keep their data
+        // where it is; everything else is appended after it. Falls back to a
+        // full save if the file can't be reused.
+        Incremental,
+    };
+
+    AEMU_EXPORT TextureSaver(android::base::StdioStream&& stream,
+                             Mode mode = Mode::Full);
     AEMU_EXPORT ~TextureSaver();
     AEMU_EXPORT void saveTexture(uint32_t texId, const saver_t& saver) override;
+    AEMU_EXPORT bool reuseTexture(uint32_t texId, uint64_t chunk) override;
+    AEMU_EXPORT uint64_t chunkFor(uint32_t texId) const override;
     AEMU_EXPORT void done();
 
     AEMU_EXPORT bool hasError() const override { return mHasError; }
     AEMU_EXPORT uint64_t diskSize() const override { return mDiskSize; }
     AEMU_EXPORT bool compressed() const override { return mIndex.version > 1; }
+    AEMU_EXPORT bool incremental() const { return !mBaseIndex.empty(); }
 
     // getDuration():
     // Returns true if there was save with measurable time
@@ -76,20 +105,64 @@ private:
         struct Texture {
             uint32_t texId;
             int64_t filePos;
+            int64_t size;
         };
 
         int64_t startPosInFile;
-        int32_t version = 2;
+        int32_t version = 3;
+        // Identifies this file in the chunk references handed out by
+        // chunkFor(), so that a reference is never resolved in a different
+        // file that happens to have a texture with the same id.
+        uint32_t stamp = 0;
         std::vector<Texture> textures;
     };
 
+    // The uncompressed texture data as the saver wrote it. The sizes of the
+    // individual writes are kept because each of them becomes its own LZ4
+    // block, and the loader reads the data back in the same pieces.
+    struct PendingTexture {
+        // Position of the texture in |mIndex.textures|.
+        int slot;
+        std::vector<char> data;
+        std::vector<uint32_t> writeSizes;
+    };
+
+    // A texture, compressed and ready to be appended to the file.
+    struct CompressedTexture {
+        int slot;
+        int64_t rawSize;
+        std::vector<char> data;
+    };
+
+    bool readBaseIndex();
+    void compressTexture(PendingTexture&& texture);
+    void writeTexture(CompressedTexture&& texture);
     void writeIndex();
 
     android::base::StdioStream mStream;
     // A buffer for fetching data from GPU memory to RAM.
     android::base::SmallFixedVector<unsigned char, 128> mBuffer;
 
+    // The chunks of the previous save that can be reused.
+    std::unordered_map<uint32_t, FileIndex::Texture> mBaseIndex;
+    uint32_t mBaseStamp = 0;
+
+    // Textures are read back on the caller's thread, compressed by
+    // |mCompressors| and appended to the file by |mWriter|, which is the
+    // only thread that touches |mStream| until done().
+    android::base::Optional<android::base::ThreadPool<PendingTexture>>
+            mCompressors;
+    android::base::Optional<android::base::WorkerThread<CompressedTexture>>
+            mWriter;
+    // Limits the amount of texture data waiting to be written, as the
+    // pipeline would otherwise buffer every texture of the snapshot.
+    android::base::Lock mPendingLock;
+    android::base::ConditionVariable mPendingCv;
+    int64_t mPendingBytes = 0;
+
+    android::base::Lock mIndexLock;
     FileIndex mIndex;
+    int64_t mWritePos = 0;
     uint64_t mDiskSize = 0;
     bool mFinished = false;
     bool mHasError = false;
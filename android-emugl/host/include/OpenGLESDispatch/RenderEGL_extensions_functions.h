@@ -21,6 +21,8 @@
   X(void, eglAddLibrarySearchPathANDROID, (const char* path)) \
   X(EGLBoolean, eglQueryVulkanInteropSupportANDROID, ()) \
   X(EGLBoolean, eglGetSyncAttribKHR, (EGLDisplay display, EGLSync sync, EGLint attribute, EGLint * value)) \
+  X(EGLBoolean, eglSwapBuffersWithDamageKHR, (EGLDisplay display, EGLSurface surface, EGLint* rects, EGLint n_rects)) \
+  X(EGLBoolean, eglSetDamageRegionKHR, (EGLDisplay display, EGLSurface surface, EGLint* rects, EGLint n_rects)) \
 
 EGLAPI EGLint EGLAPIENTRY eglGetMaxGLESVersion(EGLDisplay display);
 EGLAPI void EGLAPIENTRY eglBlitFromCurrentReadBufferANDROID(EGLDisplay display, EGLImageKHR image);
@@ -11,6 +11,8 @@
   X(void, glVertexAttribPointerWithDataSize, (GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr, GLsizei dataSize), (indx, size, type, normalized, stride, ptr, dataSize)) \
   X(void, glFramebufferTexture3DOES, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset), (target, attachment, textarget, texture, level, zoffset)) \
   X(void, glTestHostDriverPerformance, (GLuint count, uint64_t* duration_us, uint64_t* duration_cpu_us), (count, duration_us, duration_cpu_us)) \
+  X(void, glGetRedundantStateCallsAEMU, (uint64_t* count), (count)) \
+  X(void, glGetTextureDedupStatsAEMU, (uint64_t* hits, uint64_t* misses, uint64_t* savedBytes, uint64_t* cachedBytes), (hits, misses, savedBytes, cachedBytes)) \
   X(void, glBindVertexArrayOES, (GLuint array), (array)) \
   X(void, glDeleteVertexArraysOES, (GLsizei n, const GLuint * arrays), (n, arrays)) \
   X(void, glGenVertexArraysOES, (GLsizei n, GLuint * arrays), (n, arrays)) \
@@ -11,6 +11,8 @@ GL_APICALL void GL_APIENTRY glShaderBinary(GLsizei n, const GLuint* shaders, GLe
 GL_APICALL void GL_APIENTRY glVertexAttribPointerWithDataSize(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr, GLsizei dataSize);
 GL_APICALL void GL_APIENTRY glFramebufferTexture3DOES(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset);
 GL_APICALL void GL_APIENTRY glTestHostDriverPerformance(GLuint count, uint64_t* duration_us, uint64_t* duration_cpu_us);
+GL_APICALL void GL_APIENTRY glGetRedundantStateCallsAEMU(uint64_t* count);
+GL_APICALL void GL_APIENTRY glGetTextureDedupStatsAEMU(uint64_t* hits, uint64_t* misses, uint64_t* savedBytes, uint64_t* cachedBytes);
 GL_APICALL void GL_APIENTRY glBindVertexArrayOES(GLuint array);
 GL_APICALL void GL_APIENTRY glDeleteVertexArraysOES(GLsizei n, const GLuint * arrays);
 GL_APICALL void GL_APIENTRY glGenVertexArraysOES(GLsizei n, GLuint * arrays);
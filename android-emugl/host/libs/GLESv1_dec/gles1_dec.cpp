@@ -41,6 +41,17 @@ typedef unsigned int tsize_t; // Target "size_t", which is 32-bit for now. It ma
 using namespace emugl;
 
 int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
+    const bool useTracing = android::base::shouldEnableTracing();
+    if (checksumCalc->checksumByteSize() > 0) {
+        return useTracing ? decodeImpl<true, true>(buf, len, stream, checksumCalc)
+                          : decodeImpl<true, false>(buf, len, stream, checksumCalc);
+    }
+    return useTracing ? decodeImpl<false, true>(buf, len, stream, checksumCalc)
+                      : decodeImpl<false, false>(buf, len, stream, checksumCalc);
+}
+
+template <bool useChecksum, bool useTracing>
+int gles1_decoder_context_t::decodeImpl(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
     if (len < 8) return 0; 
 #ifdef CHECK_GL_ERRORS
     char lastCall[256] = {0};
@@ -48,7 +59,6 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
     unsigned char *ptr = (unsigned char *)buf;
     const unsigned char* const end = (const unsigned char*)buf + len;
     const size_t checksumSize = checksumCalc->checksumByteSize();
-    const bool useChecksum = checksumSize > 0;
     while (end - ptr >= 8) {
         uint32_t opcode = *(uint32_t *)ptr;   
         int32_t packetLen = *(int32_t *)(ptr + 4);
@@ -57,6 +67,7 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             return -1;
         }
         if (end - ptr < packetLen) return ptr - (unsigned char*)buf;
+        currentDecoderOpcode() = opcode;
 
 #ifdef CHECK_GL_OPCODE_TIME_USE
         struct timeval start;
@@ -69,7 +80,7 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
         
         switch(opcode) {
         case OP_glAlphaFunc: {
-            android::base::beginTrace("glAlphaFunc decode");
+            if (useTracing) android::base::beginTrace("glAlphaFunc decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             GLclampf var_ref = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -78,11 +89,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glAlphaFunc(var_func, var_ref);
             SET_LASTCALL("glAlphaFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearColor: {
-            android::base::beginTrace("glClearColor decode");
+            if (useTracing) android::base::beginTrace("glClearColor decode");
             GLclampf var_red = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLclampf var_green = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             GLclampf var_blue = Unpack<GLclampf,uint32_t>(ptr + 8 + 4 + 4);
@@ -93,11 +104,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearColor(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glClearColor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearDepthf: {
-            android::base::beginTrace("glClearDepthf decode");
+            if (useTracing) android::base::beginTrace("glClearDepthf decode");
             GLclampf var_depth = Unpack<GLclampf,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -105,11 +116,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearDepthf(var_depth);
             SET_LASTCALL("glClearDepthf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClipPlanef: {
-            android::base::beginTrace("glClipPlanef decode");
+            if (useTracing) android::base::beginTrace("glClipPlanef decode");
             GLenum var_plane = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_equation __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_equation(ptr + 8 + 4 + 4, size_equation);
@@ -119,11 +130,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClipPlanef(var_plane, (const GLfloat*)(inptr_equation.get()));
             SET_LASTCALL("glClipPlanef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColor4f: {
-            android::base::beginTrace("glColor4f decode");
+            if (useTracing) android::base::beginTrace("glColor4f decode");
             GLfloat var_red = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_green = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_blue = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -134,11 +145,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColor4f(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glColor4f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthRangef: {
-            android::base::beginTrace("glDepthRangef decode");
+            if (useTracing) android::base::beginTrace("glDepthRangef decode");
             GLclampf var_zNear = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLclampf var_zFar = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -147,11 +158,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthRangef(var_zNear, var_zFar);
             SET_LASTCALL("glDepthRangef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFogf: {
-            android::base::beginTrace("glFogf decode");
+            if (useTracing) android::base::beginTrace("glFogf decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -160,11 +171,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFogf(var_pname, var_param);
             SET_LASTCALL("glFogf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFogfv: {
-            android::base::beginTrace("glFogfv decode");
+            if (useTracing) android::base::beginTrace("glFogfv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -174,11 +185,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFogfv(var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glFogfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFrustumf: {
-            android::base::beginTrace("glFrustumf decode");
+            if (useTracing) android::base::beginTrace("glFrustumf decode");
             GLfloat var_left = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_right = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_bottom = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -191,11 +202,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFrustumf(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glFrustumf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetClipPlanef: {
-            android::base::beginTrace("glGetClipPlanef decode");
+            if (useTracing) android::base::beginTrace("glGetClipPlanef decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_eqn __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -213,11 +224,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetClipPlanef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFloatv: {
-            android::base::beginTrace("glGetFloatv decode");
+            if (useTracing) android::base::beginTrace("glGetFloatv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -235,11 +246,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFloatv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetLightfv: {
-            android::base::beginTrace("glGetLightfv decode");
+            if (useTracing) android::base::beginTrace("glGetLightfv decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -258,11 +269,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetLightfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetMaterialfv: {
-            android::base::beginTrace("glGetMaterialfv decode");
+            if (useTracing) android::base::beginTrace("glGetMaterialfv decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -281,11 +292,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetMaterialfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexEnvfv: {
-            android::base::beginTrace("glGetTexEnvfv decode");
+            if (useTracing) android::base::beginTrace("glGetTexEnvfv decode");
             GLenum var_env = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -304,11 +315,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexEnvfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexParameterfv: {
-            android::base::beginTrace("glGetTexParameterfv decode");
+            if (useTracing) android::base::beginTrace("glGetTexParameterfv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -327,11 +338,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightModelf: {
-            android::base::beginTrace("glLightModelf decode");
+            if (useTracing) android::base::beginTrace("glLightModelf decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -340,11 +351,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightModelf(var_pname, var_param);
             SET_LASTCALL("glLightModelf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightModelfv: {
-            android::base::beginTrace("glLightModelfv decode");
+            if (useTracing) android::base::beginTrace("glLightModelfv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -354,11 +365,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightModelfv(var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glLightModelfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightf: {
-            android::base::beginTrace("glLightf decode");
+            if (useTracing) android::base::beginTrace("glLightf decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -368,11 +379,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightf(var_light, var_pname, var_param);
             SET_LASTCALL("glLightf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightfv: {
-            android::base::beginTrace("glLightfv decode");
+            if (useTracing) android::base::beginTrace("glLightfv decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -383,11 +394,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightfv(var_light, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glLightfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLineWidth: {
-            android::base::beginTrace("glLineWidth decode");
+            if (useTracing) android::base::beginTrace("glLineWidth decode");
             GLfloat var_width = Unpack<GLfloat,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -395,11 +406,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLineWidth(var_width);
             SET_LASTCALL("glLineWidth");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLoadMatrixf: {
-            android::base::beginTrace("glLoadMatrixf decode");
+            if (useTracing) android::base::beginTrace("glLoadMatrixf decode");
             uint32_t size_m __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_m(ptr + 8 + 4, size_m);
             if (useChecksum) {
@@ -408,11 +419,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLoadMatrixf((const GLfloat*)(inptr_m.get()));
             SET_LASTCALL("glLoadMatrixf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMaterialf: {
-            android::base::beginTrace("glMaterialf decode");
+            if (useTracing) android::base::beginTrace("glMaterialf decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -422,11 +433,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMaterialf(var_face, var_pname, var_param);
             SET_LASTCALL("glMaterialf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMaterialfv: {
-            android::base::beginTrace("glMaterialfv decode");
+            if (useTracing) android::base::beginTrace("glMaterialfv decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -437,11 +448,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMaterialfv(var_face, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glMaterialfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultMatrixf: {
-            android::base::beginTrace("glMultMatrixf decode");
+            if (useTracing) android::base::beginTrace("glMultMatrixf decode");
             uint32_t size_m __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_m(ptr + 8 + 4, size_m);
             if (useChecksum) {
@@ -450,11 +461,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultMatrixf((const GLfloat*)(inptr_m.get()));
             SET_LASTCALL("glMultMatrixf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiTexCoord4f: {
-            android::base::beginTrace("glMultiTexCoord4f decode");
+            if (useTracing) android::base::beginTrace("glMultiTexCoord4f decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfloat var_s = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_t = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -466,11 +477,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiTexCoord4f(var_target, var_s, var_t, var_r, var_q);
             SET_LASTCALL("glMultiTexCoord4f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glNormal3f: {
-            android::base::beginTrace("glNormal3f decode");
+            if (useTracing) android::base::beginTrace("glNormal3f decode");
             GLfloat var_nx = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_ny = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_nz = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -480,11 +491,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glNormal3f(var_nx, var_ny, var_nz);
             SET_LASTCALL("glNormal3f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glOrthof: {
-            android::base::beginTrace("glOrthof decode");
+            if (useTracing) android::base::beginTrace("glOrthof decode");
             GLfloat var_left = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_right = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_bottom = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -497,11 +508,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glOrthof(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glOrthof");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointParameterf: {
-            android::base::beginTrace("glPointParameterf decode");
+            if (useTracing) android::base::beginTrace("glPointParameterf decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -510,11 +521,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointParameterf(var_pname, var_param);
             SET_LASTCALL("glPointParameterf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointParameterfv: {
-            android::base::beginTrace("glPointParameterfv decode");
+            if (useTracing) android::base::beginTrace("glPointParameterfv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -524,11 +535,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointParameterfv(var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glPointParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointSize: {
-            android::base::beginTrace("glPointSize decode");
+            if (useTracing) android::base::beginTrace("glPointSize decode");
             GLfloat var_size = Unpack<GLfloat,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -536,11 +547,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointSize(var_size);
             SET_LASTCALL("glPointSize");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPolygonOffset: {
-            android::base::beginTrace("glPolygonOffset decode");
+            if (useTracing) android::base::beginTrace("glPolygonOffset decode");
             GLfloat var_factor = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_units = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -549,11 +560,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPolygonOffset(var_factor, var_units);
             SET_LASTCALL("glPolygonOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRotatef: {
-            android::base::beginTrace("glRotatef decode");
+            if (useTracing) android::base::beginTrace("glRotatef decode");
             GLfloat var_angle = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -564,11 +575,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRotatef(var_angle, var_x, var_y, var_z);
             SET_LASTCALL("glRotatef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glScalef: {
-            android::base::beginTrace("glScalef decode");
+            if (useTracing) android::base::beginTrace("glScalef decode");
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_z = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -578,11 +589,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glScalef(var_x, var_y, var_z);
             SET_LASTCALL("glScalef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvf: {
-            android::base::beginTrace("glTexEnvf decode");
+            if (useTracing) android::base::beginTrace("glTexEnvf decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -592,11 +603,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvf(var_target, var_pname, var_param);
             SET_LASTCALL("glTexEnvf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvfv: {
-            android::base::beginTrace("glTexEnvfv decode");
+            if (useTracing) android::base::beginTrace("glTexEnvfv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -607,11 +618,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvfv(var_target, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glTexEnvfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterf: {
-            android::base::beginTrace("glTexParameterf decode");
+            if (useTracing) android::base::beginTrace("glTexParameterf decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -621,11 +632,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterf(var_target, var_pname, var_param);
             SET_LASTCALL("glTexParameterf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterfv: {
-            android::base::beginTrace("glTexParameterfv decode");
+            if (useTracing) android::base::beginTrace("glTexParameterfv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -636,11 +647,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterfv(var_target, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glTexParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTranslatef: {
-            android::base::beginTrace("glTranslatef decode");
+            if (useTracing) android::base::beginTrace("glTranslatef decode");
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_z = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -650,11 +661,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTranslatef(var_x, var_y, var_z);
             SET_LASTCALL("glTranslatef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glActiveTexture: {
-            android::base::beginTrace("glActiveTexture decode");
+            if (useTracing) android::base::beginTrace("glActiveTexture decode");
             GLenum var_texture = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -662,11 +673,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glActiveTexture(var_texture);
             SET_LASTCALL("glActiveTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glAlphaFuncx: {
-            android::base::beginTrace("glAlphaFuncx decode");
+            if (useTracing) android::base::beginTrace("glAlphaFuncx decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             GLclampx var_ref = Unpack<GLclampx,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -675,11 +686,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glAlphaFuncx(var_func, var_ref);
             SET_LASTCALL("glAlphaFuncx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindBuffer: {
-            android::base::beginTrace("glBindBuffer decode");
+            if (useTracing) android::base::beginTrace("glBindBuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -688,11 +699,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindBuffer(var_target, var_buffer);
             SET_LASTCALL("glBindBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindTexture: {
-            android::base::beginTrace("glBindTexture decode");
+            if (useTracing) android::base::beginTrace("glBindTexture decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -701,11 +712,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindTexture(var_target, var_texture);
             SET_LASTCALL("glBindTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendFunc: {
-            android::base::beginTrace("glBlendFunc decode");
+            if (useTracing) android::base::beginTrace("glBlendFunc decode");
             GLenum var_sfactor = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_dfactor = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -714,15 +725,15 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendFunc(var_sfactor, var_dfactor);
             SET_LASTCALL("glBlendFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBufferData: {
-            android::base::beginTrace("glBufferData decode");
+            if (useTracing) android::base::beginTrace("glBufferData decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizeiptr var_size = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_data(ptr + 8 + 4 + 4 + 4, size_data);
+            ByteInputBuffer inptr_data(ptr + 8 + 4 + 4 + 4, size_data);
             GLenum var_usage = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_data);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_data + 4, ptr + 8 + 4 + 4 + 4 + size_data + 4, checksumSize, 
@@ -730,27 +741,27 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBufferData(var_target, var_size, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()), var_usage);
             SET_LASTCALL("glBufferData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBufferSubData: {
-            android::base::beginTrace("glBufferSubData decode");
+            if (useTracing) android::base::beginTrace("glBufferSubData decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_size = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4);
-            InputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4, size_data);
+            ByteInputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4, size_data);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + size_data, ptr + 8 + 4 + 4 + 4 + 4 + size_data, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glBufferSubData: GL checksumCalculator failure\n");
             }
             this->glBufferSubData(var_target, var_offset, var_size, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glBufferSubData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClear: {
-            android::base::beginTrace("glClear decode");
+            if (useTracing) android::base::beginTrace("glClear decode");
             GLbitfield var_mask = Unpack<GLbitfield,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -758,11 +769,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClear(var_mask);
             SET_LASTCALL("glClear");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearColorx: {
-            android::base::beginTrace("glClearColorx decode");
+            if (useTracing) android::base::beginTrace("glClearColorx decode");
             GLclampx var_red = Unpack<GLclampx,uint32_t>(ptr + 8);
             GLclampx var_green = Unpack<GLclampx,uint32_t>(ptr + 8 + 4);
             GLclampx var_blue = Unpack<GLclampx,uint32_t>(ptr + 8 + 4 + 4);
@@ -773,11 +784,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearColorx(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glClearColorx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearDepthx: {
-            android::base::beginTrace("glClearDepthx decode");
+            if (useTracing) android::base::beginTrace("glClearDepthx decode");
             GLclampx var_depth = Unpack<GLclampx,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -785,11 +796,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearDepthx(var_depth);
             SET_LASTCALL("glClearDepthx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearStencil: {
-            android::base::beginTrace("glClearStencil decode");
+            if (useTracing) android::base::beginTrace("glClearStencil decode");
             GLint var_s = Unpack<GLint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -797,11 +808,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearStencil(var_s);
             SET_LASTCALL("glClearStencil");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClientActiveTexture: {
-            android::base::beginTrace("glClientActiveTexture decode");
+            if (useTracing) android::base::beginTrace("glClientActiveTexture decode");
             GLenum var_texture = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -809,11 +820,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClientActiveTexture(var_texture);
             SET_LASTCALL("glClientActiveTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColor4ub: {
-            android::base::beginTrace("glColor4ub decode");
+            if (useTracing) android::base::beginTrace("glColor4ub decode");
             GLubyte var_red = Unpack<GLubyte,uint8_t>(ptr + 8);
             GLubyte var_green = Unpack<GLubyte,uint8_t>(ptr + 8 + 1);
             GLubyte var_blue = Unpack<GLubyte,uint8_t>(ptr + 8 + 1 + 1);
@@ -824,11 +835,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColor4ub(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glColor4ub");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColor4x: {
-            android::base::beginTrace("glColor4x decode");
+            if (useTracing) android::base::beginTrace("glColor4x decode");
             GLfixed var_red = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_green = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_blue = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -839,11 +850,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColor4x(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glColor4x");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColorMask: {
-            android::base::beginTrace("glColorMask decode");
+            if (useTracing) android::base::beginTrace("glColorMask decode");
             GLboolean var_red = Unpack<GLboolean,uint8_t>(ptr + 8);
             GLboolean var_green = Unpack<GLboolean,uint8_t>(ptr + 8 + 1);
             GLboolean var_blue = Unpack<GLboolean,uint8_t>(ptr + 8 + 1 + 1);
@@ -854,11 +865,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColorMask(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glColorMask");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColorPointer: {
-            android::base::beginTrace("glColorPointer decode");
+            if (useTracing) android::base::beginTrace("glColorPointer decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -870,11 +881,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColorPointer(var_size, var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glColorPointer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexImage2D: {
-            android::base::beginTrace("glCompressedTexImage2D decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -890,11 +901,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexImage2D(var_target, var_level, var_internalformat, var_width, var_height, var_border, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexSubImage2D: {
-            android::base::beginTrace("glCompressedTexSubImage2D decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexSubImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -911,11 +922,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexSubImage2D(var_target, var_level, var_xoffset, var_yoffset, var_width, var_height, var_format, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexSubImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyTexImage2D: {
-            android::base::beginTrace("glCopyTexImage2D decode");
+            if (useTracing) android::base::beginTrace("glCopyTexImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -930,11 +941,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyTexImage2D(var_target, var_level, var_internalformat, var_x, var_y, var_width, var_height, var_border);
             SET_LASTCALL("glCopyTexImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyTexSubImage2D: {
-            android::base::beginTrace("glCopyTexSubImage2D decode");
+            if (useTracing) android::base::beginTrace("glCopyTexSubImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -949,11 +960,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyTexSubImage2D(var_target, var_level, var_xoffset, var_yoffset, var_x, var_y, var_width, var_height);
             SET_LASTCALL("glCopyTexSubImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCullFace: {
-            android::base::beginTrace("glCullFace decode");
+            if (useTracing) android::base::beginTrace("glCullFace decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -961,11 +972,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCullFace(var_mode);
             SET_LASTCALL("glCullFace");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteBuffers: {
-            android::base::beginTrace("glDeleteBuffers decode");
+            if (useTracing) android::base::beginTrace("glDeleteBuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_buffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_buffers(ptr + 8 + 4 + 4, size_buffers);
@@ -975,11 +986,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteBuffers_dec(this, var_n, (const GLuint*)(inptr_buffers.get()));
             SET_LASTCALL("glDeleteBuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteTextures: {
-            android::base::beginTrace("glDeleteTextures decode");
+            if (useTracing) android::base::beginTrace("glDeleteTextures decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_textures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_textures(ptr + 8 + 4 + 4, size_textures);
@@ -989,11 +1000,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteTextures_dec(this, var_n, (const GLuint*)(inptr_textures.get()));
             SET_LASTCALL("glDeleteTextures");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthFunc: {
-            android::base::beginTrace("glDepthFunc decode");
+            if (useTracing) android::base::beginTrace("glDepthFunc decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1001,11 +1012,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthFunc(var_func);
             SET_LASTCALL("glDepthFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthMask: {
-            android::base::beginTrace("glDepthMask decode");
+            if (useTracing) android::base::beginTrace("glDepthMask decode");
             GLboolean var_flag = Unpack<GLboolean,uint8_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 1, ptr + 8 + 1, checksumSize, 
@@ -1013,11 +1024,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthMask(var_flag);
             SET_LASTCALL("glDepthMask");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthRangex: {
-            android::base::beginTrace("glDepthRangex decode");
+            if (useTracing) android::base::beginTrace("glDepthRangex decode");
             GLclampx var_zNear = Unpack<GLclampx,uint32_t>(ptr + 8);
             GLclampx var_zFar = Unpack<GLclampx,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1026,11 +1037,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthRangex(var_zNear, var_zFar);
             SET_LASTCALL("glDepthRangex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDisable: {
-            android::base::beginTrace("glDisable decode");
+            if (useTracing) android::base::beginTrace("glDisable decode");
             GLenum var_cap = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1038,11 +1049,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDisable(var_cap);
             SET_LASTCALL("glDisable");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDisableClientState: {
-            android::base::beginTrace("glDisableClientState decode");
+            if (useTracing) android::base::beginTrace("glDisableClientState decode");
             GLenum var_array = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1050,11 +1061,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDisableClientState(var_array);
             SET_LASTCALL("glDisableClientState");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArrays: {
-            android::base::beginTrace("glDrawArrays decode");
+            if (useTracing) android::base::beginTrace("glDrawArrays decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_first = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -1064,11 +1075,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArrays(var_mode, var_first, var_count);
             SET_LASTCALL("glDrawArrays");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElements: {
-            android::base::beginTrace("glDrawElements decode");
+            if (useTracing) android::base::beginTrace("glDrawElements decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -1080,11 +1091,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElements(var_mode, var_count, var_type, (const GLvoid*)(inptr_indices.get()));
             SET_LASTCALL("glDrawElements");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEnable: {
-            android::base::beginTrace("glEnable decode");
+            if (useTracing) android::base::beginTrace("glEnable decode");
             GLenum var_cap = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1092,11 +1103,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEnable(var_cap);
             SET_LASTCALL("glEnable");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEnableClientState: {
-            android::base::beginTrace("glEnableClientState decode");
+            if (useTracing) android::base::beginTrace("glEnableClientState decode");
             GLenum var_array = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1104,33 +1115,33 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEnableClientState(var_array);
             SET_LASTCALL("glEnableClientState");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFinish: {
-            android::base::beginTrace("glFinish decode");
+            if (useTracing) android::base::beginTrace("glFinish decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glFinish: GL checksumCalculator failure\n");
             }
             this->glFinish();
             SET_LASTCALL("glFinish");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFlush: {
-            android::base::beginTrace("glFlush decode");
+            if (useTracing) android::base::beginTrace("glFlush decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glFlush: GL checksumCalculator failure\n");
             }
             this->glFlush();
             SET_LASTCALL("glFlush");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFogx: {
-            android::base::beginTrace("glFogx decode");
+            if (useTracing) android::base::beginTrace("glFogx decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1139,11 +1150,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFogx(var_pname, var_param);
             SET_LASTCALL("glFogx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFogxv: {
-            android::base::beginTrace("glFogxv decode");
+            if (useTracing) android::base::beginTrace("glFogxv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -1153,11 +1164,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFogxv(var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glFogxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFrontFace: {
-            android::base::beginTrace("glFrontFace decode");
+            if (useTracing) android::base::beginTrace("glFrontFace decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1165,11 +1176,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFrontFace(var_mode);
             SET_LASTCALL("glFrontFace");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFrustumx: {
-            android::base::beginTrace("glFrustumx decode");
+            if (useTracing) android::base::beginTrace("glFrustumx decode");
             GLfixed var_left = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_right = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_bottom = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1182,11 +1193,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFrustumx(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glFrustumx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBooleanv: {
-            android::base::beginTrace("glGetBooleanv decode");
+            if (useTracing) android::base::beginTrace("glGetBooleanv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1204,11 +1215,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetBooleanv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBufferParameteriv: {
-            android::base::beginTrace("glGetBufferParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetBufferParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1227,11 +1238,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetBufferParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClipPlanex: {
-            android::base::beginTrace("glClipPlanex decode");
+            if (useTracing) android::base::beginTrace("glClipPlanex decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_eqn __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_eqn(ptr + 8 + 4 + 4, size_eqn);
@@ -1241,11 +1252,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClipPlanex(var_pname, (const GLfixed*)(inptr_eqn.get()));
             SET_LASTCALL("glClipPlanex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenBuffers: {
-            android::base::beginTrace("glGenBuffers decode");
+            if (useTracing) android::base::beginTrace("glGenBuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_buffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1263,11 +1274,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenBuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenTextures: {
-            android::base::beginTrace("glGenTextures decode");
+            if (useTracing) android::base::beginTrace("glGenTextures decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_textures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1285,11 +1296,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenTextures");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetError: {
-            android::base::beginTrace("glGetError decode");
+            if (useTracing) android::base::beginTrace("glGetError decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glGetError: GL checksumCalculator failure\n");
@@ -1303,11 +1314,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetError");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFixedv: {
-            android::base::beginTrace("glGetFixedv decode");
+            if (useTracing) android::base::beginTrace("glGetFixedv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1325,11 +1336,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFixedv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetIntegerv: {
-            android::base::beginTrace("glGetIntegerv decode");
+            if (useTracing) android::base::beginTrace("glGetIntegerv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1347,11 +1358,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetIntegerv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetLightxv: {
-            android::base::beginTrace("glGetLightxv decode");
+            if (useTracing) android::base::beginTrace("glGetLightxv decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1370,11 +1381,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetLightxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetMaterialxv: {
-            android::base::beginTrace("glGetMaterialxv decode");
+            if (useTracing) android::base::beginTrace("glGetMaterialxv decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1393,11 +1404,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetMaterialxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPointerv: {
-            android::base::beginTrace("glGetPointerv decode");
+            if (useTracing) android::base::beginTrace("glGetPointerv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -1407,11 +1418,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetPointerv(var_pname, (GLvoid**)(inptr_params.get()));
             SET_LASTCALL("glGetPointerv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetString: {
-            android::base::beginTrace("glGetString decode");
+            if (useTracing) android::base::beginTrace("glGetString decode");
             GLenum var_name = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1419,11 +1430,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetString(var_name);
             SET_LASTCALL("glGetString");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexEnviv: {
-            android::base::beginTrace("glGetTexEnviv decode");
+            if (useTracing) android::base::beginTrace("glGetTexEnviv decode");
             GLenum var_env = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1442,11 +1453,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexEnviv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexEnvxv: {
-            android::base::beginTrace("glGetTexEnvxv decode");
+            if (useTracing) android::base::beginTrace("glGetTexEnvxv decode");
             GLenum var_env = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1465,11 +1476,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexEnvxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexParameteriv: {
-            android::base::beginTrace("glGetTexParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetTexParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1488,11 +1499,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexParameterxv: {
-            android::base::beginTrace("glGetTexParameterxv decode");
+            if (useTracing) android::base::beginTrace("glGetTexParameterxv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1511,11 +1522,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexParameterxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glHint: {
-            android::base::beginTrace("glHint decode");
+            if (useTracing) android::base::beginTrace("glHint decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1524,11 +1535,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glHint(var_target, var_mode);
             SET_LASTCALL("glHint");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsBuffer: {
-            android::base::beginTrace("glIsBuffer decode");
+            if (useTracing) android::base::beginTrace("glIsBuffer decode");
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1543,11 +1554,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsEnabled: {
-            android::base::beginTrace("glIsEnabled decode");
+            if (useTracing) android::base::beginTrace("glIsEnabled decode");
             GLenum var_cap = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1562,11 +1573,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsEnabled");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsTexture: {
-            android::base::beginTrace("glIsTexture decode");
+            if (useTracing) android::base::beginTrace("glIsTexture decode");
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1581,11 +1592,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightModelx: {
-            android::base::beginTrace("glLightModelx decode");
+            if (useTracing) android::base::beginTrace("glLightModelx decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1594,11 +1605,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightModelx(var_pname, var_param);
             SET_LASTCALL("glLightModelx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightModelxv: {
-            android::base::beginTrace("glLightModelxv decode");
+            if (useTracing) android::base::beginTrace("glLightModelxv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -1608,11 +1619,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightModelxv(var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glLightModelxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightx: {
-            android::base::beginTrace("glLightx decode");
+            if (useTracing) android::base::beginTrace("glLightx decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1622,11 +1633,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightx(var_light, var_pname, var_param);
             SET_LASTCALL("glLightx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightxv: {
-            android::base::beginTrace("glLightxv decode");
+            if (useTracing) android::base::beginTrace("glLightxv decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1637,11 +1648,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightxv(var_light, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glLightxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLineWidthx: {
-            android::base::beginTrace("glLineWidthx decode");
+            if (useTracing) android::base::beginTrace("glLineWidthx decode");
             GLfixed var_width = Unpack<GLfixed,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1649,22 +1660,22 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLineWidthx(var_width);
             SET_LASTCALL("glLineWidthx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLoadIdentity: {
-            android::base::beginTrace("glLoadIdentity decode");
+            if (useTracing) android::base::beginTrace("glLoadIdentity decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glLoadIdentity: GL checksumCalculator failure\n");
             }
             this->glLoadIdentity();
             SET_LASTCALL("glLoadIdentity");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLoadMatrixx: {
-            android::base::beginTrace("glLoadMatrixx decode");
+            if (useTracing) android::base::beginTrace("glLoadMatrixx decode");
             uint32_t size_m __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_m(ptr + 8 + 4, size_m);
             if (useChecksum) {
@@ -1673,11 +1684,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLoadMatrixx((const GLfixed*)(inptr_m.get()));
             SET_LASTCALL("glLoadMatrixx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLogicOp: {
-            android::base::beginTrace("glLogicOp decode");
+            if (useTracing) android::base::beginTrace("glLogicOp decode");
             GLenum var_opcode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1685,11 +1696,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLogicOp(var_opcode);
             SET_LASTCALL("glLogicOp");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMaterialx: {
-            android::base::beginTrace("glMaterialx decode");
+            if (useTracing) android::base::beginTrace("glMaterialx decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1699,11 +1710,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMaterialx(var_face, var_pname, var_param);
             SET_LASTCALL("glMaterialx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMaterialxv: {
-            android::base::beginTrace("glMaterialxv decode");
+            if (useTracing) android::base::beginTrace("glMaterialxv decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1714,11 +1725,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMaterialxv(var_face, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glMaterialxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMatrixMode: {
-            android::base::beginTrace("glMatrixMode decode");
+            if (useTracing) android::base::beginTrace("glMatrixMode decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1726,11 +1737,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMatrixMode(var_mode);
             SET_LASTCALL("glMatrixMode");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultMatrixx: {
-            android::base::beginTrace("glMultMatrixx decode");
+            if (useTracing) android::base::beginTrace("glMultMatrixx decode");
             uint32_t size_m __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_m(ptr + 8 + 4, size_m);
             if (useChecksum) {
@@ -1739,11 +1750,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultMatrixx((const GLfixed*)(inptr_m.get()));
             SET_LASTCALL("glMultMatrixx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiTexCoord4x: {
-            android::base::beginTrace("glMultiTexCoord4x decode");
+            if (useTracing) android::base::beginTrace("glMultiTexCoord4x decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_s = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_t = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1755,11 +1766,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiTexCoord4x(var_target, var_s, var_t, var_r, var_q);
             SET_LASTCALL("glMultiTexCoord4x");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glNormal3x: {
-            android::base::beginTrace("glNormal3x decode");
+            if (useTracing) android::base::beginTrace("glNormal3x decode");
             GLfixed var_nx = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_ny = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_nz = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1769,11 +1780,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glNormal3x(var_nx, var_ny, var_nz);
             SET_LASTCALL("glNormal3x");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glNormalPointer: {
-            android::base::beginTrace("glNormalPointer decode");
+            if (useTracing) android::base::beginTrace("glNormalPointer decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_pointer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1784,11 +1795,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glNormalPointer(var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glNormalPointer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glOrthox: {
-            android::base::beginTrace("glOrthox decode");
+            if (useTracing) android::base::beginTrace("glOrthox decode");
             GLfixed var_left = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_right = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_bottom = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1801,11 +1812,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glOrthox(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glOrthox");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPixelStorei: {
-            android::base::beginTrace("glPixelStorei decode");
+            if (useTracing) android::base::beginTrace("glPixelStorei decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1814,11 +1825,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPixelStorei(var_pname, var_param);
             SET_LASTCALL("glPixelStorei");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointParameterx: {
-            android::base::beginTrace("glPointParameterx decode");
+            if (useTracing) android::base::beginTrace("glPointParameterx decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1827,11 +1838,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointParameterx(var_pname, var_param);
             SET_LASTCALL("glPointParameterx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointParameterxv: {
-            android::base::beginTrace("glPointParameterxv decode");
+            if (useTracing) android::base::beginTrace("glPointParameterxv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -1841,11 +1852,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointParameterxv(var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glPointParameterxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointSizex: {
-            android::base::beginTrace("glPointSizex decode");
+            if (useTracing) android::base::beginTrace("glPointSizex decode");
             GLfixed var_size = Unpack<GLfixed,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1853,11 +1864,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointSizex(var_size);
             SET_LASTCALL("glPointSizex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPolygonOffsetx: {
-            android::base::beginTrace("glPolygonOffsetx decode");
+            if (useTracing) android::base::beginTrace("glPolygonOffsetx decode");
             GLfixed var_factor = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_units = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1866,33 +1877,33 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPolygonOffsetx(var_factor, var_units);
             SET_LASTCALL("glPolygonOffsetx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPopMatrix: {
-            android::base::beginTrace("glPopMatrix decode");
+            if (useTracing) android::base::beginTrace("glPopMatrix decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glPopMatrix: GL checksumCalculator failure\n");
             }
             this->glPopMatrix();
             SET_LASTCALL("glPopMatrix");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPushMatrix: {
-            android::base::beginTrace("glPushMatrix decode");
+            if (useTracing) android::base::beginTrace("glPushMatrix decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glPushMatrix: GL checksumCalculator failure\n");
             }
             this->glPushMatrix();
             SET_LASTCALL("glPushMatrix");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReadPixels: {
-            android::base::beginTrace("glReadPixels decode");
+            if (useTracing) android::base::beginTrace("glReadPixels decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -1915,11 +1926,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glReadPixels");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRotatex: {
-            android::base::beginTrace("glRotatex decode");
+            if (useTracing) android::base::beginTrace("glRotatex decode");
             GLfixed var_angle = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1930,11 +1941,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRotatex(var_angle, var_x, var_y, var_z);
             SET_LASTCALL("glRotatex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSampleCoverage: {
-            android::base::beginTrace("glSampleCoverage decode");
+            if (useTracing) android::base::beginTrace("glSampleCoverage decode");
             GLclampf var_value = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLboolean var_invert = Unpack<GLboolean,uint8_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1943,11 +1954,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSampleCoverage(var_value, var_invert);
             SET_LASTCALL("glSampleCoverage");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSampleCoveragex: {
-            android::base::beginTrace("glSampleCoveragex decode");
+            if (useTracing) android::base::beginTrace("glSampleCoveragex decode");
             GLclampx var_value = Unpack<GLclampx,uint32_t>(ptr + 8);
             GLboolean var_invert = Unpack<GLboolean,uint8_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1956,11 +1967,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSampleCoveragex(var_value, var_invert);
             SET_LASTCALL("glSampleCoveragex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glScalex: {
-            android::base::beginTrace("glScalex decode");
+            if (useTracing) android::base::beginTrace("glScalex decode");
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_z = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -1970,11 +1981,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glScalex(var_x, var_y, var_z);
             SET_LASTCALL("glScalex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glScissor: {
-            android::base::beginTrace("glScissor decode");
+            if (useTracing) android::base::beginTrace("glScissor decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -1985,11 +1996,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glScissor(var_x, var_y, var_width, var_height);
             SET_LASTCALL("glScissor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glShadeModel: {
-            android::base::beginTrace("glShadeModel decode");
+            if (useTracing) android::base::beginTrace("glShadeModel decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1997,11 +2008,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glShadeModel(var_mode);
             SET_LASTCALL("glShadeModel");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilFunc: {
-            android::base::beginTrace("glStencilFunc decode");
+            if (useTracing) android::base::beginTrace("glStencilFunc decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_ref = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLuint var_mask = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2011,11 +2022,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilFunc(var_func, var_ref, var_mask);
             SET_LASTCALL("glStencilFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilMask: {
-            android::base::beginTrace("glStencilMask decode");
+            if (useTracing) android::base::beginTrace("glStencilMask decode");
             GLuint var_mask = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2023,11 +2034,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilMask(var_mask);
             SET_LASTCALL("glStencilMask");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilOp: {
-            android::base::beginTrace("glStencilOp decode");
+            if (useTracing) android::base::beginTrace("glStencilOp decode");
             GLenum var_fail = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_zfail = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_zpass = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2037,11 +2048,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilOp(var_fail, var_zfail, var_zpass);
             SET_LASTCALL("glStencilOp");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexCoordPointer: {
-            android::base::beginTrace("glTexCoordPointer decode");
+            if (useTracing) android::base::beginTrace("glTexCoordPointer decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2053,11 +2064,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexCoordPointer(var_size, var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glTexCoordPointer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvi: {
-            android::base::beginTrace("glTexEnvi decode");
+            if (useTracing) android::base::beginTrace("glTexEnvi decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2067,11 +2078,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvi(var_target, var_pname, var_param);
             SET_LASTCALL("glTexEnvi");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvx: {
-            android::base::beginTrace("glTexEnvx decode");
+            if (useTracing) android::base::beginTrace("glTexEnvx decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -2081,11 +2092,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvx(var_target, var_pname, var_param);
             SET_LASTCALL("glTexEnvx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnviv: {
-            android::base::beginTrace("glTexEnviv decode");
+            if (useTracing) android::base::beginTrace("glTexEnviv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2096,11 +2107,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnviv(var_target, var_pname, (const GLint*)(inptr_params.get()));
             SET_LASTCALL("glTexEnviv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvxv: {
-            android::base::beginTrace("glTexEnvxv decode");
+            if (useTracing) android::base::beginTrace("glTexEnvxv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2111,11 +2122,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvxv(var_target, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glTexEnvxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexImage2D: {
-            android::base::beginTrace("glTexImage2D decode");
+            if (useTracing) android::base::beginTrace("glTexImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_internalformat = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2125,18 +2136,18 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_pixels __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
+            ByteInputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glTexImage2D: GL checksumCalculator failure\n");
             }
             this->glTexImage2D(var_target, var_level, var_internalformat, var_width, var_height, var_border, var_format, var_type, size_pixels == 0 ? nullptr : (const GLvoid*)(inptr_pixels.get()));
             SET_LASTCALL("glTexImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameteri: {
-            android::base::beginTrace("glTexParameteri decode");
+            if (useTracing) android::base::beginTrace("glTexParameteri decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2146,11 +2157,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameteri(var_target, var_pname, var_param);
             SET_LASTCALL("glTexParameteri");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterx: {
-            android::base::beginTrace("glTexParameterx decode");
+            if (useTracing) android::base::beginTrace("glTexParameterx decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -2160,11 +2171,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterx(var_target, var_pname, var_param);
             SET_LASTCALL("glTexParameterx");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameteriv: {
-            android::base::beginTrace("glTexParameteriv decode");
+            if (useTracing) android::base::beginTrace("glTexParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2175,11 +2186,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameteriv(var_target, var_pname, (const GLint*)(inptr_params.get()));
             SET_LASTCALL("glTexParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterxv: {
-            android::base::beginTrace("glTexParameterxv decode");
+            if (useTracing) android::base::beginTrace("glTexParameterxv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2190,11 +2201,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterxv(var_target, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glTexParameterxv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexSubImage2D: {
-            android::base::beginTrace("glTexSubImage2D decode");
+            if (useTracing) android::base::beginTrace("glTexSubImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2204,18 +2215,18 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_pixels __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
+            ByteInputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glTexSubImage2D: GL checksumCalculator failure\n");
             }
             this->glTexSubImage2D(var_target, var_level, var_xoffset, var_yoffset, var_width, var_height, var_format, var_type, size_pixels == 0 ? nullptr : (const GLvoid*)(inptr_pixels.get()));
             SET_LASTCALL("glTexSubImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTranslatex: {
-            android::base::beginTrace("glTranslatex decode");
+            if (useTracing) android::base::beginTrace("glTranslatex decode");
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_z = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -2225,11 +2236,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTranslatex(var_x, var_y, var_z);
             SET_LASTCALL("glTranslatex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexPointer: {
-            android::base::beginTrace("glVertexPointer decode");
+            if (useTracing) android::base::beginTrace("glVertexPointer decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2241,11 +2252,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexPointer(var_size, var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glVertexPointer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glViewport: {
-            android::base::beginTrace("glViewport decode");
+            if (useTracing) android::base::beginTrace("glViewport decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2256,11 +2267,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glViewport(var_x, var_y, var_width, var_height);
             SET_LASTCALL("glViewport");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointSizePointerOES: {
-            android::base::beginTrace("glPointSizePointerOES decode");
+            if (useTracing) android::base::beginTrace("glPointSizePointerOES decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_pointer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2271,11 +2282,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointSizePointerOES(var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glPointSizePointerOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexPointerOffset: {
-            android::base::beginTrace("glVertexPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glVertexPointerOffset decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2286,11 +2297,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexPointerOffset(this, var_size, var_type, var_stride, var_offset);
             SET_LASTCALL("glVertexPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColorPointerOffset: {
-            android::base::beginTrace("glColorPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glColorPointerOffset decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2301,11 +2312,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColorPointerOffset(this, var_size, var_type, var_stride, var_offset);
             SET_LASTCALL("glColorPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glNormalPointerOffset: {
-            android::base::beginTrace("glNormalPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glNormalPointerOffset decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLuint var_offset = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2315,11 +2326,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glNormalPointerOffset(this, var_type, var_stride, var_offset);
             SET_LASTCALL("glNormalPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointSizePointerOffset: {
-            android::base::beginTrace("glPointSizePointerOffset decode");
+            if (useTracing) android::base::beginTrace("glPointSizePointerOffset decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLuint var_offset = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2329,11 +2340,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointSizePointerOffset(this, var_type, var_stride, var_offset);
             SET_LASTCALL("glPointSizePointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexCoordPointerOffset: {
-            android::base::beginTrace("glTexCoordPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glTexCoordPointerOffset decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2344,11 +2355,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexCoordPointerOffset(this, var_size, var_type, var_stride, var_offset);
             SET_LASTCALL("glTexCoordPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glWeightPointerOffset: {
-            android::base::beginTrace("glWeightPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glWeightPointerOffset decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2359,11 +2370,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glWeightPointerOffset(this, var_size, var_type, var_stride, var_offset);
             SET_LASTCALL("glWeightPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMatrixIndexPointerOffset: {
-            android::base::beginTrace("glMatrixIndexPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glMatrixIndexPointerOffset decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2374,11 +2385,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMatrixIndexPointerOffset(this, var_size, var_type, var_stride, var_offset);
             SET_LASTCALL("glMatrixIndexPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexPointerData: {
-            android::base::beginTrace("glVertexPointerData decode");
+            if (useTracing) android::base::beginTrace("glVertexPointerData decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2391,11 +2402,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexPointerData(this, var_size, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glVertexPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColorPointerData: {
-            android::base::beginTrace("glColorPointerData decode");
+            if (useTracing) android::base::beginTrace("glColorPointerData decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2408,11 +2419,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColorPointerData(this, var_size, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glColorPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glNormalPointerData: {
-            android::base::beginTrace("glNormalPointerData decode");
+            if (useTracing) android::base::beginTrace("glNormalPointerData decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2424,11 +2435,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glNormalPointerData(this, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glNormalPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexCoordPointerData: {
-            android::base::beginTrace("glTexCoordPointerData decode");
+            if (useTracing) android::base::beginTrace("glTexCoordPointerData decode");
             GLint var_unit = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2442,11 +2453,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexCoordPointerData(this, var_unit, var_size, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glTexCoordPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointSizePointerData: {
-            android::base::beginTrace("glPointSizePointerData decode");
+            if (useTracing) android::base::beginTrace("glPointSizePointerData decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2458,11 +2469,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointSizePointerData(this, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glPointSizePointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glWeightPointerData: {
-            android::base::beginTrace("glWeightPointerData decode");
+            if (useTracing) android::base::beginTrace("glWeightPointerData decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2475,11 +2486,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glWeightPointerData(this, var_size, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glWeightPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMatrixIndexPointerData: {
-            android::base::beginTrace("glMatrixIndexPointerData decode");
+            if (useTracing) android::base::beginTrace("glMatrixIndexPointerData decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2492,11 +2503,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMatrixIndexPointerData(this, var_size, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glMatrixIndexPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsOffset: {
-            android::base::beginTrace("glDrawElementsOffset decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsOffset decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2507,11 +2518,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsOffset(this, var_mode, var_count, var_type, var_offset);
             SET_LASTCALL("glDrawElementsOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsData: {
-            android::base::beginTrace("glDrawElementsData decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsData decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2524,11 +2535,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsData(this, var_mode, var_count, var_type, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glDrawElementsData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetCompressedTextureFormats: {
-            android::base::beginTrace("glGetCompressedTextureFormats decode");
+            if (useTracing) android::base::beginTrace("glGetCompressedTextureFormats decode");
             int var_count = Unpack<int,uint32_t>(ptr + 8);
             uint32_t size_formats __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2546,11 +2557,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetCompressedTextureFormats");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFinishRoundTrip: {
-            android::base::beginTrace("glFinishRoundTrip decode");
+            if (useTracing) android::base::beginTrace("glFinishRoundTrip decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glFinishRoundTrip: GL checksumCalculator failure\n");
@@ -2564,11 +2575,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glFinishRoundTrip");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendEquationSeparateOES: {
-            android::base::beginTrace("glBlendEquationSeparateOES decode");
+            if (useTracing) android::base::beginTrace("glBlendEquationSeparateOES decode");
             GLenum var_modeRGB = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_modeAlpha = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2577,11 +2588,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendEquationSeparateOES(var_modeRGB, var_modeAlpha);
             SET_LASTCALL("glBlendEquationSeparateOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendFuncSeparateOES: {
-            android::base::beginTrace("glBlendFuncSeparateOES decode");
+            if (useTracing) android::base::beginTrace("glBlendFuncSeparateOES decode");
             GLenum var_srcRGB = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_dstRGB = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_srcAlpha = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2592,11 +2603,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendFuncSeparateOES(var_srcRGB, var_dstRGB, var_srcAlpha, var_dstAlpha);
             SET_LASTCALL("glBlendFuncSeparateOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendEquationOES: {
-            android::base::beginTrace("glBlendEquationOES decode");
+            if (useTracing) android::base::beginTrace("glBlendEquationOES decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2604,11 +2615,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendEquationOES(var_mode);
             SET_LASTCALL("glBlendEquationOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexsOES: {
-            android::base::beginTrace("glDrawTexsOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexsOES decode");
             GLshort var_x = Unpack<GLshort,uint16_t>(ptr + 8);
             GLshort var_y = Unpack<GLshort,uint16_t>(ptr + 8 + 2);
             GLshort var_z = Unpack<GLshort,uint16_t>(ptr + 8 + 2 + 2);
@@ -2620,11 +2631,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexsOES(var_x, var_y, var_z, var_width, var_height);
             SET_LASTCALL("glDrawTexsOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexiOES: {
-            android::base::beginTrace("glDrawTexiOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexiOES decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_z = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2636,11 +2647,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexiOES(var_x, var_y, var_z, var_width, var_height);
             SET_LASTCALL("glDrawTexiOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexxOES: {
-            android::base::beginTrace("glDrawTexxOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexxOES decode");
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_z = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -2652,11 +2663,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexxOES(var_x, var_y, var_z, var_width, var_height);
             SET_LASTCALL("glDrawTexxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexsvOES: {
-            android::base::beginTrace("glDrawTexsvOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexsvOES decode");
             uint32_t size_coords __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_coords(ptr + 8 + 4, size_coords);
             if (useChecksum) {
@@ -2665,11 +2676,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexsvOES((const GLshort*)(inptr_coords.get()));
             SET_LASTCALL("glDrawTexsvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexivOES: {
-            android::base::beginTrace("glDrawTexivOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexivOES decode");
             uint32_t size_coords __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_coords(ptr + 8 + 4, size_coords);
             if (useChecksum) {
@@ -2678,11 +2689,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexivOES((const GLint*)(inptr_coords.get()));
             SET_LASTCALL("glDrawTexivOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexxvOES: {
-            android::base::beginTrace("glDrawTexxvOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexxvOES decode");
             uint32_t size_coords __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_coords(ptr + 8 + 4, size_coords);
             if (useChecksum) {
@@ -2691,11 +2702,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexxvOES((const GLfixed*)(inptr_coords.get()));
             SET_LASTCALL("glDrawTexxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexfOES: {
-            android::base::beginTrace("glDrawTexfOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexfOES decode");
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_z = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2707,11 +2718,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexfOES(var_x, var_y, var_z, var_width, var_height);
             SET_LASTCALL("glDrawTexfOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawTexfvOES: {
-            android::base::beginTrace("glDrawTexfvOES decode");
+            if (useTracing) android::base::beginTrace("glDrawTexfvOES decode");
             uint32_t size_coords __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_coords(ptr + 8 + 4, size_coords);
             if (useChecksum) {
@@ -2720,11 +2731,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawTexfvOES((const GLfloat*)(inptr_coords.get()));
             SET_LASTCALL("glDrawTexfvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEGLImageTargetTexture2DOES: {
-            android::base::beginTrace("glEGLImageTargetTexture2DOES decode");
+            if (useTracing) android::base::beginTrace("glEGLImageTargetTexture2DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLeglImageOES var_image = Unpack<GLeglImageOES,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2733,11 +2744,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEGLImageTargetTexture2DOES(var_target, var_image);
             SET_LASTCALL("glEGLImageTargetTexture2DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEGLImageTargetRenderbufferStorageOES: {
-            android::base::beginTrace("glEGLImageTargetRenderbufferStorageOES decode");
+            if (useTracing) android::base::beginTrace("glEGLImageTargetRenderbufferStorageOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLeglImageOES var_image = Unpack<GLeglImageOES,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2746,11 +2757,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEGLImageTargetRenderbufferStorageOES(var_target, var_image);
             SET_LASTCALL("glEGLImageTargetRenderbufferStorageOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glAlphaFuncxOES: {
-            android::base::beginTrace("glAlphaFuncxOES decode");
+            if (useTracing) android::base::beginTrace("glAlphaFuncxOES decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             GLclampx var_ref = Unpack<GLclampx,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2759,11 +2770,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glAlphaFuncxOES(var_func, var_ref);
             SET_LASTCALL("glAlphaFuncxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearColorxOES: {
-            android::base::beginTrace("glClearColorxOES decode");
+            if (useTracing) android::base::beginTrace("glClearColorxOES decode");
             GLclampx var_red = Unpack<GLclampx,uint32_t>(ptr + 8);
             GLclampx var_green = Unpack<GLclampx,uint32_t>(ptr + 8 + 4);
             GLclampx var_blue = Unpack<GLclampx,uint32_t>(ptr + 8 + 4 + 4);
@@ -2774,11 +2785,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearColorxOES(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glClearColorxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearDepthxOES: {
-            android::base::beginTrace("glClearDepthxOES decode");
+            if (useTracing) android::base::beginTrace("glClearDepthxOES decode");
             GLclampx var_depth = Unpack<GLclampx,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2786,11 +2797,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearDepthxOES(var_depth);
             SET_LASTCALL("glClearDepthxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClipPlanexOES: {
-            android::base::beginTrace("glClipPlanexOES decode");
+            if (useTracing) android::base::beginTrace("glClipPlanexOES decode");
             GLenum var_plane = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_equation __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_equation(ptr + 8 + 4 + 4, size_equation);
@@ -2800,11 +2811,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClipPlanexOES(var_plane, (const GLfixed*)(inptr_equation.get()));
             SET_LASTCALL("glClipPlanexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClipPlanexIMG: {
-            android::base::beginTrace("glClipPlanexIMG decode");
+            if (useTracing) android::base::beginTrace("glClipPlanexIMG decode");
             GLenum var_plane = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_equation __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_equation(ptr + 8 + 4 + 4, size_equation);
@@ -2814,11 +2825,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClipPlanexIMG(var_plane, (const GLfixed*)(inptr_equation.get()));
             SET_LASTCALL("glClipPlanexIMG");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColor4xOES: {
-            android::base::beginTrace("glColor4xOES decode");
+            if (useTracing) android::base::beginTrace("glColor4xOES decode");
             GLfixed var_red = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_green = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_blue = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -2829,11 +2840,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColor4xOES(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glColor4xOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthRangexOES: {
-            android::base::beginTrace("glDepthRangexOES decode");
+            if (useTracing) android::base::beginTrace("glDepthRangexOES decode");
             GLclampx var_zNear = Unpack<GLclampx,uint32_t>(ptr + 8);
             GLclampx var_zFar = Unpack<GLclampx,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2842,11 +2853,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthRangexOES(var_zNear, var_zFar);
             SET_LASTCALL("glDepthRangexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFogxOES: {
-            android::base::beginTrace("glFogxOES decode");
+            if (useTracing) android::base::beginTrace("glFogxOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2855,11 +2866,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFogxOES(var_pname, var_param);
             SET_LASTCALL("glFogxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFogxvOES: {
-            android::base::beginTrace("glFogxvOES decode");
+            if (useTracing) android::base::beginTrace("glFogxvOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -2869,11 +2880,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFogxvOES(var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glFogxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFrustumxOES: {
-            android::base::beginTrace("glFrustumxOES decode");
+            if (useTracing) android::base::beginTrace("glFrustumxOES decode");
             GLfixed var_left = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_right = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_bottom = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -2886,11 +2897,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFrustumxOES(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glFrustumxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetClipPlanexOES: {
-            android::base::beginTrace("glGetClipPlanexOES decode");
+            if (useTracing) android::base::beginTrace("glGetClipPlanexOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_eqn __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2908,11 +2919,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetClipPlanexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetClipPlanex: {
-            android::base::beginTrace("glGetClipPlanex decode");
+            if (useTracing) android::base::beginTrace("glGetClipPlanex decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_eqn __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2930,11 +2941,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetClipPlanex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFixedvOES: {
-            android::base::beginTrace("glGetFixedvOES decode");
+            if (useTracing) android::base::beginTrace("glGetFixedvOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2952,11 +2963,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFixedvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetLightxvOES: {
-            android::base::beginTrace("glGetLightxvOES decode");
+            if (useTracing) android::base::beginTrace("glGetLightxvOES decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2975,11 +2986,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetLightxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetMaterialxvOES: {
-            android::base::beginTrace("glGetMaterialxvOES decode");
+            if (useTracing) android::base::beginTrace("glGetMaterialxvOES decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2998,11 +3009,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetMaterialxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexEnvxvOES: {
-            android::base::beginTrace("glGetTexEnvxvOES decode");
+            if (useTracing) android::base::beginTrace("glGetTexEnvxvOES decode");
             GLenum var_env = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3021,11 +3032,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexEnvxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexParameterxvOES: {
-            android::base::beginTrace("glGetTexParameterxvOES decode");
+            if (useTracing) android::base::beginTrace("glGetTexParameterxvOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3044,11 +3055,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexParameterxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightModelxOES: {
-            android::base::beginTrace("glLightModelxOES decode");
+            if (useTracing) android::base::beginTrace("glLightModelxOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3057,11 +3068,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightModelxOES(var_pname, var_param);
             SET_LASTCALL("glLightModelxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightModelxvOES: {
-            android::base::beginTrace("glLightModelxvOES decode");
+            if (useTracing) android::base::beginTrace("glLightModelxvOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -3071,11 +3082,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightModelxvOES(var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glLightModelxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightxOES: {
-            android::base::beginTrace("glLightxOES decode");
+            if (useTracing) android::base::beginTrace("glLightxOES decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3085,11 +3096,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightxOES(var_light, var_pname, var_param);
             SET_LASTCALL("glLightxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLightxvOES: {
-            android::base::beginTrace("glLightxvOES decode");
+            if (useTracing) android::base::beginTrace("glLightxvOES decode");
             GLenum var_light = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3100,11 +3111,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLightxvOES(var_light, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glLightxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLineWidthxOES: {
-            android::base::beginTrace("glLineWidthxOES decode");
+            if (useTracing) android::base::beginTrace("glLineWidthxOES decode");
             GLfixed var_width = Unpack<GLfixed,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3112,11 +3123,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLineWidthxOES(var_width);
             SET_LASTCALL("glLineWidthxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLoadMatrixxOES: {
-            android::base::beginTrace("glLoadMatrixxOES decode");
+            if (useTracing) android::base::beginTrace("glLoadMatrixxOES decode");
             uint32_t size_m __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_m(ptr + 8 + 4, size_m);
             if (useChecksum) {
@@ -3125,11 +3136,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLoadMatrixxOES((const GLfixed*)(inptr_m.get()));
             SET_LASTCALL("glLoadMatrixxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMaterialxOES: {
-            android::base::beginTrace("glMaterialxOES decode");
+            if (useTracing) android::base::beginTrace("glMaterialxOES decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3139,11 +3150,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMaterialxOES(var_face, var_pname, var_param);
             SET_LASTCALL("glMaterialxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMaterialxvOES: {
-            android::base::beginTrace("glMaterialxvOES decode");
+            if (useTracing) android::base::beginTrace("glMaterialxvOES decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3154,11 +3165,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMaterialxvOES(var_face, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glMaterialxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultMatrixxOES: {
-            android::base::beginTrace("glMultMatrixxOES decode");
+            if (useTracing) android::base::beginTrace("glMultMatrixxOES decode");
             uint32_t size_m __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_m(ptr + 8 + 4, size_m);
             if (useChecksum) {
@@ -3167,11 +3178,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultMatrixxOES((const GLfixed*)(inptr_m.get()));
             SET_LASTCALL("glMultMatrixxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiTexCoord4xOES: {
-            android::base::beginTrace("glMultiTexCoord4xOES decode");
+            if (useTracing) android::base::beginTrace("glMultiTexCoord4xOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_s = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_t = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3183,11 +3194,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiTexCoord4xOES(var_target, var_s, var_t, var_r, var_q);
             SET_LASTCALL("glMultiTexCoord4xOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glNormal3xOES: {
-            android::base::beginTrace("glNormal3xOES decode");
+            if (useTracing) android::base::beginTrace("glNormal3xOES decode");
             GLfixed var_nx = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_ny = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_nz = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3197,11 +3208,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glNormal3xOES(var_nx, var_ny, var_nz);
             SET_LASTCALL("glNormal3xOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glOrthoxOES: {
-            android::base::beginTrace("glOrthoxOES decode");
+            if (useTracing) android::base::beginTrace("glOrthoxOES decode");
             GLfixed var_left = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_right = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_bottom = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3214,11 +3225,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glOrthoxOES(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glOrthoxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointParameterxOES: {
-            android::base::beginTrace("glPointParameterxOES decode");
+            if (useTracing) android::base::beginTrace("glPointParameterxOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3227,11 +3238,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointParameterxOES(var_pname, var_param);
             SET_LASTCALL("glPointParameterxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointParameterxvOES: {
-            android::base::beginTrace("glPointParameterxvOES decode");
+            if (useTracing) android::base::beginTrace("glPointParameterxvOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -3241,11 +3252,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointParameterxvOES(var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glPointParameterxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPointSizexOES: {
-            android::base::beginTrace("glPointSizexOES decode");
+            if (useTracing) android::base::beginTrace("glPointSizexOES decode");
             GLfixed var_size = Unpack<GLfixed,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3253,11 +3264,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPointSizexOES(var_size);
             SET_LASTCALL("glPointSizexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPolygonOffsetxOES: {
-            android::base::beginTrace("glPolygonOffsetxOES decode");
+            if (useTracing) android::base::beginTrace("glPolygonOffsetxOES decode");
             GLfixed var_factor = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_units = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3266,11 +3277,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPolygonOffsetxOES(var_factor, var_units);
             SET_LASTCALL("glPolygonOffsetxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRotatexOES: {
-            android::base::beginTrace("glRotatexOES decode");
+            if (useTracing) android::base::beginTrace("glRotatexOES decode");
             GLfixed var_angle = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3281,11 +3292,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRotatexOES(var_angle, var_x, var_y, var_z);
             SET_LASTCALL("glRotatexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSampleCoveragexOES: {
-            android::base::beginTrace("glSampleCoveragexOES decode");
+            if (useTracing) android::base::beginTrace("glSampleCoveragexOES decode");
             GLclampx var_value = Unpack<GLclampx,uint32_t>(ptr + 8);
             GLboolean var_invert = Unpack<GLboolean,uint8_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3294,11 +3305,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSampleCoveragexOES(var_value, var_invert);
             SET_LASTCALL("glSampleCoveragexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glScalexOES: {
-            android::base::beginTrace("glScalexOES decode");
+            if (useTracing) android::base::beginTrace("glScalexOES decode");
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_z = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3308,11 +3319,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glScalexOES(var_x, var_y, var_z);
             SET_LASTCALL("glScalexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvxOES: {
-            android::base::beginTrace("glTexEnvxOES decode");
+            if (useTracing) android::base::beginTrace("glTexEnvxOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3322,11 +3333,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvxOES(var_target, var_pname, var_param);
             SET_LASTCALL("glTexEnvxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexEnvxvOES: {
-            android::base::beginTrace("glTexEnvxvOES decode");
+            if (useTracing) android::base::beginTrace("glTexEnvxvOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3337,11 +3348,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexEnvxvOES(var_target, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glTexEnvxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterxOES: {
-            android::base::beginTrace("glTexParameterxOES decode");
+            if (useTracing) android::base::beginTrace("glTexParameterxOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3351,11 +3362,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterxOES(var_target, var_pname, var_param);
             SET_LASTCALL("glTexParameterxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterxvOES: {
-            android::base::beginTrace("glTexParameterxvOES decode");
+            if (useTracing) android::base::beginTrace("glTexParameterxvOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3366,11 +3377,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterxvOES(var_target, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glTexParameterxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTranslatexOES: {
-            android::base::beginTrace("glTranslatexOES decode");
+            if (useTracing) android::base::beginTrace("glTranslatexOES decode");
             GLfixed var_x = Unpack<GLfixed,uint32_t>(ptr + 8);
             GLfixed var_y = Unpack<GLfixed,uint32_t>(ptr + 8 + 4);
             GLfixed var_z = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3380,11 +3391,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTranslatexOES(var_x, var_y, var_z);
             SET_LASTCALL("glTranslatexOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsRenderbufferOES: {
-            android::base::beginTrace("glIsRenderbufferOES decode");
+            if (useTracing) android::base::beginTrace("glIsRenderbufferOES decode");
             GLuint var_renderbuffer = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3399,11 +3410,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsRenderbufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindRenderbufferOES: {
-            android::base::beginTrace("glBindRenderbufferOES decode");
+            if (useTracing) android::base::beginTrace("glBindRenderbufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_renderbuffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3412,11 +3423,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindRenderbufferOES(var_target, var_renderbuffer);
             SET_LASTCALL("glBindRenderbufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteRenderbuffersOES: {
-            android::base::beginTrace("glDeleteRenderbuffersOES decode");
+            if (useTracing) android::base::beginTrace("glDeleteRenderbuffersOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_renderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_renderbuffers(ptr + 8 + 4 + 4, size_renderbuffers);
@@ -3426,11 +3437,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteRenderbuffersOES_dec(this, var_n, (const GLuint*)(inptr_renderbuffers.get()));
             SET_LASTCALL("glDeleteRenderbuffersOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenRenderbuffersOES: {
-            android::base::beginTrace("glGenRenderbuffersOES decode");
+            if (useTracing) android::base::beginTrace("glGenRenderbuffersOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_renderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3448,11 +3459,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenRenderbuffersOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRenderbufferStorageOES: {
-            android::base::beginTrace("glRenderbufferStorageOES decode");
+            if (useTracing) android::base::beginTrace("glRenderbufferStorageOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -3463,11 +3474,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRenderbufferStorageOES(var_target, var_internalformat, var_width, var_height);
             SET_LASTCALL("glRenderbufferStorageOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetRenderbufferParameterivOES: {
-            android::base::beginTrace("glGetRenderbufferParameterivOES decode");
+            if (useTracing) android::base::beginTrace("glGetRenderbufferParameterivOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3486,11 +3497,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetRenderbufferParameterivOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsFramebufferOES: {
-            android::base::beginTrace("glIsFramebufferOES decode");
+            if (useTracing) android::base::beginTrace("glIsFramebufferOES decode");
             GLuint var_framebuffer = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3505,11 +3516,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsFramebufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindFramebufferOES: {
-            android::base::beginTrace("glBindFramebufferOES decode");
+            if (useTracing) android::base::beginTrace("glBindFramebufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_framebuffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3518,11 +3529,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindFramebufferOES(var_target, var_framebuffer);
             SET_LASTCALL("glBindFramebufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteFramebuffersOES: {
-            android::base::beginTrace("glDeleteFramebuffersOES decode");
+            if (useTracing) android::base::beginTrace("glDeleteFramebuffersOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_framebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_framebuffers(ptr + 8 + 4 + 4, size_framebuffers);
@@ -3532,11 +3543,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteFramebuffersOES_dec(this, var_n, (const GLuint*)(inptr_framebuffers.get()));
             SET_LASTCALL("glDeleteFramebuffersOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenFramebuffersOES: {
-            android::base::beginTrace("glGenFramebuffersOES decode");
+            if (useTracing) android::base::beginTrace("glGenFramebuffersOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_framebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3554,11 +3565,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenFramebuffersOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCheckFramebufferStatusOES: {
-            android::base::beginTrace("glCheckFramebufferStatusOES decode");
+            if (useTracing) android::base::beginTrace("glCheckFramebufferStatusOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3573,11 +3584,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glCheckFramebufferStatusOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferRenderbufferOES: {
-            android::base::beginTrace("glFramebufferRenderbufferOES decode");
+            if (useTracing) android::base::beginTrace("glFramebufferRenderbufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_renderbuffertarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3588,11 +3599,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferRenderbufferOES(var_target, var_attachment, var_renderbuffertarget, var_renderbuffer);
             SET_LASTCALL("glFramebufferRenderbufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferTexture2DOES: {
-            android::base::beginTrace("glFramebufferTexture2DOES decode");
+            if (useTracing) android::base::beginTrace("glFramebufferTexture2DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_textarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3604,11 +3615,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferTexture2DOES(var_target, var_attachment, var_textarget, var_texture, var_level);
             SET_LASTCALL("glFramebufferTexture2DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFramebufferAttachmentParameterivOES: {
-            android::base::beginTrace("glGetFramebufferAttachmentParameterivOES decode");
+            if (useTracing) android::base::beginTrace("glGetFramebufferAttachmentParameterivOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3628,11 +3639,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFramebufferAttachmentParameterivOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenerateMipmapOES: {
-            android::base::beginTrace("glGenerateMipmapOES decode");
+            if (useTracing) android::base::beginTrace("glGenerateMipmapOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3640,11 +3651,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGenerateMipmapOES(var_target);
             SET_LASTCALL("glGenerateMipmapOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMapBufferOES: {
-            android::base::beginTrace("glMapBufferOES decode");
+            if (useTracing) android::base::beginTrace("glMapBufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_access = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3653,11 +3664,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMapBufferOES(var_target, var_access);
             SET_LASTCALL("glMapBufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBufferOES: {
-            android::base::beginTrace("glUnmapBufferOES decode");
+            if (useTracing) android::base::beginTrace("glUnmapBufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3672,11 +3683,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glUnmapBufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBufferPointervOES: {
-            android::base::beginTrace("glGetBufferPointervOES decode");
+            if (useTracing) android::base::beginTrace("glGetBufferPointervOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3687,11 +3698,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetBufferPointervOES(var_target, var_pname, (GLvoid**)(inptr_params.get()));
             SET_LASTCALL("glGetBufferPointervOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCurrentPaletteMatrixOES: {
-            android::base::beginTrace("glCurrentPaletteMatrixOES decode");
+            if (useTracing) android::base::beginTrace("glCurrentPaletteMatrixOES decode");
             GLuint var_matrixpaletteindex = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3699,22 +3710,22 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCurrentPaletteMatrixOES(var_matrixpaletteindex);
             SET_LASTCALL("glCurrentPaletteMatrixOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLoadPaletteFromModelViewMatrixOES: {
-            android::base::beginTrace("glLoadPaletteFromModelViewMatrixOES decode");
+            if (useTracing) android::base::beginTrace("glLoadPaletteFromModelViewMatrixOES decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glLoadPaletteFromModelViewMatrixOES: GL checksumCalculator failure\n");
             }
             this->glLoadPaletteFromModelViewMatrixOES();
             SET_LASTCALL("glLoadPaletteFromModelViewMatrixOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMatrixIndexPointerOES: {
-            android::base::beginTrace("glMatrixIndexPointerOES decode");
+            if (useTracing) android::base::beginTrace("glMatrixIndexPointerOES decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -3726,11 +3737,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMatrixIndexPointerOES(var_size, var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glMatrixIndexPointerOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glWeightPointerOES: {
-            android::base::beginTrace("glWeightPointerOES decode");
+            if (useTracing) android::base::beginTrace("glWeightPointerOES decode");
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_stride = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -3742,11 +3753,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glWeightPointerOES(var_size, var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glWeightPointerOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glQueryMatrixxOES: {
-            android::base::beginTrace("glQueryMatrixxOES decode");
+            if (useTracing) android::base::beginTrace("glQueryMatrixxOES decode");
             uint32_t size_mantissa __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_exponent __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3768,11 +3779,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glQueryMatrixxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthRangefOES: {
-            android::base::beginTrace("glDepthRangefOES decode");
+            if (useTracing) android::base::beginTrace("glDepthRangefOES decode");
             GLclampf var_zNear = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLclampf var_zFar = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3781,11 +3792,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthRangefOES(var_zNear, var_zFar);
             SET_LASTCALL("glDepthRangefOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFrustumfOES: {
-            android::base::beginTrace("glFrustumfOES decode");
+            if (useTracing) android::base::beginTrace("glFrustumfOES decode");
             GLfloat var_left = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_right = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_bottom = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -3798,11 +3809,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFrustumfOES(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glFrustumfOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glOrthofOES: {
-            android::base::beginTrace("glOrthofOES decode");
+            if (useTracing) android::base::beginTrace("glOrthofOES decode");
             GLfloat var_left = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_right = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_bottom = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -3815,11 +3826,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glOrthofOES(var_left, var_right, var_bottom, var_top, var_zNear, var_zFar);
             SET_LASTCALL("glOrthofOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClipPlanefOES: {
-            android::base::beginTrace("glClipPlanefOES decode");
+            if (useTracing) android::base::beginTrace("glClipPlanefOES decode");
             GLenum var_plane = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_equation __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_equation(ptr + 8 + 4 + 4, size_equation);
@@ -3829,11 +3840,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClipPlanefOES(var_plane, (const GLfloat*)(inptr_equation.get()));
             SET_LASTCALL("glClipPlanefOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClipPlanefIMG: {
-            android::base::beginTrace("glClipPlanefIMG decode");
+            if (useTracing) android::base::beginTrace("glClipPlanefIMG decode");
             GLenum var_plane = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_equation __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_equation(ptr + 8 + 4 + 4, size_equation);
@@ -3843,11 +3854,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClipPlanefIMG(var_plane, (const GLfloat*)(inptr_equation.get()));
             SET_LASTCALL("glClipPlanefIMG");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetClipPlanefOES: {
-            android::base::beginTrace("glGetClipPlanefOES decode");
+            if (useTracing) android::base::beginTrace("glGetClipPlanefOES decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_eqn __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3865,11 +3876,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetClipPlanefOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearDepthfOES: {
-            android::base::beginTrace("glClearDepthfOES decode");
+            if (useTracing) android::base::beginTrace("glClearDepthfOES decode");
             GLclampf var_depth = Unpack<GLclampf,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3877,11 +3888,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearDepthfOES(var_depth);
             SET_LASTCALL("glClearDepthfOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexGenfOES: {
-            android::base::beginTrace("glTexGenfOES decode");
+            if (useTracing) android::base::beginTrace("glTexGenfOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -3891,11 +3902,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexGenfOES(var_coord, var_pname, var_param);
             SET_LASTCALL("glTexGenfOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexGenfvOES: {
-            android::base::beginTrace("glTexGenfvOES decode");
+            if (useTracing) android::base::beginTrace("glTexGenfvOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3906,11 +3917,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexGenfvOES(var_coord, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glTexGenfvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexGeniOES: {
-            android::base::beginTrace("glTexGeniOES decode");
+            if (useTracing) android::base::beginTrace("glTexGeniOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3920,11 +3931,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexGeniOES(var_coord, var_pname, var_param);
             SET_LASTCALL("glTexGeniOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexGenivOES: {
-            android::base::beginTrace("glTexGenivOES decode");
+            if (useTracing) android::base::beginTrace("glTexGenivOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3935,11 +3946,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexGenivOES(var_coord, var_pname, (const GLint*)(inptr_params.get()));
             SET_LASTCALL("glTexGenivOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexGenxOES: {
-            android::base::beginTrace("glTexGenxOES decode");
+            if (useTracing) android::base::beginTrace("glTexGenxOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfixed var_param = Unpack<GLfixed,uint32_t>(ptr + 8 + 4 + 4);
@@ -3949,11 +3960,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexGenxOES(var_coord, var_pname, var_param);
             SET_LASTCALL("glTexGenxOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexGenxvOES: {
-            android::base::beginTrace("glTexGenxvOES decode");
+            if (useTracing) android::base::beginTrace("glTexGenxvOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3964,11 +3975,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexGenxvOES(var_coord, var_pname, (const GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glTexGenxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexGenfvOES: {
-            android::base::beginTrace("glGetTexGenfvOES decode");
+            if (useTracing) android::base::beginTrace("glGetTexGenfvOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3979,11 +3990,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetTexGenfvOES(var_coord, var_pname, (GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glGetTexGenfvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexGenivOES: {
-            android::base::beginTrace("glGetTexGenivOES decode");
+            if (useTracing) android::base::beginTrace("glGetTexGenivOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3994,11 +4005,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetTexGenivOES(var_coord, var_pname, (GLint*)(inptr_params.get()));
             SET_LASTCALL("glGetTexGenivOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexGenxvOES: {
-            android::base::beginTrace("glGetTexGenxvOES decode");
+            if (useTracing) android::base::beginTrace("glGetTexGenxvOES decode");
             GLenum var_coord = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4009,11 +4020,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetTexGenxvOES(var_coord, var_pname, (GLfixed*)(inptr_params.get()));
             SET_LASTCALL("glGetTexGenxvOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindVertexArrayOES: {
-            android::base::beginTrace("glBindVertexArrayOES decode");
+            if (useTracing) android::base::beginTrace("glBindVertexArrayOES decode");
             GLuint var_array = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4021,11 +4032,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindVertexArrayOES(var_array);
             SET_LASTCALL("glBindVertexArrayOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteVertexArraysOES: {
-            android::base::beginTrace("glDeleteVertexArraysOES decode");
+            if (useTracing) android::base::beginTrace("glDeleteVertexArraysOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_arrays __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_arrays(ptr + 8 + 4 + 4, size_arrays);
@@ -4035,11 +4046,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteVertexArraysOES_dec(this, var_n, (const GLuint*)(inptr_arrays.get()));
             SET_LASTCALL("glDeleteVertexArraysOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenVertexArraysOES: {
-            android::base::beginTrace("glGenVertexArraysOES decode");
+            if (useTracing) android::base::beginTrace("glGenVertexArraysOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_arrays __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -4057,11 +4068,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenVertexArraysOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsVertexArrayOES: {
-            android::base::beginTrace("glIsVertexArrayOES decode");
+            if (useTracing) android::base::beginTrace("glIsVertexArrayOES decode");
             GLuint var_array = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4076,11 +4087,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsVertexArrayOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDiscardFramebufferEXT: {
-            android::base::beginTrace("glDiscardFramebufferEXT decode");
+            if (useTracing) android::base::beginTrace("glDiscardFramebufferEXT decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_numAttachments = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_attachments __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4091,11 +4102,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDiscardFramebufferEXT(var_target, var_numAttachments, (const GLenum*)(inptr_attachments.get()));
             SET_LASTCALL("glDiscardFramebufferEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiDrawArraysEXT: {
-            android::base::beginTrace("glMultiDrawArraysEXT decode");
+            if (useTracing) android::base::beginTrace("glMultiDrawArraysEXT decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_first __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_first(ptr + 8 + 4 + 4, size_first);
@@ -4108,11 +4119,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiDrawArraysEXT(var_mode, (const GLint*)(inptr_first.get()), (const GLsizei*)(inptr_count.get()), var_primcount);
             SET_LASTCALL("glMultiDrawArraysEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiDrawElementsEXT: {
-            android::base::beginTrace("glMultiDrawElementsEXT decode");
+            if (useTracing) android::base::beginTrace("glMultiDrawElementsEXT decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_count __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_count(ptr + 8 + 4 + 4, size_count);
@@ -4126,11 +4137,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiDrawElementsEXT(var_mode, (const GLsizei*)(inptr_count.get()), var_type, (const GLvoid* const*)(inptr_indices.get()), var_primcount);
             SET_LASTCALL("glMultiDrawElementsEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiDrawArraysSUN: {
-            android::base::beginTrace("glMultiDrawArraysSUN decode");
+            if (useTracing) android::base::beginTrace("glMultiDrawArraysSUN decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_first __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_first(ptr + 8 + 4 + 4, size_first);
@@ -4143,11 +4154,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiDrawArraysSUN(var_mode, (GLint*)(inptr_first.get()), (GLsizei*)(inptr_count.get()), var_primcount);
             SET_LASTCALL("glMultiDrawArraysSUN");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiDrawElementsSUN: {
-            android::base::beginTrace("glMultiDrawElementsSUN decode");
+            if (useTracing) android::base::beginTrace("glMultiDrawElementsSUN decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_count __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_count(ptr + 8 + 4 + 4, size_count);
@@ -4161,11 +4172,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiDrawElementsSUN(var_mode, (const GLsizei*)(inptr_count.get()), var_type, (const GLvoid**)(inptr_indices.get()), var_primcount);
             SET_LASTCALL("glMultiDrawElementsSUN");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRenderbufferStorageMultisampleIMG: {
-            android::base::beginTrace("glRenderbufferStorageMultisampleIMG decode");
+            if (useTracing) android::base::beginTrace("glRenderbufferStorageMultisampleIMG decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_samples = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4177,11 +4188,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRenderbufferStorageMultisampleIMG(var_target, var_samples, var_internalformat, var_width, var_height);
             SET_LASTCALL("glRenderbufferStorageMultisampleIMG");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferTexture2DMultisampleIMG: {
-            android::base::beginTrace("glFramebufferTexture2DMultisampleIMG decode");
+            if (useTracing) android::base::beginTrace("glFramebufferTexture2DMultisampleIMG decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_textarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4194,11 +4205,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferTexture2DMultisampleIMG(var_target, var_attachment, var_textarget, var_texture, var_level, var_samples);
             SET_LASTCALL("glFramebufferTexture2DMultisampleIMG");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteFencesNV: {
-            android::base::beginTrace("glDeleteFencesNV decode");
+            if (useTracing) android::base::beginTrace("glDeleteFencesNV decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_fences __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_fences(ptr + 8 + 4 + 4, size_fences);
@@ -4208,11 +4219,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteFencesNV(var_n, (const GLuint*)(inptr_fences.get()));
             SET_LASTCALL("glDeleteFencesNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenFencesNV: {
-            android::base::beginTrace("glGenFencesNV decode");
+            if (useTracing) android::base::beginTrace("glGenFencesNV decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_fences __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_fences(ptr + 8 + 4 + 4, size_fences);
@@ -4222,11 +4233,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGenFencesNV(var_n, (GLuint*)(inptr_fences.get()));
             SET_LASTCALL("glGenFencesNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsFenceNV: {
-            android::base::beginTrace("glIsFenceNV decode");
+            if (useTracing) android::base::beginTrace("glIsFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4241,11 +4252,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTestFenceNV: {
-            android::base::beginTrace("glTestFenceNV decode");
+            if (useTracing) android::base::beginTrace("glTestFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4260,11 +4271,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glTestFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFenceivNV: {
-            android::base::beginTrace("glGetFenceivNV decode");
+            if (useTracing) android::base::beginTrace("glGetFenceivNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4283,11 +4294,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFenceivNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFinishFenceNV: {
-            android::base::beginTrace("glFinishFenceNV decode");
+            if (useTracing) android::base::beginTrace("glFinishFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4295,11 +4306,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFinishFenceNV(var_fence);
             SET_LASTCALL("glFinishFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSetFenceNV: {
-            android::base::beginTrace("glSetFenceNV decode");
+            if (useTracing) android::base::beginTrace("glSetFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_condition = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -4308,11 +4319,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSetFenceNV(var_fence, var_condition);
             SET_LASTCALL("glSetFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetDriverControlsQCOM: {
-            android::base::beginTrace("glGetDriverControlsQCOM decode");
+            if (useTracing) android::base::beginTrace("glGetDriverControlsQCOM decode");
             uint32_t size_num __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLsizei var_size = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_driverControls __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4334,11 +4345,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetDriverControlsQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetDriverControlStringQCOM: {
-            android::base::beginTrace("glGetDriverControlStringQCOM decode");
+            if (useTracing) android::base::beginTrace("glGetDriverControlStringQCOM decode");
             GLuint var_driverControl = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4352,7 +4363,7 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_driverControlString(&tmpBuf[0 + size_length], size_driverControlString);
+            ByteOutputBuffer outptr_driverControlString(&tmpBuf[0 + size_length], size_driverControlString);
             this->glGetDriverControlStringQCOM(var_driverControl, var_bufSize, (GLsizei*)(outptr_length.get()), (GLchar*)(outptr_driverControlString.get()));
             outptr_length.flush();
             outptr_driverControlString.flush();
@@ -4361,11 +4372,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetDriverControlStringQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEnableDriverControlQCOM: {
-            android::base::beginTrace("glEnableDriverControlQCOM decode");
+            if (useTracing) android::base::beginTrace("glEnableDriverControlQCOM decode");
             GLuint var_driverControl = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4373,11 +4384,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEnableDriverControlQCOM(var_driverControl);
             SET_LASTCALL("glEnableDriverControlQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDisableDriverControlQCOM: {
-            android::base::beginTrace("glDisableDriverControlQCOM decode");
+            if (useTracing) android::base::beginTrace("glDisableDriverControlQCOM decode");
             GLuint var_driverControl = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4385,11 +4396,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDisableDriverControlQCOM(var_driverControl);
             SET_LASTCALL("glDisableDriverControlQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetTexturesQCOM: {
-            android::base::beginTrace("glExtGetTexturesQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetTexturesQCOM decode");
             uint32_t size_textures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_maxTextures = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_numTextures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4411,11 +4422,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetTexturesQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetBuffersQCOM: {
-            android::base::beginTrace("glExtGetBuffersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetBuffersQCOM decode");
             uint32_t size_buffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_maxBuffers = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_numBuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4437,11 +4448,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetBuffersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetRenderbuffersQCOM: {
-            android::base::beginTrace("glExtGetRenderbuffersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetRenderbuffersQCOM decode");
             uint32_t size_renderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_maxRenderbuffers = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_numRenderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4463,11 +4474,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetRenderbuffersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetFramebuffersQCOM: {
-            android::base::beginTrace("glExtGetFramebuffersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetFramebuffersQCOM decode");
             uint32_t size_framebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_maxFramebuffers = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_numFramebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4489,11 +4500,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetFramebuffersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetTexLevelParameterivQCOM: {
-            android::base::beginTrace("glExtGetTexLevelParameterivQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetTexLevelParameterivQCOM decode");
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4514,11 +4525,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetTexLevelParameterivQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtTexObjectStateOverrideiQCOM: {
-            android::base::beginTrace("glExtTexObjectStateOverrideiQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtTexObjectStateOverrideiQCOM decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4528,11 +4539,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtTexObjectStateOverrideiQCOM(var_target, var_pname, var_param);
             SET_LASTCALL("glExtTexObjectStateOverrideiQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetTexSubImageQCOM: {
-            android::base::beginTrace("glExtGetTexSubImageQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetTexSubImageQCOM decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4559,11 +4570,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetTexSubImageQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetBufferPointervQCOM: {
-            android::base::beginTrace("glExtGetBufferPointervQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetBufferPointervQCOM decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -4573,11 +4584,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetBufferPointervQCOM(var_target, (GLvoid**)(inptr_params.get()));
             SET_LASTCALL("glExtGetBufferPointervQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetShadersQCOM: {
-            android::base::beginTrace("glExtGetShadersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetShadersQCOM decode");
             uint32_t size_shaders __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_maxShaders = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_numShaders __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4599,11 +4610,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetShadersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetProgramsQCOM: {
-            android::base::beginTrace("glExtGetProgramsQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetProgramsQCOM decode");
             uint32_t size_programs __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_maxPrograms = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_numPrograms __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4625,11 +4636,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtGetProgramsQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtIsProgramBinaryQCOM: {
-            android::base::beginTrace("glExtIsProgramBinaryQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtIsProgramBinaryQCOM decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4644,15 +4655,15 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtIsProgramBinaryQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetProgramBinarySourceQCOM: {
-            android::base::beginTrace("glExtGetProgramBinarySourceQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetProgramBinarySourceQCOM decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_shadertype = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_source __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_source(ptr + 8 + 4 + 4 + 4, size_source);
+            ByteInputBuffer inptr_source(ptr + 8 + 4 + 4 + 4, size_source);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_source);
             InputBuffer inptr_length(ptr + 8 + 4 + 4 + 4 + size_source + 4, size_length);
             if (useChecksum) {
@@ -4661,11 +4672,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetProgramBinarySourceQCOM(var_program, var_shadertype, (GLchar*)(inptr_source.get()), (GLint*)(inptr_length.get()));
             SET_LASTCALL("glExtGetProgramBinarySourceQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStartTilingQCOM: {
-            android::base::beginTrace("glStartTilingQCOM decode");
+            if (useTracing) android::base::beginTrace("glStartTilingQCOM decode");
             GLuint var_x = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_y = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_width = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4677,11 +4688,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStartTilingQCOM(var_x, var_y, var_width, var_height, var_preserveMask);
             SET_LASTCALL("glStartTilingQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEndTilingQCOM: {
-            android::base::beginTrace("glEndTilingQCOM decode");
+            if (useTracing) android::base::beginTrace("glEndTilingQCOM decode");
             GLbitfield var_preserveMask = Unpack<GLbitfield,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4689,11 +4700,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEndTilingQCOM(var_preserveMask);
             SET_LASTCALL("glEndTilingQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetGraphicsResetStatusEXT: {
-            android::base::beginTrace("glGetGraphicsResetStatusEXT decode");
+            if (useTracing) android::base::beginTrace("glGetGraphicsResetStatusEXT decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles1_decoder_context_t::decode, OP_glGetGraphicsResetStatusEXT: GL checksumCalculator failure\n");
@@ -4707,11 +4718,11 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetGraphicsResetStatusEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReadnPixelsEXT: {
-            android::base::beginTrace("glReadnPixelsEXT decode");
+            if (useTracing) android::base::beginTrace("glReadnPixelsEXT decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -4735,7 +4746,7 @@ int gles1_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glReadnPixelsEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         default:
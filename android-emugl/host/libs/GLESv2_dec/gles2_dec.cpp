@@ -41,6 +41,17 @@ typedef unsigned int tsize_t; // Target "size_t", which is 32-bit for now. It ma
 using namespace emugl;
 
 int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
+    const bool useTracing = android::base::shouldEnableTracing();
+    if (checksumCalc->checksumByteSize() > 0) {
+        return useTracing ? decodeImpl<true, true>(buf, len, stream, checksumCalc)
+                          : decodeImpl<true, false>(buf, len, stream, checksumCalc);
+    }
+    return useTracing ? decodeImpl<false, true>(buf, len, stream, checksumCalc)
+                      : decodeImpl<false, false>(buf, len, stream, checksumCalc);
+}
+
+template <bool useChecksum, bool useTracing>
+int gles2_decoder_context_t::decodeImpl(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
     if (len < 8) return 0; 
 #ifdef CHECK_GL_ERRORS
     char lastCall[256] = {0};
@@ -48,7 +59,6 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
     unsigned char *ptr = (unsigned char *)buf;
     const unsigned char* const end = (const unsigned char*)buf + len;
     const size_t checksumSize = checksumCalc->checksumByteSize();
-    const bool useChecksum = checksumSize > 0;
     while (end - ptr >= 8) {
         uint32_t opcode = *(uint32_t *)ptr;   
         int32_t packetLen = *(int32_t *)(ptr + 4);
@@ -57,6 +67,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             return -1;
         }
         if (end - ptr < packetLen) return ptr - (unsigned char*)buf;
+        currentDecoderOpcode() = opcode;
  
 #ifdef CHECK_GL_OPCODE_TIME_USE        
         struct timeval start;
@@ -69,7 +80,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
 
         switch(opcode) {
         case OP_glActiveTexture: {
-            android::base::beginTrace("glActiveTexture decode");
+            if (useTracing) android::base::beginTrace("glActiveTexture decode");
             GLenum var_texture = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -77,11 +88,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glActiveTexture(var_texture);
             SET_LASTCALL("glActiveTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glAttachShader: {
-            android::base::beginTrace("glAttachShader decode");
+            if (useTracing) android::base::beginTrace("glAttachShader decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -90,26 +101,26 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glAttachShader_dec(this, var_program, var_shader);
             SET_LASTCALL("glAttachShader");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindAttribLocation: {
-            android::base::beginTrace("glBindAttribLocation decode");
+            if (useTracing) android::base::beginTrace("glBindAttribLocation decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             uint32_t size_name __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_name(ptr + 8 + 4 + 4 + 4, size_name);
+            ByteInputBuffer inptr_name(ptr + 8 + 4 + 4 + 4, size_name);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_name, ptr + 8 + 4 + 4 + 4 + size_name, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glBindAttribLocation: GL checksumCalculator failure\n");
             }
             this->glBindAttribLocation_dec(this, var_program, var_index, (const GLchar*)(inptr_name.get()));
             SET_LASTCALL("glBindAttribLocation");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindBuffer: {
-            android::base::beginTrace("glBindBuffer decode");
+            if (useTracing) android::base::beginTrace("glBindBuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -118,11 +129,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindBuffer(var_target, var_buffer);
             SET_LASTCALL("glBindBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindFramebuffer: {
-            android::base::beginTrace("glBindFramebuffer decode");
+            if (useTracing) android::base::beginTrace("glBindFramebuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_framebuffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -131,11 +142,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindFramebuffer(var_target, var_framebuffer);
             SET_LASTCALL("glBindFramebuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindRenderbuffer: {
-            android::base::beginTrace("glBindRenderbuffer decode");
+            if (useTracing) android::base::beginTrace("glBindRenderbuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_renderbuffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -144,11 +155,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindRenderbuffer(var_target, var_renderbuffer);
             SET_LASTCALL("glBindRenderbuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindTexture: {
-            android::base::beginTrace("glBindTexture decode");
+            if (useTracing) android::base::beginTrace("glBindTexture decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -157,11 +168,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindTexture(var_target, var_texture);
             SET_LASTCALL("glBindTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendColor: {
-            android::base::beginTrace("glBlendColor decode");
+            if (useTracing) android::base::beginTrace("glBlendColor decode");
             GLclampf var_red = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLclampf var_green = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             GLclampf var_blue = Unpack<GLclampf,uint32_t>(ptr + 8 + 4 + 4);
@@ -172,11 +183,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendColor(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glBlendColor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendEquation: {
-            android::base::beginTrace("glBlendEquation decode");
+            if (useTracing) android::base::beginTrace("glBlendEquation decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -184,11 +195,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendEquation(var_mode);
             SET_LASTCALL("glBlendEquation");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendEquationSeparate: {
-            android::base::beginTrace("glBlendEquationSeparate decode");
+            if (useTracing) android::base::beginTrace("glBlendEquationSeparate decode");
             GLenum var_modeRGB = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_modeAlpha = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -197,11 +208,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendEquationSeparate(var_modeRGB, var_modeAlpha);
             SET_LASTCALL("glBlendEquationSeparate");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendFunc: {
-            android::base::beginTrace("glBlendFunc decode");
+            if (useTracing) android::base::beginTrace("glBlendFunc decode");
             GLenum var_sfactor = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_dfactor = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -210,11 +221,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendFunc(var_sfactor, var_dfactor);
             SET_LASTCALL("glBlendFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlendFuncSeparate: {
-            android::base::beginTrace("glBlendFuncSeparate decode");
+            if (useTracing) android::base::beginTrace("glBlendFuncSeparate decode");
             GLenum var_srcRGB = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_dstRGB = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_srcAlpha = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -225,15 +236,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlendFuncSeparate(var_srcRGB, var_dstRGB, var_srcAlpha, var_dstAlpha);
             SET_LASTCALL("glBlendFuncSeparate");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBufferData: {
-            android::base::beginTrace("glBufferData decode");
+            if (useTracing) android::base::beginTrace("glBufferData decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizeiptr var_size = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_data(ptr + 8 + 4 + 4 + 4, size_data);
+            ByteInputBuffer inptr_data(ptr + 8 + 4 + 4 + 4, size_data);
             GLenum var_usage = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_data);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_data + 4, ptr + 8 + 4 + 4 + 4 + size_data + 4, checksumSize, 
@@ -241,27 +252,27 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBufferData(var_target, var_size, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()), var_usage);
             SET_LASTCALL("glBufferData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBufferSubData: {
-            android::base::beginTrace("glBufferSubData decode");
+            if (useTracing) android::base::beginTrace("glBufferSubData decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_size = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4);
-            InputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4, size_data);
+            ByteInputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4, size_data);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + size_data, ptr + 8 + 4 + 4 + 4 + 4 + size_data, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glBufferSubData: GL checksumCalculator failure\n");
             }
             this->glBufferSubData(var_target, var_offset, var_size, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glBufferSubData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCheckFramebufferStatus: {
-            android::base::beginTrace("glCheckFramebufferStatus decode");
+            if (useTracing) android::base::beginTrace("glCheckFramebufferStatus decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -276,11 +287,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glCheckFramebufferStatus");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClear: {
-            android::base::beginTrace("glClear decode");
+            if (useTracing) android::base::beginTrace("glClear decode");
             GLbitfield var_mask = Unpack<GLbitfield,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -288,11 +299,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClear(var_mask);
             SET_LASTCALL("glClear");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearColor: {
-            android::base::beginTrace("glClearColor decode");
+            if (useTracing) android::base::beginTrace("glClearColor decode");
             GLclampf var_red = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLclampf var_green = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             GLclampf var_blue = Unpack<GLclampf,uint32_t>(ptr + 8 + 4 + 4);
@@ -303,11 +314,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearColor(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glClearColor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearDepthf: {
-            android::base::beginTrace("glClearDepthf decode");
+            if (useTracing) android::base::beginTrace("glClearDepthf decode");
             GLclampf var_depth = Unpack<GLclampf,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -315,11 +326,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearDepthf(var_depth);
             SET_LASTCALL("glClearDepthf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearStencil: {
-            android::base::beginTrace("glClearStencil decode");
+            if (useTracing) android::base::beginTrace("glClearStencil decode");
             GLint var_s = Unpack<GLint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -327,11 +338,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearStencil(var_s);
             SET_LASTCALL("glClearStencil");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glColorMask: {
-            android::base::beginTrace("glColorMask decode");
+            if (useTracing) android::base::beginTrace("glColorMask decode");
             GLboolean var_red = Unpack<GLboolean,uint8_t>(ptr + 8);
             GLboolean var_green = Unpack<GLboolean,uint8_t>(ptr + 8 + 1);
             GLboolean var_blue = Unpack<GLboolean,uint8_t>(ptr + 8 + 1 + 1);
@@ -342,11 +353,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glColorMask(var_red, var_green, var_blue, var_alpha);
             SET_LASTCALL("glColorMask");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompileShader: {
-            android::base::beginTrace("glCompileShader decode");
+            if (useTracing) android::base::beginTrace("glCompileShader decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -354,11 +365,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompileShader_dec(this, var_shader);
             SET_LASTCALL("glCompileShader");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexImage2D: {
-            android::base::beginTrace("glCompressedTexImage2D decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -374,11 +385,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexImage2D(var_target, var_level, var_internalformat, var_width, var_height, var_border, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexSubImage2D: {
-            android::base::beginTrace("glCompressedTexSubImage2D decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexSubImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -395,11 +406,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexSubImage2D(var_target, var_level, var_xoffset, var_yoffset, var_width, var_height, var_format, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexSubImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyTexImage2D: {
-            android::base::beginTrace("glCopyTexImage2D decode");
+            if (useTracing) android::base::beginTrace("glCopyTexImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -414,11 +425,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyTexImage2D(var_target, var_level, var_internalformat, var_x, var_y, var_width, var_height, var_border);
             SET_LASTCALL("glCopyTexImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyTexSubImage2D: {
-            android::base::beginTrace("glCopyTexSubImage2D decode");
+            if (useTracing) android::base::beginTrace("glCopyTexSubImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -433,11 +444,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyTexSubImage2D(var_target, var_level, var_xoffset, var_yoffset, var_x, var_y, var_width, var_height);
             SET_LASTCALL("glCopyTexSubImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCreateProgram: {
-            android::base::beginTrace("glCreateProgram decode");
+            if (useTracing) android::base::beginTrace("glCreateProgram decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glCreateProgram: GL checksumCalculator failure\n");
@@ -451,11 +462,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glCreateProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCreateShader: {
-            android::base::beginTrace("glCreateShader decode");
+            if (useTracing) android::base::beginTrace("glCreateShader decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -470,11 +481,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glCreateShader");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCullFace: {
-            android::base::beginTrace("glCullFace decode");
+            if (useTracing) android::base::beginTrace("glCullFace decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -482,11 +493,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCullFace(var_mode);
             SET_LASTCALL("glCullFace");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteBuffers: {
-            android::base::beginTrace("glDeleteBuffers decode");
+            if (useTracing) android::base::beginTrace("glDeleteBuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_buffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_buffers(ptr + 8 + 4 + 4, size_buffers);
@@ -496,11 +507,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteBuffers_dec(this, var_n, (const GLuint*)(inptr_buffers.get()));
             SET_LASTCALL("glDeleteBuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteFramebuffers: {
-            android::base::beginTrace("glDeleteFramebuffers decode");
+            if (useTracing) android::base::beginTrace("glDeleteFramebuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_framebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_framebuffers(ptr + 8 + 4 + 4, size_framebuffers);
@@ -510,11 +521,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteFramebuffers_dec(this, var_n, (const GLuint*)(inptr_framebuffers.get()));
             SET_LASTCALL("glDeleteFramebuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteProgram: {
-            android::base::beginTrace("glDeleteProgram decode");
+            if (useTracing) android::base::beginTrace("glDeleteProgram decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -522,11 +533,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteProgram_dec(this, var_program);
             SET_LASTCALL("glDeleteProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteRenderbuffers: {
-            android::base::beginTrace("glDeleteRenderbuffers decode");
+            if (useTracing) android::base::beginTrace("glDeleteRenderbuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_renderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_renderbuffers(ptr + 8 + 4 + 4, size_renderbuffers);
@@ -536,11 +547,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteRenderbuffers_dec(this, var_n, (const GLuint*)(inptr_renderbuffers.get()));
             SET_LASTCALL("glDeleteRenderbuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteShader: {
-            android::base::beginTrace("glDeleteShader decode");
+            if (useTracing) android::base::beginTrace("glDeleteShader decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -548,11 +559,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteShader_dec(this, var_shader);
             SET_LASTCALL("glDeleteShader");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteTextures: {
-            android::base::beginTrace("glDeleteTextures decode");
+            if (useTracing) android::base::beginTrace("glDeleteTextures decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_textures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_textures(ptr + 8 + 4 + 4, size_textures);
@@ -562,11 +573,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteTextures_dec(this, var_n, (const GLuint*)(inptr_textures.get()));
             SET_LASTCALL("glDeleteTextures");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthFunc: {
-            android::base::beginTrace("glDepthFunc decode");
+            if (useTracing) android::base::beginTrace("glDepthFunc decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -574,11 +585,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthFunc(var_func);
             SET_LASTCALL("glDepthFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthMask: {
-            android::base::beginTrace("glDepthMask decode");
+            if (useTracing) android::base::beginTrace("glDepthMask decode");
             GLboolean var_flag = Unpack<GLboolean,uint8_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 1, ptr + 8 + 1, checksumSize, 
@@ -586,11 +597,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthMask(var_flag);
             SET_LASTCALL("glDepthMask");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDepthRangef: {
-            android::base::beginTrace("glDepthRangef decode");
+            if (useTracing) android::base::beginTrace("glDepthRangef decode");
             GLclampf var_zNear = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLclampf var_zFar = Unpack<GLclampf,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -599,11 +610,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDepthRangef(var_zNear, var_zFar);
             SET_LASTCALL("glDepthRangef");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDetachShader: {
-            android::base::beginTrace("glDetachShader decode");
+            if (useTracing) android::base::beginTrace("glDetachShader decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -612,11 +623,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDetachShader_dec(this, var_program, var_shader);
             SET_LASTCALL("glDetachShader");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDisable: {
-            android::base::beginTrace("glDisable decode");
+            if (useTracing) android::base::beginTrace("glDisable decode");
             GLenum var_cap = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -624,11 +635,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDisable(var_cap);
             SET_LASTCALL("glDisable");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDisableVertexAttribArray: {
-            android::base::beginTrace("glDisableVertexAttribArray decode");
+            if (useTracing) android::base::beginTrace("glDisableVertexAttribArray decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -636,11 +647,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDisableVertexAttribArray(var_index);
             SET_LASTCALL("glDisableVertexAttribArray");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArrays: {
-            android::base::beginTrace("glDrawArrays decode");
+            if (useTracing) android::base::beginTrace("glDrawArrays decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_first = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -650,11 +661,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArrays(var_mode, var_first, var_count);
             SET_LASTCALL("glDrawArrays");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElements: {
-            android::base::beginTrace("glDrawElements decode");
+            if (useTracing) android::base::beginTrace("glDrawElements decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -666,11 +677,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElements(var_mode, var_count, var_type, (const GLvoid*)(inptr_indices.get()));
             SET_LASTCALL("glDrawElements");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEnable: {
-            android::base::beginTrace("glEnable decode");
+            if (useTracing) android::base::beginTrace("glEnable decode");
             GLenum var_cap = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -678,11 +689,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEnable(var_cap);
             SET_LASTCALL("glEnable");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEnableVertexAttribArray: {
-            android::base::beginTrace("glEnableVertexAttribArray decode");
+            if (useTracing) android::base::beginTrace("glEnableVertexAttribArray decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -690,33 +701,33 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEnableVertexAttribArray(var_index);
             SET_LASTCALL("glEnableVertexAttribArray");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFinish: {
-            android::base::beginTrace("glFinish decode");
+            if (useTracing) android::base::beginTrace("glFinish decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glFinish: GL checksumCalculator failure\n");
             }
             this->glFinish();
             SET_LASTCALL("glFinish");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFlush: {
-            android::base::beginTrace("glFlush decode");
+            if (useTracing) android::base::beginTrace("glFlush decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glFlush: GL checksumCalculator failure\n");
             }
             this->glFlush();
             SET_LASTCALL("glFlush");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferRenderbuffer: {
-            android::base::beginTrace("glFramebufferRenderbuffer decode");
+            if (useTracing) android::base::beginTrace("glFramebufferRenderbuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_renderbuffertarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -727,11 +738,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferRenderbuffer(var_target, var_attachment, var_renderbuffertarget, var_renderbuffer);
             SET_LASTCALL("glFramebufferRenderbuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferTexture2D: {
-            android::base::beginTrace("glFramebufferTexture2D decode");
+            if (useTracing) android::base::beginTrace("glFramebufferTexture2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_textarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -743,11 +754,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferTexture2D(var_target, var_attachment, var_textarget, var_texture, var_level);
             SET_LASTCALL("glFramebufferTexture2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFrontFace: {
-            android::base::beginTrace("glFrontFace decode");
+            if (useTracing) android::base::beginTrace("glFrontFace decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -755,11 +766,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFrontFace(var_mode);
             SET_LASTCALL("glFrontFace");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenBuffers: {
-            android::base::beginTrace("glGenBuffers decode");
+            if (useTracing) android::base::beginTrace("glGenBuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_buffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -777,11 +788,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenBuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenerateMipmap: {
-            android::base::beginTrace("glGenerateMipmap decode");
+            if (useTracing) android::base::beginTrace("glGenerateMipmap decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -789,11 +800,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGenerateMipmap(var_target);
             SET_LASTCALL("glGenerateMipmap");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenFramebuffers: {
-            android::base::beginTrace("glGenFramebuffers decode");
+            if (useTracing) android::base::beginTrace("glGenFramebuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_framebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -811,11 +822,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenFramebuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenRenderbuffers: {
-            android::base::beginTrace("glGenRenderbuffers decode");
+            if (useTracing) android::base::beginTrace("glGenRenderbuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_renderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -833,11 +844,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenRenderbuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenTextures: {
-            android::base::beginTrace("glGenTextures decode");
+            if (useTracing) android::base::beginTrace("glGenTextures decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_textures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -855,11 +866,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenTextures");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetActiveAttrib: {
-            android::base::beginTrace("glGetActiveAttrib decode");
+            if (useTracing) android::base::beginTrace("glGetActiveAttrib decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufsize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -880,7 +891,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
             OutputBuffer outptr_size(&tmpBuf[0 + size_length], size_size);
             OutputBuffer outptr_type(&tmpBuf[0 + size_length + size_size], size_type);
-            OutputBuffer outptr_name(&tmpBuf[0 + size_length + size_size + size_type], size_name);
+            ByteOutputBuffer outptr_name(&tmpBuf[0 + size_length + size_size + size_type], size_name);
             this->glGetActiveAttrib_dec(this, var_program, var_index, var_bufsize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), size_size == 0 ? nullptr : (GLint*)(outptr_size.get()), size_type == 0 ? nullptr : (GLenum*)(outptr_type.get()), size_name == 0 ? nullptr : (GLchar*)(outptr_name.get()));
             outptr_length.flush();
             outptr_size.flush();
@@ -891,11 +902,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetActiveAttrib");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetActiveUniform: {
-            android::base::beginTrace("glGetActiveUniform decode");
+            if (useTracing) android::base::beginTrace("glGetActiveUniform decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufsize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -916,7 +927,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
             OutputBuffer outptr_size(&tmpBuf[0 + size_length], size_size);
             OutputBuffer outptr_type(&tmpBuf[0 + size_length + size_size], size_type);
-            OutputBuffer outptr_name(&tmpBuf[0 + size_length + size_size + size_type], size_name);
+            ByteOutputBuffer outptr_name(&tmpBuf[0 + size_length + size_size + size_type], size_name);
             this->glGetActiveUniform_dec(this, var_program, var_index, var_bufsize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), size_size == 0 ? nullptr : (GLint*)(outptr_size.get()), size_type == 0 ? nullptr : (GLenum*)(outptr_type.get()), size_name == 0 ? nullptr : (GLchar*)(outptr_name.get()));
             outptr_length.flush();
             outptr_size.flush();
@@ -927,11 +938,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetActiveUniform");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetAttachedShaders: {
-            android::base::beginTrace("glGetAttachedShaders decode");
+            if (useTracing) android::base::beginTrace("glGetAttachedShaders decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_maxcount = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_count __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -954,14 +965,14 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetAttachedShaders");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetAttribLocation: {
-            android::base::beginTrace("glGetAttribLocation decode");
+            if (useTracing) android::base::beginTrace("glGetAttribLocation decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_name __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
-            InputBuffer inptr_name(ptr + 8 + 4 + 4, size_name);
+            ByteInputBuffer inptr_name(ptr + 8 + 4 + 4, size_name);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + size_name, ptr + 8 + 4 + 4 + size_name, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetAttribLocation: GL checksumCalculator failure\n");
@@ -975,11 +986,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetAttribLocation");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBooleanv: {
-            android::base::beginTrace("glGetBooleanv decode");
+            if (useTracing) android::base::beginTrace("glGetBooleanv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -997,11 +1008,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetBooleanv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBufferParameteriv: {
-            android::base::beginTrace("glGetBufferParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetBufferParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1020,11 +1031,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetBufferParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetError: {
-            android::base::beginTrace("glGetError decode");
+            if (useTracing) android::base::beginTrace("glGetError decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetError: GL checksumCalculator failure\n");
@@ -1038,11 +1049,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetError");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFloatv: {
-            android::base::beginTrace("glGetFloatv decode");
+            if (useTracing) android::base::beginTrace("glGetFloatv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1060,11 +1071,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFloatv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFramebufferAttachmentParameteriv: {
-            android::base::beginTrace("glGetFramebufferAttachmentParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetFramebufferAttachmentParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -1084,11 +1095,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFramebufferAttachmentParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetIntegerv: {
-            android::base::beginTrace("glGetIntegerv decode");
+            if (useTracing) android::base::beginTrace("glGetIntegerv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1106,11 +1117,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetIntegerv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramiv: {
-            android::base::beginTrace("glGetProgramiv decode");
+            if (useTracing) android::base::beginTrace("glGetProgramiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1129,11 +1140,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramInfoLog: {
-            android::base::beginTrace("glGetProgramInfoLog decode");
+            if (useTracing) android::base::beginTrace("glGetProgramInfoLog decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufsize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1147,7 +1158,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_infolog(&tmpBuf[0 + size_length], size_infolog);
+            ByteOutputBuffer outptr_infolog(&tmpBuf[0 + size_length], size_infolog);
             this->glGetProgramInfoLog_dec(this, var_program, var_bufsize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), (GLchar*)(outptr_infolog.get()));
             outptr_length.flush();
             outptr_infolog.flush();
@@ -1156,11 +1167,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramInfoLog");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetRenderbufferParameteriv: {
-            android::base::beginTrace("glGetRenderbufferParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetRenderbufferParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1179,11 +1190,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetRenderbufferParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetShaderiv: {
-            android::base::beginTrace("glGetShaderiv decode");
+            if (useTracing) android::base::beginTrace("glGetShaderiv decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1202,11 +1213,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetShaderiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetShaderInfoLog: {
-            android::base::beginTrace("glGetShaderInfoLog decode");
+            if (useTracing) android::base::beginTrace("glGetShaderInfoLog decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufsize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1220,7 +1231,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_infolog(&tmpBuf[0 + size_length], size_infolog);
+            ByteOutputBuffer outptr_infolog(&tmpBuf[0 + size_length], size_infolog);
             this->glGetShaderInfoLog_dec(this, var_shader, var_bufsize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), (GLchar*)(outptr_infolog.get()));
             outptr_length.flush();
             outptr_infolog.flush();
@@ -1229,11 +1240,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetShaderInfoLog");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetShaderPrecisionFormat: {
-            android::base::beginTrace("glGetShaderPrecisionFormat decode");
+            if (useTracing) android::base::beginTrace("glGetShaderPrecisionFormat decode");
             GLenum var_shadertype = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_precisiontype = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_range __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1256,11 +1267,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetShaderPrecisionFormat");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetShaderSource: {
-            android::base::beginTrace("glGetShaderSource decode");
+            if (useTracing) android::base::beginTrace("glGetShaderSource decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufsize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1274,7 +1285,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_source(&tmpBuf[0 + size_length], size_source);
+            ByteOutputBuffer outptr_source(&tmpBuf[0 + size_length], size_source);
             this->glGetShaderSource_dec(this, var_shader, var_bufsize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), (GLchar*)(outptr_source.get()));
             outptr_length.flush();
             outptr_source.flush();
@@ -1283,11 +1294,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetShaderSource");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetString: {
-            android::base::beginTrace("glGetString decode");
+            if (useTracing) android::base::beginTrace("glGetString decode");
             GLenum var_name = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1295,11 +1306,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetString(var_name);
             SET_LASTCALL("glGetString");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexParameterfv: {
-            android::base::beginTrace("glGetTexParameterfv decode");
+            if (useTracing) android::base::beginTrace("glGetTexParameterfv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1318,11 +1329,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexParameteriv: {
-            android::base::beginTrace("glGetTexParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetTexParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1341,11 +1352,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformfv: {
-            android::base::beginTrace("glGetUniformfv decode");
+            if (useTracing) android::base::beginTrace("glGetUniformfv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1364,11 +1375,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetUniformfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformiv: {
-            android::base::beginTrace("glGetUniformiv decode");
+            if (useTracing) android::base::beginTrace("glGetUniformiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1387,14 +1398,14 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetUniformiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformLocation: {
-            android::base::beginTrace("glGetUniformLocation decode");
+            if (useTracing) android::base::beginTrace("glGetUniformLocation decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_name __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
-            InputBuffer inptr_name(ptr + 8 + 4 + 4, size_name);
+            ByteInputBuffer inptr_name(ptr + 8 + 4 + 4, size_name);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + size_name, ptr + 8 + 4 + 4 + size_name, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetUniformLocation: GL checksumCalculator failure\n");
@@ -1408,11 +1419,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetUniformLocation");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetVertexAttribfv: {
-            android::base::beginTrace("glGetVertexAttribfv decode");
+            if (useTracing) android::base::beginTrace("glGetVertexAttribfv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1431,11 +1442,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetVertexAttribfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetVertexAttribiv: {
-            android::base::beginTrace("glGetVertexAttribiv decode");
+            if (useTracing) android::base::beginTrace("glGetVertexAttribiv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1454,11 +1465,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetVertexAttribiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetVertexAttribPointerv: {
-            android::base::beginTrace("glGetVertexAttribPointerv decode");
+            if (useTracing) android::base::beginTrace("glGetVertexAttribPointerv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_pointer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1469,11 +1480,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetVertexAttribPointerv(var_index, var_pname, (GLvoid**)(inptr_pointer.get()));
             SET_LASTCALL("glGetVertexAttribPointerv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glHint: {
-            android::base::beginTrace("glHint decode");
+            if (useTracing) android::base::beginTrace("glHint decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1482,11 +1493,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glHint(var_target, var_mode);
             SET_LASTCALL("glHint");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsBuffer: {
-            android::base::beginTrace("glIsBuffer decode");
+            if (useTracing) android::base::beginTrace("glIsBuffer decode");
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1501,11 +1512,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsEnabled: {
-            android::base::beginTrace("glIsEnabled decode");
+            if (useTracing) android::base::beginTrace("glIsEnabled decode");
             GLenum var_cap = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1520,11 +1531,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsEnabled");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsFramebuffer: {
-            android::base::beginTrace("glIsFramebuffer decode");
+            if (useTracing) android::base::beginTrace("glIsFramebuffer decode");
             GLuint var_framebuffer = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1539,11 +1550,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsFramebuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsProgram: {
-            android::base::beginTrace("glIsProgram decode");
+            if (useTracing) android::base::beginTrace("glIsProgram decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1558,11 +1569,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsRenderbuffer: {
-            android::base::beginTrace("glIsRenderbuffer decode");
+            if (useTracing) android::base::beginTrace("glIsRenderbuffer decode");
             GLuint var_renderbuffer = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1577,11 +1588,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsRenderbuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsShader: {
-            android::base::beginTrace("glIsShader decode");
+            if (useTracing) android::base::beginTrace("glIsShader decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1596,11 +1607,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsShader");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsTexture: {
-            android::base::beginTrace("glIsTexture decode");
+            if (useTracing) android::base::beginTrace("glIsTexture decode");
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1615,11 +1626,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLineWidth: {
-            android::base::beginTrace("glLineWidth decode");
+            if (useTracing) android::base::beginTrace("glLineWidth decode");
             GLfloat var_width = Unpack<GLfloat,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1627,11 +1638,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLineWidth(var_width);
             SET_LASTCALL("glLineWidth");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glLinkProgram: {
-            android::base::beginTrace("glLinkProgram decode");
+            if (useTracing) android::base::beginTrace("glLinkProgram decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1639,11 +1650,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glLinkProgram_dec(this, var_program);
             SET_LASTCALL("glLinkProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPixelStorei: {
-            android::base::beginTrace("glPixelStorei decode");
+            if (useTracing) android::base::beginTrace("glPixelStorei decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1652,11 +1663,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPixelStorei(var_pname, var_param);
             SET_LASTCALL("glPixelStorei");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPolygonOffset: {
-            android::base::beginTrace("glPolygonOffset decode");
+            if (useTracing) android::base::beginTrace("glPolygonOffset decode");
             GLfloat var_factor = Unpack<GLfloat,uint32_t>(ptr + 8);
             GLfloat var_units = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1665,11 +1676,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glPolygonOffset(var_factor, var_units);
             SET_LASTCALL("glPolygonOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReadPixels: {
-            android::base::beginTrace("glReadPixels decode");
+            if (useTracing) android::base::beginTrace("glReadPixels decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -1692,22 +1703,22 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glReadPixels");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReleaseShaderCompiler: {
-            android::base::beginTrace("glReleaseShaderCompiler decode");
+            if (useTracing) android::base::beginTrace("glReleaseShaderCompiler decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glReleaseShaderCompiler: GL checksumCalculator failure\n");
             }
             this->glReleaseShaderCompiler();
             SET_LASTCALL("glReleaseShaderCompiler");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRenderbufferStorage: {
-            android::base::beginTrace("glRenderbufferStorage decode");
+            if (useTracing) android::base::beginTrace("glRenderbufferStorage decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -1718,11 +1729,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRenderbufferStorage(var_target, var_internalformat, var_width, var_height);
             SET_LASTCALL("glRenderbufferStorage");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSampleCoverage: {
-            android::base::beginTrace("glSampleCoverage decode");
+            if (useTracing) android::base::beginTrace("glSampleCoverage decode");
             GLclampf var_value = Unpack<GLclampf,uint32_t>(ptr + 8);
             GLboolean var_invert = Unpack<GLboolean,uint8_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1731,11 +1742,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSampleCoverage(var_value, var_invert);
             SET_LASTCALL("glSampleCoverage");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glScissor: {
-            android::base::beginTrace("glScissor decode");
+            if (useTracing) android::base::beginTrace("glScissor decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -1746,11 +1757,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glScissor(var_x, var_y, var_width, var_height);
             SET_LASTCALL("glScissor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glShaderBinary: {
-            android::base::beginTrace("glShaderBinary decode");
+            if (useTracing) android::base::beginTrace("glShaderBinary decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_shaders __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_shaders(ptr + 8 + 4 + 4, size_shaders);
@@ -1764,11 +1775,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glShaderBinary(var_n, (const GLuint*)(inptr_shaders.get()), var_binaryformat, (const GLvoid*)(inptr_binary.get()), var_length);
             SET_LASTCALL("glShaderBinary");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glShaderSource: {
-            android::base::beginTrace("glShaderSource decode");
+            if (useTracing) android::base::beginTrace("glShaderSource decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_string __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1781,11 +1792,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glShaderSource(var_shader, var_count, (const GLchar* const*)(inptr_string.get()), (const GLint*)(inptr_length.get()));
             SET_LASTCALL("glShaderSource");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilFunc: {
-            android::base::beginTrace("glStencilFunc decode");
+            if (useTracing) android::base::beginTrace("glStencilFunc decode");
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_ref = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLuint var_mask = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -1795,11 +1806,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilFunc(var_func, var_ref, var_mask);
             SET_LASTCALL("glStencilFunc");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilFuncSeparate: {
-            android::base::beginTrace("glStencilFuncSeparate decode");
+            if (useTracing) android::base::beginTrace("glStencilFuncSeparate decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_func = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_ref = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -1810,11 +1821,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilFuncSeparate(var_face, var_func, var_ref, var_mask);
             SET_LASTCALL("glStencilFuncSeparate");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilMask: {
-            android::base::beginTrace("glStencilMask decode");
+            if (useTracing) android::base::beginTrace("glStencilMask decode");
             GLuint var_mask = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1822,11 +1833,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilMask(var_mask);
             SET_LASTCALL("glStencilMask");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilMaskSeparate: {
-            android::base::beginTrace("glStencilMaskSeparate decode");
+            if (useTracing) android::base::beginTrace("glStencilMaskSeparate decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_mask = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1835,11 +1846,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilMaskSeparate(var_face, var_mask);
             SET_LASTCALL("glStencilMaskSeparate");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilOp: {
-            android::base::beginTrace("glStencilOp decode");
+            if (useTracing) android::base::beginTrace("glStencilOp decode");
             GLenum var_fail = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_zfail = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_zpass = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -1849,11 +1860,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilOp(var_fail, var_zfail, var_zpass);
             SET_LASTCALL("glStencilOp");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStencilOpSeparate: {
-            android::base::beginTrace("glStencilOpSeparate decode");
+            if (useTracing) android::base::beginTrace("glStencilOpSeparate decode");
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_fail = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_zfail = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -1864,11 +1875,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStencilOpSeparate(var_face, var_fail, var_zfail, var_zpass);
             SET_LASTCALL("glStencilOpSeparate");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexImage2D: {
-            android::base::beginTrace("glTexImage2D decode");
+            if (useTracing) android::base::beginTrace("glTexImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_internalformat = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -1878,18 +1889,18 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_pixels __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
+            ByteInputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glTexImage2D: GL checksumCalculator failure\n");
             }
             this->glTexImage2D(var_target, var_level, var_internalformat, var_width, var_height, var_border, var_format, var_type, size_pixels == 0 ? nullptr : (const GLvoid*)(inptr_pixels.get()));
             SET_LASTCALL("glTexImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterf: {
-            android::base::beginTrace("glTexParameterf decode");
+            if (useTracing) android::base::beginTrace("glTexParameterf decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -1899,11 +1910,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterf(var_target, var_pname, var_param);
             SET_LASTCALL("glTexParameterf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameterfv: {
-            android::base::beginTrace("glTexParameterfv decode");
+            if (useTracing) android::base::beginTrace("glTexParameterfv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1914,11 +1925,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameterfv(var_target, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glTexParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameteri: {
-            android::base::beginTrace("glTexParameteri decode");
+            if (useTracing) android::base::beginTrace("glTexParameteri decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -1928,11 +1939,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameteri(var_target, var_pname, var_param);
             SET_LASTCALL("glTexParameteri");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexParameteriv: {
-            android::base::beginTrace("glTexParameteriv decode");
+            if (useTracing) android::base::beginTrace("glTexParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1943,11 +1954,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexParameteriv(var_target, var_pname, (const GLint*)(inptr_params.get()));
             SET_LASTCALL("glTexParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexSubImage2D: {
-            android::base::beginTrace("glTexSubImage2D decode");
+            if (useTracing) android::base::beginTrace("glTexSubImage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -1957,18 +1968,18 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_pixels __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
+            ByteInputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glTexSubImage2D: GL checksumCalculator failure\n");
             }
             this->glTexSubImage2D(var_target, var_level, var_xoffset, var_yoffset, var_width, var_height, var_format, var_type, size_pixels == 0 ? nullptr : (const GLvoid*)(inptr_pixels.get()));
             SET_LASTCALL("glTexSubImage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform1f: {
-            android::base::beginTrace("glUniform1f decode");
+            if (useTracing) android::base::beginTrace("glUniform1f decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1977,11 +1988,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform1f(var_location, var_x);
             SET_LASTCALL("glUniform1f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform1fv: {
-            android::base::beginTrace("glUniform1fv decode");
+            if (useTracing) android::base::beginTrace("glUniform1fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1992,11 +2003,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform1fv(var_location, var_count, (const GLfloat*)(inptr_v.get()));
             SET_LASTCALL("glUniform1fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform1i: {
-            android::base::beginTrace("glUniform1i decode");
+            if (useTracing) android::base::beginTrace("glUniform1i decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2005,11 +2016,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform1i(var_location, var_x);
             SET_LASTCALL("glUniform1i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform1iv: {
-            android::base::beginTrace("glUniform1iv decode");
+            if (useTracing) android::base::beginTrace("glUniform1iv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2020,11 +2031,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform1iv(var_location, var_count, (const GLint*)(inptr_v.get()));
             SET_LASTCALL("glUniform1iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform2f: {
-            android::base::beginTrace("glUniform2f decode");
+            if (useTracing) android::base::beginTrace("glUniform2f decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2034,11 +2045,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform2f(var_location, var_x, var_y);
             SET_LASTCALL("glUniform2f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform2fv: {
-            android::base::beginTrace("glUniform2fv decode");
+            if (useTracing) android::base::beginTrace("glUniform2fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2049,11 +2060,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform2fv(var_location, var_count, (const GLfloat*)(inptr_v.get()));
             SET_LASTCALL("glUniform2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform2i: {
-            android::base::beginTrace("glUniform2i decode");
+            if (useTracing) android::base::beginTrace("glUniform2i decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2063,11 +2074,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform2i(var_location, var_x, var_y);
             SET_LASTCALL("glUniform2i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform2iv: {
-            android::base::beginTrace("glUniform2iv decode");
+            if (useTracing) android::base::beginTrace("glUniform2iv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2078,11 +2089,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform2iv(var_location, var_count, (const GLint*)(inptr_v.get()));
             SET_LASTCALL("glUniform2iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform3f: {
-            android::base::beginTrace("glUniform3f decode");
+            if (useTracing) android::base::beginTrace("glUniform3f decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2093,11 +2104,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform3f(var_location, var_x, var_y, var_z);
             SET_LASTCALL("glUniform3f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform3fv: {
-            android::base::beginTrace("glUniform3fv decode");
+            if (useTracing) android::base::beginTrace("glUniform3fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2108,11 +2119,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform3fv(var_location, var_count, (const GLfloat*)(inptr_v.get()));
             SET_LASTCALL("glUniform3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform3i: {
-            android::base::beginTrace("glUniform3i decode");
+            if (useTracing) android::base::beginTrace("glUniform3i decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2123,11 +2134,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform3i(var_location, var_x, var_y, var_z);
             SET_LASTCALL("glUniform3i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform3iv: {
-            android::base::beginTrace("glUniform3iv decode");
+            if (useTracing) android::base::beginTrace("glUniform3iv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2138,11 +2149,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform3iv(var_location, var_count, (const GLint*)(inptr_v.get()));
             SET_LASTCALL("glUniform3iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform4f: {
-            android::base::beginTrace("glUniform4f decode");
+            if (useTracing) android::base::beginTrace("glUniform4f decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2154,11 +2165,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform4f(var_location, var_x, var_y, var_z, var_w);
             SET_LASTCALL("glUniform4f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform4fv: {
-            android::base::beginTrace("glUniform4fv decode");
+            if (useTracing) android::base::beginTrace("glUniform4fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2169,11 +2180,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform4fv(var_location, var_count, (const GLfloat*)(inptr_v.get()));
             SET_LASTCALL("glUniform4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform4i: {
-            android::base::beginTrace("glUniform4i decode");
+            if (useTracing) android::base::beginTrace("glUniform4i decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2185,11 +2196,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform4i(var_location, var_x, var_y, var_z, var_w);
             SET_LASTCALL("glUniform4i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform4iv: {
-            android::base::beginTrace("glUniform4iv decode");
+            if (useTracing) android::base::beginTrace("glUniform4iv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2200,11 +2211,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform4iv(var_location, var_count, (const GLint*)(inptr_v.get()));
             SET_LASTCALL("glUniform4iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix2fv: {
-            android::base::beginTrace("glUniformMatrix2fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix2fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -2216,11 +2227,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix2fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix3fv: {
-            android::base::beginTrace("glUniformMatrix3fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix3fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -2232,11 +2243,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix3fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix4fv: {
-            android::base::beginTrace("glUniformMatrix4fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix4fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -2248,11 +2259,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix4fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUseProgram: {
-            android::base::beginTrace("glUseProgram decode");
+            if (useTracing) android::base::beginTrace("glUseProgram decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2260,11 +2271,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUseProgram_dec(this, var_program);
             SET_LASTCALL("glUseProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glValidateProgram: {
-            android::base::beginTrace("glValidateProgram decode");
+            if (useTracing) android::base::beginTrace("glValidateProgram decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2272,11 +2283,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glValidateProgram_dec(this, var_program);
             SET_LASTCALL("glValidateProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib1f: {
-            android::base::beginTrace("glVertexAttrib1f decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib1f decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2285,11 +2296,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib1f(var_indx, var_x);
             SET_LASTCALL("glVertexAttrib1f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib1fv: {
-            android::base::beginTrace("glVertexAttrib1fv decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib1fv decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_values __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_values(ptr + 8 + 4 + 4, size_values);
@@ -2299,11 +2310,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib1fv(var_indx, (const GLfloat*)(inptr_values.get()));
             SET_LASTCALL("glVertexAttrib1fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib2f: {
-            android::base::beginTrace("glVertexAttrib2f decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib2f decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2313,11 +2324,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib2f(var_indx, var_x, var_y);
             SET_LASTCALL("glVertexAttrib2f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib2fv: {
-            android::base::beginTrace("glVertexAttrib2fv decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib2fv decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_values __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_values(ptr + 8 + 4 + 4, size_values);
@@ -2327,11 +2338,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib2fv(var_indx, (const GLfloat*)(inptr_values.get()));
             SET_LASTCALL("glVertexAttrib2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib3f: {
-            android::base::beginTrace("glVertexAttrib3f decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib3f decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2342,11 +2353,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib3f(var_indx, var_x, var_y, var_z);
             SET_LASTCALL("glVertexAttrib3f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib3fv: {
-            android::base::beginTrace("glVertexAttrib3fv decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib3fv decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_values __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_values(ptr + 8 + 4 + 4, size_values);
@@ -2356,11 +2367,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib3fv(var_indx, (const GLfloat*)(inptr_values.get()));
             SET_LASTCALL("glVertexAttrib3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib4f: {
-            android::base::beginTrace("glVertexAttrib4f decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib4f decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLfloat var_x = Unpack<GLfloat,uint32_t>(ptr + 8 + 4);
             GLfloat var_y = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -2372,11 +2383,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib4f(var_indx, var_x, var_y, var_z, var_w);
             SET_LASTCALL("glVertexAttrib4f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttrib4fv: {
-            android::base::beginTrace("glVertexAttrib4fv decode");
+            if (useTracing) android::base::beginTrace("glVertexAttrib4fv decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_values __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_values(ptr + 8 + 4 + 4, size_values);
@@ -2386,11 +2397,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttrib4fv(var_indx, (const GLfloat*)(inptr_values.get()));
             SET_LASTCALL("glVertexAttrib4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribPointer: {
-            android::base::beginTrace("glVertexAttribPointer decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribPointer decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2404,11 +2415,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribPointer(var_indx, var_size, var_type, var_normalized, var_stride, (const GLvoid*)(inptr_ptr.get()));
             SET_LASTCALL("glVertexAttribPointer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glViewport: {
-            android::base::beginTrace("glViewport decode");
+            if (useTracing) android::base::beginTrace("glViewport decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2419,11 +2430,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glViewport(var_x, var_y, var_width, var_height);
             SET_LASTCALL("glViewport");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEGLImageTargetTexture2DOES: {
-            android::base::beginTrace("glEGLImageTargetTexture2DOES decode");
+            if (useTracing) android::base::beginTrace("glEGLImageTargetTexture2DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLeglImageOES var_image = Unpack<GLeglImageOES,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2432,11 +2443,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEGLImageTargetTexture2DOES(var_target, var_image);
             SET_LASTCALL("glEGLImageTargetTexture2DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEGLImageTargetRenderbufferStorageOES: {
-            android::base::beginTrace("glEGLImageTargetRenderbufferStorageOES decode");
+            if (useTracing) android::base::beginTrace("glEGLImageTargetRenderbufferStorageOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLeglImageOES var_image = Unpack<GLeglImageOES,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2445,11 +2456,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEGLImageTargetRenderbufferStorageOES(var_target, var_image);
             SET_LASTCALL("glEGLImageTargetRenderbufferStorageOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramBinaryOES: {
-            android::base::beginTrace("glGetProgramBinaryOES decode");
+            if (useTracing) android::base::beginTrace("glGetProgramBinaryOES decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2464,11 +2475,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetProgramBinaryOES_dec(this, var_program, var_bufSize, (GLsizei*)(inptr_length.get()), (GLenum*)(inptr_binaryFormat.get()), (GLvoid*)(inptr_binary.get()));
             SET_LASTCALL("glGetProgramBinaryOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramBinaryOES: {
-            android::base::beginTrace("glProgramBinaryOES decode");
+            if (useTracing) android::base::beginTrace("glProgramBinaryOES decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_binaryFormat = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_binary __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2480,11 +2491,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramBinaryOES_dec(this, var_program, var_binaryFormat, (const GLvoid*)(inptr_binary.get()), var_length);
             SET_LASTCALL("glProgramBinaryOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMapBufferOES: {
-            android::base::beginTrace("glMapBufferOES decode");
+            if (useTracing) android::base::beginTrace("glMapBufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_access = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2493,11 +2504,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMapBufferOES(var_target, var_access);
             SET_LASTCALL("glMapBufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBufferOES: {
-            android::base::beginTrace("glUnmapBufferOES decode");
+            if (useTracing) android::base::beginTrace("glUnmapBufferOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2512,11 +2523,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glUnmapBufferOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexImage3DOES: {
-            android::base::beginTrace("glTexImage3DOES decode");
+            if (useTracing) android::base::beginTrace("glTexImage3DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2534,11 +2545,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexImage3DOES(var_target, var_level, var_internalformat, var_width, var_height, var_depth, var_border, var_format, var_type, size_pixels == 0 ? nullptr : (const GLvoid*)(inptr_pixels.get()));
             SET_LASTCALL("glTexImage3DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexSubImage3DOES: {
-            android::base::beginTrace("glTexSubImage3DOES decode");
+            if (useTracing) android::base::beginTrace("glTexSubImage3DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2557,11 +2568,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexSubImage3DOES(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_type, size_pixels == 0 ? nullptr : (const GLvoid*)(inptr_pixels.get()));
             SET_LASTCALL("glTexSubImage3DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyTexSubImage3DOES: {
-            android::base::beginTrace("glCopyTexSubImage3DOES decode");
+            if (useTracing) android::base::beginTrace("glCopyTexSubImage3DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2577,11 +2588,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyTexSubImage3DOES(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_x, var_y, var_width, var_height);
             SET_LASTCALL("glCopyTexSubImage3DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexImage3DOES: {
-            android::base::beginTrace("glCompressedTexImage3DOES decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexImage3DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2598,11 +2609,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexImage3DOES(var_target, var_level, var_internalformat, var_width, var_height, var_depth, var_border, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexImage3DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexSubImage3DOES: {
-            android::base::beginTrace("glCompressedTexSubImage3DOES decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexSubImage3DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -2621,11 +2632,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexSubImage3DOES(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexSubImage3DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferTexture3DOES: {
-            android::base::beginTrace("glFramebufferTexture3DOES decode");
+            if (useTracing) android::base::beginTrace("glFramebufferTexture3DOES decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_textarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2638,11 +2649,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferTexture3DOES(var_target, var_attachment, var_textarget, var_texture, var_level, var_zoffset);
             SET_LASTCALL("glFramebufferTexture3DOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindVertexArrayOES: {
-            android::base::beginTrace("glBindVertexArrayOES decode");
+            if (useTracing) android::base::beginTrace("glBindVertexArrayOES decode");
             GLuint var_array = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2650,11 +2661,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindVertexArrayOES(var_array);
             SET_LASTCALL("glBindVertexArrayOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteVertexArraysOES: {
-            android::base::beginTrace("glDeleteVertexArraysOES decode");
+            if (useTracing) android::base::beginTrace("glDeleteVertexArraysOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_arrays __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_arrays(ptr + 8 + 4 + 4, size_arrays);
@@ -2664,11 +2675,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteVertexArraysOES_dec(this, var_n, (const GLuint*)(inptr_arrays.get()));
             SET_LASTCALL("glDeleteVertexArraysOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenVertexArraysOES: {
-            android::base::beginTrace("glGenVertexArraysOES decode");
+            if (useTracing) android::base::beginTrace("glGenVertexArraysOES decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_arrays __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -2686,11 +2697,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenVertexArraysOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsVertexArrayOES: {
-            android::base::beginTrace("glIsVertexArrayOES decode");
+            if (useTracing) android::base::beginTrace("glIsVertexArrayOES decode");
             GLuint var_array = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2705,11 +2716,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsVertexArrayOES");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDiscardFramebufferEXT: {
-            android::base::beginTrace("glDiscardFramebufferEXT decode");
+            if (useTracing) android::base::beginTrace("glDiscardFramebufferEXT decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_numAttachments = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_attachments __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -2720,11 +2731,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDiscardFramebufferEXT(var_target, var_numAttachments, (const GLenum*)(inptr_attachments.get()));
             SET_LASTCALL("glDiscardFramebufferEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiDrawArraysEXT: {
-            android::base::beginTrace("glMultiDrawArraysEXT decode");
+            if (useTracing) android::base::beginTrace("glMultiDrawArraysEXT decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_first __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_first(ptr + 8 + 4 + 4, size_first);
@@ -2737,11 +2748,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiDrawArraysEXT(var_mode, (const GLint*)(inptr_first.get()), (const GLsizei*)(inptr_count.get()), var_primcount);
             SET_LASTCALL("glMultiDrawArraysEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMultiDrawElementsEXT: {
-            android::base::beginTrace("glMultiDrawElementsEXT decode");
+            if (useTracing) android::base::beginTrace("glMultiDrawElementsEXT decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_count __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_count(ptr + 8 + 4 + 4, size_count);
@@ -2755,11 +2766,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMultiDrawElementsEXT(var_mode, (const GLsizei*)(inptr_count.get()), var_type, (const GLvoid* const*)(inptr_indices.get()), var_primcount);
             SET_LASTCALL("glMultiDrawElementsEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPerfMonitorGroupsAMD: {
-            android::base::beginTrace("glGetPerfMonitorGroupsAMD decode");
+            if (useTracing) android::base::beginTrace("glGetPerfMonitorGroupsAMD decode");
             uint32_t size_numGroups __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_numGroups(ptr + 8 + 4, size_numGroups);
             GLsizei var_groupsSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + size_numGroups);
@@ -2771,11 +2782,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetPerfMonitorGroupsAMD((GLint*)(inptr_numGroups.get()), var_groupsSize, (GLuint*)(inptr_groups.get()));
             SET_LASTCALL("glGetPerfMonitorGroupsAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPerfMonitorCountersAMD: {
-            android::base::beginTrace("glGetPerfMonitorCountersAMD decode");
+            if (useTracing) android::base::beginTrace("glGetPerfMonitorCountersAMD decode");
             GLuint var_group = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_numCounters __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_numCounters(ptr + 8 + 4 + 4, size_numCounters);
@@ -2790,46 +2801,46 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetPerfMonitorCountersAMD(var_group, (GLint*)(inptr_numCounters.get()), (GLint*)(inptr_maxActiveCounters.get()), var_counterSize, (GLuint*)(inptr_counters.get()));
             SET_LASTCALL("glGetPerfMonitorCountersAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPerfMonitorGroupStringAMD: {
-            android::base::beginTrace("glGetPerfMonitorGroupStringAMD decode");
+            if (useTracing) android::base::beginTrace("glGetPerfMonitorGroupStringAMD decode");
             GLuint var_group = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
             InputBuffer inptr_length(ptr + 8 + 4 + 4 + 4, size_length);
             uint32_t size_groupString __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_length);
-            InputBuffer inptr_groupString(ptr + 8 + 4 + 4 + 4 + size_length + 4, size_groupString);
+            ByteInputBuffer inptr_groupString(ptr + 8 + 4 + 4 + 4 + size_length + 4, size_groupString);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_length + 4 + size_groupString, ptr + 8 + 4 + 4 + 4 + size_length + 4 + size_groupString, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetPerfMonitorGroupStringAMD: GL checksumCalculator failure\n");
             }
             this->glGetPerfMonitorGroupStringAMD(var_group, var_bufSize, (GLsizei*)(inptr_length.get()), (GLchar*)(inptr_groupString.get()));
             SET_LASTCALL("glGetPerfMonitorGroupStringAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPerfMonitorCounterStringAMD: {
-            android::base::beginTrace("glGetPerfMonitorCounterStringAMD decode");
+            if (useTracing) android::base::beginTrace("glGetPerfMonitorCounterStringAMD decode");
             GLuint var_group = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_counter = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4);
             InputBuffer inptr_length(ptr + 8 + 4 + 4 + 4 + 4, size_length);
             uint32_t size_counterString __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + size_length);
-            InputBuffer inptr_counterString(ptr + 8 + 4 + 4 + 4 + 4 + size_length + 4, size_counterString);
+            ByteInputBuffer inptr_counterString(ptr + 8 + 4 + 4 + 4 + 4 + size_length + 4, size_counterString);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + size_length + 4 + size_counterString, ptr + 8 + 4 + 4 + 4 + 4 + size_length + 4 + size_counterString, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetPerfMonitorCounterStringAMD: GL checksumCalculator failure\n");
             }
             this->glGetPerfMonitorCounterStringAMD(var_group, var_counter, var_bufSize, (GLsizei*)(inptr_length.get()), (GLchar*)(inptr_counterString.get()));
             SET_LASTCALL("glGetPerfMonitorCounterStringAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPerfMonitorCounterInfoAMD: {
-            android::base::beginTrace("glGetPerfMonitorCounterInfoAMD decode");
+            if (useTracing) android::base::beginTrace("glGetPerfMonitorCounterInfoAMD decode");
             GLuint var_group = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_counter = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2841,11 +2852,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetPerfMonitorCounterInfoAMD(var_group, var_counter, var_pname, (GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glGetPerfMonitorCounterInfoAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenPerfMonitorsAMD: {
-            android::base::beginTrace("glGenPerfMonitorsAMD decode");
+            if (useTracing) android::base::beginTrace("glGenPerfMonitorsAMD decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_monitors __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_monitors(ptr + 8 + 4 + 4, size_monitors);
@@ -2855,11 +2866,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGenPerfMonitorsAMD(var_n, (GLuint*)(inptr_monitors.get()));
             SET_LASTCALL("glGenPerfMonitorsAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeletePerfMonitorsAMD: {
-            android::base::beginTrace("glDeletePerfMonitorsAMD decode");
+            if (useTracing) android::base::beginTrace("glDeletePerfMonitorsAMD decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_monitors __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_monitors(ptr + 8 + 4 + 4, size_monitors);
@@ -2869,11 +2880,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeletePerfMonitorsAMD(var_n, (GLuint*)(inptr_monitors.get()));
             SET_LASTCALL("glDeletePerfMonitorsAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSelectPerfMonitorCountersAMD: {
-            android::base::beginTrace("glSelectPerfMonitorCountersAMD decode");
+            if (useTracing) android::base::beginTrace("glSelectPerfMonitorCountersAMD decode");
             GLuint var_monitor = Unpack<GLuint,uint32_t>(ptr + 8);
             GLboolean var_enable = Unpack<GLboolean,uint8_t>(ptr + 8 + 4);
             GLuint var_group = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 1);
@@ -2886,11 +2897,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSelectPerfMonitorCountersAMD(var_monitor, var_enable, var_group, var_numCounters, (GLuint*)(inptr_countersList.get()));
             SET_LASTCALL("glSelectPerfMonitorCountersAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBeginPerfMonitorAMD: {
-            android::base::beginTrace("glBeginPerfMonitorAMD decode");
+            if (useTracing) android::base::beginTrace("glBeginPerfMonitorAMD decode");
             GLuint var_monitor = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2898,11 +2909,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBeginPerfMonitorAMD(var_monitor);
             SET_LASTCALL("glBeginPerfMonitorAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEndPerfMonitorAMD: {
-            android::base::beginTrace("glEndPerfMonitorAMD decode");
+            if (useTracing) android::base::beginTrace("glEndPerfMonitorAMD decode");
             GLuint var_monitor = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -2910,11 +2921,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEndPerfMonitorAMD(var_monitor);
             SET_LASTCALL("glEndPerfMonitorAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetPerfMonitorCounterDataAMD: {
-            android::base::beginTrace("glGetPerfMonitorCounterDataAMD decode");
+            if (useTracing) android::base::beginTrace("glGetPerfMonitorCounterDataAMD decode");
             GLuint var_monitor = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLsizei var_dataSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -2928,11 +2939,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetPerfMonitorCounterDataAMD(var_monitor, var_pname, var_dataSize, (GLuint*)(inptr_data.get()), (GLint*)(inptr_bytesWritten.get()));
             SET_LASTCALL("glGetPerfMonitorCounterDataAMD");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRenderbufferStorageMultisampleIMG: {
-            android::base::beginTrace("glRenderbufferStorageMultisampleIMG decode");
+            if (useTracing) android::base::beginTrace("glRenderbufferStorageMultisampleIMG decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_samples = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2944,11 +2955,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRenderbufferStorageMultisampleIMG(var_target, var_samples, var_internalformat, var_width, var_height);
             SET_LASTCALL("glRenderbufferStorageMultisampleIMG");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferTexture2DMultisampleIMG: {
-            android::base::beginTrace("glFramebufferTexture2DMultisampleIMG decode");
+            if (useTracing) android::base::beginTrace("glFramebufferTexture2DMultisampleIMG decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_textarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -2961,11 +2972,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferTexture2DMultisampleIMG(var_target, var_attachment, var_textarget, var_texture, var_level, var_samples);
             SET_LASTCALL("glFramebufferTexture2DMultisampleIMG");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteFencesNV: {
-            android::base::beginTrace("glDeleteFencesNV decode");
+            if (useTracing) android::base::beginTrace("glDeleteFencesNV decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_fences __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_fences(ptr + 8 + 4 + 4, size_fences);
@@ -2975,11 +2986,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteFencesNV(var_n, (const GLuint*)(inptr_fences.get()));
             SET_LASTCALL("glDeleteFencesNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenFencesNV: {
-            android::base::beginTrace("glGenFencesNV decode");
+            if (useTracing) android::base::beginTrace("glGenFencesNV decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_fences __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_fences(ptr + 8 + 4 + 4, size_fences);
@@ -2989,11 +3000,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGenFencesNV(var_n, (GLuint*)(inptr_fences.get()));
             SET_LASTCALL("glGenFencesNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsFenceNV: {
-            android::base::beginTrace("glIsFenceNV decode");
+            if (useTracing) android::base::beginTrace("glIsFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3008,11 +3019,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTestFenceNV: {
-            android::base::beginTrace("glTestFenceNV decode");
+            if (useTracing) android::base::beginTrace("glTestFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3027,11 +3038,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glTestFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFenceivNV: {
-            android::base::beginTrace("glGetFenceivNV decode");
+            if (useTracing) android::base::beginTrace("glGetFenceivNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3042,11 +3053,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetFenceivNV(var_fence, var_pname, (GLint*)(inptr_params.get()));
             SET_LASTCALL("glGetFenceivNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFinishFenceNV: {
-            android::base::beginTrace("glFinishFenceNV decode");
+            if (useTracing) android::base::beginTrace("glFinishFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3054,11 +3065,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFinishFenceNV(var_fence);
             SET_LASTCALL("glFinishFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSetFenceNV: {
-            android::base::beginTrace("glSetFenceNV decode");
+            if (useTracing) android::base::beginTrace("glSetFenceNV decode");
             GLuint var_fence = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_condition = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3067,11 +3078,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSetFenceNV(var_fence, var_condition);
             SET_LASTCALL("glSetFenceNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCoverageMaskNV: {
-            android::base::beginTrace("glCoverageMaskNV decode");
+            if (useTracing) android::base::beginTrace("glCoverageMaskNV decode");
             GLboolean var_mask = Unpack<GLboolean,uint8_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 1, ptr + 8 + 1, checksumSize, 
@@ -3079,11 +3090,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCoverageMaskNV(var_mask);
             SET_LASTCALL("glCoverageMaskNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCoverageOperationNV: {
-            android::base::beginTrace("glCoverageOperationNV decode");
+            if (useTracing) android::base::beginTrace("glCoverageOperationNV decode");
             GLenum var_operation = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3091,11 +3102,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCoverageOperationNV(var_operation);
             SET_LASTCALL("glCoverageOperationNV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetDriverControlsQCOM: {
-            android::base::beginTrace("glGetDriverControlsQCOM decode");
+            if (useTracing) android::base::beginTrace("glGetDriverControlsQCOM decode");
             uint32_t size_num __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_num(ptr + 8 + 4, size_num);
             GLsizei var_size = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + size_num);
@@ -3107,28 +3118,28 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetDriverControlsQCOM((GLint*)(inptr_num.get()), var_size, (GLuint*)(inptr_driverControls.get()));
             SET_LASTCALL("glGetDriverControlsQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetDriverControlStringQCOM: {
-            android::base::beginTrace("glGetDriverControlStringQCOM decode");
+            if (useTracing) android::base::beginTrace("glGetDriverControlStringQCOM decode");
             GLuint var_driverControl = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
             InputBuffer inptr_length(ptr + 8 + 4 + 4 + 4, size_length);
             uint32_t size_driverControlString __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_length);
-            InputBuffer inptr_driverControlString(ptr + 8 + 4 + 4 + 4 + size_length + 4, size_driverControlString);
+            ByteInputBuffer inptr_driverControlString(ptr + 8 + 4 + 4 + 4 + size_length + 4, size_driverControlString);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_length + 4 + size_driverControlString, ptr + 8 + 4 + 4 + 4 + size_length + 4 + size_driverControlString, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetDriverControlStringQCOM: GL checksumCalculator failure\n");
             }
             this->glGetDriverControlStringQCOM(var_driverControl, var_bufSize, (GLsizei*)(inptr_length.get()), (GLchar*)(inptr_driverControlString.get()));
             SET_LASTCALL("glGetDriverControlStringQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEnableDriverControlQCOM: {
-            android::base::beginTrace("glEnableDriverControlQCOM decode");
+            if (useTracing) android::base::beginTrace("glEnableDriverControlQCOM decode");
             GLuint var_driverControl = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3136,11 +3147,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEnableDriverControlQCOM(var_driverControl);
             SET_LASTCALL("glEnableDriverControlQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDisableDriverControlQCOM: {
-            android::base::beginTrace("glDisableDriverControlQCOM decode");
+            if (useTracing) android::base::beginTrace("glDisableDriverControlQCOM decode");
             GLuint var_driverControl = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3148,11 +3159,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDisableDriverControlQCOM(var_driverControl);
             SET_LASTCALL("glDisableDriverControlQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetTexturesQCOM: {
-            android::base::beginTrace("glExtGetTexturesQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetTexturesQCOM decode");
             uint32_t size_textures __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_textures(ptr + 8 + 4, size_textures);
             GLint var_maxTextures = Unpack<GLint,uint32_t>(ptr + 8 + 4 + size_textures);
@@ -3164,11 +3175,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetTexturesQCOM((GLuint*)(inptr_textures.get()), var_maxTextures, (GLint*)(inptr_numTextures.get()));
             SET_LASTCALL("glExtGetTexturesQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetBuffersQCOM: {
-            android::base::beginTrace("glExtGetBuffersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetBuffersQCOM decode");
             uint32_t size_buffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_buffers(ptr + 8 + 4, size_buffers);
             GLint var_maxBuffers = Unpack<GLint,uint32_t>(ptr + 8 + 4 + size_buffers);
@@ -3180,11 +3191,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetBuffersQCOM((GLuint*)(inptr_buffers.get()), var_maxBuffers, (GLint*)(inptr_numBuffers.get()));
             SET_LASTCALL("glExtGetBuffersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetRenderbuffersQCOM: {
-            android::base::beginTrace("glExtGetRenderbuffersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetRenderbuffersQCOM decode");
             uint32_t size_renderbuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_renderbuffers(ptr + 8 + 4, size_renderbuffers);
             GLint var_maxRenderbuffers = Unpack<GLint,uint32_t>(ptr + 8 + 4 + size_renderbuffers);
@@ -3196,11 +3207,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetRenderbuffersQCOM((GLuint*)(inptr_renderbuffers.get()), var_maxRenderbuffers, (GLint*)(inptr_numRenderbuffers.get()));
             SET_LASTCALL("glExtGetRenderbuffersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetFramebuffersQCOM: {
-            android::base::beginTrace("glExtGetFramebuffersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetFramebuffersQCOM decode");
             uint32_t size_framebuffers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_framebuffers(ptr + 8 + 4, size_framebuffers);
             GLint var_maxFramebuffers = Unpack<GLint,uint32_t>(ptr + 8 + 4 + size_framebuffers);
@@ -3212,11 +3223,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetFramebuffersQCOM((GLuint*)(inptr_framebuffers.get()), var_maxFramebuffers, (GLint*)(inptr_numFramebuffers.get()));
             SET_LASTCALL("glExtGetFramebuffersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetTexLevelParameterivQCOM: {
-            android::base::beginTrace("glExtGetTexLevelParameterivQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetTexLevelParameterivQCOM decode");
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_face = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3229,11 +3240,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetTexLevelParameterivQCOM(var_texture, var_face, var_level, var_pname, (GLint*)(inptr_params.get()));
             SET_LASTCALL("glExtGetTexLevelParameterivQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtTexObjectStateOverrideiQCOM: {
-            android::base::beginTrace("glExtTexObjectStateOverrideiQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtTexObjectStateOverrideiQCOM decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3243,11 +3254,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtTexObjectStateOverrideiQCOM(var_target, var_pname, var_param);
             SET_LASTCALL("glExtTexObjectStateOverrideiQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetTexSubImageQCOM: {
-            android::base::beginTrace("glExtGetTexSubImageQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetTexSubImageQCOM decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3266,11 +3277,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetTexSubImageQCOM(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_type, (GLvoid*)(inptr_texels.get()));
             SET_LASTCALL("glExtGetTexSubImageQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetBufferPointervQCOM: {
-            android::base::beginTrace("glExtGetBufferPointervQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetBufferPointervQCOM decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_params(ptr + 8 + 4 + 4, size_params);
@@ -3280,11 +3291,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetBufferPointervQCOM(var_target, (GLvoidptr*)(inptr_params.get()));
             SET_LASTCALL("glExtGetBufferPointervQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetShadersQCOM: {
-            android::base::beginTrace("glExtGetShadersQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetShadersQCOM decode");
             uint32_t size_shaders __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_shaders(ptr + 8 + 4, size_shaders);
             GLint var_maxShaders = Unpack<GLint,uint32_t>(ptr + 8 + 4 + size_shaders);
@@ -3296,11 +3307,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetShadersQCOM((GLuint*)(inptr_shaders.get()), var_maxShaders, (GLint*)(inptr_numShaders.get()));
             SET_LASTCALL("glExtGetShadersQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetProgramsQCOM: {
-            android::base::beginTrace("glExtGetProgramsQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetProgramsQCOM decode");
             uint32_t size_programs __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_programs(ptr + 8 + 4, size_programs);
             GLint var_maxPrograms = Unpack<GLint,uint32_t>(ptr + 8 + 4 + size_programs);
@@ -3312,11 +3323,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetProgramsQCOM((GLuint*)(inptr_programs.get()), var_maxPrograms, (GLint*)(inptr_numPrograms.get()));
             SET_LASTCALL("glExtGetProgramsQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtIsProgramBinaryQCOM: {
-            android::base::beginTrace("glExtIsProgramBinaryQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtIsProgramBinaryQCOM decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3331,15 +3342,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glExtIsProgramBinaryQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glExtGetProgramBinarySourceQCOM: {
-            android::base::beginTrace("glExtGetProgramBinarySourceQCOM decode");
+            if (useTracing) android::base::beginTrace("glExtGetProgramBinarySourceQCOM decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_shadertype = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_source __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_source(ptr + 8 + 4 + 4 + 4, size_source);
+            ByteInputBuffer inptr_source(ptr + 8 + 4 + 4 + 4, size_source);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_source);
             InputBuffer inptr_length(ptr + 8 + 4 + 4 + 4 + size_source + 4, size_length);
             if (useChecksum) {
@@ -3348,11 +3359,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glExtGetProgramBinarySourceQCOM(var_program, var_shadertype, (GLchar*)(inptr_source.get()), (GLint*)(inptr_length.get()));
             SET_LASTCALL("glExtGetProgramBinarySourceQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glStartTilingQCOM: {
-            android::base::beginTrace("glStartTilingQCOM decode");
+            if (useTracing) android::base::beginTrace("glStartTilingQCOM decode");
             GLuint var_x = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_y = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_width = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3364,11 +3375,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glStartTilingQCOM(var_x, var_y, var_width, var_height, var_preserveMask);
             SET_LASTCALL("glStartTilingQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEndTilingQCOM: {
-            android::base::beginTrace("glEndTilingQCOM decode");
+            if (useTracing) android::base::beginTrace("glEndTilingQCOM decode");
             GLbitfield var_preserveMask = Unpack<GLbitfield,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3376,11 +3387,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEndTilingQCOM(var_preserveMask);
             SET_LASTCALL("glEndTilingQCOM");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribPointerData: {
-            android::base::beginTrace("glVertexAttribPointerData decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribPointerData decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3395,11 +3406,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribPointerData(this, var_indx, var_size, var_type, var_normalized, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glVertexAttribPointerData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribPointerOffset: {
-            android::base::beginTrace("glVertexAttribPointerOffset decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribPointerOffset decode");
             GLuint var_indx = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3412,11 +3423,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribPointerOffset(this, var_indx, var_size, var_type, var_normalized, var_stride, var_offset);
             SET_LASTCALL("glVertexAttribPointerOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsOffset: {
-            android::base::beginTrace("glDrawElementsOffset decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsOffset decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3427,11 +3438,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsOffset(this, var_mode, var_count, var_type, var_offset);
             SET_LASTCALL("glDrawElementsOffset");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsData: {
-            android::base::beginTrace("glDrawElementsData decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsData decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3444,11 +3455,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsData(this, var_mode, var_count, var_type, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glDrawElementsData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetCompressedTextureFormats: {
-            android::base::beginTrace("glGetCompressedTextureFormats decode");
+            if (useTracing) android::base::beginTrace("glGetCompressedTextureFormats decode");
             int var_count = Unpack<int,uint32_t>(ptr + 8);
             uint32_t size_formats __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3466,14 +3477,14 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetCompressedTextureFormats");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glShaderString: {
-            android::base::beginTrace("glShaderString decode");
+            if (useTracing) android::base::beginTrace("glShaderString decode");
             GLuint var_shader = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_string __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
-            InputBuffer inptr_string(ptr + 8 + 4 + 4, size_string);
+            ByteInputBuffer inptr_string(ptr + 8 + 4 + 4, size_string);
             GLsizei var_len = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4 + size_string);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + size_string + 4, ptr + 8 + 4 + 4 + size_string + 4, checksumSize, 
@@ -3481,11 +3492,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glShaderString(this, var_shader, (const GLchar*)(inptr_string.get()), var_len);
             SET_LASTCALL("glShaderString");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFinishRoundTrip: {
-            android::base::beginTrace("glFinishRoundTrip decode");
+            if (useTracing) android::base::beginTrace("glFinishRoundTrip decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glFinishRoundTrip: GL checksumCalculator failure\n");
@@ -3499,11 +3510,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glFinishRoundTrip");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenVertexArrays: {
-            android::base::beginTrace("glGenVertexArrays decode");
+            if (useTracing) android::base::beginTrace("glGenVertexArrays decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_arrays __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -3521,11 +3532,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenVertexArrays");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindVertexArray: {
-            android::base::beginTrace("glBindVertexArray decode");
+            if (useTracing) android::base::beginTrace("glBindVertexArray decode");
             GLuint var_array = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3533,11 +3544,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindVertexArray(var_array);
             SET_LASTCALL("glBindVertexArray");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteVertexArrays: {
-            android::base::beginTrace("glDeleteVertexArrays decode");
+            if (useTracing) android::base::beginTrace("glDeleteVertexArrays decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_arrays __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_arrays(ptr + 8 + 4 + 4, size_arrays);
@@ -3547,11 +3558,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteVertexArrays_dec(this, var_n, (const GLuint*)(inptr_arrays.get()));
             SET_LASTCALL("glDeleteVertexArrays");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsVertexArray: {
-            android::base::beginTrace("glIsVertexArray decode");
+            if (useTracing) android::base::beginTrace("glIsVertexArray decode");
             GLuint var_array = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3566,11 +3577,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsVertexArray");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMapBufferRange: {
-            android::base::beginTrace("glMapBufferRange decode");
+            if (useTracing) android::base::beginTrace("glMapBufferRange decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -3581,11 +3592,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMapBufferRange(var_target, var_offset, var_length, var_access);
             SET_LASTCALL("glMapBufferRange");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBuffer: {
-            android::base::beginTrace("glUnmapBuffer decode");
+            if (useTracing) android::base::beginTrace("glUnmapBuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -3600,11 +3611,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glUnmapBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFlushMappedBufferRange: {
-            android::base::beginTrace("glFlushMappedBufferRange decode");
+            if (useTracing) android::base::beginTrace("glFlushMappedBufferRange decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -3614,11 +3625,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFlushMappedBufferRange(var_target, var_offset, var_length);
             SET_LASTCALL("glFlushMappedBufferRange");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMapBufferRangeAEMU: {
-            android::base::beginTrace("glMapBufferRangeAEMU decode");
+            if (useTracing) android::base::beginTrace("glMapBufferRangeAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -3639,11 +3650,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glMapBufferRangeAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBufferAEMU: {
-            android::base::beginTrace("glUnmapBufferAEMU decode");
+            if (useTracing) android::base::beginTrace("glUnmapBufferAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -3666,11 +3677,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glUnmapBufferAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFlushMappedBufferRangeAEMU: {
-            android::base::beginTrace("glFlushMappedBufferRangeAEMU decode");
+            if (useTracing) android::base::beginTrace("glFlushMappedBufferRangeAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -3683,11 +3694,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFlushMappedBufferRangeAEMU(this, var_target, var_offset, var_length, var_access, size_guest_buffer == 0 ? nullptr : (void*)(inptr_guest_buffer.get()));
             SET_LASTCALL("glFlushMappedBufferRangeAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReadPixelsOffsetAEMU: {
-            android::base::beginTrace("glReadPixelsOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glReadPixelsOffsetAEMU decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -3701,11 +3712,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glReadPixelsOffsetAEMU(this, var_x, var_y, var_width, var_height, var_format, var_type, var_offset);
             SET_LASTCALL("glReadPixelsOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexImage2DOffsetAEMU: {
-            android::base::beginTrace("glCompressedTexImage2DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexImage2DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -3720,11 +3731,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexImage2DOffsetAEMU(this, var_target, var_level, var_internalformat, var_width, var_height, var_border, var_imageSize, var_offset);
             SET_LASTCALL("glCompressedTexImage2DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexSubImage2DOffsetAEMU: {
-            android::base::beginTrace("glCompressedTexSubImage2DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexSubImage2DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3740,11 +3751,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexSubImage2DOffsetAEMU(this, var_target, var_level, var_xoffset, var_yoffset, var_width, var_height, var_format, var_imageSize, var_offset);
             SET_LASTCALL("glCompressedTexSubImage2DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexImage2DOffsetAEMU: {
-            android::base::beginTrace("glTexImage2DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glTexImage2DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_internalformat = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3760,11 +3771,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexImage2DOffsetAEMU(this, var_target, var_level, var_internalformat, var_width, var_height, var_border, var_format, var_type, var_offset);
             SET_LASTCALL("glTexImage2DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexSubImage2DOffsetAEMU: {
-            android::base::beginTrace("glTexSubImage2DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glTexSubImage2DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3780,11 +3791,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexSubImage2DOffsetAEMU(this, var_target, var_level, var_xoffset, var_yoffset, var_width, var_height, var_format, var_type, var_offset);
             SET_LASTCALL("glTexSubImage2DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindBufferRange: {
-            android::base::beginTrace("glBindBufferRange decode");
+            if (useTracing) android::base::beginTrace("glBindBufferRange decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3796,11 +3807,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindBufferRange(var_target, var_index, var_buffer, var_offset, var_size);
             SET_LASTCALL("glBindBufferRange");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindBufferBase: {
-            android::base::beginTrace("glBindBufferBase decode");
+            if (useTracing) android::base::beginTrace("glBindBufferBase decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3810,11 +3821,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindBufferBase(var_target, var_index, var_buffer);
             SET_LASTCALL("glBindBufferBase");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyBufferSubData: {
-            android::base::beginTrace("glCopyBufferSubData decode");
+            if (useTracing) android::base::beginTrace("glCopyBufferSubData decode");
             GLenum var_readtarget = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_writetarget = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLintptr var_readoffset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -3826,11 +3837,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyBufferSubData(var_readtarget, var_writetarget, var_readoffset, var_writeoffset, var_size);
             SET_LASTCALL("glCopyBufferSubData");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearBufferiv: {
-            android::base::beginTrace("glClearBufferiv decode");
+            if (useTracing) android::base::beginTrace("glClearBufferiv decode");
             GLenum var_buffer = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_drawBuffer = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3841,11 +3852,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearBufferiv(var_buffer, var_drawBuffer, (const GLint*)(inptr_value.get()));
             SET_LASTCALL("glClearBufferiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearBufferuiv: {
-            android::base::beginTrace("glClearBufferuiv decode");
+            if (useTracing) android::base::beginTrace("glClearBufferuiv decode");
             GLenum var_buffer = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_drawBuffer = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3856,11 +3867,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearBufferuiv(var_buffer, var_drawBuffer, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glClearBufferuiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearBufferfv: {
-            android::base::beginTrace("glClearBufferfv decode");
+            if (useTracing) android::base::beginTrace("glClearBufferfv decode");
             GLenum var_buffer = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_drawBuffer = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3871,11 +3882,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearBufferfv(var_buffer, var_drawBuffer, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glClearBufferfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClearBufferfi: {
-            android::base::beginTrace("glClearBufferfi decode");
+            if (useTracing) android::base::beginTrace("glClearBufferfi decode");
             GLenum var_buffer = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_drawBuffer = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLfloat var_depth = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -3886,11 +3897,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glClearBufferfi(var_buffer, var_drawBuffer, var_depth, var_stencil);
             SET_LASTCALL("glClearBufferfi");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBufferParameteri64v: {
-            android::base::beginTrace("glGetBufferParameteri64v decode");
+            if (useTracing) android::base::beginTrace("glGetBufferParameteri64v decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_value = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3901,11 +3912,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetBufferParameteri64v(var_target, var_value, (GLint64*)(inptr_data.get()));
             SET_LASTCALL("glGetBufferParameteri64v");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBufferPointerv: {
-            android::base::beginTrace("glGetBufferPointerv decode");
+            if (useTracing) android::base::beginTrace("glGetBufferPointerv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3916,11 +3927,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetBufferPointerv(var_target, var_pname, (GLvoid**)(inptr_params.get()));
             SET_LASTCALL("glGetBufferPointerv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformBlockBinding: {
-            android::base::beginTrace("glUniformBlockBinding decode");
+            if (useTracing) android::base::beginTrace("glUniformBlockBinding decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_uniformBlockIndex = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_uniformBlockBinding = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -3930,14 +3941,14 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformBlockBinding_dec(this, var_program, var_uniformBlockIndex, var_uniformBlockBinding);
             SET_LASTCALL("glUniformBlockBinding");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformBlockIndex: {
-            android::base::beginTrace("glGetUniformBlockIndex decode");
+            if (useTracing) android::base::beginTrace("glGetUniformBlockIndex decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_uniformBlockName __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
-            InputBuffer inptr_uniformBlockName(ptr + 8 + 4 + 4, size_uniformBlockName);
+            ByteInputBuffer inptr_uniformBlockName(ptr + 8 + 4 + 4, size_uniformBlockName);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + size_uniformBlockName, ptr + 8 + 4 + 4 + size_uniformBlockName, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetUniformBlockIndex: GL checksumCalculator failure\n");
@@ -3951,11 +3962,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetUniformBlockIndex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformIndices: {
-            android::base::beginTrace("glGetUniformIndices decode");
+            if (useTracing) android::base::beginTrace("glGetUniformIndices decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_uniformCount = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_uniformNames __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -3968,15 +3979,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetUniformIndices(var_program, var_uniformCount, (const GLchar**)(inptr_uniformNames.get()), (GLuint*)(inptr_uniformIndices.get()));
             SET_LASTCALL("glGetUniformIndices");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformIndicesAEMU: {
-            android::base::beginTrace("glGetUniformIndicesAEMU decode");
+            if (useTracing) android::base::beginTrace("glGetUniformIndicesAEMU decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_uniformCount = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_packedUniformNames __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_packedUniformNames(ptr + 8 + 4 + 4 + 4, size_packedUniformNames);
+            ByteInputBuffer inptr_packedUniformNames(ptr + 8 + 4 + 4 + 4, size_packedUniformNames);
             GLsizei var_packedLen = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_packedUniformNames);
             uint32_t size_uniformIndices __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_packedUniformNames + 4);
             if (useChecksum) {
@@ -3994,11 +4005,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetUniformIndicesAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetActiveUniformBlockiv: {
-            android::base::beginTrace("glGetActiveUniformBlockiv decode");
+            if (useTracing) android::base::beginTrace("glGetActiveUniformBlockiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_uniformBlockIndex = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4018,11 +4029,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetActiveUniformBlockiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetActiveUniformBlockName: {
-            android::base::beginTrace("glGetActiveUniformBlockName decode");
+            if (useTracing) android::base::beginTrace("glGetActiveUniformBlockName decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_uniformBlockIndex = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -4037,7 +4048,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_uniformBlockName(&tmpBuf[0 + size_length], size_uniformBlockName);
+            ByteOutputBuffer outptr_uniformBlockName(&tmpBuf[0 + size_length], size_uniformBlockName);
             this->glGetActiveUniformBlockName_dec(this, var_program, var_uniformBlockIndex, var_bufSize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), size_uniformBlockName == 0 ? nullptr : (GLchar*)(outptr_uniformBlockName.get()));
             outptr_length.flush();
             outptr_uniformBlockName.flush();
@@ -4046,11 +4057,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetActiveUniformBlockName");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform1ui: {
-            android::base::beginTrace("glUniform1ui decode");
+            if (useTracing) android::base::beginTrace("glUniform1ui decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLuint var_v0 = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -4059,11 +4070,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform1ui(var_location, var_v0);
             SET_LASTCALL("glUniform1ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform2ui: {
-            android::base::beginTrace("glUniform2ui decode");
+            if (useTracing) android::base::beginTrace("glUniform2ui decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLuint var_v0 = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_v1 = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4073,11 +4084,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform2ui(var_location, var_v0, var_v1);
             SET_LASTCALL("glUniform2ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform3ui: {
-            android::base::beginTrace("glUniform3ui decode");
+            if (useTracing) android::base::beginTrace("glUniform3ui decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLuint var_v0 = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_v1 = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4088,11 +4099,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform3ui(var_location, var_v0, var_v1, var_v2);
             SET_LASTCALL("glUniform3ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform4ui: {
-            android::base::beginTrace("glUniform4ui decode");
+            if (useTracing) android::base::beginTrace("glUniform4ui decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLuint var_v1 = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4104,11 +4115,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform4ui(var_location, var_v0, var_v1, var_v2, var_v3);
             SET_LASTCALL("glUniform4ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform1uiv: {
-            android::base::beginTrace("glUniform1uiv decode");
+            if (useTracing) android::base::beginTrace("glUniform1uiv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4119,11 +4130,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform1uiv(var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glUniform1uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform2uiv: {
-            android::base::beginTrace("glUniform2uiv decode");
+            if (useTracing) android::base::beginTrace("glUniform2uiv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4134,11 +4145,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform2uiv(var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glUniform2uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform3uiv: {
-            android::base::beginTrace("glUniform3uiv decode");
+            if (useTracing) android::base::beginTrace("glUniform3uiv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4149,11 +4160,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform3uiv(var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glUniform3uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniform4uiv: {
-            android::base::beginTrace("glUniform4uiv decode");
+            if (useTracing) android::base::beginTrace("glUniform4uiv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_value __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4164,11 +4175,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniform4uiv(var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glUniform4uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix2x3fv: {
-            android::base::beginTrace("glUniformMatrix2x3fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix2x3fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -4180,11 +4191,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix2x3fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix2x3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix3x2fv: {
-            android::base::beginTrace("glUniformMatrix3x2fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix3x2fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -4196,11 +4207,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix3x2fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix3x2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix2x4fv: {
-            android::base::beginTrace("glUniformMatrix2x4fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix2x4fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -4212,11 +4223,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix2x4fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix2x4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix4x2fv: {
-            android::base::beginTrace("glUniformMatrix4x2fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix4x2fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -4228,11 +4239,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix4x2fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix4x2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix3x4fv: {
-            android::base::beginTrace("glUniformMatrix3x4fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix3x4fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -4244,11 +4255,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix3x4fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix3x4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUniformMatrix4x3fv: {
-            android::base::beginTrace("glUniformMatrix4x3fv decode");
+            if (useTracing) android::base::beginTrace("glUniformMatrix4x3fv decode");
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLboolean var_transpose = Unpack<GLboolean,uint8_t>(ptr + 8 + 4 + 4);
@@ -4260,11 +4271,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUniformMatrix4x3fv(var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glUniformMatrix4x3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetUniformuiv: {
-            android::base::beginTrace("glGetUniformuiv decode");
+            if (useTracing) android::base::beginTrace("glGetUniformuiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4283,11 +4294,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetUniformuiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetActiveUniformsiv: {
-            android::base::beginTrace("glGetActiveUniformsiv decode");
+            if (useTracing) android::base::beginTrace("glGetActiveUniformsiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_uniformCount = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_uniformIndices __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4309,11 +4320,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetActiveUniformsiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribI4i: {
-            android::base::beginTrace("glVertexAttribI4i decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribI4i decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v1 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4325,11 +4336,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribI4i(var_index, var_v0, var_v1, var_v2, var_v3);
             SET_LASTCALL("glVertexAttribI4i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribI4ui: {
-            android::base::beginTrace("glVertexAttribI4ui decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribI4ui decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_v0 = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_v1 = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4341,11 +4352,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribI4ui(var_index, var_v0, var_v1, var_v2, var_v3);
             SET_LASTCALL("glVertexAttribI4ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribI4iv: {
-            android::base::beginTrace("glVertexAttribI4iv decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribI4iv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_v(ptr + 8 + 4 + 4, size_v);
@@ -4355,11 +4366,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribI4iv(var_index, (const GLint*)(inptr_v.get()));
             SET_LASTCALL("glVertexAttribI4iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribI4uiv: {
-            android::base::beginTrace("glVertexAttribI4uiv decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribI4uiv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_v __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_v(ptr + 8 + 4 + 4, size_v);
@@ -4369,11 +4380,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribI4uiv(var_index, (const GLuint*)(inptr_v.get()));
             SET_LASTCALL("glVertexAttribI4uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribIPointer: {
-            android::base::beginTrace("glVertexAttribIPointer decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribIPointer decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4386,11 +4397,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribIPointer(var_index, var_size, var_type, var_stride, (const GLvoid*)(inptr_pointer.get()));
             SET_LASTCALL("glVertexAttribIPointer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribIPointerOffsetAEMU: {
-            android::base::beginTrace("glVertexAttribIPointerOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribIPointerOffsetAEMU decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4402,11 +4413,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribIPointerOffsetAEMU(this, var_index, var_size, var_type, var_stride, var_offset);
             SET_LASTCALL("glVertexAttribIPointerOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribIPointerDataAEMU: {
-            android::base::beginTrace("glVertexAttribIPointerDataAEMU decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribIPointerDataAEMU decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4420,11 +4431,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribIPointerDataAEMU(this, var_index, var_size, var_type, var_stride, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glVertexAttribIPointerDataAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetVertexAttribIiv: {
-            android::base::beginTrace("glGetVertexAttribIiv decode");
+            if (useTracing) android::base::beginTrace("glGetVertexAttribIiv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4443,11 +4454,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetVertexAttribIiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetVertexAttribIuiv: {
-            android::base::beginTrace("glGetVertexAttribIuiv decode");
+            if (useTracing) android::base::beginTrace("glGetVertexAttribIuiv decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4466,11 +4477,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetVertexAttribIuiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribDivisor: {
-            android::base::beginTrace("glVertexAttribDivisor decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribDivisor decode");
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_divisor = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -4479,11 +4490,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribDivisor(var_index, var_divisor);
             SET_LASTCALL("glVertexAttribDivisor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArraysInstanced: {
-            android::base::beginTrace("glDrawArraysInstanced decode");
+            if (useTracing) android::base::beginTrace("glDrawArraysInstanced decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_first = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -4494,11 +4505,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArraysInstanced(var_mode, var_first, var_count, var_primcount);
             SET_LASTCALL("glDrawArraysInstanced");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsInstanced: {
-            android::base::beginTrace("glDrawElementsInstanced decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsInstanced decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4511,11 +4522,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsInstanced(var_mode, var_count, var_type, (const void*)(inptr_indices.get()), var_primcount);
             SET_LASTCALL("glDrawElementsInstanced");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsInstancedDataAEMU: {
-            android::base::beginTrace("glDrawElementsInstancedDataAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsInstancedDataAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4529,11 +4540,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsInstancedDataAEMU(this, var_mode, var_count, var_type, (const void*)(inptr_indices.get()), var_primcount, var_datalen);
             SET_LASTCALL("glDrawElementsInstancedDataAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsInstancedOffsetAEMU: {
-            android::base::beginTrace("glDrawElementsInstancedOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsInstancedOffsetAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4545,11 +4556,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsInstancedOffsetAEMU(this, var_mode, var_count, var_type, var_offset, var_primcount);
             SET_LASTCALL("glDrawElementsInstancedOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawRangeElements: {
-            android::base::beginTrace("glDrawRangeElements decode");
+            if (useTracing) android::base::beginTrace("glDrawRangeElements decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_start = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_end = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4563,11 +4574,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawRangeElements(var_mode, var_start, var_end, var_count, var_type, (const GLvoid*)(inptr_indices.get()));
             SET_LASTCALL("glDrawRangeElements");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawRangeElementsDataAEMU: {
-            android::base::beginTrace("glDrawRangeElementsDataAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawRangeElementsDataAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_start = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_end = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4582,11 +4593,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawRangeElementsDataAEMU(this, var_mode, var_start, var_end, var_count, var_type, (const GLvoid*)(inptr_indices.get()), var_datalen);
             SET_LASTCALL("glDrawRangeElementsDataAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawRangeElementsOffsetAEMU: {
-            android::base::beginTrace("glDrawRangeElementsOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawRangeElementsOffsetAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_start = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_end = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4599,11 +4610,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawRangeElementsOffsetAEMU(this, var_mode, var_start, var_end, var_count, var_type, var_offset);
             SET_LASTCALL("glDrawRangeElementsOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFenceSync: {
-            android::base::beginTrace("glFenceSync decode");
+            if (useTracing) android::base::beginTrace("glFenceSync decode");
             GLenum var_condition = Unpack<GLenum,uint32_t>(ptr + 8);
             GLbitfield var_flags = Unpack<GLbitfield,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -4619,11 +4630,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glFenceSync");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClientWaitSync: {
-            android::base::beginTrace("glClientWaitSync decode");
+            if (useTracing) android::base::beginTrace("glClientWaitSync decode");
             GLsync var_wait_on = Unpack<GLsync,uint64_t>(ptr + 8);
             GLbitfield var_flags = Unpack<GLbitfield,uint32_t>(ptr + 8 + 8);
             GLuint64 var_timeout = Unpack<GLuint64,uint64_t>(ptr + 8 + 8 + 4);
@@ -4640,11 +4651,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glClientWaitSync");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glWaitSync: {
-            android::base::beginTrace("glWaitSync decode");
+            if (useTracing) android::base::beginTrace("glWaitSync decode");
             GLsync var_wait_on = Unpack<GLsync,uint64_t>(ptr + 8);
             GLbitfield var_flags = Unpack<GLbitfield,uint32_t>(ptr + 8 + 8);
             GLuint64 var_timeout = Unpack<GLuint64,uint64_t>(ptr + 8 + 8 + 4);
@@ -4654,11 +4665,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glWaitSync(var_wait_on, var_flags, var_timeout);
             SET_LASTCALL("glWaitSync");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteSync: {
-            android::base::beginTrace("glDeleteSync decode");
+            if (useTracing) android::base::beginTrace("glDeleteSync decode");
             GLsync var_to_delete = Unpack<GLsync,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -4666,11 +4677,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteSync(var_to_delete);
             SET_LASTCALL("glDeleteSync");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsSync: {
-            android::base::beginTrace("glIsSync decode");
+            if (useTracing) android::base::beginTrace("glIsSync decode");
             GLsync var_sync = Unpack<GLsync,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -4685,11 +4696,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsSync");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetSynciv: {
-            android::base::beginTrace("glGetSynciv decode");
+            if (useTracing) android::base::beginTrace("glGetSynciv decode");
             GLsync var_sync = Unpack<GLsync,uint64_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 8 + 4);
@@ -4703,11 +4714,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetSynciv(var_sync, var_pname, var_bufSize, (GLsizei*)(inptr_length.get()), (GLint*)(inptr_values.get()));
             SET_LASTCALL("glGetSynciv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFenceSyncAEMU: {
-            android::base::beginTrace("glFenceSyncAEMU decode");
+            if (useTracing) android::base::beginTrace("glFenceSyncAEMU decode");
             GLenum var_condition = Unpack<GLenum,uint32_t>(ptr + 8);
             GLbitfield var_flags = Unpack<GLbitfield,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -4723,11 +4734,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glFenceSyncAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glClientWaitSyncAEMU: {
-            android::base::beginTrace("glClientWaitSyncAEMU decode");
+            if (useTracing) android::base::beginTrace("glClientWaitSyncAEMU decode");
             uint64_t var_wait_on = Unpack<uint64_t,uint64_t>(ptr + 8);
             GLbitfield var_flags = Unpack<GLbitfield,uint32_t>(ptr + 8 + 8);
             GLuint64 var_timeout = Unpack<GLuint64,uint64_t>(ptr + 8 + 8 + 4);
@@ -4744,11 +4755,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glClientWaitSyncAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glWaitSyncAEMU: {
-            android::base::beginTrace("glWaitSyncAEMU decode");
+            if (useTracing) android::base::beginTrace("glWaitSyncAEMU decode");
             uint64_t var_wait_on = Unpack<uint64_t,uint64_t>(ptr + 8);
             GLbitfield var_flags = Unpack<GLbitfield,uint32_t>(ptr + 8 + 8);
             GLuint64 var_timeout = Unpack<GLuint64,uint64_t>(ptr + 8 + 8 + 4);
@@ -4758,11 +4769,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glWaitSyncAEMU(this, var_wait_on, var_flags, var_timeout);
             SET_LASTCALL("glWaitSyncAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteSyncAEMU: {
-            android::base::beginTrace("glDeleteSyncAEMU decode");
+            if (useTracing) android::base::beginTrace("glDeleteSyncAEMU decode");
             uint64_t var_to_delete = Unpack<uint64_t,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -4770,11 +4781,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteSyncAEMU(this, var_to_delete);
             SET_LASTCALL("glDeleteSyncAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsSyncAEMU: {
-            android::base::beginTrace("glIsSyncAEMU decode");
+            if (useTracing) android::base::beginTrace("glIsSyncAEMU decode");
             uint64_t var_sync = Unpack<uint64_t,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -4789,11 +4800,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsSyncAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetSyncivAEMU: {
-            android::base::beginTrace("glGetSyncivAEMU decode");
+            if (useTracing) android::base::beginTrace("glGetSyncivAEMU decode");
             uint64_t var_sync = Unpack<uint64_t,uint64_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 8 + 4);
@@ -4817,11 +4828,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetSyncivAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawBuffers: {
-            android::base::beginTrace("glDrawBuffers decode");
+            if (useTracing) android::base::beginTrace("glDrawBuffers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_bufs __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_bufs(ptr + 8 + 4 + 4, size_bufs);
@@ -4831,11 +4842,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawBuffers(var_n, (const GLenum*)(inptr_bufs.get()));
             SET_LASTCALL("glDrawBuffers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReadBuffer: {
-            android::base::beginTrace("glReadBuffer decode");
+            if (useTracing) android::base::beginTrace("glReadBuffer decode");
             GLenum var_src = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4843,11 +4854,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glReadBuffer(var_src);
             SET_LASTCALL("glReadBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBlitFramebuffer: {
-            android::base::beginTrace("glBlitFramebuffer decode");
+            if (useTracing) android::base::beginTrace("glBlitFramebuffer decode");
             GLint var_srcX0 = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_srcY0 = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_srcX1 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4864,11 +4875,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBlitFramebuffer(var_srcX0, var_srcY0, var_srcX1, var_srcY1, var_dstX0, var_dstY0, var_dstX1, var_dstY1, var_mask, var_filter);
             SET_LASTCALL("glBlitFramebuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glInvalidateFramebuffer: {
-            android::base::beginTrace("glInvalidateFramebuffer decode");
+            if (useTracing) android::base::beginTrace("glInvalidateFramebuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_numAttachments = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_attachments __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4879,11 +4890,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glInvalidateFramebuffer(var_target, var_numAttachments, (const GLenum*)(inptr_attachments.get()));
             SET_LASTCALL("glInvalidateFramebuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glInvalidateSubFramebuffer: {
-            android::base::beginTrace("glInvalidateSubFramebuffer decode");
+            if (useTracing) android::base::beginTrace("glInvalidateSubFramebuffer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_numAttachments = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_attachments __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -4898,11 +4909,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glInvalidateSubFramebuffer(var_target, var_numAttachments, (const GLenum*)(inptr_attachments.get()), var_x, var_y, var_width, var_height);
             SET_LASTCALL("glInvalidateSubFramebuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferTextureLayer: {
-            android::base::beginTrace("glFramebufferTextureLayer decode");
+            if (useTracing) android::base::beginTrace("glFramebufferTextureLayer decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_attachment = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -4914,11 +4925,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferTextureLayer(var_target, var_attachment, var_texture, var_level, var_layer);
             SET_LASTCALL("glFramebufferTextureLayer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glRenderbufferStorageMultisample: {
-            android::base::beginTrace("glRenderbufferStorageMultisample decode");
+            if (useTracing) android::base::beginTrace("glRenderbufferStorageMultisample decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_samples = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4930,11 +4941,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glRenderbufferStorageMultisample(var_target, var_samples, var_internalformat, var_width, var_height);
             SET_LASTCALL("glRenderbufferStorageMultisample");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexStorage2D: {
-            android::base::beginTrace("glTexStorage2D decode");
+            if (useTracing) android::base::beginTrace("glTexStorage2D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_levels = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4946,11 +4957,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexStorage2D(var_target, var_levels, var_internalformat, var_width, var_height);
             SET_LASTCALL("glTexStorage2D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetInternalformativ: {
-            android::base::beginTrace("glGetInternalformativ decode");
+            if (useTracing) android::base::beginTrace("glGetInternalformativ decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -4971,11 +4982,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetInternalformativ");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBeginTransformFeedback: {
-            android::base::beginTrace("glBeginTransformFeedback decode");
+            if (useTracing) android::base::beginTrace("glBeginTransformFeedback decode");
             GLenum var_primitiveMode = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -4983,22 +4994,22 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBeginTransformFeedback(var_primitiveMode);
             SET_LASTCALL("glBeginTransformFeedback");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEndTransformFeedback: {
-            android::base::beginTrace("glEndTransformFeedback decode");
+            if (useTracing) android::base::beginTrace("glEndTransformFeedback decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glEndTransformFeedback: GL checksumCalculator failure\n");
             }
             this->glEndTransformFeedback();
             SET_LASTCALL("glEndTransformFeedback");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenTransformFeedbacks: {
-            android::base::beginTrace("glGenTransformFeedbacks decode");
+            if (useTracing) android::base::beginTrace("glGenTransformFeedbacks decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_ids __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5016,11 +5027,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenTransformFeedbacks");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteTransformFeedbacks: {
-            android::base::beginTrace("glDeleteTransformFeedbacks decode");
+            if (useTracing) android::base::beginTrace("glDeleteTransformFeedbacks decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_ids __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_ids(ptr + 8 + 4 + 4, size_ids);
@@ -5030,11 +5041,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteTransformFeedbacks_dec(this, var_n, (const GLuint*)(inptr_ids.get()));
             SET_LASTCALL("glDeleteTransformFeedbacks");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindTransformFeedback: {
-            android::base::beginTrace("glBindTransformFeedback decode");
+            if (useTracing) android::base::beginTrace("glBindTransformFeedback decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_id = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5043,33 +5054,33 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindTransformFeedback(var_target, var_id);
             SET_LASTCALL("glBindTransformFeedback");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glPauseTransformFeedback: {
-            android::base::beginTrace("glPauseTransformFeedback decode");
+            if (useTracing) android::base::beginTrace("glPauseTransformFeedback decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glPauseTransformFeedback: GL checksumCalculator failure\n");
             }
             this->glPauseTransformFeedback();
             SET_LASTCALL("glPauseTransformFeedback");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glResumeTransformFeedback: {
-            android::base::beginTrace("glResumeTransformFeedback decode");
+            if (useTracing) android::base::beginTrace("glResumeTransformFeedback decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glResumeTransformFeedback: GL checksumCalculator failure\n");
             }
             this->glResumeTransformFeedback();
             SET_LASTCALL("glResumeTransformFeedback");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsTransformFeedback: {
-            android::base::beginTrace("glIsTransformFeedback decode");
+            if (useTracing) android::base::beginTrace("glIsTransformFeedback decode");
             GLuint var_id = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5084,11 +5095,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsTransformFeedback");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTransformFeedbackVaryings: {
-            android::base::beginTrace("glTransformFeedbackVaryings decode");
+            if (useTracing) android::base::beginTrace("glTransformFeedbackVaryings decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_varyings __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5100,15 +5111,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTransformFeedbackVaryings_dec(this, var_program, var_count, (const char**)(inptr_varyings.get()), var_bufferMode);
             SET_LASTCALL("glTransformFeedbackVaryings");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTransformFeedbackVaryingsAEMU: {
-            android::base::beginTrace("glTransformFeedbackVaryingsAEMU decode");
+            if (useTracing) android::base::beginTrace("glTransformFeedbackVaryingsAEMU decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_packedVaryings __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_packedVaryings(ptr + 8 + 4 + 4 + 4, size_packedVaryings);
+            ByteInputBuffer inptr_packedVaryings(ptr + 8 + 4 + 4 + 4, size_packedVaryings);
             GLuint var_packedVaryingsLen = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_packedVaryings);
             GLenum var_bufferMode = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_packedVaryings + 4);
             if (useChecksum) {
@@ -5117,11 +5128,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTransformFeedbackVaryingsAEMU(this, var_program, var_count, (const char*)(inptr_packedVaryings.get()), var_packedVaryingsLen, var_bufferMode);
             SET_LASTCALL("glTransformFeedbackVaryingsAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTransformFeedbackVarying: {
-            android::base::beginTrace("glGetTransformFeedbackVarying decode");
+            if (useTracing) android::base::beginTrace("glGetTransformFeedbackVarying decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -5142,7 +5153,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
             OutputBuffer outptr_size(&tmpBuf[0 + size_length], size_size);
             OutputBuffer outptr_type(&tmpBuf[0 + size_length + size_size], size_type);
-            OutputBuffer outptr_name(&tmpBuf[0 + size_length + size_size + size_type], size_name);
+            ByteOutputBuffer outptr_name(&tmpBuf[0 + size_length + size_size + size_type], size_name);
             this->glGetTransformFeedbackVarying_dec(this, var_program, var_index, var_bufSize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), (GLsizei*)(outptr_size.get()), size_type == 0 ? nullptr : (GLenum*)(outptr_type.get()), size_name == 0 ? nullptr : (char*)(outptr_name.get()));
             outptr_length.flush();
             outptr_size.flush();
@@ -5153,11 +5164,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTransformFeedbackVarying");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenSamplers: {
-            android::base::beginTrace("glGenSamplers decode");
+            if (useTracing) android::base::beginTrace("glGenSamplers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_samplers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5175,11 +5186,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenSamplers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteSamplers: {
-            android::base::beginTrace("glDeleteSamplers decode");
+            if (useTracing) android::base::beginTrace("glDeleteSamplers decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_samplers __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_samplers(ptr + 8 + 4 + 4, size_samplers);
@@ -5189,11 +5200,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteSamplers_dec(this, var_n, (const GLuint*)(inptr_samplers.get()));
             SET_LASTCALL("glDeleteSamplers");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindSampler: {
-            android::base::beginTrace("glBindSampler decode");
+            if (useTracing) android::base::beginTrace("glBindSampler decode");
             GLuint var_unit = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5202,11 +5213,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindSampler(var_unit, var_sampler);
             SET_LASTCALL("glBindSampler");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSamplerParameterf: {
-            android::base::beginTrace("glSamplerParameterf decode");
+            if (useTracing) android::base::beginTrace("glSamplerParameterf decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLfloat var_param = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -5216,11 +5227,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSamplerParameterf(var_sampler, var_pname, var_param);
             SET_LASTCALL("glSamplerParameterf");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSamplerParameteri: {
-            android::base::beginTrace("glSamplerParameteri decode");
+            if (useTracing) android::base::beginTrace("glSamplerParameteri decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5230,11 +5241,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSamplerParameteri(var_sampler, var_pname, var_param);
             SET_LASTCALL("glSamplerParameteri");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSamplerParameterfv: {
-            android::base::beginTrace("glSamplerParameterfv decode");
+            if (useTracing) android::base::beginTrace("glSamplerParameterfv decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5245,11 +5256,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSamplerParameterfv(var_sampler, var_pname, (const GLfloat*)(inptr_params.get()));
             SET_LASTCALL("glSamplerParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSamplerParameteriv: {
-            android::base::beginTrace("glSamplerParameteriv decode");
+            if (useTracing) android::base::beginTrace("glSamplerParameteriv decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5260,11 +5271,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSamplerParameteriv(var_sampler, var_pname, (const GLint*)(inptr_params.get()));
             SET_LASTCALL("glSamplerParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetSamplerParameterfv: {
-            android::base::beginTrace("glGetSamplerParameterfv decode");
+            if (useTracing) android::base::beginTrace("glGetSamplerParameterfv decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5283,11 +5294,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetSamplerParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetSamplerParameteriv: {
-            android::base::beginTrace("glGetSamplerParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetSamplerParameteriv decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5306,11 +5317,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetSamplerParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsSampler: {
-            android::base::beginTrace("glIsSampler decode");
+            if (useTracing) android::base::beginTrace("glIsSampler decode");
             GLuint var_sampler = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5325,11 +5336,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsSampler");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenQueries: {
-            android::base::beginTrace("glGenQueries decode");
+            if (useTracing) android::base::beginTrace("glGenQueries decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_queries __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5347,11 +5358,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenQueries");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteQueries: {
-            android::base::beginTrace("glDeleteQueries decode");
+            if (useTracing) android::base::beginTrace("glDeleteQueries decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_queries __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_queries(ptr + 8 + 4 + 4, size_queries);
@@ -5361,11 +5372,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteQueries_dec(this, var_n, (const GLuint*)(inptr_queries.get()));
             SET_LASTCALL("glDeleteQueries");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBeginQuery: {
-            android::base::beginTrace("glBeginQuery decode");
+            if (useTracing) android::base::beginTrace("glBeginQuery decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_query = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5374,11 +5385,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBeginQuery(var_target, var_query);
             SET_LASTCALL("glBeginQuery");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glEndQuery: {
-            android::base::beginTrace("glEndQuery decode");
+            if (useTracing) android::base::beginTrace("glEndQuery decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5386,11 +5397,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glEndQuery(var_target);
             SET_LASTCALL("glEndQuery");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetQueryiv: {
-            android::base::beginTrace("glGetQueryiv decode");
+            if (useTracing) android::base::beginTrace("glGetQueryiv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5409,11 +5420,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetQueryiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetQueryObjectuiv: {
-            android::base::beginTrace("glGetQueryObjectuiv decode");
+            if (useTracing) android::base::beginTrace("glGetQueryObjectuiv decode");
             GLuint var_query = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5432,11 +5443,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetQueryObjectuiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsQuery: {
-            android::base::beginTrace("glIsQuery decode");
+            if (useTracing) android::base::beginTrace("glIsQuery decode");
             GLuint var_query = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5451,11 +5462,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsQuery");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramParameteri: {
-            android::base::beginTrace("glProgramParameteri decode");
+            if (useTracing) android::base::beginTrace("glProgramParameteri decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_value = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5465,11 +5476,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramParameteri_dec(this, var_program, var_pname, var_value);
             SET_LASTCALL("glProgramParameteri");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramBinary: {
-            android::base::beginTrace("glProgramBinary decode");
+            if (useTracing) android::base::beginTrace("glProgramBinary decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_binaryFormat = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_binary __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5481,11 +5492,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramBinary_dec(this, var_program, var_binaryFormat, (const void*)(inptr_binary.get()), var_length);
             SET_LASTCALL("glProgramBinary");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramBinary: {
-            android::base::beginTrace("glGetProgramBinary decode");
+            if (useTracing) android::base::beginTrace("glGetProgramBinary decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5512,14 +5523,14 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramBinary");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFragDataLocation: {
-            android::base::beginTrace("glGetFragDataLocation decode");
+            if (useTracing) android::base::beginTrace("glGetFragDataLocation decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             uint32_t size_name __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
-            InputBuffer inptr_name(ptr + 8 + 4 + 4, size_name);
+            ByteInputBuffer inptr_name(ptr + 8 + 4 + 4, size_name);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + size_name, ptr + 8 + 4 + 4 + size_name, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetFragDataLocation: GL checksumCalculator failure\n");
@@ -5533,11 +5544,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFragDataLocation");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetInteger64v: {
-            android::base::beginTrace("glGetInteger64v decode");
+            if (useTracing) android::base::beginTrace("glGetInteger64v decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5555,11 +5566,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetInteger64v");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetIntegeri_v: {
-            android::base::beginTrace("glGetIntegeri_v decode");
+            if (useTracing) android::base::beginTrace("glGetIntegeri_v decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5578,11 +5589,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetIntegeri_v");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetInteger64i_v: {
-            android::base::beginTrace("glGetInteger64i_v decode");
+            if (useTracing) android::base::beginTrace("glGetInteger64i_v decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5601,11 +5612,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetInteger64i_v");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexImage3D: {
-            android::base::beginTrace("glTexImage3D decode");
+            if (useTracing) android::base::beginTrace("glTexImage3D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_internalFormat = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5616,18 +5627,18 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_data);
+            ByteInputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_data);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_data, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_data, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glTexImage3D: GL checksumCalculator failure\n");
             }
             this->glTexImage3D(var_target, var_level, var_internalFormat, var_width, var_height, var_depth, var_border, var_format, var_type, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glTexImage3D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexImage3DOffsetAEMU: {
-            android::base::beginTrace("glTexImage3DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glTexImage3DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_internalFormat = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5644,11 +5655,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexImage3DOffsetAEMU(this, var_target, var_level, var_internalFormat, var_width, var_height, var_depth, var_border, var_format, var_type, var_offset);
             SET_LASTCALL("glTexImage3DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexStorage3D: {
-            android::base::beginTrace("glTexStorage3D decode");
+            if (useTracing) android::base::beginTrace("glTexStorage3D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_levels = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -5661,11 +5672,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexStorage3D(var_target, var_levels, var_internalformat, var_width, var_height, var_depth);
             SET_LASTCALL("glTexStorage3D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexSubImage3D: {
-            android::base::beginTrace("glTexSubImage3D decode");
+            if (useTracing) android::base::beginTrace("glTexSubImage3D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5677,18 +5688,18 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_data);
+            ByteInputBuffer inptr_data(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_data);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_data, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_data, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glTexSubImage3D: GL checksumCalculator failure\n");
             }
             this->glTexSubImage3D(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_type, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glTexSubImage3D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexSubImage3DOffsetAEMU: {
-            android::base::beginTrace("glTexSubImage3DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glTexSubImage3DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5706,11 +5717,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexSubImage3DOffsetAEMU(this, var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_type, var_offset);
             SET_LASTCALL("glTexSubImage3DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexImage3D: {
-            android::base::beginTrace("glCompressedTexImage3D decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexImage3D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -5727,11 +5738,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexImage3D(var_target, var_level, var_internalformat, var_width, var_height, var_depth, var_border, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexImage3D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexImage3DOffsetAEMU: {
-            android::base::beginTrace("glCompressedTexImage3DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexImage3DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -5747,11 +5758,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexImage3DOffsetAEMU(this, var_target, var_level, var_internalformat, var_width, var_height, var_depth, var_border, var_imageSize, var_offset);
             SET_LASTCALL("glCompressedTexImage3DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexSubImage3D: {
-            android::base::beginTrace("glCompressedTexSubImage3D decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexSubImage3D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5770,11 +5781,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexSubImage3D(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_imageSize, size_data == 0 ? nullptr : (const GLvoid*)(inptr_data.get()));
             SET_LASTCALL("glCompressedTexSubImage3D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCompressedTexSubImage3DOffsetAEMU: {
-            android::base::beginTrace("glCompressedTexSubImage3DOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glCompressedTexSubImage3DOffsetAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5792,11 +5803,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCompressedTexSubImage3DOffsetAEMU(this, var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_width, var_height, var_depth, var_format, var_imageSize, var_data);
             SET_LASTCALL("glCompressedTexSubImage3DOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCopyTexSubImage3D: {
-            android::base::beginTrace("glCopyTexSubImage3D decode");
+            if (useTracing) android::base::beginTrace("glCopyTexSubImage3D decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_xoffset = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -5812,11 +5823,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glCopyTexSubImage3D(var_target, var_level, var_xoffset, var_yoffset, var_zoffset, var_x, var_y, var_width, var_height);
             SET_LASTCALL("glCopyTexSubImage3D");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetStringi: {
-            android::base::beginTrace("glGetStringi decode");
+            if (useTracing) android::base::beginTrace("glGetStringi decode");
             GLenum var_name = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5825,11 +5836,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glGetStringi(var_name, var_index);
             SET_LASTCALL("glGetStringi");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetBooleani_v: {
-            android::base::beginTrace("glGetBooleani_v decode");
+            if (useTracing) android::base::beginTrace("glGetBooleani_v decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             uint32_t size_data __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5848,11 +5859,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetBooleani_v");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMemoryBarrier: {
-            android::base::beginTrace("glMemoryBarrier decode");
+            if (useTracing) android::base::beginTrace("glMemoryBarrier decode");
             GLbitfield var_barriers = Unpack<GLbitfield,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5860,11 +5871,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMemoryBarrier(var_barriers);
             SET_LASTCALL("glMemoryBarrier");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMemoryBarrierByRegion: {
-            android::base::beginTrace("glMemoryBarrierByRegion decode");
+            if (useTracing) android::base::beginTrace("glMemoryBarrierByRegion decode");
             GLbitfield var_barriers = Unpack<GLbitfield,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5872,11 +5883,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMemoryBarrierByRegion(var_barriers);
             SET_LASTCALL("glMemoryBarrierByRegion");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGenProgramPipelines: {
-            android::base::beginTrace("glGenProgramPipelines decode");
+            if (useTracing) android::base::beginTrace("glGenProgramPipelines decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_pipelines __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -5894,11 +5905,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGenProgramPipelines");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDeleteProgramPipelines: {
-            android::base::beginTrace("glDeleteProgramPipelines decode");
+            if (useTracing) android::base::beginTrace("glDeleteProgramPipelines decode");
             GLsizei var_n = Unpack<GLsizei,uint32_t>(ptr + 8);
             uint32_t size_pipelines __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_pipelines(ptr + 8 + 4 + 4, size_pipelines);
@@ -5908,11 +5919,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDeleteProgramPipelines_dec(this, var_n, (const GLuint*)(inptr_pipelines.get()));
             SET_LASTCALL("glDeleteProgramPipelines");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindProgramPipeline: {
-            android::base::beginTrace("glBindProgramPipeline decode");
+            if (useTracing) android::base::beginTrace("glBindProgramPipeline decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5920,11 +5931,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindProgramPipeline(var_pipeline);
             SET_LASTCALL("glBindProgramPipeline");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramPipelineiv: {
-            android::base::beginTrace("glGetProgramPipelineiv decode");
+            if (useTracing) android::base::beginTrace("glGetProgramPipelineiv decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5943,11 +5954,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramPipelineiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramPipelineInfoLog: {
-            android::base::beginTrace("glGetProgramPipelineInfoLog decode");
+            if (useTracing) android::base::beginTrace("glGetProgramPipelineInfoLog decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_length __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -5961,7 +5972,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_infoLog(&tmpBuf[0 + size_length], size_infoLog);
+            ByteOutputBuffer outptr_infoLog(&tmpBuf[0 + size_length], size_infoLog);
             this->glGetProgramPipelineInfoLog(var_pipeline, var_bufSize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), (GLchar*)(outptr_infoLog.get()));
             outptr_length.flush();
             outptr_infoLog.flush();
@@ -5970,11 +5981,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramPipelineInfoLog");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glValidateProgramPipeline: {
-            android::base::beginTrace("glValidateProgramPipeline decode");
+            if (useTracing) android::base::beginTrace("glValidateProgramPipeline decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -5982,11 +5993,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glValidateProgramPipeline(var_pipeline);
             SET_LASTCALL("glValidateProgramPipeline");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glIsProgramPipeline: {
-            android::base::beginTrace("glIsProgramPipeline decode");
+            if (useTracing) android::base::beginTrace("glIsProgramPipeline decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -6001,11 +6012,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glIsProgramPipeline");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUseProgramStages: {
-            android::base::beginTrace("glUseProgramStages decode");
+            if (useTracing) android::base::beginTrace("glUseProgramStages decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             GLbitfield var_stages = Unpack<GLbitfield,uint32_t>(ptr + 8 + 4);
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6015,11 +6026,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUseProgramStages_dec(this, var_pipeline, var_stages, var_program);
             SET_LASTCALL("glUseProgramStages");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glActiveShaderProgram: {
-            android::base::beginTrace("glActiveShaderProgram decode");
+            if (useTracing) android::base::beginTrace("glActiveShaderProgram decode");
             GLuint var_pipeline = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -6028,11 +6039,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glActiveShaderProgram_dec(this, var_pipeline, var_program);
             SET_LASTCALL("glActiveShaderProgram");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCreateShaderProgramv: {
-            android::base::beginTrace("glCreateShaderProgramv decode");
+            if (useTracing) android::base::beginTrace("glCreateShaderProgramv decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_strings __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -6050,15 +6061,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glCreateShaderProgramv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glCreateShaderProgramvAEMU: {
-            android::base::beginTrace("glCreateShaderProgramvAEMU decode");
+            if (useTracing) android::base::beginTrace("glCreateShaderProgramvAEMU decode");
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             uint32_t size_packedStrings __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_packedStrings(ptr + 8 + 4 + 4 + 4, size_packedStrings);
+            ByteInputBuffer inptr_packedStrings(ptr + 8 + 4 + 4 + 4, size_packedStrings);
             GLuint var_packedLen = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4 + 4 + size_packedStrings);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_packedStrings + 4, ptr + 8 + 4 + 4 + 4 + size_packedStrings + 4, checksumSize, 
@@ -6073,11 +6084,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glCreateShaderProgramvAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform1f: {
-            android::base::beginTrace("glProgramUniform1f decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform1f decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLfloat var_v0 = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -6087,11 +6098,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform1f_dec(this, var_program, var_location, var_v0);
             SET_LASTCALL("glProgramUniform1f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform2f: {
-            android::base::beginTrace("glProgramUniform2f decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform2f decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLfloat var_v0 = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -6102,11 +6113,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform2f_dec(this, var_program, var_location, var_v0, var_v1);
             SET_LASTCALL("glProgramUniform2f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform3f: {
-            android::base::beginTrace("glProgramUniform3f decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform3f decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLfloat var_v0 = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -6118,11 +6129,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform3f_dec(this, var_program, var_location, var_v0, var_v1, var_v2);
             SET_LASTCALL("glProgramUniform3f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform4f: {
-            android::base::beginTrace("glProgramUniform4f decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform4f decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLfloat var_v0 = Unpack<GLfloat,uint32_t>(ptr + 8 + 4 + 4);
@@ -6135,11 +6146,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform4f_dec(this, var_program, var_location, var_v0, var_v1, var_v2, var_v3);
             SET_LASTCALL("glProgramUniform4f");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform1i: {
-            android::base::beginTrace("glProgramUniform1i decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform1i decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6149,11 +6160,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform1i_dec(this, var_program, var_location, var_v0);
             SET_LASTCALL("glProgramUniform1i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform2i: {
-            android::base::beginTrace("glProgramUniform2i decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform2i decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6164,11 +6175,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform2i_dec(this, var_program, var_location, var_v0, var_v1);
             SET_LASTCALL("glProgramUniform2i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform3i: {
-            android::base::beginTrace("glProgramUniform3i decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform3i decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6180,11 +6191,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform3i_dec(this, var_program, var_location, var_v0, var_v1, var_v2);
             SET_LASTCALL("glProgramUniform3i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform4i: {
-            android::base::beginTrace("glProgramUniform4i decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform4i decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6197,11 +6208,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform4i_dec(this, var_program, var_location, var_v0, var_v1, var_v2, var_v3);
             SET_LASTCALL("glProgramUniform4i");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform1ui: {
-            android::base::beginTrace("glProgramUniform1ui decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform1ui decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLuint var_v0 = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6211,11 +6222,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform1ui_dec(this, var_program, var_location, var_v0);
             SET_LASTCALL("glProgramUniform1ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform2ui: {
-            android::base::beginTrace("glProgramUniform2ui decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform2ui decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6226,11 +6237,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform2ui_dec(this, var_program, var_location, var_v0, var_v1);
             SET_LASTCALL("glProgramUniform2ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform3ui: {
-            android::base::beginTrace("glProgramUniform3ui decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform3ui decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6242,11 +6253,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform3ui_dec(this, var_program, var_location, var_v0, var_v1, var_v2);
             SET_LASTCALL("glProgramUniform3ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform4ui: {
-            android::base::beginTrace("glProgramUniform4ui decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform4ui decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_v0 = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6259,11 +6270,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform4ui_dec(this, var_program, var_location, var_v0, var_v1, var_v2, var_v3);
             SET_LASTCALL("glProgramUniform4ui");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform1fv: {
-            android::base::beginTrace("glProgramUniform1fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform1fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6275,11 +6286,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform1fv_dec(this, var_program, var_location, var_count, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform1fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform2fv: {
-            android::base::beginTrace("glProgramUniform2fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform2fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6291,11 +6302,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform2fv_dec(this, var_program, var_location, var_count, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform3fv: {
-            android::base::beginTrace("glProgramUniform3fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform3fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6307,11 +6318,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform3fv_dec(this, var_program, var_location, var_count, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform4fv: {
-            android::base::beginTrace("glProgramUniform4fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform4fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6323,11 +6334,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform4fv_dec(this, var_program, var_location, var_count, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform1iv: {
-            android::base::beginTrace("glProgramUniform1iv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform1iv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6339,11 +6350,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform1iv_dec(this, var_program, var_location, var_count, (const GLint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform1iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform2iv: {
-            android::base::beginTrace("glProgramUniform2iv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform2iv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6355,11 +6366,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform2iv_dec(this, var_program, var_location, var_count, (const GLint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform2iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform3iv: {
-            android::base::beginTrace("glProgramUniform3iv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform3iv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6371,11 +6382,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform3iv_dec(this, var_program, var_location, var_count, (const GLint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform3iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform4iv: {
-            android::base::beginTrace("glProgramUniform4iv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform4iv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6387,11 +6398,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform4iv_dec(this, var_program, var_location, var_count, (const GLint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform4iv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform1uiv: {
-            android::base::beginTrace("glProgramUniform1uiv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform1uiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6403,11 +6414,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform1uiv_dec(this, var_program, var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform1uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform2uiv: {
-            android::base::beginTrace("glProgramUniform2uiv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform2uiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6419,11 +6430,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform2uiv_dec(this, var_program, var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform2uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform3uiv: {
-            android::base::beginTrace("glProgramUniform3uiv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform3uiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6435,11 +6446,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform3uiv_dec(this, var_program, var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform3uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniform4uiv: {
-            android::base::beginTrace("glProgramUniform4uiv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniform4uiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6451,11 +6462,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniform4uiv_dec(this, var_program, var_location, var_count, (const GLuint*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniform4uiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix2fv: {
-            android::base::beginTrace("glProgramUniformMatrix2fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix2fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6468,11 +6479,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix2fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix3fv: {
-            android::base::beginTrace("glProgramUniformMatrix3fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix3fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6485,11 +6496,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix3fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix4fv: {
-            android::base::beginTrace("glProgramUniformMatrix4fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix4fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6502,11 +6513,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix4fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix2x3fv: {
-            android::base::beginTrace("glProgramUniformMatrix2x3fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix2x3fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6519,11 +6530,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix2x3fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix2x3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix3x2fv: {
-            android::base::beginTrace("glProgramUniformMatrix3x2fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix3x2fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6536,11 +6547,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix3x2fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix3x2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix2x4fv: {
-            android::base::beginTrace("glProgramUniformMatrix2x4fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix2x4fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6553,11 +6564,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix2x4fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix2x4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix4x2fv: {
-            android::base::beginTrace("glProgramUniformMatrix4x2fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix4x2fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6570,11 +6581,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix4x2fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix4x2fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix3x4fv: {
-            android::base::beginTrace("glProgramUniformMatrix3x4fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix3x4fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6587,11 +6598,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix3x4fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix3x4fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glProgramUniformMatrix4x3fv: {
-            android::base::beginTrace("glProgramUniformMatrix4x3fv decode");
+            if (useTracing) android::base::beginTrace("glProgramUniformMatrix4x3fv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -6604,11 +6615,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glProgramUniformMatrix4x3fv_dec(this, var_program, var_location, var_count, var_transpose, (const GLfloat*)(inptr_value.get()));
             SET_LASTCALL("glProgramUniformMatrix4x3fv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramInterfaceiv: {
-            android::base::beginTrace("glGetProgramInterfaceiv decode");
+            if (useTracing) android::base::beginTrace("glGetProgramInterfaceiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_programInterface = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -6628,11 +6639,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramInterfaceiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramResourceiv: {
-            android::base::beginTrace("glGetProgramResourceiv decode");
+            if (useTracing) android::base::beginTrace("glGetProgramResourceiv decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_programInterface = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6660,15 +6671,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramResourceiv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramResourceIndex: {
-            android::base::beginTrace("glGetProgramResourceIndex decode");
+            if (useTracing) android::base::beginTrace("glGetProgramResourceIndex decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_programInterface = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_name __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_name(ptr + 8 + 4 + 4 + 4, size_name);
+            ByteInputBuffer inptr_name(ptr + 8 + 4 + 4 + 4, size_name);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_name, ptr + 8 + 4 + 4 + 4 + size_name, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetProgramResourceIndex: GL checksumCalculator failure\n");
@@ -6682,15 +6693,15 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramResourceIndex");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramResourceLocation: {
-            android::base::beginTrace("glGetProgramResourceLocation decode");
+            if (useTracing) android::base::beginTrace("glGetProgramResourceLocation decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_programInterface = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_name __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
-            InputBuffer inptr_name(ptr + 8 + 4 + 4 + 4, size_name);
+            ByteInputBuffer inptr_name(ptr + 8 + 4 + 4 + 4, size_name);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + size_name, ptr + 8 + 4 + 4 + 4 + size_name, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetProgramResourceLocation: GL checksumCalculator failure\n");
@@ -6704,11 +6715,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramResourceLocation");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetProgramResourceName: {
-            android::base::beginTrace("glGetProgramResourceName decode");
+            if (useTracing) android::base::beginTrace("glGetProgramResourceName decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLenum var_programInterface = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6724,7 +6735,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             totalTmpSize += checksumSize;
             unsigned char *tmpBuf = stream->alloc(totalTmpSize);
             OutputBuffer outptr_length(&tmpBuf[0], size_length);
-            OutputBuffer outptr_name(&tmpBuf[0 + size_length], size_name);
+            ByteOutputBuffer outptr_name(&tmpBuf[0 + size_length], size_name);
             this->glGetProgramResourceName_dec(this, var_program, var_programInterface, var_index, var_bufSize, size_length == 0 ? nullptr : (GLsizei*)(outptr_length.get()), (char*)(outptr_name.get()));
             outptr_length.flush();
             outptr_name.flush();
@@ -6733,11 +6744,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetProgramResourceName");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindImageTexture: {
-            android::base::beginTrace("glBindImageTexture decode");
+            if (useTracing) android::base::beginTrace("glBindImageTexture decode");
             GLuint var_unit = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_texture = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6751,11 +6762,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindImageTexture(var_unit, var_texture, var_level, var_layered, var_layer, var_access, var_format);
             SET_LASTCALL("glBindImageTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDispatchCompute: {
-            android::base::beginTrace("glDispatchCompute decode");
+            if (useTracing) android::base::beginTrace("glDispatchCompute decode");
             GLuint var_num_groups_x = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_num_groups_y = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLuint var_num_groups_z = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6765,11 +6776,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDispatchCompute(var_num_groups_x, var_num_groups_y, var_num_groups_z);
             SET_LASTCALL("glDispatchCompute");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDispatchComputeIndirect: {
-            android::base::beginTrace("glDispatchComputeIndirect decode");
+            if (useTracing) android::base::beginTrace("glDispatchComputeIndirect decode");
             GLintptr var_indirect = Unpack<GLintptr,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -6777,11 +6788,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDispatchComputeIndirect(var_indirect);
             SET_LASTCALL("glDispatchComputeIndirect");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glBindVertexBuffer: {
-            android::base::beginTrace("glBindVertexBuffer decode");
+            if (useTracing) android::base::beginTrace("glBindVertexBuffer decode");
             GLuint var_bindingindex = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -6792,11 +6803,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glBindVertexBuffer(var_bindingindex, var_buffer, var_offset, var_stride);
             SET_LASTCALL("glBindVertexBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribBinding: {
-            android::base::beginTrace("glVertexAttribBinding decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribBinding decode");
             GLuint var_attribindex = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_bindingindex = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -6805,11 +6816,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribBinding(var_attribindex, var_bindingindex);
             SET_LASTCALL("glVertexAttribBinding");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribFormat: {
-            android::base::beginTrace("glVertexAttribFormat decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribFormat decode");
             GLuint var_attribindex = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -6821,11 +6832,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribFormat(var_attribindex, var_size, var_type, var_normalized, var_relativeoffset);
             SET_LASTCALL("glVertexAttribFormat");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexAttribIFormat: {
-            android::base::beginTrace("glVertexAttribIFormat decode");
+            if (useTracing) android::base::beginTrace("glVertexAttribIFormat decode");
             GLuint var_attribindex = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_size = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -6836,11 +6847,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexAttribIFormat(var_attribindex, var_size, var_type, var_relativeoffset);
             SET_LASTCALL("glVertexAttribIFormat");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glVertexBindingDivisor: {
-            android::base::beginTrace("glVertexBindingDivisor decode");
+            if (useTracing) android::base::beginTrace("glVertexBindingDivisor decode");
             GLuint var_bindingindex = Unpack<GLuint,uint32_t>(ptr + 8);
             GLuint var_divisor = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -6849,11 +6860,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glVertexBindingDivisor(var_bindingindex, var_divisor);
             SET_LASTCALL("glVertexBindingDivisor");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArraysIndirect: {
-            android::base::beginTrace("glDrawArraysIndirect decode");
+            if (useTracing) android::base::beginTrace("glDrawArraysIndirect decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_indirect __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_indirect(ptr + 8 + 4 + 4, size_indirect);
@@ -6863,11 +6874,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArraysIndirect(var_mode, (const void*)(inptr_indirect.get()));
             SET_LASTCALL("glDrawArraysIndirect");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArraysIndirectDataAEMU: {
-            android::base::beginTrace("glDrawArraysIndirectDataAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawArraysIndirectDataAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             uint32_t size_indirect __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_indirect(ptr + 8 + 4 + 4, size_indirect);
@@ -6878,11 +6889,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArraysIndirectDataAEMU(this, var_mode, (const void*)(inptr_indirect.get()), var_datalen);
             SET_LASTCALL("glDrawArraysIndirectDataAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArraysIndirectOffsetAEMU: {
-            android::base::beginTrace("glDrawArraysIndirectOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawArraysIndirectOffsetAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_offset = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -6891,11 +6902,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArraysIndirectOffsetAEMU(this, var_mode, var_offset);
             SET_LASTCALL("glDrawArraysIndirectOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsIndirect: {
-            android::base::beginTrace("glDrawElementsIndirect decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsIndirect decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_indirect __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -6906,11 +6917,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsIndirect(var_mode, var_type, (const void*)(inptr_indirect.get()));
             SET_LASTCALL("glDrawElementsIndirect");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsIndirectDataAEMU: {
-            android::base::beginTrace("glDrawElementsIndirectDataAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsIndirectDataAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_indirect __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -6922,11 +6933,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsIndirectDataAEMU(this, var_mode, var_type, (const void*)(inptr_indirect.get()), var_datalen);
             SET_LASTCALL("glDrawElementsIndirectDataAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsIndirectOffsetAEMU: {
-            android::base::beginTrace("glDrawElementsIndirectOffsetAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsIndirectOffsetAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLuint var_offset = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -6936,11 +6947,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsIndirectOffsetAEMU(this, var_mode, var_type, var_offset);
             SET_LASTCALL("glDrawElementsIndirectOffsetAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glTexStorage2DMultisample: {
-            android::base::beginTrace("glTexStorage2DMultisample decode");
+            if (useTracing) android::base::beginTrace("glTexStorage2DMultisample decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_samples = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_internalformat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -6953,11 +6964,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glTexStorage2DMultisample(var_target, var_samples, var_internalformat, var_width, var_height, var_fixedsamplelocations);
             SET_LASTCALL("glTexStorage2DMultisample");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glSampleMaski: {
-            android::base::beginTrace("glSampleMaski decode");
+            if (useTracing) android::base::beginTrace("glSampleMaski decode");
             GLuint var_maskNumber = Unpack<GLuint,uint32_t>(ptr + 8);
             GLbitfield var_mask = Unpack<GLbitfield,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -6966,11 +6977,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glSampleMaski(var_maskNumber, var_mask);
             SET_LASTCALL("glSampleMaski");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetMultisamplefv: {
-            android::base::beginTrace("glGetMultisamplefv decode");
+            if (useTracing) android::base::beginTrace("glGetMultisamplefv decode");
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8);
             GLuint var_index = Unpack<GLuint,uint32_t>(ptr + 8 + 4);
             uint32_t size_val __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -6989,11 +7000,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetMultisamplefv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFramebufferParameteri: {
-            android::base::beginTrace("glFramebufferParameteri decode");
+            if (useTracing) android::base::beginTrace("glFramebufferParameteri decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             GLint var_param = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -7003,11 +7014,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFramebufferParameteri(var_target, var_pname, var_param);
             SET_LASTCALL("glFramebufferParameteri");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetFramebufferParameteriv: {
-            android::base::beginTrace("glGetFramebufferParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetFramebufferParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4);
             uint32_t size_params __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -7026,11 +7037,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetFramebufferParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexLevelParameterfv: {
-            android::base::beginTrace("glGetTexLevelParameterfv decode");
+            if (useTracing) android::base::beginTrace("glGetTexLevelParameterfv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -7050,11 +7061,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexLevelParameterfv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetTexLevelParameteriv: {
-            android::base::beginTrace("glGetTexLevelParameteriv decode");
+            if (useTracing) android::base::beginTrace("glGetTexLevelParameteriv decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_level = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLenum var_pname = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -7074,11 +7085,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetTexLevelParameteriv");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMapBufferRangeDMA: {
-            android::base::beginTrace("glMapBufferRangeDMA decode");
+            if (useTracing) android::base::beginTrace("glMapBufferRangeDMA decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7090,11 +7101,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glMapBufferRangeDMA(this, var_target, var_offset, var_length, var_access, var_paddr);
             SET_LASTCALL("glMapBufferRangeDMA");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBufferDMA: {
-            android::base::beginTrace("glUnmapBufferDMA decode");
+            if (useTracing) android::base::beginTrace("glUnmapBufferDMA decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7116,11 +7127,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glUnmapBufferDMA");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glMapBufferRangeDirect: {
-            android::base::beginTrace("glMapBufferRangeDirect decode");
+            if (useTracing) android::base::beginTrace("glMapBufferRangeDirect decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7139,11 +7150,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glMapBufferRangeDirect");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBufferDirect: {
-            android::base::beginTrace("glUnmapBufferDirect decode");
+            if (useTracing) android::base::beginTrace("glUnmapBufferDirect decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7166,11 +7177,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glUnmapBufferDirect");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFlushMappedBufferRangeDirect: {
-            android::base::beginTrace("glFlushMappedBufferRangeDirect decode");
+            if (useTracing) android::base::beginTrace("glFlushMappedBufferRangeDirect decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7181,11 +7192,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFlushMappedBufferRangeDirect(this, var_target, var_offset, var_length, var_access);
             SET_LASTCALL("glFlushMappedBufferRangeDirect");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetGraphicsResetStatusEXT: {
-            android::base::beginTrace("glGetGraphicsResetStatusEXT decode");
+            if (useTracing) android::base::beginTrace("glGetGraphicsResetStatusEXT decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "gles2_decoder_context_t::decode, OP_glGetGraphicsResetStatusEXT: GL checksumCalculator failure\n");
@@ -7199,11 +7210,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetGraphicsResetStatusEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glReadnPixelsEXT: {
-            android::base::beginTrace("glReadnPixelsEXT decode");
+            if (useTracing) android::base::beginTrace("glReadnPixelsEXT decode");
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_width = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -7227,11 +7238,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glReadnPixelsEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetnUniformfvEXT: {
-            android::base::beginTrace("glGetnUniformfvEXT decode");
+            if (useTracing) android::base::beginTrace("glGetnUniformfvEXT decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -7251,11 +7262,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetnUniformfvEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glGetnUniformivEXT: {
-            android::base::beginTrace("glGetnUniformivEXT decode");
+            if (useTracing) android::base::beginTrace("glGetnUniformivEXT decode");
             GLuint var_program = Unpack<GLuint,uint32_t>(ptr + 8);
             GLint var_location = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_bufSize = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -7275,11 +7286,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             stream->flush();
             SET_LASTCALL("glGetnUniformivEXT");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawArraysNullAEMU: {
-            android::base::beginTrace("glDrawArraysNullAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawArraysNullAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLint var_first = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4 + 4);
@@ -7289,11 +7300,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawArraysNullAEMU(var_mode, var_first, var_count);
             SET_LASTCALL("glDrawArraysNullAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsNullAEMU: {
-            android::base::beginTrace("glDrawElementsNullAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsNullAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -7305,11 +7316,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsNullAEMU(var_mode, var_count, var_type, (const GLvoid*)(inptr_indices.get()));
             SET_LASTCALL("glDrawElementsNullAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsOffsetNullAEMU: {
-            android::base::beginTrace("glDrawElementsOffsetNullAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsOffsetNullAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -7320,11 +7331,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsOffsetNullAEMU(this, var_mode, var_count, var_type, var_offset);
             SET_LASTCALL("glDrawElementsOffsetNullAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glDrawElementsDataNullAEMU: {
-            android::base::beginTrace("glDrawElementsDataNullAEMU decode");
+            if (useTracing) android::base::beginTrace("glDrawElementsDataNullAEMU decode");
             GLenum var_mode = Unpack<GLenum,uint32_t>(ptr + 8);
             GLsizei var_count = Unpack<GLsizei,uint32_t>(ptr + 8 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -7337,11 +7348,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glDrawElementsDataNullAEMU(this, var_mode, var_count, var_type, (void*)(inptr_data.get()), var_datalen);
             SET_LASTCALL("glDrawElementsDataNullAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glUnmapBufferAsyncAEMU: {
-            android::base::beginTrace("glUnmapBufferAsyncAEMU decode");
+            if (useTracing) android::base::beginTrace("glUnmapBufferAsyncAEMU decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7356,11 +7367,11 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glUnmapBufferAEMU(this, var_target, var_offset, var_length, var_access, size_guest_buffer == 0 ? nullptr : (void*)(inptr_guest_buffer.get()), (GLboolean*)(inptr_out_res.get()));
             SET_LASTCALL("glUnmapBufferAsyncAEMU");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_glFlushMappedBufferRangeAEMU2: {
-            android::base::beginTrace("glFlushMappedBufferRangeAEMU2 decode");
+            if (useTracing) android::base::beginTrace("glFlushMappedBufferRangeAEMU2 decode");
             GLenum var_target = Unpack<GLenum,uint32_t>(ptr + 8);
             GLintptr var_offset = Unpack<GLintptr,uint32_t>(ptr + 8 + 4);
             GLsizeiptr var_length = Unpack<GLsizeiptr,uint32_t>(ptr + 8 + 4 + 4);
@@ -7373,7 +7384,7 @@ int gles2_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Che
             }
             this->glFlushMappedBufferRangeAEMU(this, var_target, var_offset, var_length, var_access, size_guest_buffer == 0 ? nullptr : (void*)(inptr_guest_buffer.get()));
             SET_LASTCALL("glFlushMappedBufferRangeAEMU2");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         default:
@@ -15,6 +15,11 @@ struct gles2_decoder_context_t : public gles2_server_context_t {
 
     int decode(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);
 
+private:
+    // decode() for a given checksum and tracing mode.
+    template <bool useChecksum, bool useTracing>
+    int decodeImpl(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);
+
 };
 
 #endif  // GUARD_gles2_decoder_context_t
@@ -700,6 +700,11 @@ void EglDisplay::onLoadAllImages(android::base::Stream* stream,
         eglImg->imageId = hndl;
         eglImg->saveableTexture =
                 m_globalNameSpace.getSaveableTextureFromLoad(globalName);
+        if (eglImg->saveableTexture) {
+            // ColorBuffers are EglImages; the first frame posts some of them.
+            eglImg->saveableTexture->raiseRestorePriority(
+                    SaveableTexture::RestorePriority::EglImage);
+        }
         eglImg->needRestore = true;
         return std::make_pair(hndl, std::move(eglImg));
     });
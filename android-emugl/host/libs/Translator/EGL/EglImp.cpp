@@ -121,6 +121,8 @@ EGLAPI void EGLAPIENTRY eglWaitImageFenceANDROID(EGLDisplay display, void* fence
 EGLAPI void EGLAPIENTRY eglAddLibrarySearchPathANDROID(const char* path);
 EGLAPI EGLBoolean EGLAPIENTRY eglQueryVulkanInteropSupportANDROID(void);
 EGLAPI EGLBoolean EGLAPIENTRY eglGetSyncAttribKHR(EGLDisplay display, EGLSyncKHR sync, EGLint attribute, EGLint *value);
+EGLAPI EGLBoolean EGLAPIENTRY eglSwapBuffersWithDamageKHR(EGLDisplay display, EGLSurface surface, EGLint *rects, EGLint n_rects);
+EGLAPI EGLBoolean EGLAPIENTRY eglSetDamageRegionKHR(EGLDisplay display, EGLSurface surface, EGLint *rects, EGLint n_rects);
 
 EGLAPI EGLBoolean EGLAPIENTRY eglSaveConfig(EGLDisplay display, EGLConfig config, EGLStream stream);
 EGLAPI EGLConfig EGLAPIENTRY eglLoadConfig(EGLDisplay display, EGLStream stream);
@@ -174,6 +176,10 @@ static const ExtensionDescriptor s_eglExtensions[] = {
                 (__eglMustCastToProperFunctionPointerType)eglQueryVulkanInteropSupportANDROID },
         {"eglGetSyncAttribKHR",
                 (__eglMustCastToProperFunctionPointerType)eglGetSyncAttribKHR },
+        {"eglSwapBuffersWithDamageKHR",
+                (__eglMustCastToProperFunctionPointerType)eglSwapBuffersWithDamageKHR },
+        {"eglSetDamageRegionKHR",
+                (__eglMustCastToProperFunctionPointerType)eglSetDamageRegionKHR },
 };
 
 static const int s_eglExtensionsSize =
@@ -857,6 +863,16 @@ EGLAPI EGLBoolean EGLAPIENTRY eglQuerySurface(EGLDisplay display, EGLSurface sur
    VALIDATE_DISPLAY(display);
    VALIDATE_SURFACE(surface,srfc);
 
+   if (attribute == EGL_BUFFER_AGE_EXT) {
+       if (!value) {
+           RETURN_ERROR(EGL_FALSE,EGL_BAD_PARAMETER);
+       }
+       *value = srfc->type() == EglSurface::WINDOW
+                        ? dpy->nativeType()->queryBufferAge(srfc->native())
+                        : 0;
+       return EGL_TRUE;
+   }
+
    if(!srfc->getAttrib(attribute,value)) {
        RETURN_ERROR(EGL_FALSE,EGL_BAD_ATTRIBUTE);
    }
@@ -1240,6 +1256,58 @@ EGLAPI EGLBoolean EGLAPIENTRY eglSwapBuffers(EGLDisplay display, EGLSurface surf
     return EGL_TRUE;
 }
 
+EGLAPI EGLBoolean EGLAPIENTRY eglSwapBuffersWithDamageKHR(EGLDisplay display,
+                                                          EGLSurface surface,
+                                                          EGLint* rects,
+                                                          EGLint n_rects) {
+    VALIDATE_DISPLAY(display);
+    VALIDATE_SURFACE(surface,Srfc);
+    ThreadInfo* thread        = getThreadInfo();
+    ContextPtr currentCtx    = thread->eglContext;
+
+    if(Srfc->type() != EglSurface::WINDOW){
+        RETURN_ERROR(EGL_TRUE,EGL_SUCCESS);
+    }
+
+    if(!currentCtx.get() || !currentCtx->usingSurface(Srfc) ||
+            !dpy->nativeType()->isValidNativeWin(Srfc.get()->native())) {
+        RETURN_ERROR(EGL_FALSE,EGL_BAD_SURFACE);
+    }
+
+    if (n_rects < 0 || (n_rects > 0 && !rects)) {
+        RETURN_ERROR(EGL_FALSE,EGL_BAD_PARAMETER);
+    }
+
+    if (n_rects == 0) {
+        dpy->nativeType()->swapBuffers(Srfc->native());
+    } else {
+        dpy->nativeType()->swapBuffersWithDamage(Srfc->native(), rects,
+                                                 n_rects);
+    }
+    return EGL_TRUE;
+}
+
+EGLAPI EGLBoolean EGLAPIENTRY eglSetDamageRegionKHR(EGLDisplay display,
+                                                    EGLSurface surface,
+                                                    EGLint* rects,
+                                                    EGLint n_rects) {
+    VALIDATE_DISPLAY(display);
+    VALIDATE_SURFACE(surface,Srfc);
+
+    if(Srfc->type() != EglSurface::WINDOW) {
+        RETURN_ERROR(EGL_FALSE,EGL_BAD_MATCH);
+    }
+
+    if (n_rects < 0 || (n_rects > 0 && !rects)) {
+        RETURN_ERROR(EGL_FALSE,EGL_BAD_PARAMETER);
+    }
+
+    if (!dpy->nativeType()->setDamageRegion(Srfc->native(), rects, n_rects)) {
+        RETURN_ERROR(EGL_FALSE,EGL_BAD_ACCESS);
+    }
+    return EGL_TRUE;
+}
+
 EGLAPI EGLContext EGLAPIENTRY eglGetCurrentContext(void) {
     MEM_TRACE("EMUGL");
     emugl::Mutex::AutoLock mutex(s_eglLock);
@@ -187,6 +187,27 @@ public:
 
     virtual void swapBuffers(Surface* srfc) = 0;
 
+    // Present only the |numRects| rectangles (x, y, width, height, origin
+    // at the bottom left) of |rects|. Engines without
+    // EGL_KHR_swap_buffers_with_damage present the whole surface.
+    virtual void swapBuffersWithDamage(Surface* srfc,
+                                       const EGLint* rects,
+                                       EGLint numRects) {
+        swapBuffers(srfc);
+    }
+
+    // Number of frames since the current back buffer of |srfc| was
+    // presented, or 0 if its contents are undefined (EGL_EXT_buffer_age).
+    virtual EGLint queryBufferAge(Surface* srfc) { return 0; }
+
+    // Restrict rendering of the next frame of |srfc| to |rects|
+    // (EGL_KHR_partial_update). Returns false if not supported.
+    virtual bool setDamageRegion(Surface* srfc,
+                                 const EGLint* rects,
+                                 EGLint numRects) {
+        return false;
+    }
+
     DISALLOW_COPY_AND_ASSIGN(Display);
 };
 
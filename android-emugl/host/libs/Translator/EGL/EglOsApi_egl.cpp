@@ -23,9 +23,12 @@
 #include "emugl/common/shared_library.h"
 
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <GLES2/gl2.h>
 #include <memory>
 
+#include <string.h>
+
 #define DEBUG 0
 #if DEBUG
 #define D(...) fprintf(stderr, __VA_ARGS__);
@@ -66,7 +69,7 @@ static const char* kGLES2LibName = "libGLESv2.dylib";
 
 // List of EGL functions of interest to probe with GetProcAddress()
 #define LIST_EGL_FUNCTIONS(X)                                                  \
-    X(EGLBoolean, eglGetProcAddress,                                           \
+    X(__eglMustCastToProperFunctionPointerType, eglGetProcAddress,             \
       (const char* procname))                                                  \
     X(const char*, eglQueryString,                                             \
       (EGLDisplay dpy, EGLint id))                                             \
@@ -97,6 +100,9 @@ static const char* kGLES2LibName = "libGLESv2.dylib";
       (EGLDisplay display, EGLSurface draw, EGLSurface read,                   \
        EGLContext context))                                                    \
     X(EGLBoolean, eglSwapBuffers, (EGLDisplay display, EGLSurface surface))    \
+    X(EGLBoolean, eglQuerySurface,                                             \
+      (EGLDisplay display, EGLSurface surface, EGLint attribute,              \
+       EGLint * value))                                                        \
     X(EGLSurface, eglCreateWindowSurface,                                      \
       (EGLDisplay display, EGLConfig config,                                   \
        EGLNativeWindowType native_window, EGLint const* attrib_list))
@@ -260,6 +266,13 @@ public:
     bool releasePbuffer(Surface* pb);
     bool makeCurrent(Surface* read, Surface* draw, Context* context);
     void swapBuffers(Surface* srfc);
+    void swapBuffersWithDamage(Surface* srfc,
+                               const EGLint* rects,
+                               EGLint numRects) override;
+    EGLint queryBufferAge(Surface* srfc) override;
+    bool setDamageRegion(Surface* srfc,
+                         const EGLint* rects,
+                         EGLint numRects) override;
     bool isValidNativeWin(Surface* win);
     bool isValidNativeWin(EGLNativeWindowType win);
     bool checkWindowPixelFormatMatch(EGLNativeWindowType win,
@@ -273,6 +286,15 @@ private:
     EglOsEglDispatcher mDispatcher;
     bool mHeadless = false;
 
+    // Damage extensions of the host display, resolved at construction.
+    using SwapBuffersWithDamage =
+            EGLBoolean(EGLAPIENTRY*)(EGLDisplay, EGLSurface, EGLint*, EGLint);
+    using SetDamageRegion =
+            EGLBoolean(EGLAPIENTRY*)(EGLDisplay, EGLSurface, EGLint*, EGLint);
+    SwapBuffersWithDamage mSwapBuffersWithDamage = nullptr;
+    SetDamageRegion mSetDamageRegion = nullptr;
+    bool mHasBufferAge = false;
+
 #ifdef __linux__
     ::Display* mGlxDisplay = nullptr;
 #endif // __linux__
@@ -292,6 +314,26 @@ EglOsEglDisplay::EglOsEglDisplay() {
     mDispatcher.eglBindAPI(EGL_OPENGL_ES_API);
     CHECK_EGL_ERR
 
+    auto hasExt = [clientExts](const char* ext) {
+        return clientExts && strstr(clientExts, ext);
+    };
+    if (mDispatcher.eglGetProcAddress) {
+        if (hasExt("EGL_KHR_swap_buffers_with_damage")) {
+            mSwapBuffersWithDamage = (SwapBuffersWithDamage)
+                    mDispatcher.eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+        } else if (hasExt("EGL_EXT_swap_buffers_with_damage")) {
+            mSwapBuffersWithDamage = (SwapBuffersWithDamage)
+                    mDispatcher.eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+        }
+        if (hasExt("EGL_KHR_partial_update")) {
+            mSetDamageRegion = (SetDamageRegion)
+                    mDispatcher.eglGetProcAddress("eglSetDamageRegionKHR");
+        }
+    }
+    mHasBufferAge = mDispatcher.eglQuerySurface &&
+                    (hasExt("EGL_EXT_buffer_age") ||
+                     hasExt("EGL_KHR_partial_update"));
+
     mHeadless = System::getEnvironmentVariable("ANDROID_EMU_HEADLESS") == "1";
 
 #ifdef __linux__
@@ -524,6 +566,42 @@ void EglOsEglDisplay::swapBuffers(Surface* surface) {
     mDispatcher.eglSwapBuffers(mDisplay, sfc->getHndl());
 }
 
+void EglOsEglDisplay::swapBuffersWithDamage(Surface* surface,
+                                            const EGLint* rects,
+                                            EGLint numRects) {
+    if (!mSwapBuffersWithDamage) {
+        swapBuffers(surface);
+        return;
+    }
+    EglOsEglSurface* sfc = (EglOsEglSurface*)surface;
+    mSwapBuffersWithDamage(mDisplay, sfc->getHndl(),
+                           const_cast<EGLint*>(rects), numRects);
+}
+
+EGLint EglOsEglDisplay::queryBufferAge(Surface* surface) {
+    if (!mHasBufferAge) {
+        return 0;
+    }
+    EglOsEglSurface* sfc = (EglOsEglSurface*)surface;
+    EGLint age = 0;
+    if (!mDispatcher.eglQuerySurface(mDisplay, sfc->getHndl(),
+                                     EGL_BUFFER_AGE_EXT, &age)) {
+        return 0;
+    }
+    return age;
+}
+
+bool EglOsEglDisplay::setDamageRegion(Surface* surface,
+                                      const EGLint* rects,
+                                      EGLint numRects) {
+    if (!mSetDamageRegion) {
+        return false;
+    }
+    EglOsEglSurface* sfc = (EglOsEglSurface*)surface;
+    return mSetDamageRegion(mDisplay, sfc->getHndl(),
+                            const_cast<EGLint*>(rects), numRects);
+}
+
 bool EglOsEglDisplay::isValidNativeWin(Surface* win) {
     if (!win)
         return false;
@@ -35,6 +35,10 @@
 
 #define DEBUG_PBUF_POOL 0
 
+#ifndef GLX_BACK_BUFFER_AGE_EXT
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+#endif
+
 // TODO: Replace with latency tracker.
 #define PROFILE_SLOW(tag)
 
@@ -597,6 +601,24 @@ public:
         }
     }
 
+    virtual EGLint queryBufferAge(EglOS::Surface* srfc) {
+        if (!srfc || srfc->type() != GlxSurface::SurfaceType::WINDOW) {
+            return 0;
+        }
+        if (mHasBufferAge < 0) {
+            const char* exts =
+                    glXQueryExtensionsString(mDisplay, DefaultScreen(mDisplay));
+            mHasBufferAge = exts && strstr(exts, "GLX_EXT_buffer_age") ? 1 : 0;
+        }
+        if (!mHasBufferAge) {
+            return 0;
+        }
+        unsigned int age = 0;
+        glXQueryDrawable(mDisplay, GlxSurface::drawableFor(srfc),
+                         GLX_BACK_BUFFER_AGE_EXT, &age);
+        return (EGLint)age;
+    }
+
 private:
     using CreateContextAttribs =
         GLXContext (*)(X11Display*, GLXFBConfig, GLXContext, Bool, const int*);
@@ -666,6 +688,8 @@ private:
 
     CreateContextAttribs mCreateContextAttribs = nullptr;
     SwapInterval mSwapInterval = nullptr;
+    // GLX_EXT_buffer_age support, -1 until queried.
+    int mHasBufferAge = -1;
 
     bool mCoreProfileSupported = false;
     int mCoreMajorVersion = 4;
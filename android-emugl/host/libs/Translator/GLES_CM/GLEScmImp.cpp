@@ -766,9 +766,8 @@ GL_API void GL_APIENTRY  glCompressedTexSubImage2D( GLenum target, GLint level,
                                              height, format, imageSize, data);
     } else {
         GLenum uncompressedFrmt;
-        unsigned char* uncompressed = uncompressTexture(format,uncompressedFrmt,width,height,imageSize,data,level);
+        const unsigned char* uncompressed = uncompressTexture(format,uncompressedFrmt,width,height,imageSize,data,level);
         ctx->dispatcher().glTexSubImage2D(target,level,xoffset,yoffset,width,height,uncompressedFrmt,GL_UNSIGNED_BYTE,uncompressed);
-        delete uncompressed;
     }
 
     TextureData* texData = getTextureTargetData(target);
@@ -745,6 +745,9 @@ void GLESv2Context::initExtensionString() {
     if (s_glSupport.GL_EXT_TEXTURE_FORMAT_BGRA8888) {
         *s_glExtensions+="GL_EXT_texture_format_BGRA8888 GL_APPLE_texture_format_BGRA8888 ";
     }
+    if (s_glSupport.GL_EXT_READ_FORMAT_BGRA) {
+        *s_glExtensions+="GL_EXT_read_format_bgra ";
+    }
 
     s_glExtensionsInitialized = true;
 }
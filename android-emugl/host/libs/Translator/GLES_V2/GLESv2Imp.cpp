@@ -35,6 +35,7 @@
 #include "GLcommon/GLutils.h"
 #include "GLcommon/SaveableTexture.h"
 #include "GLcommon/TextureData.h"
+#include "GLcommon/TextureUploadCache.h"
 #include "GLcommon/TextureUtils.h"
 #include "GLcommon/TranslatorIfaces.h"
 #include "OpenglCodecCommon/ErrorLog.h"
@@ -157,6 +158,8 @@ GL_API void GL_APIENTRY glBindTexture (GLenum target, GLuint texture);
 GL_APICALL void  GL_APIENTRY glVertexAttribPointerWithDataSize(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr, GLsizei dataSize);
 GL_APICALL void  GL_APIENTRY glVertexAttribIPointerWithDataSize(GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid* ptr, GLsizei dataSize);
 GL_APICALL void  GL_APIENTRY glTestHostDriverPerformance(GLuint count, uint64_t* duration_us, uint64_t* duration_cpu_us);
+GL_APICALL void  GL_APIENTRY glGetRedundantStateCallsAEMU(uint64_t* count);
+GL_APICALL void  GL_APIENTRY glGetTextureDedupStatsAEMU(uint64_t* hits, uint64_t* misses, uint64_t* savedBytes, uint64_t* cachedBytes);
 GL_APICALL void  GL_APIENTRY glDrawArraysNullAEMU(GLenum mode, GLint first, GLsizei count);
 GL_APICALL void  GL_APIENTRY glDrawElementsNullAEMU(GLenum mode, GLsizei count, GLenum type, const void* indices);
 
@@ -270,6 +273,8 @@ static __translatorMustCastToProperFunctionPointerType getProcAddressGles2(const
         (*s_gles2Extensions)["glVertexAttribPointerWithDataSize"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glVertexAttribPointerWithDataSize);
         (*s_gles2Extensions)["glVertexAttribIPointerWithDataSize"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glVertexAttribIPointerWithDataSize);
         (*s_gles2Extensions)["glTestHostDriverPerformance"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glTestHostDriverPerformance);
+        (*s_gles2Extensions)["glGetRedundantStateCallsAEMU"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glGetRedundantStateCallsAEMU);
+        (*s_gles2Extensions)["glGetTextureDedupStatsAEMU"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glGetTextureDedupStatsAEMU);
         (*s_gles2Extensions)["glDrawArraysNullAEMU"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glDrawArraysNullAEMU);
         (*s_gles2Extensions)["glDrawElementsNullAEMU"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glDrawElementsNullAEMU);
         (*s_gles2Extensions)["glGetUnsignedBytevEXT"] = (__translatorMustCastToProperFunctionPointerType)GLES2_NAMESPACED(glGetUnsignedBytevEXT);
@@ -482,7 +487,23 @@ GL_APICALL void  GL_APIENTRY glBindBuffer(GLenum target, GLuint buffer){
     SET_ERROR_IF(!GLESv2Validate::bufferTarget(ctx, target), GL_INVALID_ENUM);
 
     GLuint globalBufferName = ctx->bindBuffer(target,buffer);
-    ctx->dispatcher().glBindBuffer(target, globalBufferName);
+    // Indexed targets are also changed by glBindBufferBase/Range and the
+    // element array binding belongs to the VAO, so only the plain ones
+    // go through the binding cache.
+    switch (target) {
+    case GL_ARRAY_BUFFER:
+    case GL_COPY_READ_BUFFER:
+    case GL_COPY_WRITE_BUFFER:
+    case GL_PIXEL_PACK_BUFFER:
+    case GL_PIXEL_UNPACK_BUFFER:
+        if (ctx->isRedundantBinding(target, globalBufferName)) return;
+        ctx->dispatcher().glBindBuffer(target, globalBufferName);
+        ctx->onBindingDispatched(target, globalBufferName);
+        break;
+    default:
+        ctx->dispatcher().glBindBuffer(target, globalBufferName);
+        break;
+    }
 }
 
 static bool sIsFboTextureTarget(GLenum target) {
@@ -702,7 +723,11 @@ GL_APICALL void  GL_APIENTRY glBindTexture(GLenum target, GLuint texture){
     }
 
     ctx->setBindedTexture(target,texture);
+    // GL_DEPTH_TEXTURE_MODE below is texture state, already set when the
+    // texture was bound last.
+    if (ctx->isRedundantBinding(target, globalTextureName)) return;
     ctx->dispatcher().glBindTexture(target,globalTextureName);
+    ctx->onBindingDispatched(target, globalTextureName);
 
     if (ctx->getMajorVersion() < 3) return;
 
@@ -724,6 +749,7 @@ GL_APICALL void  GL_APIENTRY glBlendColor(GLclampf red, GLclampf green, GLclampf
 GL_APICALL void  GL_APIENTRY glBlendEquation( GLenum mode ){
     GET_CTX_V2();
     SET_ERROR_IF(!GLESv2Validate::blendEquationMode(ctx, mode), GL_INVALID_ENUM);
+    if (ctx->isRedundantBlendEquation(mode, mode)) return;
     ctx->setBlendEquationSeparate(mode, mode);
     ctx->dispatcher().glBlendEquation(mode);
 }
@@ -732,6 +758,7 @@ GL_APICALL void  GL_APIENTRY glBlendEquationSeparate(GLenum modeRGB, GLenum mode
     GET_CTX_V2();
     SET_ERROR_IF(!(GLESv2Validate::blendEquationMode(ctx, modeRGB) &&
                    GLESv2Validate::blendEquationMode(ctx, modeAlpha)), GL_INVALID_ENUM);
+    if (ctx->isRedundantBlendEquation(modeRGB, modeAlpha)) return;
     ctx->setBlendEquationSeparate(modeRGB, modeAlpha);
     ctx->dispatcher().glBlendEquationSeparate(modeRGB,modeAlpha);
 }
@@ -739,6 +766,7 @@ GL_APICALL void  GL_APIENTRY glBlendEquationSeparate(GLenum modeRGB, GLenum mode
 GL_APICALL void  GL_APIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor){
     GET_CTX();
     SET_ERROR_IF(!GLESv2Validate::blendSrc(sfactor) || !GLESv2Validate::blendDst(dfactor),GL_INVALID_ENUM)
+    if (ctx->isRedundantBlendFunc(sfactor, dfactor, sfactor, dfactor)) return;
     ctx->setBlendFuncSeparate(sfactor, dfactor, sfactor, dfactor);
     ctx->dispatcher().glBlendFunc(sfactor,dfactor);
 }
@@ -747,6 +775,7 @@ GL_APICALL void  GL_APIENTRY glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, G
     GET_CTX();
     SET_ERROR_IF(
 !(GLESv2Validate::blendSrc(srcRGB) && GLESv2Validate::blendDst(dstRGB) && GLESv2Validate::blendSrc(srcAlpha) && GLESv2Validate::blendDst(dstAlpha)),GL_INVALID_ENUM);
+    if (ctx->isRedundantBlendFunc(srcRGB, dstRGB, srcAlpha, dstAlpha)) return;
     ctx->setBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
     ctx->dispatcher().glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
 }
@@ -809,6 +838,7 @@ GL_APICALL void  GL_APIENTRY glClearStencil(GLint s){
 }
 GL_APICALL void  GL_APIENTRY glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha){
     GET_CTX();
+    if (ctx->isRedundantColorMask(red, green, blue, alpha)) return;
     ctx->setColorMask(red, green, blue, alpha);
     ctx->dispatcher().glColorMask(red,green,blue,alpha);
 }
@@ -904,6 +934,7 @@ GL_APICALL void  GL_APIENTRY glCompressedTexSubImage2D(GLenum target, GLint leve
                 SET_ERROR_IF(yoffset % 4, GL_INVALID_OPERATION);
             }
             SET_ERROR_IF(format != texData->compressedFormat, GL_INVALID_OPERATION);
+            texData->makeDirty();
         }
         SET_ERROR_IF(ctx->getMajorVersion() < 3 && !data, GL_INVALID_OPERATION);
         if (shouldPassthroughCompressedFormat(ctx, format)) {
@@ -971,6 +1002,7 @@ void s_glInitTexImage2D(GLenum target, GLint level, GLint internalformat,
                             NamedObjectType::TEXTURE, tex);
                 ctx->dispatcher().glBindTexture(GL_TEXTURE_2D,
                         globalTextureName);
+                ctx->onBindingDispatched(GL_TEXTURE_2D, globalTextureName);
                 texData->sourceEGLImage = 0;
                 texData->setGlobalName(globalTextureName);
             }
@@ -1370,6 +1402,7 @@ GL_APICALL void  GL_APIENTRY glDepthFunc(GLenum func){
 }
 GL_APICALL void  GL_APIENTRY glDepthMask(GLboolean flag){
     GET_CTX();
+    if (ctx->isRedundantDepthMask(flag)) return;
     ctx->setDepthMask(flag);
     ctx->dispatcher().glDepthMask(flag);
 }
@@ -1427,6 +1460,7 @@ GL_APICALL void  GL_APIENTRY glDisable(GLenum cap){
         return;
     }
 #endif
+    if (ctx->isRedundantEnable(cap, false)) return;
     ctx->setEnable(cap, false);
     ctx->dispatcher().glDisable(cap);
 }
@@ -1565,6 +1599,7 @@ GL_APICALL void  GL_APIENTRY glEnable(GLenum cap){
         return;
     }
 #endif
+    if (ctx->isRedundantEnable(cap, true)) return;
     ctx->setEnable(cap, true);
     ctx->dispatcher().glEnable(cap);
 }
@@ -3311,6 +3346,7 @@ GL_APICALL void  GL_APIENTRY glSampleCoverage(GLclampf value, GLboolean invert){
 
 GL_APICALL void  GL_APIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height){
     GET_CTX();
+    if (ctx->isRedundantScissor(x, y, width, height)) return;
     ctx->setScissor(x, y, width, height);
     ctx->dispatcher().glScissor(x,y,width,height);
 }
@@ -3495,7 +3531,21 @@ GL_APICALL void  GL_APIENTRY glTexImage2D(GLenum target, GLint level, GLint inte
             &internalformat, &format);
     }
 
-    ctx->dispatcher().glTexImage2D(target,level,internalformat,width,height,border,format,type,pixels);
+    TextureUploadCache* uploadCache = TextureUploadCache::get();
+    TextureData* texData = getTextureTargetData(target);
+    TextureUploadCache::Key uploadKey;
+    const bool dedup = uploadCache && target == GL_TEXTURE_2D && level == 0 &&
+            texData && ctx->hasPlainUnpackLayout() &&
+            TextureUploadCache::makeKey(width, height, internalformat, format,
+                                        type, ctx->getUnpackAlignment(),
+                                        pixels, &uploadKey);
+
+    if (!dedup || !uploadCache->copyToBoundTexture(uploadKey)) {
+        ctx->dispatcher().glTexImage2D(target,level,internalformat,width,height,border,format,type,pixels);
+        if (dedup) {
+            uploadCache->onUploaded(uploadKey, texData->getGlobalName());
+        }
+    }
 
     err = ctx->dispatcher().glGetError();
     if (err != GL_NO_ERROR) {
@@ -3844,7 +3894,11 @@ GL_APICALL void  GL_APIENTRY glUseProgram(GLuint program){
         ctx->setUseProgram(program, objData);
         SHADER_DEBUG_PRINT("use program %u", program);
 
+        if (ctx->isRedundantBinding(GL_CURRENT_PROGRAM, globalProgramName)) {
+            return;
+        }
         ctx->dispatcher().glUseProgram(globalProgramName);
+        ctx->onBindingDispatched(GL_CURRENT_PROGRAM, globalProgramName);
     }
 }
 
@@ -3995,6 +4049,7 @@ GL_APICALL void  GL_APIENTRY glVertexAttribPointerWithDataSize(GLuint index, GLi
 
 GL_APICALL void  GL_APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height){
     GET_CTX();
+    if (ctx->isRedundantViewport(x, y, width, height)) return;
     ctx->setViewport(x, y, width, height);
     ctx->dispatcher().glViewport(x,y,width,height);
 }
@@ -4021,6 +4076,8 @@ GL_APICALL void GL_APIENTRY glEGLImageTargetTexture2DOES(GLenum target, GLeglIma
             ctx->shareGroup()->replaceGlobalObject(NamedObjectType::TEXTURE, tex,
                                                    img->globalTexObj);
             ctx->dispatcher().glBindTexture(GL_TEXTURE_2D, img->globalTexObj->getGlobalName());
+            ctx->onBindingDispatched(GL_TEXTURE_2D,
+                                     img->globalTexObj->getGlobalName());
             TextureData *texData = getTextureTargetData(target);
             SET_ERROR_IF(texData==NULL,GL_INVALID_OPERATION);
             texData->width = img->width;
@@ -4341,6 +4398,25 @@ fprintf(stderr, "%s: begin count %d\n", __func__, count);
     gl->glUseProgram(0);
     gl->glDeleteProgram(program);
     gl->glDeleteBuffers(1, &buffer);
+    // The bindings changed behind the redundant state filter.
+    GLEScontext::onGlobalObjectDeleted();
+}
+
+// Number of state setting calls dropped as redundant since startup, over
+// all contexts.
+GL_APICALL void GL_APIENTRY glGetRedundantStateCallsAEMU(uint64_t* count) {
+    *count = GLEScontext::getRedundantStateCalls();
+}
+
+// Texture upload deduplication totals; all zero when it is disabled.
+GL_APICALL void GL_APIENTRY glGetTextureDedupStatsAEMU(uint64_t* hits, uint64_t* misses, uint64_t* savedBytes, uint64_t* cachedBytes) {
+    TextureUploadCache* cache = TextureUploadCache::get();
+    const TextureUploadCache::Stats stats =
+            cache ? cache->getStats() : TextureUploadCache::Stats{};
+    *hits = stats.hits;
+    *misses = stats.misses;
+    *savedBytes = stats.savedBytes;
+    *cachedBytes = stats.cachedBytes;
 }
 
 // Vulkan/GL interop
@@ -19,15 +19,49 @@
 #include "GLcommon/GLEScontext.h"
 #include "GLcommon/SaveableTexture.h"
 #include "android/base/system/System.h"
+#include "android/base/threads/FunctorThread.h"
 #include "android/utils/system.h"
+#include "emugl/common/logging.h"
 
 #include <EGL/eglext.h>
 #include <GLES2/gl2.h>
 
+#include <algorithm>
+#include <stdlib.h>
+
+using android::base::FunctorThread;
+using android::base::System;
+
 EGLContext s_context = EGL_NO_CONTEXT;
 EGLSurface s_surface = EGL_NO_SURFACE;
 
+// More workers restore faster, but each of them needs its own context and
+// competes with the render threads for the GPU.
+static constexpr int kMaxRestoreWorkers = 4;
+
+static int restoreWorkerCount() {
+    const std::string env = System::getEnvironmentVariable(
+            "ANDROID_EMUGL_SNAPSHOT_RESTORE_THREADS");
+    int count = env.empty() ? 0 : atoi(env.c_str());
+    if (count <= 0) {
+        count = System::get()->getCpuCoreCount() / 2;
+    }
+    return std::max(1, std::min(count, kMaxRestoreWorkers));
+}
+
+struct GLBackgroundLoader::Progress {
+    std::atomic<size_t> next { 0 };
+    // Textures a frame needs (SaveableTexture::RestorePriority other than
+    // Background) that nobody has restored yet.
+    std::atomic<int> pendingUrgent { 0 };
+    std::atomic<uint64_t> urgentDoneUs { 0 };
+    // Textures a render thread needed before a worker got to them.
+    std::atomic<int> syncRestores { 0 };
+    std::atomic<uint64_t> syncRestoreUs { 0 };
+};
+
 intptr_t GLBackgroundLoader::main() {
+    const auto startUs = System::get()->getHighResTimeUs();
 #if SNAPSHOT_PROFILE > 1
     const auto start = get_uptime_ms();
     printf("Starting GL background loading at %" PRIu64 " ms\n", start);
@@ -45,39 +79,118 @@ intptr_t GLBackgroundLoader::main() {
         }
     }
 
+    // Whatever the next frame draws goes first; the map order is arbitrary.
+    Progress progress;
+    std::vector<SaveableTexturePtr> textures;
+    textures.reserve(m_textureMap.size());
     for (const auto& it : m_textureMap) {
-        if (m_interrupted.load(std::memory_order_relaxed)) break;
-
-        // Acquire the texture loader for each load; bail
-        // in case something else happened to interrupt loading.
-        auto ptr = m_textureLoaderWPtr.lock();
-        if (!ptr) {
-            break;
+        if (!it.second) {
+            continue;
         }
-
-        const SaveableTexturePtr& saveable = it.second;
-        if (saveable) {
-            m_glesIface.restoreTexture(saveable.get());
-            // allow other threads to run for a while
-            ptr.reset();
-            android::base::System::get()->sleepMs(
-                m_loadDelayMs.load(std::memory_order_relaxed));
+        textures.push_back(it.second);
+        if (it.second->restorePriority() !=
+            SaveableTexture::RestorePriority::Background) {
+            progress.pendingUrgent++;
         }
     }
+    std::stable_sort(textures.begin(), textures.end(),
+                     [](const SaveableTexturePtr& a,
+                        const SaveableTexturePtr& b) {
+                         return a->restorePriority() < b->restorePriority();
+                     });
+
+    // The extra workers take textures from the same list, each with its own
+    // context, which shares textures with all the others.
+    const int workerCount = std::min<int>(
+            restoreWorkerCount(), std::max<size_t>(textures.size(), 1));
+    std::vector<std::unique_ptr<FunctorThread>> workers;
+    for (int i = 1; i < workerCount; i++) {
+        workers.emplace_back(new FunctorThread([this, &textures, &progress] {
+            EGLContext context = EGL_NO_CONTEXT;
+            EGLSurface surface = EGL_NO_SURFACE;
+            if (!m_eglIface.createAndBindAuxiliaryContext(&context,
+                                                          &surface)) {
+                return;
+            }
+            restoreTextures(textures, &progress);
+            m_eglIface.unbindAndDestroyAuxiliaryContext(context, surface);
+        }));
+        workers.back()->start();
+    }
+    restoreTextures(textures, &progress);
+    for (auto& worker : workers) {
+        worker->wait();
+    }
 
+    const size_t textureCount = textures.size();
+    textures.clear();
     m_textureMap.clear();
 
     m_eglIface.unbindAuxiliaryContext();
 
+    const auto endUs = System::get()->getHighResTimeUs();
+    const auto urgentDoneUs = progress.urgentDoneUs.load();
+    GL_LOG("GL background loading: %zu textures with %d workers in %.3f ms, "
+           "first frame ready after %.3f ms, %d synchronous restores took "
+           "%.3f ms%s\n",
+           textureCount, workerCount, (endUs - startUs) / 1000.0,
+           urgentDoneUs ? (urgentDoneUs - startUs) / 1000.0 : 0.0,
+           progress.syncRestores.load(), progress.syncRestoreUs.load() / 1000.0,
+           m_interrupted.load() ? " (interrupted)" : "");
+
 #if SNAPSHOT_PROFILE > 1
     const auto end = get_uptime_ms();
     printf("Finished GL background loading at %" PRIu64 " ms (%d ms total)\n",
            end, int(end - start));
+    printf("GL background loading: first frame ready after %.3f ms, "
+           "%d synchronous restores took %.3f ms\n",
+           urgentDoneUs ? (urgentDoneUs - startUs) / 1000.0 : 0.0,
+           progress.syncRestores.load(),
+           progress.syncRestoreUs.load() / 1000.0);
 #endif
 
     return 0;
 }
 
+void GLBackgroundLoader::restoreTextures(
+        const std::vector<SaveableTexturePtr>& textures,
+        Progress* progress) {
+    for (;;) {
+        if (m_interrupted.load(std::memory_order_relaxed)) break;
+
+        const size_t index = progress->next++;
+        if (index >= textures.size()) break;
+
+        // Acquire the texture loader for each load; bail
+        // in case something else happened to interrupt loading.
+        auto ptr = m_textureLoaderWPtr.lock();
+        if (!ptr) {
+            break;
+        }
+
+        SaveableTexture* saveable = textures[index].get();
+        if (saveable->needRestore()) {
+            m_glesIface.restoreTexture(saveable);
+        } else {
+            // Somebody needed it earlier and had to restore it synchronously.
+            progress->syncRestores++;
+            progress->syncRestoreUs += saveable->restoreDurationUs();
+        }
+        ptr.reset();
+
+        if (saveable->restorePriority() !=
+            SaveableTexture::RestorePriority::Background) {
+            // Don't hold up the first frame.
+            if (--progress->pendingUrgent == 0) {
+                progress->urgentDoneUs = System::get()->getHighResTimeUs();
+            }
+            continue;
+        }
+        // allow other threads to run for a while
+        System::get()->sleepMs(m_loadDelayMs.load(std::memory_order_relaxed));
+    }
+}
+
 bool GLBackgroundLoader::wait(intptr_t* exitStatus) {
     m_loadDelayMs.store(0, std::memory_order_relaxed);
     return Thread::wait();
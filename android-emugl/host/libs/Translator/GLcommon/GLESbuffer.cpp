@@ -17,6 +17,8 @@
 #include <GLcommon/GLEScontext.h>
 #include <string.h>
 
+#include <vector>
+
 bool  GLESbuffer::setBuffer(GLuint size,GLuint usage,const GLvoid* data) {
     m_size = size;
     m_usage = usage;
@@ -24,13 +26,16 @@ bool  GLESbuffer::setBuffer(GLuint size,GLuint usage,const GLvoid* data) {
         delete [] m_data;
         m_data = NULL;
     }
+    m_conversionManager.clear();
+    m_conversionManager.addRange(Range(0,m_size));
+    if(!m_shadowed) {
+        return true;
+    }
     m_data = new unsigned char[size];
     if(m_data) {
         if(data) {
             memcpy(m_data,data,size);
         }
-        m_conversionManager.clear();
-        m_conversionManager.addRange(Range(0,m_size));
         return true;
     }
     return false;
@@ -38,12 +43,63 @@ bool  GLESbuffer::setBuffer(GLuint size,GLuint usage,const GLvoid* data) {
 
 bool  GLESbuffer::setSubBuffer(GLint offset,GLuint size,const GLvoid* data) {
     if(offset + size > m_size) return false;
-    memcpy(m_data+offset,data,size);
+    if(m_data) {
+        memcpy(m_data+offset,data,size);
+    }
     m_conversionManager.addRange(Range(offset,size));
     m_conversionManager.merge();
     return true;
 }
 
+bool GLESbuffer::ensureShadow(GLuint globalName) {
+    m_shadowed = true;
+    if (m_data || !m_size) {
+        return true;
+    }
+    m_data = new unsigned char[m_size];
+    // The driver holds the original, unconverted data.
+    m_conversionManager.clear();
+    m_conversionManager.addRange(Range(0,m_size));
+    bool success = readBack(globalName, [this](const void* data) {
+        memcpy(m_data, data, m_size);
+    });
+    if (!success) {
+        fprintf(stderr, "%s: cannot read back buffer %u\n", __func__,
+                globalName);
+        memset(m_data, 0, m_size);
+        return false;
+    }
+    return true;
+}
+
+bool GLESbuffer::readBack(GLuint globalName,
+                          const std::function<void(const void*)>& f) const {
+    GLDispatch& dispatcher = GLEScontext::dispatcher();
+    if (!dispatcher.glMapBufferRange || m_size == 0) {
+        return false;
+    }
+    // + We do not handle the situation when this happens between a map and
+    // an unmap, because the way we implement GLES decoder prevents such
+    // behavior.
+    int prevBuffer = 0;
+    dispatcher.glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prevBuffer);
+    dispatcher.glBindBuffer(GL_ARRAY_BUFFER, globalName);
+    void * data = dispatcher.glMapBufferRange(GL_ARRAY_BUFFER, 0,
+                m_size, GL_MAP_READ_BIT);
+    assert(data);
+    // BUG: 68051848
+    // It is supposed to be fixed, but for safety we keep the fallback path
+    // here.
+    if (data) {
+        f(data);
+        bool success = dispatcher.glUnmapBuffer(GL_ARRAY_BUFFER);
+        assert(success);
+        (void)success;
+    }
+    dispatcher.glBindBuffer(GL_ARRAY_BUFFER, prevBuffer);
+    return data != nullptr;
+}
+
 void  GLESbuffer::getConversions(const RangeList& rIn,RangeList& rOut) {
         m_conversionManager.delRanges(rIn,rOut);
         rOut.merge();
@@ -72,36 +128,25 @@ void GLESbuffer::onSave(android::base::Stream* stream,
     ObjectData::onSave(stream, globalName);
     stream->putBe32(m_size);
     stream->putBe32(m_usage);
-    GLDispatch& dispatcher = GLEScontext::dispatcher();
     bool mapSuccess = false;
-    if (!needRestore() && dispatcher.glMapBufferRange && m_size != 0) {
+    if (!needRestore() && m_size != 0) {
         // If glMapBufferRange is supported, m_data might be inconsistent
-        // with GPU memory (because we did not update m_data when glUnmapBuffer)
+        // with GPU memory (because we did not update m_data when glUnmapBuffer),
+        // and most buffers do not keep m_data at all.
         // Thus we directly load buffer data from GPU memory
-
-        // + We do not handle the situation when snapshot happens between
-        // a map and an unmap, because the way we implement GLES decoder
-        // prevents such behavior.
-        int prevBuffer = 0;
-        dispatcher.glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prevBuffer);
-        dispatcher.glBindBuffer(GL_ARRAY_BUFFER, globalName);
-        void * data = dispatcher.glMapBufferRange(GL_ARRAY_BUFFER, 0,
-                    m_size, GL_MAP_READ_BIT);
-        assert(data);
-        // BUG: 68051848
-        // It is supposed to be fixed, but for safety we keep the fallback path
-        // here.
-        if (data) {
+        mapSuccess = readBack(globalName, [this, stream](const void* data) {
             stream->write(data, m_size);
-            bool success = dispatcher.glUnmapBuffer(GL_ARRAY_BUFFER);
-            assert(success);
-            (void)success;
-            mapSuccess = true;
-        }
-        dispatcher.glBindBuffer(GL_ARRAY_BUFFER, prevBuffer);
+        });
     }
     if (!mapSuccess) {
-        stream->write(m_data, m_size);
+        if (m_data || !m_size) {
+            stream->write(m_data, m_size);
+        } else {
+            fprintf(stderr, "%s: cannot read back buffer %u\n", __func__,
+                    globalName);
+            std::vector<unsigned char> zeros(m_size);
+            stream->write(zeros.data(), m_size);
+        }
     }
 
     // TODO: m_conversionManager
@@ -40,6 +40,7 @@
 #endif
 #include <string.h>
 
+#include <atomic>
 #include <numeric>
 #include <map>
 
@@ -581,6 +582,8 @@ GLEScontext::~GLEScontext() {
         gl.glDeleteTextures(1, &m_blitState.tex);
         gl.glDeleteVertexArrays(1, &m_blitState.vao);
         gl.glDeleteBuffers(1, &m_blitState.vbo);
+    }
+    if (m_blitState.fbo) {
         gl.glDeleteFramebuffers(1, &m_blitState.fbo);
     }
 
@@ -638,6 +641,27 @@ void GLEScontext::postLoad() {
                     return m_shareGroup->getObjectDataPtr(p_type, p_localName);
                 }
             });
+
+    // The textures this context had bound are the ones it is most likely to
+    // draw with first, so have the background loader restore them early.
+    if (!m_texState) {
+        return;
+    }
+    for (unsigned int i = 0; i <= m_maxUsedTexUnit; i++) {
+        for (unsigned int j = 0; j < NUM_TEXTURE_TARGETS; j++) {
+            const GLuint texture = m_texState[i][j].texture;
+            if (!texture) {
+                continue;
+            }
+            auto texData = static_cast<TextureData*>(
+                    m_shareGroup->getObjectData(NamedObjectType::TEXTURE,
+                                                texture));
+            if (texData && texData->getSaveableTexture()) {
+                texData->getSaveableTexture()->raiseRestorePriority(
+                        SaveableTexture::RestorePriority::Bound);
+            }
+        }
+    }
 }
 
 void GLEScontext::onSave(android::base::Stream* stream) const {
@@ -982,6 +1006,19 @@ GLint GLEScontext::getUnpackAlignment() {
             GL_UNPACK_ALIGNMENT, 4);
 }
 
+bool GLEScontext::hasPlainUnpackLayout() {
+    if (m_pixelUnpackBuffer) {
+        return false;
+    }
+    for (GLenum pname : {GL_UNPACK_ROW_LENGTH, GL_UNPACK_SKIP_PIXELS,
+                         GL_UNPACK_SKIP_ROWS}) {
+        if (android::base::findOrDefault(m_glPixelStoreiList, pname, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void GLEScontext::enableArr(GLenum arr,bool enable) {
     auto vertexAttrib = m_currVaoState.find(arr);
     if (vertexAttrib != m_currVaoState.end()) {
@@ -1118,6 +1155,7 @@ void GLEScontext::convertDirectVBO(GLESConversionArrays& cArrs,GLint first,GLsiz
     GLuint* indices = NULL;
     int attribSize = p->getSize();
     int stride = p->getStride()?p->getStride():sizeof(GLfixed)*attribSize;
+    ensureBufferShadow(p);
     char* data = (char*)p->getBufferData();
 
     if(p->bufferNeedConversion()) {
@@ -1180,6 +1218,7 @@ void GLEScontext::convertIndirectVBO(GLESConversionArrays& cArrs,GLsizei count,G
     GLuint* conversionIndices = NULL;
     int attribSize = p->getSize();
     int stride = p->getStride()?p->getStride():sizeof(GLfixed)*attribSize;
+    ensureBufferShadow(p);
     char* data = static_cast<char*>(p->getBufferData());
     if(p->bufferNeedConversion()) {
         indirectToBytesRanges(indices,indices_type,count,p,ranges); //converting indices range to buffer bytes ranges by offset
@@ -1194,6 +1233,17 @@ void GLEScontext::convertIndirectVBO(GLESConversionArrays& cArrs,GLsizei count,G
     cArrs.setArr(data,p->getStride(),GL_FLOAT);
 }
 
+void GLEScontext::ensureBufferShadow(GLESpointer* p) {
+    GLuint bufferName = p->getBufferName();
+    GLESbuffer* vbo = static_cast<GLESbuffer*>(
+            m_shareGroup
+                    ->getObjectData(NamedObjectType::VERTEXBUFFER, bufferName));
+    if (vbo) {
+        vbo->ensureShadow(m_shareGroup->getGlobalName(
+                NamedObjectType::VERTEXBUFFER, bufferName));
+    }
+}
+
 GLuint GLEScontext::bindBuffer(GLenum target,GLuint buffer) {
     switch(target) {
     case GL_ARRAY_BUFFER:
@@ -1449,8 +1499,13 @@ bool GLEScontext::setBufferData(GLenum target,GLsizeiptr size,const GLvoid* data
     GLESbuffer* vbo = static_cast<GLESbuffer*>(
             m_shareGroup
                     ->getObjectData(NamedObjectType::VERTEXBUFFER, bufferName));
-    if (vbo)
+    if (vbo) {
+        // GLES1 draws straight from the CPU copy.
+        if (m_glesMajorVersion == 1) {
+            vbo->setShadowed();
+        }
         return vbo->setBuffer(size,usage,data);
+    }
     return false;
 }
 
@@ -1646,6 +1701,105 @@ void GLEScontext::setColorMask(GLboolean red, GLboolean green, GLboolean blue,
     m_colorMaskA = alpha;
 }
 
+static std::atomic<uint64_t> sRedundantStateCalls{0};
+static std::atomic<uint64_t> sGlobalObjectDeletions{0};
+
+// static
+bool GLEScontext::readStateFilterEnabled() {
+    return !::getenv("ANDROID_EMUGL_DISABLE_STATE_FILTER");
+}
+
+// static
+uint64_t GLEScontext::getRedundantStateCalls() {
+    return sRedundantStateCalls.load(std::memory_order_relaxed);
+}
+
+// static
+void GLEScontext::onGlobalObjectDeleted() {
+    sGlobalObjectDeletions.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool GLEScontext::countRedundant(bool redundant) {
+    if (!redundant || !isStateFilterEnabled()) {
+        return false;
+    }
+    sRedundantStateCalls.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool GLEScontext::isRedundantEnable(GLenum item, bool isEnable) {
+    // Only caps set through the entry points before; the others are at
+    // their driver defaults, which differ between caps.
+    auto it = m_glEnableList.find(item);
+    return countRedundant(it != m_glEnableList.end() && it->second == isEnable);
+}
+
+bool GLEScontext::isRedundantViewport(GLint x, GLint y, GLsizei width,
+        GLsizei height) {
+    return countRedundant(m_isViewport && m_viewportX == x &&
+            m_viewportY == y && m_viewportWidth == width &&
+            m_viewportHeight == height);
+}
+
+bool GLEScontext::isRedundantScissor(GLint x, GLint y, GLsizei width,
+        GLsizei height) {
+    return countRedundant(m_isScissor && m_scissorX == x &&
+            m_scissorY == y && m_scissorWidth == width &&
+            m_scissorHeight == height);
+}
+
+bool GLEScontext::isRedundantBlendEquation(GLenum modeRGB, GLenum modeAlpha) {
+    return countRedundant(m_blendEquationRgb == modeRGB &&
+            m_blendEquationAlpha == modeAlpha);
+}
+
+bool GLEScontext::isRedundantBlendFunc(GLenum srcRGB, GLenum dstRGB,
+        GLenum srcAlpha, GLenum dstAlpha) {
+    return countRedundant(m_blendSrcRgb == srcRGB && m_blendDstRgb == dstRGB &&
+            m_blendSrcAlpha == srcAlpha && m_blendDstAlpha == dstAlpha);
+}
+
+bool GLEScontext::isRedundantDepthMask(GLboolean flag) {
+    return countRedundant(m_depthMask == flag);
+}
+
+bool GLEScontext::isRedundantColorMask(GLboolean red, GLboolean green,
+        GLboolean blue, GLboolean alpha) {
+    return countRedundant(m_colorMaskR == (bool)red &&
+            m_colorMaskG == (bool)green && m_colorMaskB == (bool)blue &&
+            m_colorMaskA == (bool)alpha);
+}
+
+uint64_t GLEScontext::bindingCacheKey(GLenum target) const {
+    switch (target) {
+    case GL_TEXTURE_2D:
+    case GL_TEXTURE_CUBE_MAP:
+    case GL_TEXTURE_2D_ARRAY:
+    case GL_TEXTURE_3D:
+    case GL_TEXTURE_2D_MULTISAMPLE:
+        return ((uint64_t)m_activeTexture << 32) | target;
+    default:
+        return target;
+    }
+}
+
+bool GLEScontext::isRedundantBinding(GLenum target, GLuint globalName) {
+    const uint64_t serial =
+            sGlobalObjectDeletions.load(std::memory_order_relaxed);
+    if (serial != m_bindingCacheSerial) {
+        m_bindingCache.clear();
+        m_bindingCacheSerial = serial;
+        return false;
+    }
+    auto it = m_bindingCache.find(bindingCacheKey(target));
+    return countRedundant(it != m_bindingCache.end() &&
+                          it->second == globalName);
+}
+
+void GLEScontext::onBindingDispatched(GLenum target, GLuint globalName) {
+    m_bindingCache[bindingCacheKey(target)] = globalName;
+}
+
 void GLEScontext::setClearColor(GLclampf red, GLclampf green, GLclampf blue,
         GLclampf alpha) {
     m_clearColorR = red;
@@ -1803,6 +1957,11 @@ void GLEScontext::initCapsLocked(const GLubyte * extensionString)
         (!isGles2Gles() && !(Version((const char*)glVersion) < Version("1.2"))))
         s_glSupport.GL_EXT_TEXTURE_FORMAT_BGRA8888 = true;
 
+    // Desktop GL reads back GL_BGRA since 1.2; GLES needs the extension.
+    if ((isGles2Gles() && strstr(cstring, "GL_EXT_read_format_bgra")) ||
+        (!isGles2Gles() && !(Version((const char*)glVersion) < Version("1.2"))))
+        s_glSupport.GL_EXT_READ_FORMAT_BGRA = true;
+
     if (::isCoreProfile() ||
         strstr(cstring,"GL_EXT_framebuffer_object ")!=NULL)
         s_glSupport.GL_EXT_FRAMEBUFFER_OBJECT = true;
@@ -2687,7 +2846,9 @@ void GLEScontext::setupImageBlitState() {
     m_blitState.samplerLoc =
         gl.glGetUniformLocation(m_blitState.program, "source_tex");
 
-    gl.glGenFramebuffers(1, &m_blitState.fbo);
+    if (!m_blitState.fbo) {
+        gl.glGenFramebuffers(1, &m_blitState.fbo);
+    }
     gl.glGenFramebuffers(1, &m_blitState.resolveFbo);
     gl.glGenTextures(1, &m_blitState.tex);
     gl.glGenVertexArrays(1, &m_blitState.vao);
@@ -2801,6 +2962,52 @@ bool GLEScontext::setupImageBlitForTexture(uint32_t width,
     return true;
 }
 
+// The window surface read buffer is a single-sampled fixed-point
+// renderbuffer of the same size as the target in the common case. Then a
+// mirrored glBlitFramebuffer does the copy and the flip in one pass,
+// instead of copying into m_blitState.tex and drawing that upside down.
+bool GLEScontext::blitDefaultReadBufferToTextureFlipped(GLuint globalTexObj,
+                                                        GLuint width,
+                                                        GLuint height) {
+    auto& gl = dispatcher();
+    if (!gl.glBlitFramebuffer || !m_defaultFBO ||
+        m_defaultReadFBO != m_defaultFBO || m_defaultFBOSamples > 0 ||
+        m_defaultFBOWidth != (GLint)width ||
+        m_defaultFBOHeight != (GLint)height ||
+        isIntegerInternalFormat(m_defaultFBOColorFormat) ||
+        m_defaultFBOColorFormat == GL_RGB10_A2) {
+        return false;
+    }
+
+    // In eglSwapBuffers, the surface must be bound as the draw surface of
+    // the current context, which corresponds to m_defaultFBO here (see
+    // setupImageBlitForTexture()).
+    const GLuint readFboBinding = getFramebufferBinding(GL_READ_FRAMEBUFFER);
+    const GLuint drawFboBinding = getFramebufferBinding(GL_DRAW_FRAMEBUFFER);
+    if (!m_blitState.fbo) {
+        gl.glGenFramebuffers(1, &m_blitState.fbo);
+    }
+    gl.glBindFramebuffer(GL_READ_FRAMEBUFFER, m_defaultFBO);
+    gl.glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_blitState.fbo);
+    gl.glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_TEXTURE_2D, globalTexObj, 0);
+
+    gl.glDisable(GL_SCISSOR_TEST);
+    gl.glBlitFramebuffer(0, 0, width, height, 0, height, width, 0,
+                         GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    if (isEnabled(GL_SCISSOR_TEST)) gl.glEnable(GL_SCISSOR_TEST);
+
+    gl.glBindFramebuffer(
+        GL_DRAW_FRAMEBUFFER,
+        drawFboBinding ? getFBOGlobalName(drawFboBinding) : m_defaultFBO);
+    gl.glBindFramebuffer(
+        GL_READ_FRAMEBUFFER,
+        readFboBinding ? getFBOGlobalName(readFboBinding) : m_defaultReadFBO);
+
+    gl.glFlush();
+    return true;
+}
+
 void GLEScontext::blitFromReadBufferToTextureFlipped(GLuint globalTexObj,
                                                      GLuint width,
                                                      GLuint height,
@@ -2811,6 +3018,10 @@ void GLEScontext::blitFromReadBufferToTextureFlipped(GLuint globalTexObj,
     (void)format;
     (void)type;
 
+    if (blitDefaultReadBufferToTextureFlipped(globalTexObj, width, height)) {
+        return;
+    }
+
     auto& gl = dispatcher();
     GLint prevViewport[4];
     getViewport(prevViewport);
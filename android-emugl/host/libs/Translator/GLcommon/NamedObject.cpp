@@ -96,9 +96,11 @@ NamedObject::~NamedObject() {
     switch (m_type) {
     case NamedObjectType::VERTEXBUFFER:
         GLEScontext::dispatcher().glDeleteBuffers(1, &m_globalName);
+        GLEScontext::onGlobalObjectDeleted();
         break;
     case NamedObjectType::TEXTURE:
         GLEScontext::dispatcher().glDeleteTextures(1, &m_globalName);
+        GLEScontext::onGlobalObjectDeleted();
         break;
     case NamedObjectType::RENDERBUFFER:
         GLEScontext::dispatcher().glDeleteRenderbuffers(1, &m_globalName);
@@ -112,6 +114,7 @@ NamedObject::~NamedObject() {
         } else {
             GLEScontext::dispatcher().glDeleteShader(m_globalName);
         }
+        GLEScontext::onGlobalObjectDeleted();
         break;
     case NamedObjectType::SAMPLER:
         GLEScontext::dispatcher().glDeleteSamplers(1, &m_globalName);
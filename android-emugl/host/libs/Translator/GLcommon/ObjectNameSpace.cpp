@@ -324,6 +324,12 @@ void GlobalNameSpace::preSaveAddEglImage(EglImage* eglImage) {
     } else {
         assert(m_textureMap[globalName] == eglImage->saveableTexture);
     }
+    // EGL images back the color buffers, which the renderer also draws to
+    // and uploads to outside of any guest context, so their dirty state
+    // can't be trusted for an incremental save.
+    if (eglImage->saveableTexture) {
+        eglImage->saveableTexture->makeDirty();
+    }
 }
 
 void GlobalNameSpace::preSaveAddTex(TextureData* texture) {
@@ -364,24 +370,36 @@ void GlobalNameSpace::onSave(android::base::Stream* stream,
                     const std::pair<const unsigned int, SaveableTexturePtr>&
                             tex) {
                 stream->putBe32(tex.first);
+                SaveableTexture* saveableTexture = tex.second.get();
+                // Textures that haven't changed since the last save or load
+                // keep pointing at the data that's already on disk.
+                if (saveableTexture && !saveableTexture->isDirty() &&
+                    textureSaver->reuseTexture(
+                            tex.first, saveableTexture->snapshotChunk())) {
 #if SNAPSHOT_PROFILE > 1
-                if (tex.second.get() && tex.second->isDirty()) {
-                    dirtyTexs ++;
-                } else {
                     cleanTexs ++;
-                }
 #endif // SNAPSHOT_PROFILE > 1
-                textureSaver->saveTexture(
-                        tex.first,
-                        [saver, &tex](android::base::Stream* stream,
-                                      ITextureSaver::Buffer* buffer) {
-                            if (!tex.second.get()) return;
-                            saver(tex.second.get(), stream, buffer);
-                        });
+                } else {
+#if SNAPSHOT_PROFILE > 1
+                    dirtyTexs ++;
+#endif // SNAPSHOT_PROFILE > 1
+                    textureSaver->saveTexture(
+                            tex.first,
+                            [saver, saveableTexture](
+                                    android::base::Stream* stream,
+                                    ITextureSaver::Buffer* buffer) {
+                                if (!saveableTexture) return;
+                                saver(saveableTexture, stream, buffer);
+                            });
+                }
+                if (saveableTexture) {
+                    saveableTexture->setSnapshotChunk(
+                            textureSaver->chunkFor(tex.first));
+                }
             });
     clearTextureMap();
 #if SNAPSHOT_PROFILE > 1
-    printf("Dirty texture saved %d, clean texture saved %d\n",
+    printf("Dirty texture saved %d, clean texture reused %d\n",
             dirtyTexs, cleanTexs);
 #endif // SNAPSHOT_PROFILE > 1
 }
@@ -400,7 +418,8 @@ void GlobalNameSpace::onLoad(android::base::Stream* stream,
     }
     loadCollection(
             stream, &m_textureMap,
-            [this, creator, textureLoaderWPtr](android::base::Stream* stream) {
+            [this, creator, textureLoaderWPtr,
+             &textureLoader](android::base::Stream* stream) {
                 unsigned int globalName = stream->getBe32();
                 // A lot of function wrapping happens here.
                 // When touched, saveableTexture triggers
@@ -419,6 +438,8 @@ void GlobalNameSpace::onLoad(android::base::Stream* stream,
                                         saveableTexture->loadFromStream(stream);
                                     });
                         });
+                saveableTexture->setSnapshotChunk(
+                        textureLoader->chunkFor(globalName));
                 return std::make_pair(globalName,
                                       SaveableTexturePtr(saveableTexture));
             });
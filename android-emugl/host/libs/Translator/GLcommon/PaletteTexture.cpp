@@ -14,7 +14,10 @@
 * limitations under the License.
 */
 #include "GLcommon/PaletteTexture.h"
+#include "GLcommon/TextureUtils.h"
+#include <algorithm>
 #include <stdio.h>
+#include <string.h>
 
 
 
@@ -105,7 +108,7 @@ Color paletteColor(const unsigned char* pallete,unsigned int index,GLenum format
     }
 }
 
-unsigned char* uncompressTexture(GLenum internalformat,GLenum& formatOut,GLsizei width,GLsizei height,GLsizei imageSize, const GLvoid* data,GLint level) {
+const unsigned char* uncompressTexture(GLenum internalformat,GLenum& formatOut,GLsizei width,GLsizei height,GLsizei imageSize, const GLvoid* data,GLint level) {
 
     unsigned int indexSizeBits = 0;  //the size of the color index in the pallete
     unsigned int colorSizeBytes = 0; //the size of each color cell in the pallete
@@ -134,37 +137,51 @@ unsigned char* uncompressTexture(GLenum internalformat,GLenum& formatOut,GLsizei
 
     int colorSizeOut = (formatOut == GL_RGB? 3:4);
     int nPixels = width*height;
-    unsigned char* pixelsOut = new unsigned char[nPixels*colorSizeOut];
-    if(!pixelsOut) return NULL;
+    unsigned char* pixelsOut =
+            getTextureConversionBuffer((size_t)nPixels * colorSizeOut);
 
     int leftBytes = ((palette + imageSize) /* the end of data pointer*/
                       - imageIndices);
+    // Data that ends before the indices has no pixels; don't let the
+    // unsigned division below turn a negative count into a huge one.
+    leftBytes = std::max(leftBytes, 0);
     int leftPixels = (leftBytes * 8 )/indexSizeBits;
 
     int maxIndices = (leftPixels < nPixels) ? leftPixels:nPixels;
 
-    //filling the pixels array
-    for(int i =0 ; i < maxIndices ; i++) {
-        int paletteIndex = 0;
-        int indexOut = i*colorSizeOut;
-        if(indexSizeBits == 4) {
-            paletteIndex = (i%2) == 0 ?
-                           imageIndices[i/2] >> 4:  //upper bits
-                           imageIndices[i/2] & 0xf; //lower bits
-        } else {
-            paletteIndex = imageIndices[i];
-        }
-
-        paletteIndex*=colorSizeBytes;
-        Color c = paletteColor(palette,paletteIndex,internalformat);
+    // Expand the palette once, so each pixel is a plain table copy instead
+    // of a per-pixel format switch and divisions. Only the colors that are
+    // actually within |imageSize| are read, the rest stay black.
+    unsigned char colors[256 * 4] = {};
+    int availColors = 0;
+    if (imageSize > 0 && colorSizeBytes) {
+        availColors = std::min(nColors, imageSize / (int)colorSizeBytes);
+    }
+    for (int i = 0; i < availColors; i++) {
+        Color c = paletteColor(palette, i * colorSizeBytes, internalformat);
+        colors[i * 4] = c.red;
+        colors[i * 4 + 1] = c.green;
+        colors[i * 4 + 2] = c.blue;
+        colors[i * 4 + 3] = c.alpha;
+    }
 
-        pixelsOut[indexOut] = c.red;
-        pixelsOut[indexOut+1] = c.green;
-        pixelsOut[indexOut+2] = c.blue;
-        if(formatOut == GL_RGBA) {
-            pixelsOut[indexOut+3] = c.alpha;
+    //filling the pixels array
+    auto paletteIndex = [indexSizeBits, imageIndices](int i) {
+        if (indexSizeBits == 4) {
+            return (i % 2) == 0 ? imageIndices[i / 2] >> 4  //upper bits
+                                : imageIndices[i / 2] & 0xf; //lower bits
         }
+        return (int)imageIndices[i];
+    };
+    // Full 4 byte stores overlap into the next pixel for GL_RGB; the last
+    // pixel is copied exactly so nothing is written past the end.
+    unsigned char* out = pixelsOut;
+    for (int i = 0; i + 1 < maxIndices; i++) {
+        memcpy(out, colors + paletteIndex(i) * 4, 4);
+        out += colorSizeOut;
+    }
+    if (maxIndices > 0) {
+        memcpy(out, colors + paletteIndex(maxIndices - 1) * 4, colorSizeOut);
     }
     return pixelsOut;
 }
-
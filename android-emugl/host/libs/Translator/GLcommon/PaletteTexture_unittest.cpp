@@ -0,0 +1,205 @@
+// Copyright (C) 2024 The Android Open Source Project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <GLcommon/PaletteTexture.h>
+
+#include <GLES/glext.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <string.h>
+
+namespace {
+
+// The per pixel decoder uncompressTexture() used before it expanded the
+// palette into a lookup table. Its output is the reference: the table based
+// one must match it byte for byte. Returns the number of pixels decoded.
+int referenceUncompress(GLenum format, GLsizei width, GLsizei height,
+                        GLsizei imageSize, const unsigned char* data,
+                        GLint level, GLenum* formatOut,
+                        std::vector<unsigned char>* out) {
+    unsigned int indexSizeBits = 8;
+    unsigned int colorSizeBytes = 0;
+    bool rgba = false;
+    switch (format) {
+        case GL_PALETTE4_RGB8_OES: indexSizeBits = 4; colorSizeBytes = 3; break;
+        case GL_PALETTE4_RGBA8_OES: indexSizeBits = 4; colorSizeBytes = 4; rgba = true; break;
+        case GL_PALETTE4_R5_G6_B5_OES: indexSizeBits = 4; colorSizeBytes = 2; break;
+        case GL_PALETTE4_RGBA4_OES:
+        case GL_PALETTE4_RGB5_A1_OES: indexSizeBits = 4; colorSizeBytes = 2; rgba = true; break;
+        case GL_PALETTE8_RGB8_OES: colorSizeBytes = 3; break;
+        case GL_PALETTE8_RGBA8_OES: colorSizeBytes = 4; rgba = true; break;
+        case GL_PALETTE8_R5_G6_B5_OES: colorSizeBytes = 2; break;
+        case GL_PALETTE8_RGBA4_OES:
+        case GL_PALETTE8_RGB5_A1_OES: colorSizeBytes = 2; rgba = true; break;
+    }
+
+    const int nColors = 1 << indexSizeBits;
+    const unsigned char* indices = data + nColors * colorSizeBytes;
+    for (int i = 0; i < level; i++) {
+        indices += (width * height * indexSizeBits) / 8;
+        width >>= 1;
+        height >>= 1;
+    }
+    *formatOut = rgba ? GL_RGBA : GL_RGB;
+    const int colorSizeOut = rgba ? 4 : 3;
+    const int nPixels = width * height;
+    const int leftPixels = (int)((data + imageSize - indices) * 8 / indexSizeBits);
+    const int maxIndices = leftPixels < nPixels ? leftPixels : nPixels;
+
+    out->assign((size_t)nPixels * colorSizeOut, 0);
+    for (int i = 0; i < maxIndices; i++) {
+        int index;
+        if (indexSizeBits == 4) {
+            index = (i % 2) == 0 ? indices[i / 2] >> 4 : indices[i / 2] & 0xf;
+        } else {
+            index = indices[i];
+        }
+        const unsigned char* p = data + index * colorSizeBytes;
+        short s;
+        memcpy(&s, p, sizeof(s));
+        unsigned char c[4];
+        switch (format) {
+            case GL_PALETTE4_RGB8_OES:
+            case GL_PALETTE8_RGB8_OES:
+                c[0] = p[0]; c[1] = p[1]; c[2] = p[2]; c[3] = 0;
+                break;
+            case GL_PALETTE4_R5_G6_B5_OES:
+            case GL_PALETTE8_R5_G6_B5_OES:
+                c[0] = (s >> 11) * 255 / 31;
+                c[1] = ((s >> 5) & 0x3f) * 255 / 63;
+                c[2] = (s & 0x1f) * 255 / 31;
+                c[3] = 0;
+                break;
+            case GL_PALETTE4_RGBA8_OES:
+            case GL_PALETTE8_RGBA8_OES:
+                c[0] = p[0]; c[1] = p[1]; c[2] = p[2]; c[3] = p[3];
+                break;
+            case GL_PALETTE4_RGBA4_OES:
+            case GL_PALETTE8_RGBA4_OES:
+                c[0] = ((s >> 12) & 0xf) * 255 / 15;
+                c[1] = ((s >> 8) & 0xf) * 255 / 15;
+                c[2] = ((s >> 4) & 0xf) * 255 / 15;
+                c[3] = (s & 0xf) * 255 / 15;
+                break;
+            case GL_PALETTE4_RGB5_A1_OES:
+            case GL_PALETTE8_RGB5_A1_OES:
+                c[0] = ((s >> 11) & 0x1f) * 255 / 31;
+                c[1] = ((s >> 6) & 0x1f) * 255 / 31;
+                c[2] = ((s >> 1) & 0x1f) * 255 / 31;
+                c[3] = (s & 0x1) * 255;
+                break;
+        }
+        memcpy(out->data() + i * colorSizeOut, c, colorSizeOut);
+    }
+    return maxIndices;
+}
+
+const GLenum kFormats[] = {
+        GL_PALETTE4_RGB8_OES,     GL_PALETTE4_RGBA8_OES,
+        GL_PALETTE4_R5_G6_B5_OES, GL_PALETTE4_RGBA4_OES,
+        GL_PALETTE4_RGB5_A1_OES,  GL_PALETTE8_RGB8_OES,
+        GL_PALETTE8_RGBA8_OES,    GL_PALETTE8_R5_G6_B5_OES,
+        GL_PALETTE8_RGBA4_OES,    GL_PALETTE8_RGB5_A1_OES,
+};
+
+int paletteBytes(GLenum format) {
+    switch (format) {
+        case GL_PALETTE4_RGB8_OES: return 16 * 3;
+        case GL_PALETTE4_RGBA8_OES: return 16 * 4;
+        case GL_PALETTE4_R5_G6_B5_OES:
+        case GL_PALETTE4_RGBA4_OES:
+        case GL_PALETTE4_RGB5_A1_OES: return 16 * 2;
+        case GL_PALETTE8_RGB8_OES: return 256 * 3;
+        case GL_PALETTE8_RGBA8_OES: return 256 * 4;
+        default: return 256 * 2;
+    }
+}
+
+int indexBits(GLenum format) {
+    return format <= GL_PALETTE4_RGB5_A1_OES ? 4 : 8;
+}
+
+// Decodes |level| of a |width|x|height| texture whose data is cut to
+// |imageSize| bytes, and expects the reference output.
+void expectSameAsReference(GLenum format, GLsizei width, GLsizei height,
+                           GLint level, GLsizei imageSize) {
+    std::vector<unsigned char> data(imageSize);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>(i * 97 + (i >> 3) + format);
+    }
+    GLenum expectedFormat = 0;
+    std::vector<unsigned char> expected;
+    const int decoded =
+            referenceUncompress(format, width, height, imageSize, data.data(),
+                                level, &expectedFormat, &expected);
+
+    GLenum formatOut = 0;
+    const unsigned char* pixels = uncompressTexture(
+            format, formatOut, width, height, imageSize, data.data(), level);
+    ASSERT_NE(nullptr, pixels);
+    ASSERT_EQ(expectedFormat, formatOut);
+    const int colorSizeOut = formatOut == GL_RGBA ? 4 : 3;
+    EXPECT_EQ(0, memcmp(expected.data(), pixels, decoded * colorSizeOut))
+            << "format 0x" << std::hex << format << std::dec << " " << width
+            << "x" << height << " level " << level << " size " << imageSize;
+}
+
+}  // namespace
+
+TEST(PaletteTexture, MatchesPerPixelDecode) {
+    const GLsizei kSizes[][2] = {{1, 1}, {2, 2}, {3, 5}, {17, 9}, {64, 64}};
+    for (GLenum format : kFormats) {
+        for (const auto& size : kSizes) {
+            const GLsizei width = size[0];
+            const GLsizei height = size[1];
+            const int levelBytes = (width * height * indexBits(format) + 7) / 8;
+            expectSameAsReference(format, width, height, 0,
+                                  paletteBytes(format) + levelBytes);
+        }
+    }
+}
+
+TEST(PaletteTexture, MatchesPerPixelDecodeOfMipmap) {
+    for (GLenum format : kFormats) {
+        // Level 1 of 16x8 is 8x4, right after the level 0 indices.
+        const int level0Bytes = 16 * 8 * indexBits(format) / 8;
+        const int level1Bytes = 8 * 4 * indexBits(format) / 8;
+        expectSameAsReference(format, 16, 8, 1,
+                              paletteBytes(format) + level0Bytes + level1Bytes);
+    }
+}
+
+TEST(PaletteTexture, MatchesPerPixelDecodeOfTruncatedData) {
+    // Only the first pixels have indices; the rest are left undecoded.
+    for (GLenum format : kFormats) {
+        for (int indexBytes : {0, 1, 5, 31}) {
+            expectSameAsReference(format, 16, 16, 0,
+                                  paletteBytes(format) + indexBytes);
+        }
+    }
+}
+
+TEST(PaletteTexture, TruncatedPaletteStaysInBounds) {
+    // Data that ends inside the palette: only the entries within
+    // |imageSize| may be read, and there are no pixels to decode.
+    for (GLenum format : kFormats) {
+        const GLsizei imageSize = paletteBytes(format) / 2;
+        std::vector<unsigned char> data(imageSize, 0xff);
+        GLenum formatOut = 0;
+        EXPECT_NE(nullptr, uncompressTexture(format, formatOut, 4, 4,
+                                             imageSize, data.data(), 0));
+    }
+}
@@ -652,7 +652,10 @@ void SaveableTexture::onSave(
                                 GLenum target, bool isDepth,
                                 std::unique_ptr<LevelImageData[]>& imgData) {
 
-            if (m_isDirty) {
+            // A clean texture only gets here when the data it was last saved
+            // or loaded with can't be reused, and it has no copy of it in
+            // memory; read it back then as well.
+            if (m_isDirty || !imgData) {
                 imgData.reset(new LevelImageData[numLevels]);
                 for (unsigned int level = 0; level < numLevels; level++) {
                     unsigned int& width = imgData.get()[level].m_width;
@@ -815,15 +818,10 @@ void SaveableTexture::onSave(
         }
         dispatcher.glBindTexture(m_target, prevTex);
 
-        // If we were under memory pressure, we deleted the intermediate
-        // buffer, so we need to maintain the invariant that m_isDirty = false
-        // textures requires that the intermediate buffer is still around.
-        // Therefore, mark as dirty if we were under memory pressure.
-        //
-        // TODO: Don't keep those around in memory regardless of memory
-        // pressure
-
-        m_isDirty = false || isLowMem;
+        // The texture now matches what was just saved, even if the
+        // intermediate buffer is gone: the next incremental save can point
+        // at this data instead of reading the texture back again.
+        m_isDirty = false;
     } else if (m_target != 0) {
         // SaveableTexture is uninitialized iff a texture hasn't been bound,
         // which will give m_target==0
@@ -833,6 +831,13 @@ void SaveableTexture::onSave(
 }
 
 void SaveableTexture::restore() {
+    const auto startUs = android::base::System::get()->getHighResTimeUs();
+    restoreFromSnapshot();
+    m_restoreDurationUs =
+            android::base::System::get()->getHighResTimeUs() - startUs;
+}
+
+void SaveableTexture::restoreFromSnapshot() {
     assert(m_loader);
     m_loader(this);
 
@@ -1022,6 +1027,11 @@ void SaveableTexture::restore() {
             }
         }
         m_texParam.clear();
+        // The texture is on the GPU now. Saving it again either reuses its
+        // data in the snapshot or reads it back, so don't hold on to it.
+        for (auto& levelData : m_levelData) {
+            levelData.reset();
+        }
         // Restore environment
         for (int i = 0; i != android::base::arraySize(pixelStoreIndexes); ++i) {
             if (isGles2Gles() && pixelStoreIndexes[i] != GL_PACK_ALIGNMENT &&
@@ -1059,6 +1069,26 @@ void SaveableTexture::fillEglImage(EglImage* eglImage) {
     }
 }
 
+void SaveableTexture::setSnapshotChunk(uint64_t chunk) {
+    m_snapshotChunk = chunk;
+}
+
+uint64_t SaveableTexture::snapshotChunk() const {
+    return m_snapshotChunk;
+}
+
+void SaveableTexture::raiseRestorePriority(RestorePriority priority) {
+    m_restorePriority = std::min(m_restorePriority, priority);
+}
+
+SaveableTexture::RestorePriority SaveableTexture::restorePriority() const {
+    return m_restorePriority;
+}
+
+uint64_t SaveableTexture::restoreDurationUs() const {
+    return m_restoreDurationUs;
+}
+
 void SaveableTexture::makeDirty() {
     m_isDirty = true;
 }
@@ -109,6 +109,10 @@ void TextureData::setGlobalName(unsigned int name) {
 
 void TextureData::setTexParam(GLenum pname, GLint param) {
     m_texParam[pname] = param;
+    // Parameters are saved along with the texture image.
+    if (m_saveableTexture) {
+        m_saveableTexture->makeDirty();
+    }
 }
 
 GLenum TextureData::getSwizzle(GLenum component) const {
@@ -141,4 +145,5 @@ void TextureData::setTarget(GLenum _target) {
 
 void TextureData::setMipmapLevelAtLeast(unsigned int level) {
     m_saveableTexture->setMipmapLevelAtLeast(level);
+    m_saveableTexture->makeDirty();
 }
@@ -0,0 +1,250 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "GLcommon/TextureUploadCache.h"
+
+#include "GLcommon/GLEScontext.h"
+#include "GLcommon/GLutils.h"
+
+#include <GLES3/gl3.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Smaller images are cheaper to upload than to hash and copy.
+static const size_t kMinImageBytes = 16 * 1024;
+
+// Bound on the images remembered as uploaded once.
+static const size_t kMaxSeenImages = 4096;
+
+// XXH64 (https://github.com/Cyan4973/xxHash), good enough that a match of
+// hash, size and format is taken as a match of the pixels.
+static const uint64_t kPrime1 = 11400714785074694791ULL;
+static const uint64_t kPrime2 = 14029467366897019727ULL;
+static const uint64_t kPrime3 = 1609587929392839161ULL;
+static const uint64_t kPrime4 = 9650029242287828579ULL;
+static const uint64_t kPrime5 = 2870177450012600261ULL;
+
+static inline uint64_t sRotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t sRead64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t sRead32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t sRound(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    acc = sRotl(acc, 31);
+    return acc * kPrime1;
+}
+
+static inline uint64_t sMergeRound(uint64_t acc, uint64_t val) {
+    acc ^= sRound(0, val);
+    return acc * kPrime1 + kPrime4;
+}
+
+static uint64_t sHash(const void* data, size_t len) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + len;
+    uint64_t h;
+
+    if (len >= 32) {
+        const unsigned char* const limit = end - 32;
+        uint64_t v1 = kPrime1 + kPrime2;
+        uint64_t v2 = kPrime2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - kPrime1;
+        do {
+            v1 = sRound(v1, sRead64(p));
+            v2 = sRound(v2, sRead64(p + 8));
+            v3 = sRound(v3, sRead64(p + 16));
+            v4 = sRound(v4, sRead64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = sRotl(v1, 1) + sRotl(v2, 7) + sRotl(v3, 12) + sRotl(v4, 18);
+        h = sMergeRound(h, v1);
+        h = sMergeRound(h, v2);
+        h = sMergeRound(h, v3);
+        h = sMergeRound(h, v4);
+    } else {
+        h = kPrime5;
+    }
+    h += (uint64_t)len;
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= sRound(0, sRead64(p));
+        h = sRotl(h, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end) {
+        h ^= (uint64_t)sRead32(p) * kPrime1;
+        h = sRotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= (*p) * kPrime5;
+        h = sRotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+static size_t sImageBytes(const TextureUploadCache::Key& key) {
+    return (size_t)key.width * key.height * (key.format == GL_RGB ? 3 : 4);
+}
+
+// Copies level 0 of |src| into level 0 of the texture bound to
+// GL_TEXTURE_2D, which must already have the same size and format.
+static void sCopyTexture(GLuint src, GLsizei width, GLsizei height) {
+    GLDispatch& gl = GLEScontext::dispatcher();
+    GLint prevReadFbo = 0;
+    gl.glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+    GLuint fbo = 0;
+    gl.glGenFramebuffers(1, &fbo);
+    gl.glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    gl.glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_TEXTURE_2D, src, 0);
+    gl.glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+    gl.glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFbo);
+    gl.glDeleteFramebuffers(1, &fbo);
+}
+
+static TextureUploadCache* sCreateCache() {
+    const char* env = ::getenv("ANDROID_EMUGL_TEXTURE_DEDUP_MB");
+    const size_t capMb = env ? strtoul(env, nullptr, 10) : 0;
+    if (!capMb || isGles2Gles()) {
+        return nullptr;
+    }
+    return new TextureUploadCache(capMb * 1024 * 1024);
+}
+
+// static
+TextureUploadCache* TextureUploadCache::get() {
+    static TextureUploadCache* const sCache = sCreateCache();
+    return sCache;
+}
+
+TextureUploadCache::TextureUploadCache(size_t capBytes)
+    : mCapBytes(capBytes) {}
+
+// static
+bool TextureUploadCache::makeKey(GLsizei width, GLsizei height,
+                                 GLint internalFormat, GLenum format,
+                                 GLenum type, GLint unpackAlignment,
+                                 const void* pixels, Key* key) {
+    if (!pixels || width <= 0 || height <= 0 || type != GL_UNSIGNED_BYTE) {
+        return false;
+    }
+    switch (format) {
+        case GL_RGB:
+        case GL_RGBA:
+        case GL_BGRA_EXT:
+            break;
+        default:
+            return false;
+    }
+    *key = {0, width, height, internalFormat, format, type};
+    const size_t bytes = sImageBytes(*key);
+    // Rows must follow each other without padding.
+    if (bytes < kMinImageBytes || !unpackAlignment ||
+        (bytes / height) % unpackAlignment) {
+        return false;
+    }
+    key->hash = sHash(pixels, bytes);
+    return true;
+}
+
+bool TextureUploadCache::copyToBoundTexture(const Key& key) {
+    emugl::Mutex::AutoLock lock(mLock);
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+        ++mMisses;
+        return false;
+    }
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+
+    GLDispatch& gl = GLEScontext::dispatcher();
+    gl.glTexImage2D(GL_TEXTURE_2D, 0, key.internalFormat, key.width,
+                    key.height, 0, key.format, key.type, nullptr);
+    sCopyTexture(it->second->tex, key.width, key.height);
+    ++mHits;
+    mSavedBytes += it->second->bytes;
+    return true;
+}
+
+void TextureUploadCache::onUploaded(const Key& key, GLuint texture) {
+    const size_t bytes = sImageBytes(key);
+    if (bytes > mCapBytes) {
+        return;
+    }
+    emugl::Mutex::AutoLock lock(mLock);
+    if (mIndex.count(key)) {
+        return;
+    }
+    if (!mSeen.count(key)) {
+        if (mSeen.size() >= kMaxSeenImages) {
+            mSeen.clear();
+        }
+        mSeen[key] = true;
+        return;
+    }
+    mSeen.erase(key);
+
+    trimLocked(mCapBytes - bytes);
+    GLDispatch& gl = GLEScontext::dispatcher();
+    GLuint tex = 0;
+    gl.glGenTextures(1, &tex);
+    gl.glBindTexture(GL_TEXTURE_2D, tex);
+    gl.glTexImage2D(GL_TEXTURE_2D, 0, key.internalFormat, key.width,
+                    key.height, 0, key.format, key.type, nullptr);
+    sCopyTexture(texture, key.width, key.height);
+    gl.glBindTexture(GL_TEXTURE_2D, texture);
+    // Other contexts copy from it next.
+    gl.glFlush();
+
+    mEntries.push_front({key, tex, bytes});
+    mIndex[key] = mEntries.begin();
+    mCachedBytes += bytes;
+}
+
+TextureUploadCache::Stats TextureUploadCache::getStats() {
+    emugl::Mutex::AutoLock lock(mLock);
+    return {mHits, mMisses, mSavedBytes, mCachedBytes};
+}
+
+void TextureUploadCache::trimLocked(size_t capBytes) {
+    GLDispatch& gl = GLEScontext::dispatcher();
+    while (mCachedBytes > capBytes && !mEntries.empty()) {
+        const Entry& victim = mEntries.back();
+        gl.glDeleteTextures(1, &victim.tex);
+        mCachedBytes -= victim.bytes;
+        mIndex.erase(victim.key);
+        mEntries.pop_back();
+    }
+}
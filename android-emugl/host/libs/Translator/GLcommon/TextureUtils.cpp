@@ -18,6 +18,7 @@
 #include <GLcommon/GLDispatch.h>
 #include <GLcommon/GLESvalidate.h>
 #include <stdio.h>
+#include <algorithm>
 #include <cmath>
 #include <memory>
 
@@ -455,16 +456,16 @@ void doCompressedTexImage2D(GLEScontext* ctx, GLenum target, GLint level,
         const int32_t align = ctx->getUnpackAlignment()-1;
         const int32_t bpr = ((width * pixelSize) + align) & ~align;
         const size_t size = bpr * height;
-        std::unique_ptr<etc1_byte[]> pOut(new etc1_byte[size]);
+        etc1_byte* pOut = getTextureConversionBuffer(size);
 
         int res =
             etc2_decode_image(
-                    (const etc1_byte*)data, etcFormat, pOut.get(),
+                    (const etc1_byte*)data, etcFormat, pOut,
                     width, height, bpr);
         SET_ERROR_IF(res!=0, GL_INVALID_VALUE);
 
         glTexImage2DPtr(target, level, convertedInternalFormat,
-                        width, height, border, format, type, pOut.get());
+                        width, height, border, format, type, pOut);
         if (emulateCompressedData) {
             delete [] (char*)data;
         }
@@ -478,17 +479,16 @@ void doCompressedTexImage2D(GLEScontext* ctx, GLenum target, GLint level,
         const int32_t stride = ((width * 4) + align) & ~align;
         const size_t size = stride * height;
 
-        AlignedBuf<uint8_t, 64> alignedUncompressedData(size);
+        uint8_t* uncompressedData = getTextureConversionBuffer(size);
 
         const bool result = astc_codec::ASTCDecompressToRGBA(
                 reinterpret_cast<const uint8_t*>(data), imageSize, width,
-                height, footprint, alignedUncompressedData.data(), size,
-                stride);
+                height, footprint, uncompressedData, size, stride);
         SET_ERROR_IF(!result, GL_INVALID_VALUE);
 
         glTexImage2DPtr(target, level, srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8, width,
                         height, border, GL_RGBA, GL_UNSIGNED_BYTE,
-                        alignedUncompressedData.data());
+                        uncompressedData);
 
     } else if (isPaletteFormat(internalformat)) {
         // TODO: fix the case when GL_PIXEL_UNPACK_BUFFER is bound
@@ -507,7 +507,7 @@ void doCompressedTexImage2D(GLEScontext* ctx, GLenum target, GLint level,
         for(int i = 0; i < nMipmaps; i++)
         {
             GLenum uncompressedFrmt;
-            unsigned char* uncompressed =
+            const unsigned char* uncompressed =
                 uncompressTexture(internalformat, uncompressedFrmt,
                                   width, height, imageSize, data, i);
             glTexImage2DPtr(target, i, uncompressedFrmt,
@@ -515,13 +515,28 @@ void doCompressedTexImage2D(GLEScontext* ctx, GLenum target, GLint level,
                             uncompressedFrmt, GL_UNSIGNED_BYTE, uncompressed);
             tmpWidth /= 2;
             tmpHeight /= 2;
-            delete [] uncompressed;
         }
     } else {
         SET_ERROR_IF(1, GL_INVALID_ENUM);
     }
 }
 
+// Buffers above this stay allocated until the next conversion on the same
+// thread that fits below it, which shrinks the buffer back.
+static const size_t kMaxRetainedConversionBytes = 16 * 1024 * 1024;
+
+unsigned char* getTextureConversionBuffer(size_t size) {
+    static thread_local AlignedBuf<unsigned char, 64> buf(0);
+    if (size > buf.size() ||
+        (buf.size() > kMaxRetainedConversionBytes &&
+         size <= kMaxRetainedConversionBytes)) {
+        // Drop the old contents instead of having resize() copy them over.
+        buf.resize(0);
+        buf.resize(std::max(size, (size_t)1));
+    }
+    return buf.data();
+}
+
 void deleteRenderbufferGlobal(GLuint rbo) {
     if (rbo) {
         GLEScontext::dispatcher().glDeleteRenderbuffers(1, &rbo);
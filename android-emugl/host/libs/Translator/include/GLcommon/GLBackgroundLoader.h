@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 class GLBackgroundLoader : public emugl::InterruptibleThread {
 public:
@@ -44,6 +45,12 @@ public:
     void interrupt() override;
 
 private:
+    struct Progress;
+    // Restores textures from |textures|, in order, until all of them are
+    // taken by some worker. Requires a context to be bound.
+    void restoreTextures(const std::vector<SaveableTexturePtr>& textures,
+                         Progress* progress);
+
     std::atomic<int> m_loadDelayMs { 10 };
     std::atomic<bool> m_interrupted { false };
 
@@ -22,6 +22,8 @@
 #include <GLcommon/ObjectData.h>
 #include <GLcommon/RangeManip.h>
 
+#include <functional>
+
 class GLESbuffer: public ObjectData {
 public:
    GLESbuffer():ObjectData(BUFFER_DATA) {}
@@ -32,7 +34,14 @@ public:
                 const getGlobalName_t& getGlobalName) override;
    GLuint getSize(){return m_size;};
    GLuint getUsage(){return m_usage;};
+   // CPU copy of the contents, or NULL if none is kept. GLES1 draws from
+   // it and GLES2 converts GL_FIXED attributes in it; every other buffer
+   // only lives in the driver.
    GLvoid* getData(){ return m_data;}
+   // Keep a CPU copy from now on. ensureShadow() also reads the current
+   // contents back from |globalName| if there is no copy yet.
+   void  setShadowed(){m_shadowed = true;};
+   bool  ensureShadow(GLuint globalName);
    bool  setBuffer(GLuint size,GLuint usage,const GLvoid* data);
    bool  setSubBuffer(GLint offset,GLuint size,const GLvoid* data);
    void  getConversions(const RangeList& rIn,RangeList& rOut);
@@ -42,11 +51,16 @@ public:
    ~GLESbuffer();
 
 private:
+    // Map the driver's copy of the buffer and pass it to |f|.
+    bool readBack(GLuint globalName,
+                  const std::function<void(const void*)>& f) const;
+
     GLuint         m_size = 0;
     GLuint         m_usage = GL_STATIC_DRAW;
     unsigned char* m_data = nullptr;
     RangeList      m_conversionManager;
     bool           m_wasBound = false;
+    bool           m_shadowed = false;
 };
 
 #endif
@@ -84,6 +84,7 @@ struct GLSupport {
 
     Version glslVersion;
     bool GL_EXT_TEXTURE_FORMAT_BGRA8888 = false;
+    bool GL_EXT_READ_FORMAT_BGRA = false;
     bool GL_EXT_FRAMEBUFFER_OBJECT = false;
     bool GL_ARB_VERTEX_BLEND = false;
     bool GL_ARB_MATRIX_PALETTE = false;
@@ -237,6 +238,9 @@ public:
     bool isInitialized() { return m_initialized; };
     bool needRestore();
     GLint getUnpackAlignment();
+    // True when client pixels are read as consecutive rows: no unpack
+    // buffer bound and no row length or skips set.
+    bool hasPlainUnpackLayout();
 
     bool  isArrEnabled(GLenum);
     virtual void  enableArr(GLenum arr,bool enable);
@@ -375,6 +379,34 @@ public:
     void setColorMask(GLboolean red, GLboolean green, GLboolean blue,
             GLboolean alpha);
 
+    // Redundant state change filtering. Guest GL stacks re-issue state
+    // changes that change nothing all the time; the GLESv2 entry points
+    // check them against the state tracked here and drop the driver call
+    // when it would be a no-op. Each isRedundant*() returns true (and
+    // counts the dropped call) only if filtering is on, which it is unless
+    // ANDROID_EMUGL_DISABLE_STATE_FILTER was set when the context was
+    // created; contexts created after the variable changes pick it up.
+    bool isStateFilterEnabled() const { return m_stateFilterEnabled; }
+    static uint64_t getRedundantStateCalls();
+    bool isRedundantEnable(GLenum item, bool isEnable);
+    bool isRedundantViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    bool isRedundantScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+    bool isRedundantBlendEquation(GLenum modeRGB, GLenum modeAlpha);
+    bool isRedundantBlendFunc(GLenum srcRGB, GLenum dstRGB,
+            GLenum srcAlpha, GLenum dstAlpha);
+    bool isRedundantDepthMask(GLboolean flag);
+    bool isRedundantColorMask(GLboolean red, GLboolean green, GLboolean blue,
+            GLboolean alpha);
+    // Object bindings are compared by global name with the last one bound
+    // on the driver through the entry points, recorded by
+    // onBindingDispatched(). Texture bindings are per active unit.
+    bool isRedundantBinding(GLenum target, GLuint globalName);
+    void onBindingDispatched(GLenum target, GLuint globalName);
+    // The driver unbinds deleted names and recycles them, so deleting any
+    // texture, buffer or program invalidates the recorded bindings of all
+    // contexts.
+    static void onGlobalObjectDeleted();
+
     void setClearColor(GLclampf red, GLclampf green, GLclampf blue,
             GLclampf alpha);
     void setClearDepth(GLclampf depth);
@@ -497,6 +529,8 @@ protected:
     void convertDirectVBO(GLESConversionArrays& fArrs,GLint first,GLsizei count,GLenum array_id,GLESpointer* p);
     void convertIndirect(GLESConversionArrays& fArrs,GLsizei count,GLenum type,const GLvoid* indices,GLenum array_id,GLESpointer* p);
     void convertIndirectVBO(GLESConversionArrays& fArrs,GLsizei count,GLenum indices_type,const GLvoid* indices,GLenum array_id,GLESpointer* p);
+    // Make sure the buffer |p| points into keeps a CPU copy to convert.
+    void ensureBufferShadow(GLESpointer* p);
     static void initCapsLocked(const GLubyte * extensionString);
     virtual void initExtensionString() =0;
 
@@ -667,6 +701,14 @@ private:
 
     bool m_primitiveRestartEnabled = false;
 
+    uint64_t bindingCacheKey(GLenum target) const;
+    bool countRedundant(bool redundant);
+    static bool readStateFilterEnabled();
+    const bool m_stateFilterEnabled = readStateFilterEnabled();
+    // Binding point (see bindingCacheKey()) -> global name last bound.
+    std::unordered_map<uint64_t, GLuint> m_bindingCache;
+    uint64_t m_bindingCacheSerial = 0;
+
     struct ImageBlitState {
         GLuint program = 0;
         GLuint samplerLoc = 0;
@@ -693,6 +735,10 @@ private:
     void setupImageBlitState();
     bool setupImageBlitForTexture(uint32_t width, uint32_t height,
                                   GLint internalFormat);
+    // Single-pass variant of blitFromReadBufferToTextureFlipped(). Returns
+    // false if the read buffer cannot be blitted directly.
+    bool blitDefaultReadBufferToTextureFlipped(GLuint globalTexObj,
+                                               GLuint width, GLuint height);
 };
 
 #endif
@@ -20,6 +20,10 @@
 
 #define MAX_SUPPORTED_PALETTE 10
 
-unsigned char* uncompressTexture(GLenum internalformat,GLenum& formatOut,GLsizei width,GLsizei height,GLsizei imageSize, const GLvoid* data,GLint level);
+// Expands mipmap |level| of a GL_PALETTE* texture to GL_RGB or GL_RGBA
+// (returned in |formatOut|). The result lives in the calling thread's
+// texture conversion buffer (see getTextureConversionBuffer()) and is only
+// valid until the next conversion on that thread.
+const unsigned char* uncompressTexture(GLenum internalformat,GLenum& formatOut,GLsizei width,GLsizei height,GLsizei imageSize, const GLvoid* data,GLint level);
 
 #endif
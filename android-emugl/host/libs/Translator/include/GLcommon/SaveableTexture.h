@@ -58,6 +58,11 @@ public:
     using creator_t = SaveableTexture* (*)(GlobalNameSpace*, loader_t&&);
     using restorer_t = void (*)(SaveableTexture*);
 
+    // The order in which GLBackgroundLoader restores textures after a load,
+    // most urgent first: the ones backing EglImages (i.e. ColorBuffers, which
+    // get posted), then the ones bound in a context, then everything else.
+    enum class RestorePriority { EglImage, Bound, Background };
+
     SaveableTexture() = delete;
     SaveableTexture(SaveableTexture&&) = delete;
     SaveableTexture(GlobalNameSpace* globalNameSpace, loader_t&& loader);
@@ -78,9 +83,21 @@ public:
     void fillEglImage(EglImage* eglImage);
     void loadFromStream(android::base::Stream* stream);
     void makeDirty();
+    // A texture is dirty if its contents changed since it was last saved or
+    // loaded. A clean texture can be saved by pointing the snapshot at the
+    // data that was saved or loaded back then, referenced by |chunk|.
     bool isDirty() const;
+    void setSnapshotChunk(uint64_t chunk);
+    uint64_t snapshotChunk() const;
     void setTarget(GLenum target);
     void setMipmapLevelAtLeast(unsigned int level);
+    // Only ever raises the priority; set while loading, before the
+    // background loader starts.
+    void raiseRestorePriority(RestorePriority priority);
+    RestorePriority restorePriority() const;
+    // How long restore() took, i.e. how long whoever touched the texture
+    // first had to wait for it.
+    uint64_t restoreDurationUs() const;
 
     unsigned int getGlobalName();
 
@@ -89,6 +106,8 @@ public:
     void restore();
 
 private:
+    void restoreFromSnapshot();
+
     unsigned int m_target = GL_TEXTURE_2D;
     unsigned int m_width = 0;
     unsigned int m_height = 0;
@@ -114,6 +133,11 @@ private:
     loader_t m_loader;
     GlobalNameSpace* m_globalNamespace = nullptr;
     bool m_isDirty = true;
+    // Where the contents are saved when the texture is clean, see
+    // android::snapshot::ITextureSaver::chunkFor().
+    uint64_t m_snapshotChunk = 0;
+    RestorePriority m_restorePriority = RestorePriority::Background;
+    uint64_t m_restoreDurationUs = 0;
     std::atomic<bool> m_loadedFromStream { false };
 };
 
@@ -0,0 +1,116 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "emugl/common/mutex.h"
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include <list>
+#include <unordered_map>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Deduplicates glTexImage2D uploads of identical images.
+//
+// Apps running side by side upload the same assets (fonts, launcher
+// icons, nine-patches) into textures of their own. Once an image has been
+// uploaded twice, a GPU side copy of it is kept here, keyed by a hash of
+// the pixels plus size and format, and later uploads of the same image
+// are served by copying that texture on the GPU instead of pushing the
+// pixels through the driver again.
+//
+// Opt-in: ANDROID_EMUGL_TEXTURE_DEDUP_MB sets how many megabytes of
+// textures are kept (unset or 0 disables it). Only desktop GL hosts are
+// supported, as the copies go through GL_READ_FRAMEBUFFER.
+//
+// All methods that touch GL must be called with a translator context
+// current; cached textures live in the global share group.
+class TextureUploadCache {
+public:
+    struct Key {
+        uint64_t hash;
+        GLsizei width;
+        GLsizei height;
+        GLint internalFormat;
+        GLenum format;
+        GLenum type;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash && width == other.width &&
+                   height == other.height &&
+                   internalFormat == other.internalFormat &&
+                   format == other.format && type == other.type;
+        }
+    };
+
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t savedBytes;
+        uint64_t cachedBytes;
+    };
+
+    // Returns the cache, or nullptr if deduplication is disabled.
+    static TextureUploadCache* get();
+
+    // Fills |key| for uploading |pixels| as level 0 of a 2D texture, and
+    // returns false if such uploads are not cached. Assumes no unpack
+    // buffer, row length or skips are set.
+    static bool makeKey(GLsizei width, GLsizei height, GLint internalFormat,
+                        GLenum format, GLenum type, GLint unpackAlignment,
+                        const void* pixels, Key* key);
+
+    // If an image matching |key| is cached, defines level 0 of the texture
+    // bound to GL_TEXTURE_2D with a copy of it and returns true.
+    bool copyToBoundTexture(const Key& key);
+
+    // Called after the image for |key| was uploaded to |texture| (bound to
+    // GL_TEXTURE_2D). Keeps a copy of it if the image was seen before.
+    void onUploaded(const Key& key, GLuint texture);
+
+    Stats getStats();
+
+    explicit TextureUploadCache(size_t capBytes);
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return (size_t)key.hash; }
+    };
+    struct Entry {
+        Key key;
+        GLuint tex;
+        size_t bytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    void trimLocked(size_t capBytes);
+
+    emugl::Mutex mLock;
+    const size_t mCapBytes;
+    // Most recently used first.
+    EntryList mEntries;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> mIndex;
+    // Images uploaded once, which get cached on their second upload.
+    std::unordered_map<Key, bool, KeyHash> mSeen;
+    size_t mCachedBytes = 0;
+
+    uint64_t mHits = 0;
+    uint64_t mMisses = 0;
+    uint64_t mSavedBytes = 0;
+};
@@ -42,6 +42,12 @@ void doCompressedTexImage2D(GLEScontext* ctx, GLenum target, GLint level,
                             GLsizei height, GLint border, GLsizei imageSize,
                             const GLvoid* data, glTexImage2D_t glTexImage2DPtr);
 void deleteRenderbufferGlobal(GLuint rbo);
+
+// Returns a 64-byte aligned buffer of at least |size| bytes that belongs to
+// the calling thread. Decompressed texture data is written there before it
+// is uploaded, so uploads don't allocate (and fault in) a new image every
+// time. The contents are only valid until the next call on the same thread.
+unsigned char* getTextureConversionBuffer(size_t size);
 GLenum decompressedInternalFormat(GLEScontext* ctx, GLenum compressedFormat);
 
 bool isCubeMapFaceTarget(GLenum target);
@@ -42,6 +42,8 @@ public:
    // virtual const unsigned char *read(void *buf, size_t inout_len);
 
     bool valid() { return m_sock >= 0; }
+    // The socket, for callers that wait for data with poll() or epoll.
+    int getSocket() const { return m_sock; }
     virtual int recv(void *buf, size_t len);
     virtual int writeFully(const void *buf, size_t len);
     virtual const unsigned char * readFully( void *buf, size_t len);
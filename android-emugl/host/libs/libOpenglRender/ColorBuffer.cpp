@@ -16,9 +16,12 @@
 #include "ColorBuffer.h"
 
 #include "android/base/memory/ScopedPtr.h"
+#include "android/base/system/System.h"
 
+#include "ColorBufferTexturePool.h"
 #include "DispatchTables.h"
 #include "GLcommon/GLutils.h"
+#include "PixelConvert.h"
 #include "RenderThreadInfo.h"
 #include "TextureDraw.h"
 #include "TextureResize.h"
@@ -30,6 +33,10 @@
 
 #include <GLES2/gl2ext.h>
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include <stdio.h>
 #include <string.h>
 
@@ -81,6 +88,48 @@ void unbindFbo() {
 
 ColorBuffer::Helper::~Helper() = default;
 
+// Zero the content of |tex|, which must be bound to GL_TEXTURE_2D. Clearing
+// through a temporary FBO avoids allocating and uploading a zeroed image of
+// the full buffer size; formats that are not color-renderable fall back to
+// that upload. Runs in the helper context, where nothing relies on the
+// clear color, scissor test or color mask: they are set instead of queried
+// and restored.
+static bool sZeroTexture(GLuint tex, GLsizei width, GLsizei height,
+                         GLenum texFormat, GLenum pixelType, size_t bufsize) {
+    GLuint fbo = 0;
+    bool cleared = false;
+    s_gles2.glGenFramebuffers(1, &fbo);
+    s_gles2.glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    s_gles2.glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                   GL_TEXTURE_2D, tex, 0);
+    if (s_gles2.glCheckFramebufferStatus(GL_FRAMEBUFFER) ==
+        GL_FRAMEBUFFER_COMPLETE) {
+        s_gles2.glDisable(GL_SCISSOR_TEST);
+        s_gles2.glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        s_gles2.glClearColor(0.f, 0.f, 0.f, 0.f);
+        s_gles2.glClear(GL_COLOR_BUFFER_BIT);
+        cleared = true;
+    }
+    s_gles2.glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    s_gles2.glDeleteFramebuffers(1, &fbo);
+    if (cleared) {
+        return true;
+    }
+
+    android::base::ScopedCPtr<char> zeroImage(
+            static_cast<char*>(::calloc(bufsize, 1)));
+    if (!zeroImage) {
+        fprintf(stderr,
+                "error: failed to allocate initial memory for ColorBuffer "
+                "of size %dx%d (%zu KB)\n",
+                width, height, bufsize / 1024);
+        return false;
+    }
+    s_gles2.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, texFormat,
+                            pixelType, zeroImage.get());
+    return true;
+}
+
 static GLenum sGetUnsizedColorBufferFormat(GLenum format) {
     switch (format) {
         case GL_R8:
@@ -202,6 +251,8 @@ ColorBuffer* ColorBuffer::create(EGLDisplay p_display,
                                  HandleType hndl,
                                  Helper* helper,
                                  bool fastBlitSupported) {
+    const uint64_t createStartUs =
+            android::base::System::get()->getHighResTimeUs();
     GLenum texFormat = 0;
     GLenum pixelType = GL_UNSIGNED_BYTE;
     int bytesPerPixel = 4;
@@ -220,16 +271,6 @@ ColorBuffer* ColorBuffer::create(EGLDisplay p_display,
 
     const unsigned long bufsize = ((unsigned long)bytesPerPixel) * p_width
             * p_height;
-    android::base::ScopedCPtr<char> initialImage(
-                static_cast<char*>(::malloc(bufsize)));
-    if (!initialImage) {
-        fprintf(stderr,
-                "error: failed to allocate initial memory for ColorBuffer "
-                "of size %dx%dx%d (%lu KB)\n",
-                p_width, p_height, bytesPerPixel * 8, bufsize / 1024);
-        return nullptr;
-    }
-    memset(initialImage.get(), 0x0, bufsize);
 
     RecursiveScopedHelperContext context(helper);
     if (!context.isOk()) {
@@ -242,31 +283,33 @@ ColorBuffer* ColorBuffer::create(EGLDisplay p_display,
     s_gles2.glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevUnpackAlignment);
     s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-    s_gles2.glGenTextures(1, &cb->m_tex);
-    s_gles2.glBindTexture(GL_TEXTURE_2D, cb->m_tex);
-
-    s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, p_internalFormat, p_width, p_height,
-                         0, texFormat, pixelType,
-                         initialImage.get());
-    initialImage.reset();
+    // Reuse the texture of a recently destroyed ColorBuffer of the same
+    // size and format when there is one; it only needs to be cleared.
+    ColorBufferTexturePool* pool = ColorBufferTexturePool::get();
+    cb->m_tex = pool->acquire(p_width, p_height, p_internalFormat, pixelType);
+    if (cb->m_tex) {
+        s_gles2.glBindTexture(GL_TEXTURE_2D, cb->m_tex);
+    } else {
+        s_gles2.glGenTextures(1, &cb->m_tex);
+        s_gles2.glBindTexture(GL_TEXTURE_2D, cb->m_tex);
+        s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, p_internalFormat, p_width,
+                             p_height, 0, texFormat, pixelType, NULL);
+    }
+    if (!sZeroTexture(cb->m_tex, p_width, p_height, texFormat, pixelType,
+                      bufsize)) {
+        s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlignment);
+        delete cb;
+        return nullptr;
+    }
+    cb->m_texPoolable = true;
 
     s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    //
-    // create another texture for that colorbuffer for blit
-    //
-    s_gles2.glGenTextures(1, &cb->m_blitTex);
-    s_gles2.glBindTexture(GL_TEXTURE_2D, cb->m_blitTex);
-    s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, p_internalFormat, p_width, p_height,
-                         0, texFormat, pixelType, NULL);
-
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // The blit texture and the resizer are created the first time
+    // blitFromCurrentReadBuffer() / scale() need them.
 
     cb->m_width = p_width;
     cb->m_height = p_height;
@@ -279,12 +322,6 @@ ColorBuffer* ColorBuffer::create(EGLDisplay p_display,
             p_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
             (EGLClientBuffer)SafePointerFromUInt(cb->m_tex), NULL);
 
-    cb->m_blitEGLImage = s_egl.eglCreateImageKHR(
-            p_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
-            (EGLClientBuffer)SafePointerFromUInt(cb->m_blitTex), NULL);
-
-    cb->m_resizer = new TextureResize(p_width, p_height);
-
     cb->m_frameworkFormat = p_frameworkFormat;
     switch (cb->m_frameworkFormat) {
         case FRAMEWORK_FORMAT_GL_COMPATIBLE:
@@ -304,18 +341,151 @@ ColorBuffer* ColorBuffer::create(EGLDisplay p_display,
         cb->m_asyncReadbackType = GL_UNSIGNED_INT_8_8_8_8_REV;
     }
 
+    // GLES only has to support GL_RGBA readbacks; GL_BGRA_EXT needs
+    // GL_EXT_read_format_bgra, which the translator also reports when the
+    // host GL reads back BGRA natively. Without it, the CPU swaps.
+    static const bool bgraReadbackSupported = [] {
+        const char* s = (const char*)s_gles2.glGetString(GL_EXTENSIONS);
+        return emugl::hasExtension(s ? s : "", "GL_EXT_read_format_bgra");
+    }();
+    cb->m_bgraReadbackSupported = bgraReadbackSupported;
+
     cb->m_numBytes = (size_t)bufsize;
+    cb->trackResidentBytes(cb->m_numBytes);
 
     s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlignment);
     s_gles2.glFinish();
+
+    pool->onColorBufferCreated(
+            android::base::System::get()->getHighResTimeUs() - createStartUs);
     return cb;
 }
 
+bool ColorBuffer::ensureBlitTexture() {
+    if (m_blitEGLImage) {
+        return true;
+    }
+
+    s_gles2.glGenTextures(1, &m_blitTex);
+    s_gles2.glBindTexture(GL_TEXTURE_2D, m_blitTex);
+    s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_width, m_height,
+                         0, m_format, m_type, NULL);
+
+    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_blitEGLImage = s_egl.eglCreateImageKHR(
+            m_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
+            (EGLClientBuffer)SafePointerFromUInt(m_blitTex), NULL);
+    if (!m_blitEGLImage) {
+        s_gles2.glDeleteTextures(1, &m_blitTex);
+        m_blitTex = 0;
+        return false;
+    }
+    trackResidentBytes(m_numBytes);
+    return true;
+}
+
+TextureResize* ColorBuffer::getResizer() {
+    if (!m_resizer) {
+        m_resizer = new TextureResize(m_width, m_height);
+    }
+    return m_resizer;
+}
+
+size_t ColorBuffer::getResidentBytes() const {
+    return (size_t)m_residentBytes + m_resizeCacheBytes;
+}
+
+size_t ColorBuffer::dropResizeCache() {
+    if (!m_resizer ||
+        s_egl.eglGetCurrentContext() == EGL_NO_CONTEXT) {
+        return 0;
+    }
+    const size_t bytes = m_resizer->getResidentBytes();
+    delete m_resizer;
+    m_resizer = nullptr;
+    m_resizeCacheBytes = 0;
+    // |m_scaleRotationFbo| is attached to one of the resizer's textures.
+    if (m_scaleRotationFbo) {
+        s_gles2.glDeleteFramebuffers(1, &m_scaleRotationFbo);
+        m_scaleRotationFbo = 0;
+    }
+    return bytes;
+}
+
+void ColorBuffer::trackResidentBytes(int64_t delta) {
+    m_residentBytes += delta;
+    ColorBufferTexturePool::get()->addResidentBytes(delta);
+}
+
+// Serials of different ColorBuffers never overlap, so that a consumer can
+// tell a recreated buffer with a recycled handle from the old one.
+static std::atomic<uint64_t> sDamageSerialBase{0};
+
 ColorBuffer::ColorBuffer(EGLDisplay display, HandleType hndl, Helper* helper)
     : m_display(display), m_helper(helper), mHndl(hndl), 
-    m_pre_record_time(0), m_record_counter(0){}
+    m_pre_record_time(0), m_record_counter(0),
+    m_contentSerial((sDamageSerialBase.fetch_add(1) + 1) << 32) {}
+
+uint64_t ColorBuffer::getContentSerial() const {
+    android::base::AutoLock lock(m_damageLock);
+    return m_contentSerial;
+}
+
+bool ColorBuffer::getDamage(uint64_t from, uint64_t to,
+                            hwc_rect_t* damage) const {
+    android::base::AutoLock lock(m_damageLock);
+    if (m_damageUntracked || from > to || to > m_contentSerial ||
+        m_contentSerial - from > kDamageLogSize ||
+        (from >> 32) != (m_contentSerial >> 32)) {
+        return false;
+    }
+    *damage = {0, 0, 0, 0};
+    for (uint64_t s = from + 1; s <= to; ++s) {
+        const DamageEntry& entry = m_damageLog[s % kDamageLogSize];
+        if (entry.serial != s) {
+            return false;
+        }
+        const hwc_rect_t& r = entry.rect;
+        if (damage->right <= damage->left || damage->bottom <= damage->top) {
+            *damage = r;
+        } else {
+            damage->left = std::min(damage->left, r.left);
+            damage->top = std::min(damage->top, r.top);
+            damage->right = std::max(damage->right, r.right);
+            damage->bottom = std::max(damage->bottom, r.bottom);
+        }
+    }
+    return true;
+}
+
+void ColorBuffer::addDamage(int x, int y, int width, int height) {
+    android::base::AutoLock lock(m_damageLock);
+    ++m_contentSerial;
+    DamageEntry& entry = m_damageLog[m_contentSerial % kDamageLogSize];
+    entry.serial = m_contentSerial;
+    entry.rect = {std::max(x, 0), std::max(y, 0),
+                  std::min(x + width, (int)m_width),
+                  std::min(y + height, (int)m_height)};
+}
+
+bool ColorBuffer::isDamageTracked() const {
+    android::base::AutoLock lock(m_damageLock);
+    return !m_damageUntracked;
+}
+
+void ColorBuffer::setDamageUntracked() {
+    android::base::AutoLock lock(m_damageLock);
+    m_damageUntracked = true;
+}
 
 ColorBuffer::~ColorBuffer() {
+    const uint64_t destroyStartUs =
+            android::base::System::get()->getHighResTimeUs();
     FrameBuffer *fb = FrameBuffer::getFB();
     if (fb) {
         fb->removeCaptureScreenColorBuffer(mHndl);
@@ -343,14 +513,26 @@ ColorBuffer::~ColorBuffer() {
 
     m_yuv_converter.reset();
 
-    GLuint tex[2] = {m_tex, m_blitTex};
-    s_gles2.glDeleteTextures(2, tex);
+    if (m_blitTex) {
+        s_gles2.glDeleteTextures(1, &m_blitTex);
+    }
+    ColorBufferTexturePool* pool = ColorBufferTexturePool::get();
+    if (m_texPoolable && context.isOk()) {
+        pool->release(m_tex, m_width, m_height, m_internalFormat, m_type,
+                      m_numBytes);
+    } else if (m_tex) {
+        s_gles2.glDeleteTextures(1, &m_tex);
+    }
 
     if (m_memoryObject) {
         s_gles2.glDeleteMemoryObjectsEXT(1, &m_memoryObject);
     }
 
     delete m_resizer;
+
+    trackResidentBytes(-m_residentBytes);
+    pool->onColorBufferDestroyed(
+            android::base::System::get()->getHighResTimeUs() - destroyStartUs);
 }
 
 inline int64_t get_micro_time()
@@ -453,7 +635,11 @@ void ColorBuffer::readPixelsScaled(int width,
     }
     p_format = sGetUnsizedColorBufferFormat(p_format);
     touch();
-    GLuint tex = m_resizer->update(m_tex, width, height, rotation);
+    if (readPixelsRotated(width, height, p_format, p_type, rotation, pixels)) {
+        return;
+    }
+    GLuint tex = getResizer()->update(m_tex, width, height, rotation);
+    m_resizeCacheBytes = m_resizer->getResidentBytes();
     if (bindFbo(&m_scaleRotationFbo, tex)) {
         GLint prevAlignment = 0;
         s_gles2.glGetIntegerv(GL_PACK_ALIGNMENT, &prevAlignment);
@@ -464,6 +650,58 @@ void ColorBuffer::readPixelsScaled(int width,
     }
 }
 
+bool ColorBuffer::readPixelsRotated(int width,
+                                    int height,
+                                    GLenum p_format,
+                                    GLenum p_type,
+                                    SkinRotation rotation,
+                                    void* pixels) {
+    const bool sideways =
+            rotation == SKIN_ROTATION_90 || rotation == SKIN_ROTATION_270;
+    if (p_format != GL_RGBA || p_type != GL_UNSIGNED_BYTE ||
+        width != (int)(sideways ? m_height : m_width) ||
+        height != (int)(sideways ? m_width : m_height)) {
+        return false;
+    }
+    // Only formats glReadPixels converts to RGBA8 exactly, and whose colors
+    // don't depend on texture swizzles the resizer's sampling would apply.
+    if (m_BRSwizzle || m_frameworkFormat != FRAMEWORK_FORMAT_GL_COMPATIBLE) {
+        return false;
+    }
+    switch (m_internalFormat) {
+        case GL_RGB:
+        case GL_RGB8:
+        case GL_RGBA:
+        case GL_RGBA8:
+            break;
+        default:
+            return false;
+    }
+    if (!bindFbo(&m_fbo, m_tex)) {
+        return false;
+    }
+
+    // Rows are read back bottom-up, just like the resizer's output is, so
+    // the rotation is all that's left to do. The resizer renders into an
+    // RGB texture, so alpha is made opaque to match.
+    const ptrdiff_t stride = 4 * m_width;
+    if (rotation == SKIN_ROTATION_0) {
+        s_gles2.glReadPixels(0, 0, m_width, m_height, GL_RGBA,
+                             GL_UNSIGNED_BYTE, pixels);
+        unbindFbo();
+        emugl::rotatePixels(pixels, stride, m_width, m_height, pixels, stride,
+                            SKIN_ROTATION_0, true /* opaque */);
+        return true;
+    }
+    std::vector<uint8_t> unrotated(stride * m_height);
+    s_gles2.glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE,
+                         unrotated.data());
+    unbindFbo();
+    emugl::rotatePixels(unrotated.data(), stride, m_width, m_height, pixels,
+                        4 * width, rotation, true /* opaque */);
+    return true;
+}
+
 void ColorBuffer::readPixelsYUVCached(int x,
                                       int y,
                                       int width,
@@ -523,9 +761,11 @@ void ColorBuffer::reformat(GLint internalformat, GLenum type) {
     s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_width, m_height,
                          0, texFormat, pixelType, nullptr);
 
-    s_gles2.glBindTexture(GL_TEXTURE_2D, m_blitTex);
-    s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_width, m_height,
-                         0, texFormat, pixelType, nullptr);
+    if (m_blitTex) {
+        s_gles2.glBindTexture(GL_TEXTURE_2D, m_blitTex);
+        s_gles2.glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_width,
+                             m_height, 0, texFormat, pixelType, nullptr);
+    }
 
     // EGL images need to be recreated because the EGL_KHR_image_base spec
     // states that respecifying an image (i.e. glTexImage2D) will generally
@@ -535,10 +775,12 @@ void ColorBuffer::reformat(GLint internalformat, GLenum type) {
             m_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
             (EGLClientBuffer)SafePointerFromUInt(m_tex), NULL);
 
-    s_egl.eglDestroyImageKHR(m_display, m_blitEGLImage);
-    m_blitEGLImage = s_egl.eglCreateImageKHR(
-            m_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
-            (EGLClientBuffer)SafePointerFromUInt(m_blitTex), NULL);
+    if (m_blitTex) {
+        s_egl.eglDestroyImageKHR(m_display, m_blitEGLImage);
+        m_blitEGLImage = s_egl.eglCreateImageKHR(
+                m_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
+                (EGLClientBuffer)SafePointerFromUInt(m_blitTex), NULL);
+    }
 
     s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -547,12 +789,17 @@ void ColorBuffer::reformat(GLint internalformat, GLenum type) {
     m_type = pixelType;
     m_sizedInternalFormat = sizedInternalFormat;
 
-    m_numBytes = bpp * m_width * m_height;
+    const size_t numBytes = bpp * m_width * m_height;
+    trackResidentBytes(((int64_t)numBytes - (int64_t)m_numBytes) *
+                       (m_blitTex ? 2 : 1));
+    m_numBytes = numBytes;
+    addFullDamage();
 }
 
 void ColorBuffer::swapYUVTextures(uint32_t type, uint32_t* textures) {
     if (type == FRAMEWORK_FORMAT_NV12) {
         m_yuv_converter->swapTextures(type, textures);
+        addFullDamage();
     } else {
         fprintf(stderr,
                 "%s: ERROR: format other than NV12 is not supported: 0x%x\n",
@@ -607,6 +854,8 @@ void ColorBuffer::subUpdate(int x,
         s_gles2.glFlush();
         m_sync = (GLsync)s_egl.eglSetImageFenceANDROID(m_display, m_eglImage);
     }
+
+    addDamage(x, y, width, height);
 }
 
 bool ColorBuffer::replaceContents(const void* newContents, size_t numBytes) {
@@ -630,6 +879,7 @@ bool ColorBuffer::replaceContents(const void* newContents, size_t numBytes) {
     }
 
     touch();
+    addFullDamage();
 
     s_gles2.glBindTexture(GL_TEXTURE_2D, m_tex);
     s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -671,11 +921,19 @@ bool ColorBuffer::blitFromCurrentReadBuffer() {
     }
 
     touch();
+    addFullDamage();
 
     if (m_fastBlitSupported) {
         s_egl.eglBlitFromCurrentReadBufferANDROID(m_display, m_eglImage);
         m_sync = (GLsync)s_egl.eglSetImageFenceANDROID(m_display, m_eglImage);
     } else {
+        if (!m_blitEGLImage) {
+            RecursiveScopedHelperContext context(m_helper);
+            if (!context.isOk() || !ensureBlitTexture()) {
+                return false;
+            }
+        }
+
         // Copy the content of the current read surface into m_blitEGLImage.
         // This is done by creating a temporary texture, bind it to the EGLImage
         // then call glCopyTexSubImage2D().
@@ -881,6 +1139,8 @@ bool ColorBuffer::bindToTexture() {
             return false;
         }
         touch();
+        setDamageUntracked();
+        m_texPoolable = false;
 
         if (tInfo->currContext->clientVersion() > GLESApi_CM) {
             s_gles2.glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, m_eglImage);
@@ -897,6 +1157,8 @@ bool ColorBuffer::bindToTexture2() {
         return false;
     }
 
+    setDamageUntracked();
+    m_texPoolable = false;
     s_gles2.glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, m_eglImage);
     return true;
 }
@@ -910,6 +1172,8 @@ bool ColorBuffer::bindToRenderbuffer() {
         return false;
     }
     touch();
+    setDamageUntracked();
+    m_texPoolable = false;
     if (tInfo->currContext->clientVersion() > GLESApi_CM) {
         s_gles2.glEGLImageTargetRenderbufferStorageOES(GL_RENDERBUFFER_OES,
                                                        m_eglImage);
@@ -920,8 +1184,10 @@ bool ColorBuffer::bindToRenderbuffer() {
     return true;
 }
 
-GLuint ColorBuffer::scale() {
-    return m_resizer->update(m_tex);
+GLuint ColorBuffer::scale(int viewportWidth, int viewportHeight) {
+    GLuint tex = getResizer()->update(m_tex, viewportWidth, viewportHeight);
+    m_resizeCacheBytes = m_resizer->getResidentBytes();
+    return tex;
 }
 
 void ColorBuffer::setSync(bool debug) {
@@ -999,29 +1265,47 @@ void ColorBuffer::readback(unsigned char* img, bool readbackBgra) {
     if (bindFbo(&m_fbo, m_tex)) {
         // Flip the readback format if RED/BLUE components are swizzled.
         bool shouldReadbackBgra = m_BRSwizzle ? !readbackBgra : readbackBgra;
-        GLenum format = shouldReadbackBgra ? GL_BGRA_EXT : GL_RGBA;
+        const bool swapOnCpu = shouldReadbackBgra && !m_bgraReadbackSupported;
+        GLenum format =
+                shouldReadbackBgra && !swapOnCpu ? GL_BGRA_EXT : GL_RGBA;
 
         s_gles2.glReadPixels(0, 0, m_width, m_height, format, GL_UNSIGNED_BYTE, img);
         unbindFbo();
+        if (swapOnCpu) {
+            emugl::swapRedBlue(img, 4 * m_width, img, 4 * m_width, m_width,
+                               m_height);
+        }
     }
 }
 
-void ColorBuffer::readbackAsync(GLuint buffer, bool readbackBgra) {
+GLsync ColorBuffer::readbackAsync(GLuint buffer, bool readbackBgra,
+                                  bool* swapRedBlue) {
+    *swapRedBlue = false;
     RecursiveScopedHelperContext context(m_helper);
     if (!context.isOk()) {
-        return;
+        return nullptr;
     }
     touch();
     waitSync();
 
+    GLsync fence = nullptr;
     if (bindFbo(&m_fbo, m_tex)) {
         s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
         bool shouldReadbackBgra = m_BRSwizzle ? !readbackBgra : readbackBgra;
-        GLenum format = shouldReadbackBgra ? GL_BGRA_EXT : GL_RGBA;
+        // The pixels are swapped when they are copied out of |buffer|.
+        *swapRedBlue = shouldReadbackBgra && !m_bgraReadbackSupported;
+        GLenum format = shouldReadbackBgra && !*swapRedBlue ? GL_BGRA_EXT
+                                                            : GL_RGBA;
         s_gles2.glReadPixels(0, 0, m_width, m_height, format, m_asyncReadbackType, 0);
         s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
         unbindFbo();
+        if (s_gles2.glFenceSync) {
+            fence = s_gles2.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        // Other contexts wait on the fence; make sure it gets to the GPU.
+        s_gles2.glFlush();
     }
+    return fence;
 }
 
 HandleType ColorBuffer::getHndl() const {
@@ -1034,8 +1318,8 @@ void ColorBuffer::onSave(android::base::Stream* stream) {
     stream->putBe32(static_cast<uint32_t>(m_height));
     stream->putBe32(static_cast<uint32_t>(m_internalFormat));
     stream->putBe32(static_cast<uint32_t>(m_frameworkFormat));
-    // for debug
-    assert(m_eglImage && m_blitEGLImage);
+    // for debug; the blit image is only created on demand.
+    assert(m_eglImage);
     stream->putBe32(reinterpret_cast<uintptr_t>(m_eglImage));
     stream->putBe32(reinterpret_cast<uintptr_t>(m_blitEGLImage));
     stream->putBe32(m_needFormatCheck);
@@ -1063,7 +1347,7 @@ ColorBuffer* ColorBuffer::onLoad(android::base::Stream* stream,
     cb->mNeedRestore = true;
     cb->m_eglImage = eglImage;
     cb->m_blitEGLImage = blitEGLImage;
-    assert(eglImage && blitEGLImage);
+    assert(eglImage);
     cb->m_width = width;
     cb->m_height = height;
     cb->m_internalFormat = internalFormat;
@@ -1079,11 +1363,12 @@ void ColorBuffer::restore() {
     s_gles2.glBindTexture(GL_TEXTURE_2D, m_tex);
     s_gles2.glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, m_eglImage);
 
-    s_gles2.glGenTextures(1, &m_blitTex);
-    s_gles2.glBindTexture(GL_TEXTURE_2D, m_blitTex);
-    s_gles2.glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, m_blitEGLImage);
+    if (m_blitEGLImage) {
+        s_gles2.glGenTextures(1, &m_blitTex);
+        s_gles2.glBindTexture(GL_TEXTURE_2D, m_blitTex);
+        s_gles2.glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, m_blitEGLImage);
+    }
 
-    m_resizer = new TextureResize(m_width, m_height);
     switch (m_frameworkFormat) {
         case FRAMEWORK_FORMAT_GL_COMPATIBLE:
             break;
@@ -1095,6 +1380,7 @@ void ColorBuffer::restore() {
         default:
             break;
     }
+    addFullDamage();
 }
 
 
@@ -1145,7 +1431,11 @@ bool ColorBuffer::importMemory(
         readContents(&bytes, prevContents.data());
     }
 
+    // The new texture is backed by imported memory and must not be recycled.
+    // Vulkan writes to it are not seen here either.
+    setDamageUntracked();
     s_gles2.glDeleteTextures(1, &m_tex);
+    m_texPoolable = false;
     s_gles2.glGenTextures(1, &m_tex);
     s_gles2.glBindTexture(GL_TEXTURE_2D, m_tex);
 
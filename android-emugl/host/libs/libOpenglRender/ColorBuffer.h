@@ -21,6 +21,7 @@
 #include <GLES/gl.h>
 #include <GLES3/gl3.h>
 #include "android/base/files/Stream.h"
+#include "android/base/synchronization/Lock.h"
 #include "android/skin/rect.h"
 #include "android/snapshot/LazySnapshotObj.h"
 #include "emugl/common/smart_ptr.h"
@@ -29,6 +30,7 @@
 #include "RenderContext.h"
 #include "GrabberHelper.h"
 
+#include <atomic>
 #include <memory>
 
 class TextureDraw;
@@ -159,6 +161,16 @@ public:
     GLuint getHeight() const { return m_height; }
     GLint getInternalFormat() const { return m_internalFormat; }
 
+    // Return the GPU memory held by this ColorBuffer, including its
+    // resize cache.
+    size_t getResidentBytes() const;
+
+    // Free the intermediate textures used by scale() and
+    // readPixelsScaled(). They are recreated on next use. Returns the
+    // number of bytes released. Must run on the post thread, in the
+    // context scale() runs in.
+    size_t dropResizeCache();
+
     // Read the ColorBuffer instance's pixel values into host memory.
     void readPixels(int x,
                     int y,
@@ -210,9 +222,10 @@ public:
     // framebuffer object / window surface. This doesn't display anything.
     bool draw();
 
-    // Scale the underlying texture of this ColorBuffer to match viewport size.
+    // Scale the underlying texture of this ColorBuffer to match the viewport
+    // (0, 0, |viewportWidth|, |viewportHeight|) in place.
     // It returns the texture name after scaling.
-    GLuint scale();
+    GLuint scale(int viewportWidth, int viewportHeight);
     // Post this ColorBuffer to the host native sub-window.
     // |rotation| is the rotation angle in degrees, clockwise in the GL
     // coordinate space.
@@ -243,7 +256,12 @@ public:
     // |img| must be a buffer large enough (i.e. width * height * 4).
     void readback(unsigned char* img, bool readbackBgra = false);
     // readback() but async (to the specified |buffer|)
-    void readbackAsync(GLuint buffer, bool readbackBgra = false);
+    // Reads back into the pixel pack buffer |buffer| without waiting for the
+    // GPU. Returns a fence that signals when the readback is done, or null
+    // if fences aren't supported, in which case mapping |buffer| waits.
+    // |*swapRedBlue| is set if red and blue still have to be swapped on the
+    // CPU to get the format asked for.
+    GLsync readbackAsync(GLuint buffer, bool readbackBgra, bool* swapRedBlue);
 
     void onSave(android::base::Stream* stream);
     static ColorBuffer* onLoad(android::base::Stream* stream,
@@ -272,6 +290,19 @@ public:
 
     void setSync(bool debug = false);
     void waitSync(bool debug = false);
+
+    // Damage tracking. Every change of the contents bumps the content
+    // serial. getDamage() returns the bounding box of what changed after
+    // serial |from| up to and including |to|, in the texel coordinates used
+    // by subUpdate() (|top| is the first texture row, |right| and |bottom|
+    // are exclusive). It returns false if that is unknown and the whole
+    // buffer has to be treated as damaged.
+    uint64_t getContentSerial() const;
+    // False once the buffer may be written without its serial moving.
+    bool isDamageTracked() const;
+    bool getDamage(uint64_t from, uint64_t to, hwc_rect_t* damage) const;
+    void addDamage(int x, int y, int width, int height);
+    void addFullDamage() { addDamage(0, 0, m_width, m_height); }
     void setDisplay(uint32_t displayId) { m_displayId = displayId; }
     uint32_t getDisplay() { return m_displayId; }
     FrameworkFormat getFrameworkFormat() { return m_frameworkFormat; }
@@ -286,8 +317,29 @@ public:
 private:
     ColorBuffer(EGLDisplay display, HandleType hndl, Helper* helper);
 
+    // Create |m_blitTex| / |m_blitEGLImage| if needed. Must be called with
+    // the helper context current.
+    bool ensureBlitTexture();
+    TextureResize* getResizer();
+    // readPixelsScaled() without the resizer's draw, for RGBA screenshots
+    // at the size of the ColorBuffer: reads the pixels back as they are and
+    // rotates them on the CPU. Returns false if the request doesn't qualify.
+    bool readPixelsRotated(int width,
+                           int height,
+                           GLenum p_format,
+                           GLenum p_type,
+                           SkinRotation rotation,
+                           void* pixels);
+    void trackResidentBytes(int64_t delta);
+    void setDamageUntracked();
+
 private:
     GLuint m_tex = 0;
+    // Whether |m_tex| owns plain texture storage that can be handed to
+    // ColorBufferTexturePool on destruction. Cleared once |m_eglImage| is
+    // bound to another texture or renderbuffer, which keeps sharing the
+    // storage after the image is destroyed.
+    bool m_texPoolable = false;
     GLuint m_blitTex = 0;
     EGLImageKHR m_eglImage = nullptr;
     EGLImageKHR m_blitEGLImage = nullptr;
@@ -326,7 +378,29 @@ private:
     bool m_fastBlitSupported = false;
 
     GLenum m_asyncReadbackType = GL_UNSIGNED_BYTE;
+    // Whether glReadPixels can produce GL_BGRA_EXT without a conversion of
+    // its own; if not, BGRA readbacks are done as RGBA and swapped on the
+    // CPU.
+    bool m_bgraReadbackSupported = false;
     size_t m_numBytes = 0;
+    // GPU memory accounted to this ColorBuffer (|m_tex| and |m_blitTex|).
+    int64_t m_residentBytes = 0;
+    // Size of |m_resizer|'s textures. |m_resizer| belongs to the post
+    // thread, this is what other threads read instead.
+    std::atomic<size_t> m_resizeCacheBytes{0};
+
+    // Last kDamageLogSize content changes, indexed by serial.
+    static constexpr int kDamageLogSize = 16;
+    struct DamageEntry {
+        uint64_t serial;
+        hwc_rect_t rect;
+    };
+    mutable android::base::Lock m_damageLock;
+    uint64_t m_contentSerial = 0;
+    DamageEntry m_damageLog[kDamageLogSize] = {};
+    // Set once the guest may render into |m_tex| behind our back (EGLImage
+    // bound as a texture or renderbuffer, imported memory).
+    bool m_damageUntracked = false;
 
     bool m_importedMemory = false;
     GLuint m_memoryObject = 0;
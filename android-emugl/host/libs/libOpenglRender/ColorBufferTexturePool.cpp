@@ -0,0 +1,129 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "ColorBufferTexturePool.h"
+
+#include "DispatchTables.h"
+
+#include "android/base/StringFormat.h"
+#include "android/base/memory/LazyInstance.h"
+#include "android/base/system/System.h"
+
+#include <stdlib.h>
+
+using android::base::AutoLock;
+using android::base::LazyInstance;
+using android::base::System;
+
+static const size_t kDefaultCapMb = 64;
+
+static size_t sGetCapBytes() {
+    std::string env = System::get()->envGet("ANDROID_EMUGL_CB_POOL_MB");
+    size_t capMb = env.empty() ? kDefaultCapMb : strtoul(env.c_str(), nullptr, 10);
+    return capMb * 1024 * 1024;
+}
+
+static LazyInstance<ColorBufferTexturePool> sPool = LAZY_INSTANCE_INIT;
+
+// static
+ColorBufferTexturePool* ColorBufferTexturePool::get() {
+    return sPool.ptr();
+}
+
+ColorBufferTexturePool::ColorBufferTexturePool() : mCapBytes(sGetCapBytes()) {}
+
+GLuint ColorBufferTexturePool::acquire(GLsizei width, GLsizei height,
+                                       GLenum internalFormat, GLenum type) {
+    AutoLock lock(mLock);
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        if (it->width == width && it->height == height &&
+            it->internalFormat == internalFormat && it->type == type) {
+            GLuint tex = it->tex;
+            mPooledBytes -= it->bytes;
+            mEntries.erase(it);
+            ++mHits;
+            return tex;
+        }
+    }
+    ++mMisses;
+    return 0;
+}
+
+void ColorBufferTexturePool::release(GLuint tex, GLsizei width, GLsizei height,
+                                     GLenum internalFormat, GLenum type,
+                                     size_t bytes) {
+    if (!tex) {
+        return;
+    }
+    if (bytes > mCapBytes) {
+        s_gles2.glDeleteTextures(1, &tex);
+        return;
+    }
+    AutoLock lock(mLock);
+    trimLocked(mCapBytes - bytes);
+    mEntries.push_front({width, height, internalFormat, type, tex, bytes});
+    mPooledBytes += bytes;
+}
+
+void ColorBufferTexturePool::clear(ColorBuffer::Helper* helper) {
+    ColorBuffer::RecursiveScopedHelperContext context(helper);
+    if (!context.isOk()) {
+        return;
+    }
+    AutoLock lock(mLock);
+    trimLocked(0);
+}
+
+void ColorBufferTexturePool::trimLocked(size_t capBytes) {
+    while (mPooledBytes > capBytes && !mEntries.empty()) {
+        const Entry& victim = mEntries.back();
+        s_gles2.glDeleteTextures(1, &victim.tex);
+        mPooledBytes -= victim.bytes;
+        mEntries.pop_back();
+    }
+}
+
+void ColorBufferTexturePool::onColorBufferCreated(uint64_t latencyUs) {
+    AutoLock lock(mLock);
+    ++mCreateCount;
+    mCreateTotalUs += latencyUs;
+}
+
+void ColorBufferTexturePool::onColorBufferDestroyed(uint64_t latencyUs) {
+    AutoLock lock(mLock);
+    ++mDestroyCount;
+    mDestroyTotalUs += latencyUs;
+}
+
+void ColorBufferTexturePool::addResidentBytes(int64_t delta) {
+    AutoLock lock(mLock);
+    mResidentBytes += delta;
+}
+
+std::string ColorBufferTexturePool::printUsage() const {
+    AutoLock lock(mLock);
+    return android::base::StringFormat(
+            "ColorBuffer: created %llu (avg %llu us) destroyed %llu "
+            "(avg %llu us) resident %.2f mb; texture pool: %zu entries "
+            "%.2f mb, hits %llu misses %llu",
+            (unsigned long long)mCreateCount,
+            (unsigned long long)(mCreateCount ? mCreateTotalUs / mCreateCount : 0),
+            (unsigned long long)mDestroyCount,
+            (unsigned long long)(mDestroyCount ? mDestroyTotalUs / mDestroyCount : 0),
+            (float)mResidentBytes / 1048576.0f, mEntries.size(),
+            (float)mPooledBytes / 1048576.0f, (unsigned long long)mHits,
+            (unsigned long long)mMisses);
+}
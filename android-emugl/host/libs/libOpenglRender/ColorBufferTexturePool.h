@@ -0,0 +1,95 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "ColorBuffer.h"
+
+#include "android/base/synchronization/Lock.h"
+
+#include <GLES2/gl2.h>
+
+#include <list>
+#include <string>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Recycles the backing textures of destroyed ColorBuffers.
+//
+// Guests create and destroy gralloc buffers of a handful of sizes all the
+// time (window resizes, SurfaceView churn), and every new ColorBuffer used
+// to allocate and zero-fill a fresh texture. Released textures are kept
+// here, keyed by (width, height, internal format, type), and handed out
+// again on the next matching ColorBuffer::create().
+//
+// The pool holds at most ANDROID_EMUGL_CB_POOL_MB megabytes (default 64,
+// 0 disables pooling); the least recently released textures are deleted
+// first. acquire() and release() must be called with the ColorBuffer helper
+// context current. Only plain textures go in: ones that were ever the
+// source of an EGLImage target can still share storage with another
+// texture or renderbuffer.
+//
+// The pool also keeps the ColorBuffer create/destroy latency and resident
+// size counters reported by printUsage().
+class ColorBufferTexturePool {
+public:
+    ColorBufferTexturePool();
+
+    static ColorBufferTexturePool* get();
+
+    // Return a pooled texture matching the key, or 0 if there is none.
+    GLuint acquire(GLsizei width, GLsizei height, GLenum internalFormat,
+                   GLenum type);
+
+    // Give |tex| back to the pool, or delete it if it does not fit.
+    void release(GLuint tex, GLsizei width, GLsizei height,
+                 GLenum internalFormat, GLenum type, size_t bytes);
+
+    // Delete every pooled texture, with the |helper| context bound.
+    void clear(ColorBuffer::Helper* helper);
+
+    // Statistics.
+    void onColorBufferCreated(uint64_t latencyUs);
+    void onColorBufferDestroyed(uint64_t latencyUs);
+    void addResidentBytes(int64_t delta);
+    std::string printUsage() const;
+
+private:
+    struct Entry {
+        GLsizei width;
+        GLsizei height;
+        GLenum internalFormat;
+        GLenum type;
+        GLuint tex;
+        size_t bytes;
+    };
+
+    void trimLocked(size_t capBytes);
+
+    mutable android::base::Lock mLock;
+    // Most recently released first.
+    std::list<Entry> mEntries;
+    size_t mPooledBytes = 0;
+    const size_t mCapBytes;
+
+    uint64_t mHits = 0;
+    uint64_t mMisses = 0;
+    uint64_t mCreateCount = 0;
+    uint64_t mCreateTotalUs = 0;
+    uint64_t mDestroyCount = 0;
+    uint64_t mDestroyTotalUs = 0;
+    int64_t mResidentBytes = 0;
+};
@@ -0,0 +1,129 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "DecodeAheadReader.h"
+
+#include "ErrorLog.h"
+
+#include "emugl/common/crash_reporter.h"
+
+#include <string.h>
+
+namespace emugl {
+
+// Every packet starts with its opcode and its total size, both int32.
+static constexpr int kPacketHeaderSize = 8;
+
+static constexpr size_t kReadBufferSize = 128 * 1024;
+
+DecodeAheadReader::DecodeAheadReader(IOStream* stream)
+    : mStream(stream),
+      mReadBuf(kReadBufferSize),
+      mThread([this] { readerMain(); }) {}
+
+DecodeAheadReader::~DecodeAheadReader() {
+    stop();
+    if (mStarted) {
+        mThread.wait();
+    }
+}
+
+bool DecodeAheadReader::start() {
+    mStarted = mThread.start();
+    return mStarted;
+}
+
+bool DecodeAheadReader::next(Batch* batch) {
+    if (!batch->empty()) {
+        batch->clear();
+        mFree.trySend(std::move(*batch));
+    }
+    if (!mFilled.receive(batch)) {
+        return false;
+    }
+    return !batch->empty();
+}
+
+void DecodeAheadReader::stop() {
+    mFilled.stop();
+    mFree.stop();
+}
+
+int DecodeAheadReader::frameCompletePackets(int* needed) {
+    const unsigned char* const data = mReadBuf.buf();
+    const int available = static_cast<int>(mReadBuf.validData());
+    int framed = 0;
+    while (available - framed >= kPacketHeaderSize) {
+        int32_t packetSize;
+        memcpy(&packetSize, data + framed + 4, sizeof(packetSize));
+        if (!packetSize) {
+            // Same as RenderThread: the decoders would get live-stuck on it.
+            emugl::emugl_crash_reporter(
+                    "Guest should never send a size-0 GL packet\n");
+        }
+        if (packetSize < kPacketHeaderSize) {
+            if (framed) {
+                // Hand over the good packets first.
+                *needed = kPacketHeaderSize;
+                return framed;
+            }
+            ERR("DecodeAheadReader: malformed packet, opcode %d size %d\n",
+                *(const int32_t*)(data + framed), packetSize);
+            return -1;
+        }
+        if (packetSize > available - framed) {
+            *needed = packetSize;
+            return framed;
+        }
+        framed += packetSize;
+        mPackets.fetch_add(1, std::memory_order_relaxed);
+    }
+    *needed = kPacketHeaderSize;
+    return framed;
+}
+
+void DecodeAheadReader::readerMain() {
+    Batch batch;
+    for (;;) {
+        int needed;
+        const int framed = frameCompletePackets(&needed);
+        if (framed < 0) {
+            break;
+        }
+        if (framed > 0) {
+            if (!mFree.tryReceive(&batch)) {
+                batch = Batch();
+            }
+            batch.assign(mReadBuf.buf(), mReadBuf.buf() + framed);
+            mReadBuf.consume(framed);
+            mBatches.fetch_add(1, std::memory_order_relaxed);
+            mBytes.fetch_add(framed, std::memory_order_relaxed);
+            if (!mFilled.send(std::move(batch))) {
+                return;
+            }
+            continue;
+        }
+
+        // Wait for the rest of the first packet, taking whatever else has
+        // arrived by then.
+        if (mReadBuf.getData(mStream, needed) <= 0) {
+            break;
+        }
+    }
+    // Tell the RenderThread that nothing more is coming.
+    mFilled.send(Batch());
+}
+
+}  // namespace emugl
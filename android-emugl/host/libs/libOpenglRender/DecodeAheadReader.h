@@ -0,0 +1,93 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "ReadBuffer.h"
+
+#include "android/base/Compiler.h"
+#include "android/base/synchronization/MessageChannel.h"
+#include "android/base/threads/FunctorThread.h"
+
+#include <atomic>
+#include <vector>
+
+#include <stdint.h>
+
+class IOStream;
+
+namespace emugl {
+
+// Receives the command stream of a guest connection on a thread of its own,
+// ahead of the RenderThread that executes it.
+//
+// All RenderThreads of the server take turns on one decoding lock, so while
+// a connection waits for its turn, its reader keeps pulling packets off the
+// socket and checking their framing. The RenderThread then gets batches of
+// whole packets and only has to run the decoders on them. Commands are
+// still executed in order, and replies are written by the RenderThread, so
+// a guest blocked on a call with a return value sees no difference.
+class DecodeAheadReader {
+public:
+    // A run of complete packets, in stream order. An empty batch marks the
+    // end of the stream or a malformed packet.
+    using Batch = std::vector<unsigned char>;
+
+    explicit DecodeAheadReader(IOStream* stream);
+
+    // Stops the reader thread. The stream has to be forced to stop first, so
+    // that a pending read returns.
+    ~DecodeAheadReader();
+
+    bool start();
+
+    // Waits for the next batch and swaps it into |batch|; the previous
+    // contents of |batch| are recycled. Returns false at the end of the
+    // stream.
+    bool next(Batch* batch);
+
+    // Stops handing out batches, e.g. when the RenderThread bails out on
+    // a packet the decoders rejected.
+    void stop();
+
+    uint64_t packets() const { return mPackets.load(std::memory_order_relaxed); }
+    uint64_t batches() const { return mBatches.load(std::memory_order_relaxed); }
+    uint64_t bytes() const { return mBytes.load(std::memory_order_relaxed); }
+
+private:
+    void readerMain();
+
+    // Returns the size of the complete packets at the start of |mReadBuf|,
+    // or -1 if it starts with a malformed one. |*needed| is set to the
+    // amount of data the first incomplete packet needs.
+    int frameCompletePackets(int* needed);
+
+    static constexpr size_t kMaxQueuedBatches = 4;
+
+    IOStream* mStream;
+    ReadBuffer mReadBuf;
+    android::base::MessageChannel<Batch, kMaxQueuedBatches> mFilled;
+    android::base::MessageChannel<Batch, kMaxQueuedBatches + 2> mFree;
+    android::base::FunctorThread mThread;
+    bool mStarted = false;
+
+    std::atomic<uint64_t> mPackets{0};
+    std::atomic<uint64_t> mBatches{0};
+    std::atomic<uint64_t> mBytes{0};
+
+    DISALLOW_COPY_ASSIGN_AND_MOVE(DecodeAheadReader);
+};
+
+}  // namespace emugl
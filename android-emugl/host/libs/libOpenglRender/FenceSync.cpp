@@ -49,8 +49,8 @@ public:
     Timeline() = default;
 
     static constexpr int kMaxGuestTimelines = 16;
-    void addFence(FenceSync* fence) {
-        mFences.set(fence, mTime.load() + kMaxGuestTimelines);
+    void addFence(uint64_t handle) {
+        mFences.set(handle, mTime.load() + kMaxGuestTimelines);
     }
 
     void incrementTimelineAndDeleteOldFences() {
@@ -59,8 +59,8 @@ public:
     }
 
     void sweep() {
-        mFences.eraseIf([time = mTime.load()](FenceSync* fence, int fenceTime) {
-            FenceSync* actual = FenceSync::getFromHandle((uint64_t)(uintptr_t)fence);
+        mFences.eraseIf([time = mTime.load()](uint64_t handle, int fenceTime) {
+            FenceSync* actual = FenceSync::getFromHandle(handle);
             if (!actual) return true;
 
             bool shouldErase = fenceTime <= time;
@@ -76,7 +76,7 @@ public:
 
 private:
     std::atomic<int> mTime {0};
-    StaticMap<FenceSync*, int> mFences;
+    StaticMap<uint64_t, int> mFences;
 };
 
 static LazyInstance<Timeline> sTimeline = LAZY_INSTANCE_INIT;
@@ -86,18 +86,8 @@ void FenceSync::incrementTimelineAndDeleteOldFences() {
     sTimeline->incrementTimelineAndDeleteOldFences();
 }
 
-FenceSync::FenceSync(bool hasNativeFence,
-                     bool destroyWhenSignaled) :
+FenceSync::FenceSync(bool destroyWhenSignaled) :
     mDestroyWhenSignaled(destroyWhenSignaled) {
-
-    addToRegistry();
-
-    assert(mCount == 1);
-    if (hasNativeFence) {
-        incRef();
-        sTimeline->addFence(this);
-    }
-
     // assumes that there is a valid + current OpenGL context
     assert(RenderThreadInfo::get());
 
@@ -107,10 +97,6 @@ FenceSync::FenceSync(bool hasNativeFence,
                                    NULL);
 }
 
-FenceSync::~FenceSync() {
-    removeFromRegistry();
-}
-
 EGLint FenceSync::wait(uint64_t timeout) {
     incRef();
     EGLint wait_res =
@@ -156,23 +142,39 @@ void FenceSync::destroy() {
 // that has the same uint64_t casting as a FenceSync object from a previous
 // snapshot.
 
-// Maintain a StalePtrRegistry<FenceSync>:
+// All fences live in a StalePtrRegistry<FenceSync>, which takes care of 1
+// and 3: handles of fences from a previous snapshot don't resolve to
+// anything, and no new fence gets the same handle as one of those.
 static android::base::LazyInstance<StalePtrRegistry<FenceSync> >
     sFenceRegistry = LAZY_INSTANCE_INIT;
 
 // static
-void FenceSync::addToRegistry() {
-    sFenceRegistry->addPtr(this);
+FenceSync* FenceSync::create(bool hasNativeFence,
+                             bool destroyWhenSignaled) {
+    FenceSync* fenceSync = sFenceRegistry->add(destroyWhenSignaled);
+    if (!fenceSync) {
+        fprintf(stderr, "%s: too many fence sync objects\n", __func__);
+        return nullptr;
+    }
+
+    assert(fenceSync->mCount == 1);
+    if (hasNativeFence) {
+        fenceSync->incRef();
+        sTimeline->addFence(fenceSync->handle());
+    }
+    return fenceSync;
 }
 
-// static
 void FenceSync::removeFromRegistry() {
-    sFenceRegistry->removePtr(this);
+    sFenceRegistry->remove(this);
+}
+
+uint64_t FenceSync::handle() const {
+    return sFenceRegistry->getHandle(this);
 }
 
 // static
 void FenceSync::onSave(android::base::Stream* stream) {
-    sFenceRegistry->makeCurrentPtrsStale();
     sFenceRegistry->onSave(stream);
 }
 
@@ -26,6 +26,9 @@
 
 #include <atomic>
 
+template <class T>
+class StalePtrRegistry;
+
 // The FenceSync class wraps actual EGLSyncKHR objects
 // and issues calls to eglCreateSyncKHR, eglClientWaitSyncKHR,
 // and eglDestroySyncKHR.
@@ -54,16 +57,19 @@
 //     those on the guest, as that would require starting up another guest
 //     thread and OpenGL context (complete with host connection)
 //     to destroy it.
+//
+// FenceSync objects are owned by a StalePtrRegistry; the guest refers to them
+// by the handle it gives out, see handle() and getFromHandle().
 class FenceSync {
 public:
-    // The constructor wraps eglCreateSyncKHR on the host OpenGL driver.
+    // create() wraps eglCreateSyncKHR on the host OpenGL driver.
     // |hasNativeFence| specifies whether this sync object
     // is of EGL_SYNC_NATIVE_FENCE_ANDROID nature (2), and
     // |destroyWhenSignaled| specifies whether or not to destroy
     // the sync object when the native fence FD becomes signaled (3).
-    FenceSync(bool hasNativeFence,
-              bool destroyWhenSignaled);
-    ~FenceSync();
+    // Returns nullptr if there are too many sync objects already.
+    static FenceSync* create(bool hasNativeFence,
+                             bool destroyWhenSignaled);
 
     // wait() wraps eglClientWaitSyncKHR. During such a wait, we need
     // to increment the reference count while the wait is active,
@@ -109,15 +115,14 @@ public:
             // undesirably less simple.
             destroy();
             // This delete-then-return seems OK.
-            delete this;
+            removeFromRegistry();
             return true;
         }
         return false;
     }
 
-    // Tracks current active set of fences. Useful for snapshotting.
-    void addToRegistry();
-    void removeFromRegistry();
+    // The handle the guest knows this sync object by.
+    uint64_t handle() const;
 
     static FenceSync* getFromHandle(uint64_t handle);
 
@@ -125,6 +130,14 @@ public:
     static void onSave(android::base::Stream* stream);
     static void onLoad(android::base::Stream* stream);
 private:
+    friend class StalePtrRegistry<FenceSync>;
+
+    explicit FenceSync(bool destroyWhenSignaled);
+    ~FenceSync() = default;
+
+    // Destroys this object and frees its handle.
+    void removeFromRegistry();
+
     bool mDestroyWhenSignaled;
     std::atomic<int> mCount {1};
 
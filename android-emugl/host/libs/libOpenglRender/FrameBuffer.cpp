@@ -16,9 +16,13 @@
 
 #include "FrameBuffer.h"
 
+#include "ColorBufferTexturePool.h"
 #include "DispatchTables.h"
 #include "GLESVersionDetector.h"
+#include "GpuCapabilityCache.h"
 #include "NativeSubWindow.h"
+#include "PixelConvert.h"
+#include "ProtocolUtils.h"
 #include "RenderControl.h"
 #include "RenderThreadInfo.h"
 #include "YUVConverter.h"
@@ -30,6 +34,7 @@
 
 #include "android/base/LayoutResolver.h"
 #include "android/base/CpuUsage.h"
+#include "android/base/StringFormat.h"
 #include "android/base/containers/Lookup.h"
 #include "android/base/files/StreamSerializing.h"
 #include "android/base/memory/LazyInstance.h"
@@ -44,6 +49,9 @@
 #include "emugl/common/misc.h"
 #include "emugl/common/vm_operations.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -111,19 +119,71 @@ static unsigned int getUptimeMs() {
     return (unsigned int)(times.wallClockMs);
 }
 
+static std::string printRedundantStateStats() {
+    if (!s_gles2.glGetRedundantStateCallsAEMU) {
+        return "";
+    }
+    static uint64_t sLastCount = 0;
+    static uint64_t sLastTimeUs = 0;
+    uint64_t count = 0;
+    s_gles2.glGetRedundantStateCallsAEMU(&count);
+    const uint64_t nowUs = System::get()->getHighResTimeUs();
+    const float perSec = sLastTimeUs && nowUs > sLastTimeUs
+            ? (count - sLastCount) * 1e6f / (float)(nowUs - sLastTimeUs)
+            : 0.0f;
+    sLastCount = count;
+    sLastTimeUs = nowUs;
+    return android::base::StringFormat(
+            "Redundant GL state calls skipped: %llu (%.0f/s)",
+            (unsigned long long)count, perSec);
+}
+
+static std::string printTextureDedupStats() {
+    if (!s_gles2.glGetTextureDedupStatsAEMU) {
+        return "";
+    }
+    uint64_t hits = 0, misses = 0, savedBytes = 0, cachedBytes = 0;
+    s_gles2.glGetTextureDedupStatsAEMU(&hits, &misses, &savedBytes,
+                                       &cachedBytes);
+    if (!hits && !misses) {
+        return "";
+    }
+    return android::base::StringFormat(
+            "Texture dedup: hits %llu misses %llu, saved %.2f mb, "
+            "cached %.2f mb",
+            (unsigned long long)hits, (unsigned long long)misses,
+            (float)savedBytes / 1048576.0f, (float)cachedBytes / 1048576.0f);
+}
+
 static void dumpPerfStats() {
     auto usage = System::get()->getMemUsage();
-    std::string memoryStats = "";
+    std::string memoryStats = ColorBufferTexturePool::get()->printUsage();
         /*emugl::getMemoryTracker()
                 ? emugl::getMemoryTracker()->printUsage()
                 : "";*/
+    FrameBuffer* fb = FrameBuffer::getFB();
+    std::string procStats = fb ? fb->printProcGpuMemoryUsage(5) : "";
+    std::string presentStats = fb ? fb->printPresentStats() : "";
+    std::string cleanupStats = fb ? fb->printProcCleanupStats() : "";
+    std::string grallocStats = printGrallocSyncStats();
+    std::string copyStats = emugl::printDecoderCopyStats(5);
+    std::string stateStats = printRedundantStateStats();
+    std::string dedupStats = printTextureDedupStats();
     auto cpuUsage = emugl::getCpuUsage();
     std::string lastStats =
         cpuUsage ? cpuUsage->printUsage() : "";
-    printf("%s Uptime: %u ms Resident memory: %f mb %s \n%s\n",
+    printf("%s Uptime: %u ms Resident memory: %f mb %s \n%s\n%s\n%s\n%s\n%s\n%s\n%s\n%s\n",
         getTimeStampString().c_str(), getUptimeMs(),
         (float)usage.resident / 1048576.0f, lastStats.c_str(),
-        memoryStats.c_str());
+        memoryStats.c_str(), procStats.c_str(), presentStats.c_str(),
+        cleanupStats.c_str(),
+        grallocStats.c_str(), copyStats.c_str(), stateStats.c_str(),
+        dedupStats.c_str());
+}
+
+static size_t sGetBudgetBytes(const char* envName) {
+    std::string env = System::get()->envGet(envName);
+    return env.empty() ? 0 : strtoul(env.c_str(), nullptr, 10) * 1024 * 1024;
 }
 
 class PerfStatThread : public android::base::Thread {
@@ -306,6 +366,7 @@ void FrameBuffer::finalize() {
     m_windows.clear();
     m_contexts.clear();
     if (m_eglDisplay != EGL_NO_DISPLAY) {
+        ColorBufferTexturePool::get()->clear(m_colorBufferHelper);
         s_egl.eglMakeCurrent(m_eglDisplay, NULL, NULL, NULL);
         if (m_eglContext != EGL_NO_CONTEXT) {
             s_egl.eglDestroyContext(m_eglDisplay, m_eglContext);
@@ -338,6 +399,8 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
 
     android::base::initializeTracing();
 
+    const uint64_t initStartUs = System::get()->getHighResTimeUs();
+
     //
     // allocate space for the FrameBuffer object
     //
@@ -393,8 +456,24 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
     GL_LOG("egl: %d %d", fb->m_caps.eglMajor, fb->m_caps.eglMinor);
     s_egl.eglBindAPI(EGL_OPENGL_ES_API);
 
-    GLESDispatchMaxVersion dispatchMaxVersion =
-            calcMaxVersionFromDispatch(fb->m_eglDisplay);
+    //
+    // Probing the GLES version and extensions needs throw-away contexts,
+    // which is a large part of the cold start cost. Reuse the result of a
+    // previous run when the cache has one; it is validated against the
+    // GL strings once the FB context is current.
+    //
+    GpuCapabilityCache capsCache;
+    GpuCapabilities caps;
+    bool useCachedCaps = capsCache.load(&caps);
+
+    GLESDispatchMaxVersion dispatchMaxVersion;
+    if (useCachedCaps) {
+        GL_LOG("using cached GPU capabilities for %s", caps.glRenderer.c_str());
+        dispatchMaxVersion = caps.maxVersion;
+        setGlesVersionFromMaxVersion(dispatchMaxVersion);
+    } else {
+        dispatchMaxVersion = calcMaxVersionFromDispatch(fb->m_eglDisplay);
+    }
 
     FrameBuffer::setMaxGLESVersion(dispatchMaxVersion);
     if (s_egl.eglSetMaxGLESVersion) {
@@ -435,13 +514,18 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
     // if GLES2 plugin has loaded - try to make GLES2 context and
     // get GLES2 extension string
     //
-    android::base::ScopedCPtr<char> gles2Extensions(
-            getGLES2ExtensionString(fb->m_eglDisplay));
-    if (!gles2Extensions) {
-        // Could not create GLES2 context - drop GL2 capability
-        GL_LOG("Failed to obtain GLES 2.x extensions string!");
-        ERR("Failed to obtain GLES 2.x extensions string!\n");
-        return false;
+    if (!useCachedCaps) {
+        android::base::ScopedCPtr<char> gles2Extensions(
+                getGLES2ExtensionString(fb->m_eglDisplay));
+        if (!gles2Extensions) {
+            // Could not create GLES2 context - drop GL2 capability
+            GL_LOG("Failed to obtain GLES 2.x extensions string!");
+            ERR("Failed to obtain GLES 2.x extensions string!\n");
+            return false;
+        }
+        caps.maxVersion = dispatchMaxVersion;
+        caps.hasGlOesImage =
+                emugl::hasExtension(gles2Extensions.get(), "GL_OES_EGL_image");
     }
 
     //
@@ -495,6 +579,36 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
     GL_LOG("attempting to create egl context");
     fb->m_eglContext = s_egl.eglCreateContext(fb->m_eglDisplay, fb->m_eglConfig,
                                               EGL_NO_CONTEXT, getGlesMaxContextAttribs());
+    if (fb->m_eglContext == EGL_NO_CONTEXT && useCachedCaps) {
+        // The cached version no longer works on this host, redo the full
+        // probe. Nothing has been bound yet, so the dispatcher can still
+        // be reconfigured.
+        GL_LOG("cached GPU capabilities rejected, probing again");
+        capsCache.invalidate();
+        useCachedCaps = false;
+        dispatchMaxVersion = calcMaxVersionFromDispatch(fb->m_eglDisplay);
+        FrameBuffer::setMaxGLESVersion(dispatchMaxVersion);
+        if (s_egl.eglSetMaxGLESVersion) {
+            s_egl.eglSetMaxGLESVersion(dispatchMaxVersion);
+        }
+        emugl::getGlesVersion(&glesMaj, &glesMin);
+        fb->m_asyncReadbackSupported = glesMaj > 2;
+
+        android::base::ScopedCPtr<char> gles2Extensions(
+                getGLES2ExtensionString(fb->m_eglDisplay));
+        if (!gles2Extensions) {
+            GL_LOG("Failed to obtain GLES 2.x extensions string!");
+            ERR("Failed to obtain GLES 2.x extensions string!\n");
+            return false;
+        }
+        caps.maxVersion = dispatchMaxVersion;
+        caps.hasGlOesImage =
+                emugl::hasExtension(gles2Extensions.get(), "GL_OES_EGL_image");
+
+        fb->m_eglContext = s_egl.eglCreateContext(
+                fb->m_eglDisplay, fb->m_eglConfig, EGL_NO_CONTEXT,
+                getGlesMaxContextAttribs());
+    }
     if (fb->m_eglContext == EGL_NO_CONTEXT) {
         GL_LOG("Failed to create context 0x%x", s_egl.eglGetError());
         ERR("Failed to create context 0x%x\n", s_egl.eglGetError());
@@ -545,12 +659,41 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
     }
     GL_LOG("context-current successful");
 
+    //
+    // Cache the GL strings so we don't have to think about threading or
+    // current-context when asked for them.
+    //
+    fb->m_glVendor = std::string((const char*)s_gles2.glGetString(GL_VENDOR));
+    fb->m_glRenderer = std::string((const char*)s_gles2.glGetString(GL_RENDERER));
+    fb->m_glVersion = std::string((const char*)s_gles2.glGetString(GL_VERSION));
+
+    DBG("GL Vendor %s\n", fb->m_glVendor.c_str());
+    DBG("GL Renderer %s\n", fb->m_glRenderer.c_str());
+    DBG("GL Extensions %s\n", fb->m_glVersion.c_str());
+    GL_LOG("GL Vendor %s", fb->m_glVendor.c_str());
+    GL_LOG("GL Renderer %s", fb->m_glRenderer.c_str());
+    GL_LOG("GL Extensions %s", fb->m_glVersion.c_str());
+
+    bool storeCaps = !useCachedCaps;
+    if (useCachedCaps &&
+        !GpuCapabilityCache::matches(caps, fb->m_glVendor, fb->m_glRenderer,
+                                     fb->m_glVersion)) {
+        // GPU or driver changed since the cache was written. The dispatcher
+        // is already set up with the cached version, so keep it for this
+        // run; the extensions can be re-read from the current context. The
+        // cached version may be wrong for this driver, so it is not stored
+        // again: the next run probes from scratch.
+        GL_LOG("GPU capability cache does not match the current driver");
+        const char* s = (const char*)s_gles2.glGetString(GL_EXTENSIONS);
+        caps.hasGlOesImage = emugl::hasExtension(s ? s : "", "GL_OES_EGL_image");
+        capsCache.invalidate();
+        storeCaps = false;
+    }
+
     //
     // Initilize framebuffer capabilities
     //
-    const bool has_gl_oes_image =
-            emugl::hasExtension(gles2Extensions.get(), "GL_OES_EGL_image");
-    gles2Extensions.reset();
+    const bool has_gl_oes_image = caps.hasGlOesImage;
 
     fb->m_caps.has_eglimage_texture_2d = false;
     fb->m_caps.has_eglimage_renderbuffer = false;
@@ -619,21 +762,16 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
 
     GL_LOG("There are sufficient EGLconfigs available");
 
-    //
-    // Cache the GL strings so we don't have to think about threading or
-    // current-context when asked for them.
-    //
-    fb->m_glVendor = std::string((const char*)s_gles2.glGetString(GL_VENDOR));
-    fb->m_glRenderer = std::string((const char*)s_gles2.glGetString(GL_RENDERER));
-    fb->m_glVersion = std::string((const char*)s_gles2.glGetString(GL_VERSION));
-
-    DBG("GL Vendor %s\n", fb->m_glVendor.c_str());
-    DBG("GL Renderer %s\n", fb->m_glRenderer.c_str());
-    DBG("GL Extensions %s\n", fb->m_glVersion.c_str());
-    GL_LOG("GL Vendor %s", fb->m_glVendor.c_str());
-    GL_LOG("GL Renderer %s", fb->m_glRenderer.c_str());
-    GL_LOG("GL Extensions %s", fb->m_glVersion.c_str());
+    if (storeCaps) {
+        caps.glVendor = fb->m_glVendor;
+        caps.glRenderer = fb->m_glRenderer;
+        caps.glVersion = fb->m_glVersion;
+        if (!capsCache.store(caps)) {
+            GL_LOG("Failed to write GPU capability cache");
+        }
+    }
 
+    // TextureDraw only compiles its program on first use, so this is cheap.
     fb->m_textureDraw = new TextureDraw();
     if (!fb->m_textureDraw) {
         GL_LOG("Failed: creation of TextureDraw instance");
@@ -653,6 +791,9 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
     #ifdef KY_ENABLE_VULKAN
     goldfish_vk::setGlInteropSupported(fb->m_vulkanInteropSupported);
     #endif
+    fb->m_initStartUs = initStartUs;
+    fb->m_initDoneUs = System::get()->getHighResTimeUs();
+
     //
     // Keep the singleton framebuffer pointer
     //
@@ -668,7 +809,8 @@ bool FrameBuffer::initialize(int width, int height, bool useSubWindow,
         SyncThread::get();
     }
 
-    GL_LOG("basic EGL initialization successful");
+    GL_LOG("basic EGL initialization successful, took %llu ms",
+           (unsigned long long)(s_theFrameBuffer->m_initDoneUs - initStartUs) / 1000);
 
     // Nothing else to do - we're ready to rock!
     return true;
@@ -755,6 +897,8 @@ FrameBuffer::FrameBuffer(int p_width, int p_height, bool useSubWindow)
       m_postThread([this](FrameBuffer::Post&& post) {
           return postWorkerFunc(post);
       }) {
+     m_procGpuSoftBudgetBytes = sGetBudgetBytes("ANDROID_EMUGL_PROC_GPU_SOFT_MB");
+     m_procGpuHardBudgetBytes = sGetBudgetBytes("ANDROID_EMUGL_PROC_GPU_HARD_MB");
      /*uint32_t displayId = 0;
      if (createDisplay(&displayId) < 0) {
          fprintf(stderr, "Failed to create default display\n");
@@ -796,8 +940,13 @@ FrameBuffer::sendReadbackWorkerCmd(const Readback& readback) {
     case ReadbackCmd::Init:
         m_readbackWorker->initGL();
         return WorkerProcessingResult::Continue;
-    case ReadbackCmd::GetPixels:
-        m_readbackWorker->getPixels(readback.displayId, readback.pixelsOut, readback.bytes);
+    case ReadbackCmd::AcquireFrame:
+        *static_cast<ReadbackFramePtr*>(readback.pixelsOut) =
+                m_readbackWorker->acquireFrame(readback.displayId);
+        return WorkerProcessingResult::Continue;
+    case ReadbackCmd::ReleaseFrame:
+        m_readbackWorker->releaseFrame(readback.displayId, readback.slot,
+                                       readback.frameNumber);
         return WorkerProcessingResult::Continue;
     case ReadbackCmd::AddRecordDisplay:
         m_readbackWorker->setRecordDisplay(readback.displayId, readback.width, readback.height, true);
@@ -830,9 +979,12 @@ FrameBuffer::postWorkerFunc(const Post& post) {
     switch (post.cmd) {
         case PostCmd::Post:
         {              
+            const uint64_t startUs = System::get()->getHighResTimeUs();
             m_postWorker->viewport(cw_attri->width, cw_attri->height);
             //bindSubwin_locked(post.window_attri->surface);
             m_postWorker->post(post.cb,cw_attri->surface , cw_attri->width, cw_attri->height, cw_attri->rotation);
+            m_postFrameUs += System::get()->getHighResTimeUs() - startUs;
+            ++m_postFrames;
             break;
         }
         case PostCmd::Viewport:
@@ -860,6 +1012,23 @@ FrameBuffer::postWorkerFunc(const Post& post) {
                 post.screenshot.rotation,
                 post.screenshot.pixels);
             break;
+        case PostCmd::DropResizeCaches: {
+            size_t freed = 0;
+            for (const auto& cb : *post.resizeCaches) {
+                freed += cb->dropResizeCache();
+            }
+            m_gpuReclaimedBytes += freed;
+            GL_LOG("Dropped %zu bytes of resize caches", freed);
+            {
+                emugl::Mutex::AutoLock lock(m_droppedResizeCacheLock);
+                m_droppedResizeCacheRefs.insert(
+                        m_droppedResizeCacheRefs.end(),
+                        post.resizeCaches->begin(), post.resizeCaches->end());
+            }
+            delete post.resizeCaches;
+            m_resizeCacheDropPending = false;
+            break;
+        }
         case PostCmd::Exit:
             return WorkerProcessingResult::Stop;
         default:
@@ -1114,11 +1283,24 @@ HandleType FrameBuffer::createColorBufferWithHandleLocked(
 
     sweepColorBuffersLocked();
 
+    // Callers outside a render thread, like virtio-gpu, have no thread info;
+    // what they create is not charged to any process.
+    RenderThreadInfo* const ownerInfo = RenderThreadInfo::get();
+    const uint64_t ownerPuid = ownerInfo ? ownerInfo->m_puid : 0;
+    if (!checkProcGpuBudgetLocked(ownerPuid,
+                                  (size_t)p_width * p_height * 4)) {
+        ERR("FB: color buffer %dx%d rejected, process %llu is over its GPU "
+            "memory budget\n", p_width, p_height,
+            (unsigned long long)ownerPuid);
+        return 0;
+    }
+
     ColorBufferPtr cb(ColorBuffer::create(getDisplay(), p_width, p_height,
                                           p_internalFormat, p_frameworkFormat,
                                           handle, m_colorBufferHelper,
                                           m_fastBlitSupported));
-    pthread_t tid = pthread_self();
+    pthread_t tid =
+            ownerInfo ? ownerInfo->m_colorBufferOwner : pthread_self();
     if (cb.get() != NULL) {
         assert(m_colorbuffers.count(handle) == 0);
         // When guest feature flag RefCountPipe is on, no reference counting is
@@ -1126,7 +1308,8 @@ HandleType FrameBuffer::createColorBufferWithHandleLocked(
         // Explicitly set refcount to 1 to avoid the colorbuffer being added to
         // m_colorBufferDelayedCloseList in FrameBuffer::onLoad().
         if (m_refCountPipeEnabled) {
-            m_colorbuffers[handle] = { std::move(cb), 1, false, 0 };
+            m_colorbuffers[handle] = { std::move(cb), 1, false, 0,
+                                       ownerPuid };
         } else {
             // Android master default api level is 1000
             int apiLevel = 1000;
@@ -1134,18 +1317,18 @@ HandleType FrameBuffer::createColorBufferWithHandleLocked(
             // pre-O and post-O use different color buffer memory management
             // logic
             if (apiLevel > 0 && apiLevel < 26) {
-                m_colorbuffers[handle] = {std::move(cb), 1, false, 0};
+                m_colorbuffers[handle] = {std::move(cb), 1, false, 0,
+                                          ownerPuid};
 
-                RenderThreadInfo* tInfo = RenderThreadInfo::get();
-                uint64_t puid = tInfo->m_puid;
-                if (puid) {
-                    m_procOwnedColorBuffers[puid].insert(handle);
+                if (ownerPuid) {
+                    m_procOwnedColorBuffers[ownerPuid].insert(handle);
                 }
                 m_pthreadOwnedColorBuffers[tid].insert(handle);
             } else {
                 // set 'refcount' init value to '1' to avoid some colorbuffer 
                 // released abnormally by color buffer memory management
-                m_colorbuffers[handle] = {std::move(cb), 1, false, 0};
+                m_colorbuffers[handle] = {std::move(cb), 1, false, 0,
+                                          ownerPuid};
                 m_pthreadOwnedColorBuffers[tid].insert(handle);
             }
         }
@@ -1187,10 +1370,20 @@ HandleType FrameBuffer::createBufferWithHandleLocked(int p_size,
         abort();
     }
 
+    // Not charged to any process without a render thread, see
+    // createColorBufferWithHandleLocked().
+    RenderThreadInfo* const ownerInfo = RenderThreadInfo::get();
+    const uint64_t ownerPuid = ownerInfo ? ownerInfo->m_puid : 0;
+    if (!checkProcGpuBudgetLocked(ownerPuid, p_size)) {
+        ERR("FB: buffer of %d bytes rejected, process %llu is over its GPU "
+            "memory budget\n", p_size, (unsigned long long)ownerPuid);
+        return 0;
+    }
+
     BufferPtr buffer(Buffer::create(p_size, handle));
 
     if (buffer) {
-        m_buffers[handle] = {std::move(buffer)};
+        m_buffers[handle] = {std::move(buffer), ownerPuid};
     } else {
         handle = 0;
         DBG("Create buffer failed.\n");
@@ -1424,10 +1617,16 @@ int FrameBuffer::openColorBuffer(HandleType p_colorbuffer) {
         return -1;
     }
 
+    uint64_t puid = tInfo->m_puid;
+    if (puid && !c->second.opened) {
+        // Charge the buffer to the app using it rather than to the process
+        // that allocated it for the app.
+        c->second.ownerPuid = puid;
+    }
+
     c->second.refcount++;
     markOpened(&c->second);
 
-    uint64_t puid = tInfo->m_puid;
     if (puid) {
         m_procOwnedColorBuffers[puid].insert(p_colorbuffer);
     }
@@ -1621,14 +1820,19 @@ void FrameBuffer::eraseDelayedCloseColorBufferLocked(
 }
 
 void FrameBuffer::cleanupProcGLObjects(uint64_t puid) {
-    AutoLock mutex(m_lock);
-    auto colorBuffersToCleanup = cleanupProcGLObjects_locked(puid);
-
+    // Only the handles are dropped under m_lock, so the guest sees them gone
+    // right away; the GL objects are released afterwards.
+    ProcCleanupBatch batch;
+    std::vector<HandleType> colorBuffersToCleanup;
     // Run other cleanup callbacks
     // Avoid deadlock by first storing a separate list of callbacks
     std::vector<std::function<void()>> callbacks;
-
     {
+        AutoLock mutex(m_lock);
+        const uint64_t lockedUs = System::get()->getHighResTimeUs();
+        colorBuffersToCleanup =
+                cleanupProcGLObjects_locked(puid, false, &batch);
+
         auto procIte = m_procOwnedCleanupCallbacks.find(puid);
         if (procIte != m_procOwnedCleanupCallbacks.end()) {
             for (auto it : procIte->second) {
@@ -1636,8 +1840,17 @@ void FrameBuffer::cleanupProcGLObjects(uint64_t puid) {
             }
             m_procOwnedCleanupCallbacks.erase(procIte);
         }
+
+        const uint64_t heldUs = System::get()->getHighResTimeUs() - lockedUs;
+        ++m_procCleanupCount;
+        m_procCleanupLockedUs += heldUs;
+        if (heldUs > m_procCleanupMaxLockedUs) {
+            m_procCleanupMaxLockedUs = heldUs;
+        }
     }
 
+    releaseProcCleanupBatch(&batch);
+
     for (auto handle : colorBuffersToCleanup) {
         #ifdef KY_ENABLE_VULKAN
         goldfish_vk::teardownVkColorBuffer(handle);
@@ -1649,7 +1862,61 @@ void FrameBuffer::cleanupProcGLObjects(uint64_t puid) {
     }
 }
 
-std::vector<HandleType> FrameBuffer::cleanupProcGLObjects_locked(uint64_t puid, bool forced) {
+void FrameBuffer::releaseProcCleanupBatch(ProcCleanupBatch* batch) {
+    // Objects released between short pauses, so a big process going away
+    // does not keep the driver busy for other render threads.
+    static constexpr size_t kObjectsPerBatch = 16;
+    static constexpr unsigned kPauseMs = 1;
+
+    const uint64_t startUs = System::get()->getHighResTimeUs();
+    const size_t count = batch->windowSurfaces.size() +
+                         batch->colorBuffers.size() + batch->eglImages.size() +
+                         batch->contexts.size();
+    if (!count) {
+        return;
+    }
+
+    // Window surfaces may hold the last reference to a color buffer, and
+    // color buffers own FBOs and VAOs that only exist in the helper
+    // context, so these go with it bound, which takes m_lock; it is only
+    // held for one group of objects at a time.
+    auto release = [this, batch](size_t index) {
+        if (index < batch->windowSurfaces.size()) {
+            batch->windowSurfaces[index].reset();
+            return;
+        }
+        index -= batch->windowSurfaces.size();
+        if (index < batch->colorBuffers.size()) {
+            batch->colorBuffers[index].reset();
+            return;
+        }
+        index -= batch->colorBuffers.size();
+        s_egl.eglDestroyImageKHR(
+                m_eglDisplay,
+                reinterpret_cast<EGLImageKHR>(batch->eglImages[index]));
+    };
+    const size_t boundCount = count - batch->contexts.size();
+    for (size_t released = 0; released < boundCount;) {
+        if (released) {
+            System::get()->sleepMs(kPauseMs);
+        }
+        AutoLock mutex(m_lock);
+        ScopedBind bind(m_colorBufferHelper);
+        const size_t end = std::min(released + kObjectsPerBatch, boundCount);
+        for (; released < end; ++released) {
+            release(released);
+        }
+        s_gles2.glFlush();
+    }
+    // Contexts need none current to go.
+    *batch = ProcCleanupBatch();
+
+    m_procCleanupObjects += count;
+    m_procCleanupReleaseUs += System::get()->getHighResTimeUs() - startUs;
+}
+
+std::vector<HandleType> FrameBuffer::cleanupProcGLObjects_locked(
+        uint64_t puid, bool forced, ProcCleanupBatch* deferred) {
     std::vector<HandleType> colorBuffersToCleanup;
     {
         ScopedBind bind(m_colorBufferHelper);
@@ -1659,6 +1926,13 @@ std::vector<HandleType> FrameBuffer::cleanupProcGLObjects_locked(uint64_t puid,
             if (procIte != m_procOwnedWindowSurfaces.end()) {
                 for (auto whndl : procIte->second) {
                     auto w = m_windows.find(whndl);
+                    if (deferred) {
+                        deferred->windowSurfaces.push_back(w->second.first);
+                        auto c = m_colorbuffers.find(w->second.second);
+                        if (c != m_colorbuffers.end()) {
+                            deferred->colorBuffers.push_back(c->second.cb);
+                        }
+                    }
                     if (m_refCountPipeEnabled) {
                         if (decColorBufferRefCountLocked(w->second.second)) {
                             colorBuffersToCleanup.push_back(w->second.second);
@@ -1681,6 +1955,12 @@ std::vector<HandleType> FrameBuffer::cleanupProcGLObjects_locked(uint64_t puid,
             auto procIte = m_procOwnedColorBuffers.find(puid);
             if (procIte != m_procOwnedColorBuffers.end()) {
                 for (auto cb : procIte->second) {
+                    if (deferred) {
+                        auto c = m_colorbuffers.find(cb);
+                        if (c != m_colorbuffers.end()) {
+                            deferred->colorBuffers.push_back(c->second.cb);
+                        }
+                    }
                     if (closeColorBufferLocked(cb, forced)) {
                         colorBuffersToCleanup.push_back(cb);
                     }
@@ -1693,7 +1973,11 @@ std::vector<HandleType> FrameBuffer::cleanupProcGLObjects_locked(uint64_t puid,
         {
             auto procIte = m_procOwnedEGLImages.find(puid);
             if (procIte != m_procOwnedEGLImages.end()) {
-                if (!procIte->second.empty()) {
+                if (deferred) {
+                    deferred->eglImages.insert(deferred->eglImages.end(),
+                                               procIte->second.begin(),
+                                               procIte->second.end());
+                } else if (!procIte->second.empty()) {
                     for (auto eglImg : procIte->second) {
                         s_egl.eglDestroyImageKHR(
                                 m_eglDisplay,
@@ -1710,6 +1994,12 @@ std::vector<HandleType> FrameBuffer::cleanupProcGLObjects_locked(uint64_t puid,
         auto procIte = m_procOwnedRenderContext.find(puid);
         if (procIte != m_procOwnedRenderContext.end()) {
             for (auto ctx : procIte->second) {
+                if (deferred) {
+                    auto c = m_contexts.find(ctx);
+                    if (c != m_contexts.end()) {
+                        deferred->contexts.push_back(c->second);
+                    }
+                }
                 m_contexts.erase(ctx);
             }
             m_procOwnedRenderContext.erase(procIte);
@@ -2147,6 +2437,27 @@ bool FrameBuffer::bindContext(HandleType p_context,
     return true;
 }
 
+bool FrameBuffer::restoreContext() {
+    if (m_shuttingDown) {
+        return false;
+    }
+
+    RenderThreadInfo* tinfo = RenderThreadInfo::get();
+    const WindowSurfacePtr& draw = tinfo->currDrawSurf;
+    const WindowSurfacePtr& read = tinfo->currReadSurf;
+    const RenderContextPtr& ctx = tinfo->currContext;
+
+    AutoLock mutex(m_lock);
+    if (!s_egl.eglMakeCurrent(m_eglDisplay,
+                              draw ? draw->getEGLSurface() : EGL_NO_SURFACE,
+                              read ? read->getEGLSurface() : EGL_NO_SURFACE,
+                              ctx ? ctx->getEGLContext() : EGL_NO_CONTEXT)) {
+        ERR("eglMakeCurrent failed\n");
+        return false;
+    }
+    return true;
+}
+
 RenderContextPtr FrameBuffer::getContext_locked(HandleType p_context) {
     assert(m_lock.isLocked());
     return android::base::findOrDefault(m_contexts, p_context);
@@ -2485,6 +2796,9 @@ void FrameBuffer::freeRenderWindow (RendererWindowAttri** window_attri_ptr) {
         //s_egl.eglDestroySurface(m_eglDisplay, window_attri->surface);
         s_egl.eglMakeCurrent(m_eglDisplay,NULL,NULL,NULL);
         if (window_attri->surface != EGL_NO_SURFACE) {
+            if (m_postWorker) {
+                m_postWorker->forgetSurface(window_attri->surface);
+            }
             s_egl.eglDestroySurface(m_eglDisplay, window_attri->surface);
         }
         if (window_attri->native_window && m_useSubWindow) {
@@ -2507,6 +2821,7 @@ bool FrameBuffer::DeleteWindowAttri(int display_id) {
         RendererWindowAttri** window_attri_ptr = win->second;
         freeRenderWindow(window_attri_ptr);
         subWindowsMap.erase(win);
+        m_framePacer.forget(display_id);
 
         long delete_time = System::get()->getUnixTime();
         auto de_win = deletedWindowsMap.find(display_id);
@@ -2692,13 +3007,70 @@ RendererWindowAttri* FrameBuffer::UpdateWindowAttri(int display_id, EGLNativeWin
 
 //bool FrameBuffer::post(HandleType p_colorbuffer, bool needLockAndBind)
 bool FrameBuffer::post(int display_id, HandleType p_colorbuffer, int32_t width, int32_t height, int32_t orientation, bool needLockAndBind) {
+    return postInSlot(
+            m_framePacer.reserve(display_id, getCallerSwapInterval()),
+            p_colorbuffer, width, height, orientation, needLockAndBind);
+}
+
+void FrameBuffer::postDisplays(const std::vector<DisplayPost>& posts) {
+    const int interval = getCallerSwapInterval();
+    std::vector<std::pair<FramePacer::Slot, const DisplayPost*>> slots;
+    for (const DisplayPost& post : posts) {
+        slots.emplace_back(m_framePacer.reserve(post.display_id, interval),
+                           &post);
+    }
+    std::stable_sort(slots.begin(), slots.end(),
+                     [](const std::pair<FramePacer::Slot, const DisplayPost*>& a,
+                        const std::pair<FramePacer::Slot, const DisplayPost*>& b) {
+                         return a.first.deadlineUs < b.first.deadlineUs;
+                     });
+    for (const auto& slot : slots) {
+        postInSlot(slot.first, slot.second->colorbuffer, slot.second->width,
+                   slot.second->height, slot.second->orientation, true);
+    }
+}
+
+int FrameBuffer::getCallerSwapInterval() {
+    RenderThreadInfo* const tInfo = RenderThreadInfo::get();
+    const int interval = tInfo && tInfo->currDrawSurf
+                                 ? tInfo->currDrawSurf->getSwapInterval()
+                                 : -1;
+    return interval >= 0 ? interval : m_framePacer.getDefaultSwapInterval();
+}
+
+bool FrameBuffer::postInSlot(const FramePacer::Slot& slot,
+                             HandleType p_colorbuffer,
+                             int32_t width,
+                             int32_t height,
+                             int32_t orientation,
+                             bool needLockAndBind) {
     #ifdef KY_ENABLE_VULKAN
     if (m_guestUsesAngle) {
         goldfish_vk::updateColorBufferFromVkImage(p_colorbuffer);
     }
     #endif
+    const uint64_t now = System::get()->getHighResTimeUs();
+    if (slot.deadlineUs > now) {
+        // Other render threads keep decoding meanwhile.
+        ScopedBlockingWait blocking(true /* dropDecodeLock */);
+        System::get()->sleepUs((unsigned)(slot.deadlineUs - now));
+    }
+    if (!m_framePacer.claim(slot)) {
+        // A newer frame of this window takes its slot.
+        return true;
+    }
+    const int display_id = slot.displayId;
     bool res = postImpl(display_id, p_colorbuffer, width, height, orientation, needLockAndBind);
-    if (res) setGuestPostedAFrame();
+    if (res) {
+        m_framePacer.onPresented(display_id);
+        setGuestPostedAFrame();
+        if (!m_firstFramePosted.exchange(true)) {
+            uint64_t now = System::get()->getHighResTimeUs();
+            syslog(LOG_DEBUG, "time to first frame: %llu ms (init %llu ms)",
+                   (unsigned long long)(now - m_initStartUs) / 1000,
+                   (unsigned long long)(m_initDoneUs - m_initStartUs) / 1000);
+        }
+    }
     return res;
 }
 
@@ -2842,14 +3214,39 @@ void FrameBuffer::doPostCallback(void* pixels, uint32_t displayId) {
 }
 
 void FrameBuffer::getPixels(void* pixels, uint32_t bytes, uint32_t displayId) {
+    // Only mapping the frame needs the readback thread; copy it out here.
+    const ReadbackFramePtr frame = acquireReadbackFrame(displayId);
+    if (!frame) {
+        return;
+    }
+    if (!frame->swapRedBlue) {
+        memcpy(pixels, frame->pixels, std::min(bytes, frame->bytes));
+        return;
+    }
+    const uint32_t stride = 4 * frame->width;
+    emugl::swapRedBlue(frame->pixels, stride, pixels, stride, frame->width,
+                       std::min(bytes, frame->bytes) / stride);
+}
+
+ReadbackFramePtr FrameBuffer::acquireReadbackFrame(uint32_t displayId) {
     const auto& iter = m_onPost.find(displayId);
     if (iter == m_onPost.end()) {
         ERR("Display %d not configured for recording yet", displayId);
-        return;
+        return nullptr;
     }
-    m_readbackThread.enqueue({ ReadbackCmd::GetPixels, displayId,
-                                           0, pixels, bytes });
+    ReadbackFramePtr frame;
+    m_readbackThread.enqueue({ ReadbackCmd::AcquireFrame, displayId,
+                                           0, &frame });
     m_readbackThread.waitQueuedItems();
+    return frame;
+}
+
+void FrameBuffer::releaseReadbackFrame(uint32_t displayId, uint32_t slot,
+                                       uint64_t frameNumber) {
+    // Unmapping needs the readback thread's context, but nobody has to
+    // wait for it.
+    m_readbackThread.enqueue({ ReadbackCmd::ReleaseFrame, displayId,
+                               0, nullptr, 0, 0, 0, slot, frameNumber });
 }
 
 void FrameBuffer::flushReadPipeline(int displayId) {
@@ -3242,6 +3639,13 @@ int FrameBuffer::setDisplayPose(uint32_t displayId,
 }
 
 void FrameBuffer::sweepColorBuffersLocked() {
+    std::vector<ColorBufferPtr> droppedResizeCacheRefs;
+    {
+        emugl::Mutex::AutoLock lock(m_droppedResizeCacheLock);
+        droppedResizeCacheRefs.swap(m_droppedResizeCacheRefs);
+    }
+    droppedResizeCacheRefs.clear();
+
     HandleType handleToDestroy;
     while (mOutstandingColorBufferDestroys.tryReceive(&handleToDestroy)) {
         bool needCleanup = decColorBufferRefCountLocked(handleToDestroy);
@@ -3255,6 +3659,188 @@ void FrameBuffer::sweepColorBuffersLocked() {
     }
 }
 
+ProcGpuMemoryUsage FrameBuffer::procGpuMemoryUsageLocked(uint64_t puid) {
+    ProcGpuMemoryUsage usage;
+    usage.puid = puid;
+    for (const auto& it : m_colorbuffers) {
+        if (it.second.ownerPuid == puid && it.second.cb) {
+            ++usage.colorBufferCount;
+            usage.colorBufferBytes += it.second.cb->getResidentBytes();
+        }
+    }
+    for (const auto& it : m_buffers) {
+        if (it.second.ownerPuid == puid && it.second.buffer) {
+            ++usage.bufferCount;
+            usage.bufferBytes += it.second.buffer->getSize();
+        }
+    }
+    return usage;
+}
+
+bool FrameBuffer::checkProcGpuBudgetLocked(uint64_t puid, size_t newBytes) {
+    if (!puid || (!m_procGpuSoftBudgetBytes && !m_procGpuHardBudgetBytes)) {
+        return true;
+    }
+
+    size_t total = procGpuMemoryUsageLocked(puid).totalBytes() + newBytes;
+    if (m_procGpuSoftBudgetBytes && total > m_procGpuSoftBudgetBytes) {
+        reclaimGpuMemoryLocked(puid);
+        total = procGpuMemoryUsageLocked(puid).totalBytes() + newBytes;
+    }
+    if (m_procGpuHardBudgetBytes && total > m_procGpuHardBudgetBytes) {
+        ++m_gpuBudgetRejectCount;
+        return false;
+    }
+    return true;
+}
+
+void FrameBuffer::reclaimGpuMemoryLocked(uint64_t puid) {
+    // Resize caches are rebuilt on demand. Only the post thread uses them,
+    // so drop them there, between two posts. Render threads post while
+    // holding our lock, so don't wait for it here; the references taken
+    // are handed back to sweepColorBuffersLocked() once it is done. Keep
+    // the caches of the buffers on screen, they are needed for the next
+    // frame of each display.
+    if (m_postThread.isStarted() && !m_resizeCacheDropPending) {
+        std::unordered_set<HandleType> onScreen = {m_lastPostedColorBuffer};
+        for (const auto& win : subWindowsMap) {
+            if (win.second && *win.second) {
+                onScreen.insert((*win.second)->lastPostedColorBuffer);
+            }
+        }
+        auto cbs = new std::vector<ColorBufferPtr>();
+        for (const auto& it : m_colorbuffers) {
+            if (it.second.cb && !onScreen.count(it.first)) {
+                cbs->push_back(it.second.cb);
+            }
+        }
+        if (cbs->empty()) {
+            delete cbs;
+        } else {
+            Post post;
+            post.cmd = PostCmd::DropResizeCaches;
+            post.resizeCaches = cbs;
+            m_resizeCacheDropPending = true;
+            m_postThread.enqueue(Post(post));
+        }
+    }
+
+    // Pooled textures are not charged to any process but still occupy VRAM.
+    ColorBufferTexturePool::get()->clear(m_colorBufferHelper);
+
+    ++m_gpuReclaimCount;
+    GL_LOG("Reclaiming GPU memory for process %llu",
+           (unsigned long long)puid);
+}
+
+std::vector<ProcGpuMemoryUsage> FrameBuffer::getProcGpuMemoryUsage(
+        size_t maxEntries) {
+    AutoLock mutex(m_lock);
+    std::unordered_map<uint64_t, ProcGpuMemoryUsage> byPuid;
+    for (const auto& it : m_colorbuffers) {
+        if (!it.second.cb) {
+            continue;
+        }
+        ProcGpuMemoryUsage& usage = byPuid[it.second.ownerPuid];
+        usage.puid = it.second.ownerPuid;
+        ++usage.colorBufferCount;
+        usage.colorBufferBytes += it.second.cb->getResidentBytes();
+    }
+    for (const auto& it : m_buffers) {
+        if (!it.second.buffer) {
+            continue;
+        }
+        ProcGpuMemoryUsage& usage = byPuid[it.second.ownerPuid];
+        usage.puid = it.second.ownerPuid;
+        ++usage.bufferCount;
+        usage.bufferBytes += it.second.buffer->getSize();
+    }
+
+    std::vector<ProcGpuMemoryUsage> res;
+    res.reserve(byPuid.size());
+    for (const auto& it : byPuid) {
+        res.push_back(it.second);
+    }
+    std::sort(res.begin(), res.end(),
+              [](const ProcGpuMemoryUsage& a, const ProcGpuMemoryUsage& b) {
+                  return a.totalBytes() > b.totalBytes();
+              });
+    if (maxEntries && res.size() > maxEntries) {
+        res.resize(maxEntries);
+    }
+    return res;
+}
+
+std::string FrameBuffer::printProcGpuMemoryUsage(size_t maxEntries) {
+    std::vector<ProcGpuMemoryUsage> usages = getProcGpuMemoryUsage(maxEntries);
+    AutoLock mutex(m_lock);
+    std::string res = android::base::StringFormat(
+            "GPU memory by process (soft %zu mb, hard %zu mb, reclaims %llu "
+            "freeing %.2f mb, rejected %llu):",
+            m_procGpuSoftBudgetBytes / 1048576,
+            m_procGpuHardBudgetBytes / 1048576,
+            (unsigned long long)m_gpuReclaimCount,
+            (float)m_gpuReclaimedBytes.load() / 1048576.0f,
+            (unsigned long long)m_gpuBudgetRejectCount);
+    for (const auto& usage : usages) {
+        res += android::base::StringFormat(
+                "\n  puid %llu: %.2f mb (%zu color buffers %.2f mb, "
+                "%zu buffers %.2f mb)",
+                (unsigned long long)usage.puid,
+                (float)usage.totalBytes() / 1048576.0f,
+                usage.colorBufferCount,
+                (float)usage.colorBufferBytes / 1048576.0f,
+                usage.bufferCount, (float)usage.bufferBytes / 1048576.0f);
+    }
+    return res;
+}
+
+std::string FrameBuffer::printProcCleanupStats() {
+    const uint64_t count = m_procCleanupCount;
+    if (!count) {
+        return "";
+    }
+    return android::base::StringFormat(
+            "Process cleanup: %llu processes, m_lock held avg %llu us max "
+            "%llu us, %llu objects released in %llu ms",
+            (unsigned long long)count,
+            (unsigned long long)(m_procCleanupLockedUs / count),
+            (unsigned long long)m_procCleanupMaxLockedUs.load(),
+            (unsigned long long)m_procCleanupObjects.load(),
+            (unsigned long long)(m_procCleanupReleaseUs / 1000));
+}
+
+std::string FrameBuffer::printPresentStats() {
+    if (!m_postWorker) {
+        return "";
+    }
+    const PostWorker::PresentStats stats = m_postWorker->getPresentStats();
+    std::string res = android::base::StringFormat(
+            "Present: %llu frames (%llu partial), %.2f mpixels",
+            (unsigned long long)stats.frames,
+            (unsigned long long)stats.partialFrames,
+            (double)stats.pixels / 1000000.0);
+    if (stats.composes) {
+        res += android::base::StringFormat(
+                ", %llu composes (%llu skipped) of %llu layers in %llu draws",
+                (unsigned long long)stats.composes,
+                (unsigned long long)stats.skippedComposes,
+                (unsigned long long)stats.composedLayers,
+                (unsigned long long)stats.composeDraws);
+    }
+    const uint64_t postFrames = m_postFrames;
+    if (postFrames) {
+        res += android::base::StringFormat(
+                ", post thread %.2f ms per frame",
+                (double)m_postFrameUs / postFrames / 1000.0);
+    }
+    std::string pacing = m_framePacer.printStats();
+    if (!pacing.empty()) {
+        res += "\n" + pacing;
+    }
+    return res;
+}
+
 void FrameBuffer::waitForGpu(uint64_t eglsync) {
     FenceSync* fenceSync = FenceSync::getFromHandle(eglsync);
 
@@ -3264,17 +3850,15 @@ void FrameBuffer::waitForGpu(uint64_t eglsync) {
         return;
     }
 
-    SyncThread::get()->triggerBlockedWaitNoTimeline(fenceSync);
+    SyncThread::get()->triggerBlockedWaitNoTimeline(eglsync);
 }
 
 void FrameBuffer::waitForGpuVulkan(uint64_t deviceHandle, uint64_t fenceHandle) {
     (void)deviceHandle;
 
-    // Note: this will always be nullptr.
-    FenceSync* fenceSync = FenceSync::getFromHandle(fenceHandle);
-
-    // Note: this will always signal right away.
-    SyncThread::get()->triggerBlockedWaitNoTimeline(fenceSync);
+    // Note: this will always signal right away, as |fenceHandle| is not a
+    // FenceSync handle.
+    SyncThread::get()->triggerBlockedWaitNoTimeline(fenceHandle);
 }
 
 void FrameBuffer::supportDynamicSize(uint32_t display_id, unsigned int p_colorbuffer, int32_t width, int32_t height, bool support)
@@ -25,6 +25,7 @@
 #include "ColorBuffer.h"
 #include "emugl/common/mutex.h"
 #include "FbConfig.h"
+#include "FramePacer.h"
 #include "GLESVersionDetector.h"
 #include "Hwc2.h"
 #include "PostWorker.h"
@@ -38,6 +39,7 @@
 
 #include <EGL/egl.h>
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <unordered_map>
@@ -57,10 +59,27 @@ struct ColorBufferRef {
     // Tracks the time when this buffer got a close request while not being
     // opened yet.
     android::base::System::Duration closedTs;
+
+    // Guest process the GPU memory of this buffer is charged to: the first
+    // process that opened it, or the creator if it was never opened.
+    uint64_t ownerPuid;
 };
 
 struct BufferRef {
     BufferPtr buffer;
+    uint64_t ownerPuid;  // creating guest process
+};
+
+// GPU memory charged to one guest process, see
+// FrameBuffer::getProcGpuMemoryUsage().
+struct ProcGpuMemoryUsage {
+    uint64_t puid = 0;
+    size_t colorBufferCount = 0;
+    size_t colorBufferBytes = 0;
+    size_t bufferCount = 0;
+    size_t bufferBytes = 0;
+
+    size_t totalBytes() const { return colorBufferBytes + bufferBytes; }
 };
 
 typedef std::unordered_map<HandleType, std::pair<WindowSurfacePtr, HandleType> > WindowSurfaceMap;
@@ -314,6 +333,12 @@ public:
                       HandleType p_drawSurface,
                       HandleType p_readSurface);
 
+    // Makes the context and surfaces recorded in the current RenderThreadInfo
+    // current again on the calling thread, after a render worker switched
+    // to another guest connection. Unlike bindContext(), surfaces are not
+    // rebound. Returns true on success, false on failure.
+    bool  restoreContext();
+
     // Return a render context pointer from its handle
     RenderContextPtr getContext_locked(HandleType p_context);
 
@@ -451,7 +476,20 @@ public:
     // acquiring/releasing the FrameBuffer instance's lock and binding the
     // contexts. It should be |false| only when called internally.
     //bool post(HandleType p_colorbuffer, bool needLockAndBind = true);
+    // Posts are paced to the host refresh rate, see FramePacer, with the
+    // swap interval of the calling render thread's draw surface.
     bool post(int display_id, HandleType p_colorbuffer, int32_t width, int32_t height, int32_t orientation, bool needLockAndBind = true);
+    // A frame for postDisplays().
+    struct DisplayPost {
+        int display_id;
+        HandleType colorbuffer;
+        int32_t width;
+        int32_t height;
+        int32_t orientation;
+    };
+    // Posts |posts| like post() does, each window waiting for its own
+    // deadline only: frames are posted in the order their slots come up.
+    void postDisplays(const std::vector<DisplayPost>& posts);
     bool hasGuestPostedAFrame() { return m_guestPostedAFrame; }
     void resetGuestPostedAFrame() { m_guestPostedAFrame = false; }
 
@@ -460,6 +498,12 @@ public:
     void doPostCallback(void* pixels, uint32_t displayId);
 
     void getPixels(void* pixels, uint32_t bytes, uint32_t displayId);
+    // Returns a reference to the latest frame read back for |displayId|,
+    // mapped so that consumers can read it without a copy, or null if none
+    // is ready yet. See ReadbackFrame.
+    ReadbackFramePtr acquireReadbackFrame(uint32_t displayId);
+    void releaseReadbackFrame(uint32_t displayId, uint32_t slot,
+                              uint64_t frameNumber);
     void flushReadPipeline(int displayId);
     void ensureReadbackWorker();
 
@@ -631,11 +675,39 @@ public:
     HandleType getLastPostedColorBuffer() { return m_lastPostedColorBuffer; }
     void waitForGpu(uint64_t eglsync);
     void waitForGpuVulkan(uint64_t deviceHandle, uint64_t fenceHandle);
-    void addCaptureScreenColorBuffer(HandleType p_colorbuffer) { m_captureScreenColorBuffers.emplace(p_colorbuffer);}
-    void removeCaptureScreenColorBuffer(HandleType p_colorbuffer) { m_captureScreenColorBuffers.erase(p_colorbuffer);}
-    bool isOwnedByCaptureScreen(HandleType p_colorbuffer) { return m_captureScreenColorBuffers.count(p_colorbuffer);}
+    // These take their own lock: ColorBuffers can be destroyed outside of
+    // m_lock (see cleanupProcGLObjects()).
+    void addCaptureScreenColorBuffer(HandleType p_colorbuffer) {
+        emugl::Mutex::AutoLock lock(m_captureScreenLock);
+        m_captureScreenColorBuffers.emplace(p_colorbuffer);
+    }
+    void removeCaptureScreenColorBuffer(HandleType p_colorbuffer) {
+        emugl::Mutex::AutoLock lock(m_captureScreenLock);
+        m_captureScreenColorBuffers.erase(p_colorbuffer);
+    }
+    bool isOwnedByCaptureScreen(HandleType p_colorbuffer) {
+        emugl::Mutex::AutoLock lock(m_captureScreenLock);
+        return m_captureScreenColorBuffers.count(p_colorbuffer);
+    }
     void supportDynamicSize(uint32_t display_id, unsigned int p_colorbuffer, int32_t width, int32_t height, bool support);
-    
+
+    // Per guest process GPU memory usage, largest consumers first.
+    // |maxEntries| == 0 returns every process.
+    std::vector<ProcGpuMemoryUsage> getProcGpuMemoryUsage(size_t maxEntries = 0);
+    // Human readable report of the |maxEntries| largest consumers.
+    std::string printProcGpuMemoryUsage(size_t maxEntries);
+
+    // Number of frames and pixels presented to the host windows, how
+    // many frames only redrew their damaged region, the time the post
+    // thread spends per frame, and how well frames kept to the host
+    // refresh.
+    std::string printPresentStats();
+
+    // Dead processes cleaned up, how long m_lock was held for them (the
+    // stall other render threads see) and how long releasing their GL
+    // objects took in the background.
+    std::string printProcCleanupStats();
+
 private:
     FrameBuffer(int p_width, int p_height, bool useSubWindow);
     HandleType genHandle_locked();
@@ -643,8 +715,24 @@ private:
     bool bindSubwin_locked(EGLSurface surface);
     bool bindFakeWindow_locked();
     bool removeSubWindow_locked();
-    // Returns the set of ColorBuffers destroyed (for further cleanup)
-    std::vector<HandleType> cleanupProcGLObjects_locked(uint64_t puid, bool forced = false);
+    // Objects of a dead process that are gone from the handle maps but
+    // still need their GL/EGL resources released.
+    struct ProcCleanupBatch {
+        std::vector<WindowSurfacePtr> windowSurfaces;
+        std::vector<ColorBufferPtr> colorBuffers;
+        std::vector<HandleType> eglImages;
+        std::vector<RenderContextPtr> contexts;
+    };
+
+    // Returns the set of ColorBuffers destroyed (for further cleanup).
+    // With |deferred|, references to the objects are moved there and
+    // EGLImages are not destroyed, so that no GL work is done here.
+    std::vector<HandleType> cleanupProcGLObjects_locked(
+            uint64_t puid, bool forced = false,
+            ProcCleanupBatch* deferred = nullptr);
+    // Drops |batch| a few objects at a time, taking m_lock and the helper
+    // context for each group only.
+    void releaseProcCleanupBatch(ProcCleanupBatch* batch);
 
     void markOpened(ColorBufferRef* cbRef);
     // Returns true if the color buffer was erased.
@@ -678,6 +766,15 @@ private:
     void setDisplayPoseInSkinUI(int totalHeight);
     void sweepColorBuffersLocked();
 
+    ProcGpuMemoryUsage procGpuMemoryUsageLocked(uint64_t puid);
+    // Returns false if allocating |newBytes| more for |puid| would exceed
+    // the hard budget even after reclaiming. Reclaims memory when the soft
+    // budget is exceeded.
+    bool checkProcGpuBudgetLocked(uint64_t puid, size_t newBytes);
+    // Frees pooled textures and asks the post thread to drop the resize
+    // caches of the color buffers not on screen, without waiting for it.
+    void reclaimGpuMemoryLocked(uint64_t puid);
+
 private:
     static FrameBuffer *s_theFrameBuffer;
     static HandleType s_nextHandle;
@@ -697,6 +794,11 @@ private:
     int m_statsNumFrames = 0;
     long long m_statsStartTime = 0;
 
+    // Cold start timestamps, see initialize() and post().
+    uint64_t m_initStartUs = 0;
+    uint64_t m_initDoneUs = 0;
+    std::atomic<bool> m_firstFramePosted{false};
+
     android::base::Thread* m_perfThread;
     emugl::Mutex m_lock;
     emugl::ReadWriteMutex m_contextStructureLock;
@@ -709,6 +811,7 @@ private:
     ColorBufferMap m_colorbuffers;
     BufferMap m_buffers;
     std::unordered_map<HandleType, HandleType> m_windowSurfaceToColorBuffer;
+    emugl::Mutex m_captureScreenLock;
     std::set<HandleType> m_captureScreenColorBuffers;
 
     // A collection of color buffers that were closed without any usages
@@ -752,10 +855,11 @@ private:
     // Async readback
     enum class ReadbackCmd {
         Init = 0,
-        GetPixels = 1,
+        AcquireFrame = 1,
         AddRecordDisplay = 2,
         DelRecordDisplay = 3,
         Exit = 4,
+        ReleaseFrame = 5,
     };
     struct Readback {
         ReadbackCmd cmd;
@@ -765,6 +869,8 @@ private:
         uint32_t bytes;
         uint32_t width;
         uint32_t height;
+        uint32_t slot;
+        uint64_t frameNumber;
     };
     android::base::WorkerProcessingResult sendReadbackWorkerCmd(const Readback& readback);
     bool m_asyncReadbackSupported = true;
@@ -803,6 +909,27 @@ private:
     ProcOwnedRenderContexts m_procOwnedRenderContext;
     ProcOwnedCleanupCallbacks m_procOwnedCleanupCallbacks;
 
+    // Per guest process GPU memory budgets, 0 == unlimited. Set with
+    // ANDROID_EMUGL_PROC_GPU_SOFT_MB and ANDROID_EMUGL_PROC_GPU_HARD_MB.
+    size_t m_procGpuSoftBudgetBytes = 0;
+    size_t m_procGpuHardBudgetBytes = 0;
+    uint64_t m_gpuReclaimCount = 0;
+    std::atomic<uint64_t> m_gpuReclaimedBytes{0};
+    uint64_t m_gpuBudgetRejectCount = 0;
+    // Set while a DropResizeCaches command is queued to the post thread.
+    std::atomic<bool> m_resizeCacheDropPending{false};
+    // References the post thread is done with after dropping their resize
+    // caches. They are released by sweepColorBuffersLocked() so the last
+    // reference to a color buffer never goes away on the post thread.
+    emugl::Mutex m_droppedResizeCacheLock;
+    std::vector<ColorBufferPtr> m_droppedResizeCacheRefs;
+
+    std::atomic<uint64_t> m_procCleanupCount{0};
+    std::atomic<uint64_t> m_procCleanupLockedUs{0};
+    std::atomic<uint64_t> m_procCleanupMaxLockedUs{0};
+    std::atomic<uint64_t> m_procCleanupReleaseUs{0};
+    std::atomic<uint64_t> m_procCleanupObjects{0};
+
     // Flag set when emulator is shutting down.
     bool m_shuttingDown = false;
 
@@ -828,6 +955,7 @@ private:
         Clear = 3,
         Screenshot = 4,
         Exit = 5,
+        DropResizeCaches = 6,
     };
 
     struct Post {
@@ -848,14 +976,26 @@ private:
                 SkinRotation rotation;
                 void* pixels;
             } screenshot;
+            // Owned by the command, deleted by the post thread.
+            std::vector<ColorBufferPtr>* resizeCaches;
         };
         RendererWindowAttri **window_attri;
     };
 
     std::unique_ptr<PostWorker> m_postWorker = {};
+    FramePacer m_framePacer;
+    // Time the post thread spent drawing and swapping guest frames.
+    std::atomic<uint64_t> m_postFrames{0};
+    std::atomic<uint64_t> m_postFrameUs{0};
     android::base::WorkerThread<Post> m_postThread;
     android::base::WorkerProcessingResult postWorkerFunc(const Post& post);
     void sendPostWorkerCmd(Post post);
+    // The swap interval to pace the calling render thread's posts with.
+    int getCallerSwapInterval();
+    // Waits for |slot| and posts the frame unless it was superseded.
+    bool postInSlot(const FramePacer::Slot& slot, HandleType p_colorbuffer,
+                    int32_t width, int32_t height, int32_t orientation,
+                    bool needLockAndBind);
 
     bool m_fastBlitSupported = false;
     bool m_vulkanInteropSupported = false;
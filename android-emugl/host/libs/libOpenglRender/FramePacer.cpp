@@ -0,0 +1,176 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "FramePacer.h"
+
+#include "android/base/StringFormat.h"
+#include "android/base/system/System.h"
+#include "emugl/common/shared_library.h"
+
+#include <algorithm>
+
+#include <stdlib.h>
+
+#include <X11/Xlib.h>
+
+using android::base::AutoLock;
+using android::base::System;
+
+static const int kDefaultRefreshHz = 60;
+
+// Refresh rate of the default X11 screen, through libXrandr if present.
+static int sQueryX11RefreshHz() {
+    struct XRRScreenConfiguration;
+    using GetScreenInfo = XRRScreenConfiguration* (*)(Display*, Window);
+    using ConfigCurrentRate = short (*)(XRRScreenConfiguration*);
+    using FreeScreenConfigInfo = void (*)(XRRScreenConfiguration*);
+
+    char error[256];
+    emugl::SharedLibrary* lib =
+            emugl::SharedLibrary::open("libXrandr.so.2", error, sizeof(error));
+    if (!lib) {
+        return 0;
+    }
+    auto getScreenInfo = (GetScreenInfo)lib->findSymbol("XRRGetScreenInfo");
+    auto currentRate =
+            (ConfigCurrentRate)lib->findSymbol("XRRConfigCurrentRate");
+    auto freeInfo =
+            (FreeScreenConfigInfo)lib->findSymbol("XRRFreeScreenConfigInfo");
+    if (!getScreenInfo || !currentRate || !freeInfo) {
+        return 0;
+    }
+
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return 0;
+    }
+    int hz = 0;
+    XRRScreenConfiguration* config =
+            getScreenInfo(display, DefaultRootWindow(display));
+    if (config) {
+        hz = currentRate(config);
+        freeInfo(config);
+    }
+    XCloseDisplay(display);
+    return hz;
+}
+
+FramePacer::FramePacer() {
+    std::string interval = System::get()->envGet("ANDROID_EMUGL_SWAP_INTERVAL");
+    if (!interval.empty()) {
+        mDefaultInterval = std::max(atoi(interval.c_str()), 0);
+    }
+}
+
+uint64_t FramePacer::periodUsLocked() {
+    if (!mPeriodUs) {
+        std::string hz =
+                System::get()->envGet("ANDROID_EMUGL_DISPLAY_REFRESH_HZ");
+        mRefreshHz = hz.empty() ? sQueryX11RefreshHz() : atoi(hz.c_str());
+        if (mRefreshHz <= 0 || mRefreshHz > 1000) {
+            mRefreshHz = kDefaultRefreshHz;
+        }
+        mPeriodUs = 1000000 / mRefreshHz;
+    }
+    return mPeriodUs;
+}
+
+FramePacer::Slot FramePacer::reserve(int displayId, int interval) {
+    interval = std::max(interval, 0);
+    const uint64_t now = System::get()->getHighResTimeUs();
+
+    AutoLock lock(mLock);
+    Window& w = mWindows[displayId];
+    const uint64_t deadline =
+            interval && w.nextDeadlineUs > now ? w.nextDeadlineUs : now;
+    return {displayId, interval, deadline, ++w.generation};
+}
+
+bool FramePacer::claim(const Slot& slot) {
+    AutoLock lock(mLock);
+    auto it = mWindows.find(slot.displayId);
+    if (it == mWindows.end()) {
+        return true;
+    }
+    if (it->second.generation != slot.generation) {
+        ++mDropped;
+        return false;
+    }
+    it->second.slotUs = slot.deadlineUs;
+    it->second.interval = slot.interval;
+    return true;
+}
+
+void FramePacer::onPresented(int displayId) {
+    const uint64_t now = System::get()->getHighResTimeUs();
+
+    AutoLock lock(mLock);
+    auto it = mWindows.find(displayId);
+    if (it == mWindows.end()) {
+        return;
+    }
+    Window& w = it->second;
+    const uint64_t period = w.interval ? periodUsLocked() : 0;
+    const uint64_t step = (uint64_t)w.interval * period;
+
+    const uint64_t latency = now > w.slotUs ? now - w.slotUs : 0;
+    ++mFrames;
+    mLatencySumUs += latency;
+    mLatencyMaxUs = std::max(mLatencyMaxUs, latency);
+    if (step && latency > period) {
+        ++mMissed;
+    }
+
+    // Only frames of a running animation count towards jitter; a window
+    // that was idle is not late.
+    if (step && w.lastPresentUs && now - w.lastPresentUs < 2 * step) {
+        const uint64_t delta = now - w.lastPresentUs;
+        mJitterSumUs += delta > step ? delta - step : step - delta;
+        ++mJitterSamples;
+    }
+    w.lastPresentUs = now;
+
+    // Keep the window on its own grid, unless it fell behind by more than
+    // a period.
+    if (step && w.nextDeadlineUs && w.slotUs < w.nextDeadlineUs + period) {
+        w.nextDeadlineUs += step;
+    } else {
+        w.nextDeadlineUs = now + step;
+    }
+}
+
+void FramePacer::forget(int displayId) {
+    AutoLock lock(mLock);
+    mWindows.erase(displayId);
+}
+
+std::string FramePacer::printStats() {
+    AutoLock lock(mLock);
+    if (!mFrames) {
+        return "";
+    }
+    // mRefreshHz stays 0 if no frame was ever paced.
+    return android::base::StringFormat(
+            "Frame pacing: %d Hz, default interval %d, %llu frames, "
+            "%llu dropped, %llu missed deadlines, latency avg %llu us max "
+            "%llu us, jitter avg %llu us",
+            mRefreshHz, mDefaultInterval, (unsigned long long)mFrames,
+            (unsigned long long)mDropped, (unsigned long long)mMissed,
+            (unsigned long long)(mLatencySumUs / mFrames),
+            (unsigned long long)mLatencyMaxUs,
+            (unsigned long long)(mJitterSamples
+                                         ? mJitterSumUs / mJitterSamples
+                                         : 0));
+}
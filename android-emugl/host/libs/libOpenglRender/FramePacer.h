@@ -0,0 +1,107 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "android/base/Compiler.h"
+#include "android/base/synchronization/Lock.h"
+
+#include <string>
+#include <unordered_map>
+
+#include <stdint.h>
+
+// Paces the frames guest windows post to the refresh rate of the host
+// display.
+//
+// Host window surfaces are swapped with vsync off (see EglOsApi_glx.cpp),
+// as a blocking swap on the one post thread would make every window wait
+// on the others. Instead each window gets a deadline every |swap interval|
+// refresh periods: a frame reserves the next slot of its window, the thread
+// posting it sleeps until the slot's deadline without the decoding lock,
+// and then claims the slot before handing the frame to the post thread.
+// Other windows and render threads are not delayed by it, and a frame
+// superseded while waiting is dropped.
+//
+// The swap interval is the one the guest set on the surface it posts from
+// (rcFBSetSwapInterval), defaulting to ANDROID_EMUGL_SWAP_INTERVAL or 0
+// (no pacing). The refresh rate is looked up the first time a frame is
+// paced: ANDROID_EMUGL_DISPLAY_REFRESH_HZ, else the X11 screen's, else
+// 60 Hz.
+class FramePacer {
+public:
+    FramePacer();
+
+    // The interval for surfaces the guest set none on.
+    int getDefaultSwapInterval() const { return mDefaultInterval; }
+
+    // A frame's turn to be presented, see reserve().
+    struct Slot {
+        int displayId;
+        int interval;
+        uint64_t deadlineUs;
+        uint64_t generation;
+    };
+
+    // Reserves the next slot of |displayId| for a frame shown for
+    // |interval| refresh periods. Any earlier frame of the window that has
+    // not claimed its slot yet is superseded.
+    Slot reserve(int displayId, int interval);
+
+    // Called once the deadline of |slot| has passed. Returns false if a
+    // newer frame of the window reserved a slot meanwhile, in which case
+    // this one must be dropped.
+    bool claim(const Slot& slot);
+
+    // Called once the frame of the claimed slot was presented.
+    void onPresented(int displayId);
+
+    // Drops the state of a window that went away.
+    void forget(int displayId);
+
+    // Refresh rate, frames paced and dropped, deadlines missed by more
+    // than a refresh period, latency from the deadline to the end of the
+    // swap, and the average deviation of frame intervals from the target.
+    std::string printStats();
+
+private:
+    struct Window {
+        uint64_t nextDeadlineUs = 0;
+        uint64_t slotUs = 0;  // deadline of the frame being presented
+        int interval = 0;     // and its swap interval
+        uint64_t lastPresentUs = 0;
+        uint64_t generation = 0;
+    };
+
+    // Refresh period of the host display, looked up on first use.
+    uint64_t periodUsLocked();
+
+    int mDefaultInterval = 0;
+
+    android::base::Lock mLock;
+    uint64_t mPeriodUs = 0;
+    int mRefreshHz = 0;
+    std::unordered_map<int, Window> mWindows;
+
+    uint64_t mFrames = 0;
+    uint64_t mDropped = 0;
+    uint64_t mMissed = 0;
+    uint64_t mLatencySumUs = 0;
+    uint64_t mLatencyMaxUs = 0;
+    uint64_t mJitterSumUs = 0;
+    uint64_t mJitterSamples = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(FramePacer);
+};
@@ -130,6 +130,12 @@ GLESDispatchMaxVersion calcMaxVersionFromDispatch(EGLDisplay dpy) {
                      GLES_DISPATCH_MAX_VERSION_3_0);
     }
 
+    setGlesVersionFromMaxVersion(maxVersion);
+
+    return maxVersion;
+}
+
+void setGlesVersionFromMaxVersion(GLESDispatchMaxVersion maxVersion) {
     int maj = 2; int min = 0;
     switch (maxVersion) {
         case GLES_DISPATCH_MAX_VERSION_2:
@@ -145,8 +151,6 @@ GLESDispatchMaxVersion calcMaxVersionFromDispatch(EGLDisplay dpy) {
     }
 
     emugl::setGlesVersion(maj, min);
-
-    return maxVersion;
 }
 
 // For determining whether or not to use core profile OpenGL.
@@ -24,6 +24,11 @@
 // Used to determine maximum supported GLES version.
 GLESDispatchMaxVersion calcMaxVersionFromDispatch(EGLDisplay dpy);
 
+// Publish |maxVersion| through emugl::setGlesVersion(). Done implicitly by
+// calcMaxVersionFromDispatch(); needed when the version comes from elsewhere
+// (e.g. the GPU capability cache).
+void setGlesVersionFromMaxVersion(GLESDispatchMaxVersion maxVersion);
+
 // For determining whether or not to use core profile OpenGL.
 bool shouldEnableCoreProfile();
 
@@ -0,0 +1,28 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "android/base/system/System.h"
+
+// glGetError() and other state queries make the CPU wait for the GPU on
+// several drivers, so the post and compose paths only look for GL errors
+// when ANDROID_EMUGL_CHECK_POST_GL_ERRORS is set.
+inline bool shouldCheckPostGlErrors() {
+    static const bool check = !android::base::System::get()
+                                       ->envGet("ANDROID_EMUGL_CHECK_POST_GL_ERRORS")
+                                       .empty();
+    return check;
+}
@@ -0,0 +1,135 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "GpuCapabilityCache.h"
+
+#include "android/base/files/IniFile.h"
+#include "android/base/files/PathUtils.h"
+#include "android/base/system/System.h"
+#include "android/utils/path.h"
+
+#include "emugl/common/feature_control.h"
+#include "emugl/common/logging.h"
+#include "emugl/common/misc.h"
+
+using android::base::IniFile;
+using android::base::PathUtils;
+using android::base::System;
+
+// Bump this whenever the set of cached values or their meaning changes.
+static const int kCacheFormatVersion = 1;
+
+static const char kKeyFormatVersion[] = "format_version";
+static const char kKeyRenderer[] = "selected_renderer";
+static const char kKeyPlayStoreImage[] = "play_store_image";
+static const char kKeyGlVendor[] = "gl_vendor";
+static const char kKeyGlRenderer[] = "gl_renderer";
+static const char kKeyGlVersion[] = "gl_version";
+static const char kKeyMaxVersion[] = "gles_dispatch_max_version";
+static const char kKeyHasGlOesImage[] = "has_gl_oes_image";
+
+static bool sPlayStoreImage() {
+    return emugl::emugl_feature_is_enabled(
+            android::featurecontrol::PlayStoreImage);
+}
+
+GpuCapabilityCache::GpuCapabilityCache() {
+    System* system = System::get();
+    if (!system->envGet("ANDROID_EMUGL_DISABLE_GPU_CAPS_CACHE").empty()) {
+        return;
+    }
+
+    std::string cacheDir = system->envGet("XDG_CACHE_HOME");
+    if (cacheDir.empty()) {
+        const std::string& home = system->getHomeDirectory();
+        if (home.empty()) {
+            return;
+        }
+        cacheDir = PathUtils::join(home, ".cache");
+    }
+    mDir = PathUtils::join(cacheDir, "fde");
+    mPath = PathUtils::join(mDir, "gpu_caps.ini");
+}
+
+bool GpuCapabilityCache::load(GpuCapabilities* caps) {
+    if (!isEnabled() || !System::get()->pathIsFile(mPath)) {
+        return false;
+    }
+
+    IniFile ini(mPath);
+    if (!ini.read(false)) {
+        return false;
+    }
+
+    if (ini.getInt(kKeyFormatVersion, -1) != kCacheFormatVersion ||
+        ini.getInt(kKeyRenderer, -1) != (int)emugl::getRenderer() ||
+        ini.getBool(kKeyPlayStoreImage, !sPlayStoreImage()) !=
+                sPlayStoreImage()) {
+        GL_LOG("GPU capability cache %s is stale", mPath.c_str());
+        return false;
+    }
+
+    int maxVersion = ini.getInt(kKeyMaxVersion, -1);
+    if (maxVersion < GLES_DISPATCH_MAX_VERSION_2 ||
+        maxVersion > GLES_DISPATCH_MAX_VERSION_3_2) {
+        return false;
+    }
+
+    caps->glVendor = ini.getString(kKeyGlVendor, "");
+    caps->glRenderer = ini.getString(kKeyGlRenderer, "");
+    caps->glVersion = ini.getString(kKeyGlVersion, "");
+    caps->maxVersion = (GLESDispatchMaxVersion)maxVersion;
+    caps->hasGlOesImage = ini.getBool(kKeyHasGlOesImage, false);
+
+    return !caps->glRenderer.empty();
+}
+
+// static
+bool GpuCapabilityCache::matches(const GpuCapabilities& caps,
+                                 const std::string& glVendor,
+                                 const std::string& glRenderer,
+                                 const std::string& glVersion) {
+    return caps.glVendor == glVendor && caps.glRenderer == glRenderer &&
+           caps.glVersion == glVersion;
+}
+
+bool GpuCapabilityCache::store(const GpuCapabilities& caps) {
+    if (!isEnabled()) {
+        return false;
+    }
+
+    if (path_mkdir_if_needed(mDir.c_str(), 0755) < 0) {
+        GL_LOG("Cannot create GPU capability cache directory %s", mDir.c_str());
+        return false;
+    }
+
+    IniFile ini(mPath);
+    ini.setInt(kKeyFormatVersion, kCacheFormatVersion);
+    ini.setInt(kKeyRenderer, (int)emugl::getRenderer());
+    ini.setBool(kKeyPlayStoreImage, sPlayStoreImage());
+    ini.setString(kKeyGlVendor, caps.glVendor);
+    ini.setString(kKeyGlRenderer, caps.glRenderer);
+    ini.setString(kKeyGlVersion, caps.glVersion);
+    ini.setInt(kKeyMaxVersion, (int)caps.maxVersion);
+    ini.setBool(kKeyHasGlOesImage, caps.hasGlOesImage);
+    return ini.write();
+}
+
+void GpuCapabilityCache::invalidate() {
+    if (isEnabled() && System::get()->pathIsFile(mPath)) {
+        System::get()->deleteFile(mPath);
+    }
+}
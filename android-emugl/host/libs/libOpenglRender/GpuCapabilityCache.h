@@ -0,0 +1,70 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "OpenGLESDispatch/GLESv2Dispatch.h"
+
+#include <string>
+
+// Result of the host GPU probing done by FrameBuffer::initialize().
+// |glVendor|, |glRenderer| and |glVersion| identify the GPU and driver
+// the other fields were measured on.
+struct GpuCapabilities {
+    std::string glVendor;
+    std::string glRenderer;
+    std::string glVersion;
+    GLESDispatchMaxVersion maxVersion = GLES_DISPATCH_MAX_VERSION_2;
+    bool hasGlOesImage = false;
+};
+
+// Small on-disk cache of GpuCapabilities so that the renderer does not
+// have to create throw-away contexts on every cold start just to find
+// out what the host GPU can do.
+//
+// The cache is an ini file stored under $XDG_CACHE_HOME (or ~/.cache).
+// An entry is only returned by load() when its format version, selected
+// renderer and feature set match the current process; the caller must
+// still compare the GL strings with matches() once a context is current
+// and call invalidate() when they differ (e.g. after a driver update).
+//
+// Setting ANDROID_EMUGL_DISABLE_GPU_CAPS_CACHE disables the cache.
+class GpuCapabilityCache {
+public:
+    GpuCapabilityCache();
+
+    bool isEnabled() const { return !mPath.empty(); }
+
+    // Fill |caps| from the cache file. Returns false if there is no
+    // usable entry.
+    bool load(GpuCapabilities* caps);
+
+    // Returns true if |caps| were measured on the GPU described by the
+    // given GL strings.
+    static bool matches(const GpuCapabilities& caps,
+                        const std::string& glVendor,
+                        const std::string& glRenderer,
+                        const std::string& glVersion);
+
+    // Persist |caps|, replacing any previous entry.
+    bool store(const GpuCapabilities& caps);
+
+    // Remove the cache file so that the next start does a full probe.
+    void invalidate();
+
+private:
+    std::string mDir;
+    std::string mPath;
+};
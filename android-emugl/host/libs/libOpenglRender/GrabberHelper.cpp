@@ -18,10 +18,40 @@
  */
  
 #include "GrabberHelper.h"
+#include "PixelConvert.h"
+#include "emugl/common/misc.h"
+#include <GLES2/gl2ext.h>
+#include <GLES3/gl3.h>
 #include <sys/shm.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <string.h>
 
+// Upper bound for waiting on the GPU before reusing a PBO slot. A slot is
+// only reused GRABBER_PBO_SLOTS frames later, so this is normally a no-op.
+static const GLuint64 kSlotWaitTimeoutNs = 1000000000ULL;
+
+static uint32_t bytesPerPixel(GLenum format, GLenum type)
+{
+    if (type == GL_UNSIGNED_SHORT_5_6_5) {
+        return 2;
+    }
+    if (type != GL_UNSIGNED_BYTE) {
+        return 0;
+    }
+    switch (format) {
+        case GL_LUMINANCE:
+            return 1;
+        case GL_RGB:
+            return 3;
+        case GL_RGBA:
+        case GL_BGRA_EXT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
 static const char vShaderCode[] =
     "attribute vec3 position;\n"
     "attribute vec2 inCoord;\n"
@@ -55,6 +85,10 @@ GrabberHelper::GrabberHelper(EGLDisplay display, uint32_t width, uint32_t height
     , m_fbo(0)
     , tmp_fbo(0)
     , m_img_tex_ready(false)
+    , m_fbo_tex_ready(false)
+    , m_fbo_tex_unfinished(false)
+    , m_use_pbo(false)
+    , m_unpack_index(0)
     , m_sem_for_shm(SEM_FAILED)
     , m_sem_for_grab(SEM_FAILED)
 {
@@ -62,6 +96,13 @@ GrabberHelper::GrabberHelper(EGLDisplay display, uint32_t width, uint32_t height
     m_data_info.shm_id = -1;
     m_data_info.shm_data = (void *) -1;
     memset(&m_screen_image_info, 0, sizeof(m_screen_image_info));
+    memset(m_unpack_slots, 0, sizeof(m_unpack_slots));
+    memset(&m_pack_slot, 0, sizeof(m_pack_slot));
+
+    int glesMaj = 2, glesMin = 0;
+    emugl::getGlesVersion(&glesMaj, &glesMin);
+    m_use_pbo = glesMaj >= 3 && s_gles2.glMapBufferRange && s_gles2.glUnmapBuffer &&
+        s_gles2.glFenceSync && s_gles2.glClientWaitSync && s_gles2.glDeleteSync;
 
     InitVerticeData();
     InitImageTex();
@@ -76,6 +117,10 @@ GrabberHelper::~GrabberHelper()
     if (m_fbo_tex != 0) s_gles2.glDeleteTextures(1, &m_fbo_tex);
     if (m_fbo != 0) s_gles2.glDeleteFramebuffers(1, &m_fbo);
     if (tmp_fbo != 0) s_gles2.glDeleteFramebuffers(1, &tmp_fbo);
+    for (int i = 0; i < GRABBER_PBO_SLOTS; i++) {
+        DestroySlot(m_unpack_slots[i]);
+    }
+    DestroySlot(m_pack_slot);
     if (m_shader) delete m_shader;
     if ((m_data_info.shm_id != -1) && (m_data_info.shm_data != (void *) -1)) {
         shmdt(m_data_info.shm_data);
@@ -285,20 +330,148 @@ void GrabberHelper::InitImageTex()
     s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-bool GrabberHelper::UpdateImageTex()
+bool GrabberHelper::PrepareSlot(pbo_slot &slot, GLenum target, uint32_t size, GLenum usage)
+{
+    WaitSlot(slot);
+    if (slot.pbo == 0) {
+        s_gles2.glGenBuffers(1, &slot.pbo);
+    }
+    s_gles2.glBindBuffer(target, slot.pbo);
+    if (slot.size != size) {
+        s_gles2.glBufferData(target, size, NULL, usage);
+        slot.size = size;
+    }
+    return slot.pbo != 0;
+}
+
+void GrabberHelper::WaitSlot(pbo_slot &slot)
 {
+    if (slot.fence) {
+        s_gles2.glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kSlotWaitTimeoutNs);
+        s_gles2.glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+}
+
+void GrabberHelper::DestroySlot(pbo_slot &slot)
+{
+    if (slot.fence) {
+        s_gles2.glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (slot.pbo != 0) {
+        s_gles2.glDeleteBuffers(1, &slot.pbo);
+        slot.pbo = 0;
+    }
+    slot.size = 0;
+}
+
+// Copy the shared memory image into a PBO and upload it from there to the
+// bound texture. Must be called with |m_sem_for_shm| held; only the copy
+// depends on it, the texture upload itself is queued to the GPU after it.
+// With |swizzle|, red and blue are swapped and alpha is made opaque on the
+// way, see UploadImageDirect().
+bool GrabberHelper::UploadImageViaPbo(shm_data_info *data_info, bool swizzle)
+{
+    uint32_t bpp = bytesPerPixel(m_img_tex_gl_format, m_img_tex_data_type);
+    if (bpp == 0) {
+        return false;
+    }
+    uint32_t size = data_info->width * data_info->height * bpp;
+    pbo_slot &slot = m_unpack_slots[m_unpack_index];
+    if (!PrepareSlot(slot, GL_PIXEL_UNPACK_BUFFER, size, GL_STREAM_DRAW)) {
+        return false;
+    }
+    // The fence was waited on in PrepareSlot(), no need to let the driver
+    // synchronize again.
+    void *dst = s_gles2.glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!dst) {
+        s_gles2.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+    if (swizzle) {
+        emugl::swapRedBlue(data_info->pixel_data, data_info->width * 4, dst,
+                           data_info->width * 4, data_info->width,
+                           data_info->height, true /* opaque */);
+    } else {
+        memcpy(dst, data_info->pixel_data, size);
+    }
+    s_gles2.glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    GLint prevAlignment = 0;
+    s_gles2.glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevAlignment);
+    s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    s_gles2.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, data_info->width, data_info->height,
+                            m_img_tex_gl_format, m_img_tex_data_type, 0);
+    s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, prevAlignment);
+    slot.fence = s_gles2.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s_gles2.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_unpack_index = (m_unpack_index + 1) % GRABBER_PBO_SLOTS;
+    return true;
+}
+
+// A 32-bit image the size of the FBO texture maps 1:1 onto it, and all
+// RenderToFboTex() would do is swap red and blue and make alpha opaque. Do
+// that on the CPU while copying out of the shared memory instead, and upload
+// straight into the FBO texture, saving the draw and the intermediate
+// texture upload.
+bool GrabberHelper::UploadImageDirect(shm_data_info *data_info)
+{
+    if (data_info->width != m_width || data_info->height != m_height ||
+        bytesPerPixel(m_img_tex_gl_format, m_img_tex_data_type) != 4) {
+        return false;
+    }
+    // Creates the FBO texture on first use.
+    if (!BindFbo()) {
+        return false;
+    }
+    UnbindFbo();
+
+    s_gles2.glBindTexture(GL_TEXTURE_2D, m_fbo_tex);
+    if (!m_use_pbo || !UploadImageViaPbo(data_info, true)) {
+        m_staging.resize(m_width * m_height * 4);
+        emugl::swapRedBlue(data_info->pixel_data, m_width * 4, m_staging.data(),
+                           m_width * 4, m_width, m_height, true /* opaque */);
+        s_gles2.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height,
+                                GL_RGBA, GL_UNSIGNED_BYTE, m_staging.data());
+    }
+    // Same as RenderToFboTex(): updataEglImage() finishes for other contexts.
+    s_gles2.glFlush();
+    m_fbo_tex_ready = true;
+    m_fbo_tex_unfinished = true;
+    return true;
+}
+
+// |new_frame| is set when |m_img_tex| got new content that still has to be
+// drawn into the FBO texture with RenderToFboTex(). When app_stream is busy
+// writing the shared memory we keep the previous image instead of blocking
+// the render thread on the semaphore.
+bool GrabberHelper::UpdateImageTex(bool *new_frame)
+{
+    *new_frame = false;
     if (!m_img_tex_ready) {
         InitImageTex();
     }
 
     if (m_img_tex_ready && GetSem()) {
+        if (sem_trywait(m_sem_for_shm) != 0) {
+            if (errno != EAGAIN) {
+                syslog(LOG_WARNING, "[GrabberHelper] Error: sem_trywait failed: %s", strerror(errno));
+            }
+            return m_fbo_tex_ready;
+        }
         shm_data_info *data_info = static_cast<shm_data_info *>(m_data_info.shm_data);
-        s_gles2.glBindTexture(GL_TEXTURE_2D, m_img_tex);
-        sem_wait(m_sem_for_shm);
         if (CheckDataInfo(data_info)) {
-            s_gles2.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, data_info->width, data_info->height, 
-                                    m_img_tex_gl_format, m_img_tex_data_type, data_info->pixel_data);
-            //s_gles2.glGenerateMipmap(GL_TEXTURE_2D);
+            if (!UploadImageDirect(data_info)) {
+                s_gles2.glBindTexture(GL_TEXTURE_2D, m_img_tex);
+                if (!m_use_pbo || !UploadImageViaPbo(data_info, false)) {
+                    s_gles2.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, data_info->width, data_info->height,
+                                            m_img_tex_gl_format, m_img_tex_data_type, data_info->pixel_data);
+                }
+                *new_frame = true;
+            }
         }
         else {
             syslog(LOG_WARNING, "[GrabberHelper] Error: Check data info failed!");
@@ -306,7 +479,7 @@ bool GrabberHelper::UpdateImageTex()
         sem_post(m_sem_for_shm);
         sem_post(m_sem_for_grab);
         s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
-        return true;
+        return *new_frame || m_fbo_tex_ready;
     }
     s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
     return false;
@@ -381,7 +554,12 @@ bool GrabberHelper::RenderToFboTex()
         s_gles2.glBindTexture(GL_TEXTURE_2D, m_img_tex);
 
         s_gles2.glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-        s_gles2.glFinish();
+        // ReadFboTexPixel() reads in this context and needs no wait. Other
+        // contexts sample the texture through the EGLImage; updataEglImage()
+        // finishes before handing it out.
+        s_gles2.glFlush();
+        m_fbo_tex_ready = true;
+        m_fbo_tex_unfinished = true;
 
         UnbindFbo();
         s_gles2.glBindVertexArray(0);
@@ -415,8 +593,10 @@ bool GrabberHelper::UpdateAndReadPixel(int x, int y, int width, int height, GLen
     }
     pre_time = now_time;
 */
-    if (UpdateImageTex() && RenderToFboTex()) {
-        bool tmp = ReadFboTexPixel(x, y, width, height, p_format, p_type, pixels);
+    bool new_frame = false;
+    if (UpdateImageTex(&new_frame) && (!new_frame || RenderToFboTex())) {
+        bool tmp = (m_use_pbo && ReadFboTexPixelViaPbo(x, y, width, height, p_format, p_type, pixels)) ||
+            ReadFboTexPixel(x, y, width, height, p_format, p_type, pixels);
         //int64_t tmp_time = hrt_time_micro();
         //syslog(LOG_DEBUG, "[GrabberHelper][%s] fps = %02f, coast %d us per frame.", 
         //    __func__, fps, tmp_time - now_time);
@@ -439,16 +619,56 @@ bool GrabberHelper::ReadFboTexPixel(int x, int y, int width, int height, GLenum
     return false;
 }
 
+// Read back through a PBO. The caller needs the frame it just rendered, so
+// wait for this read's fence before mapping; the PBO only spares the
+// driver the synchronous copy into client memory that glReadPixels does.
+bool GrabberHelper::ReadFboTexPixelViaPbo(int x, int y, int width, int height, GLenum p_format, GLenum p_type, void* pixels)
+{
+    uint32_t bpp = bytesPerPixel(p_format, p_type);
+    if (bpp == 0 || !BindFbo()) {
+        return false;
+    }
+    uint32_t size = width * height * bpp;
+    if (!PrepareSlot(m_pack_slot, GL_PIXEL_PACK_BUFFER, size, GL_STREAM_READ)) {
+        UnbindFbo();
+        return false;
+    }
+    GLint prevAlignment = 0;
+    s_gles2.glGetIntegerv(GL_PACK_ALIGNMENT, &prevAlignment);
+    s_gles2.glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    s_gles2.glReadPixels(x, y, width, height, p_format, p_type, 0);
+    s_gles2.glPixelStorei(GL_PACK_ALIGNMENT, prevAlignment);
+    m_pack_slot.fence = s_gles2.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    UnbindFbo();
+
+    WaitSlot(m_pack_slot);
+    s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pack_slot.pbo);
+    void *src = s_gles2.glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (src) {
+        memcpy(pixels, src, size);
+        s_gles2.glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return src != nullptr;
+}
+
 bool GrabberHelper::updataEglImage()
 {
     //syslog(LOG_DEBUG, "[GrabberHelper][%s]", __func__);
-    if (UpdateImageTex() && RenderToFboTex()) {
+    bool new_frame = false;
+    if (UpdateImageTex(&new_frame) && (!new_frame || RenderToFboTex())) {
         if (!m_egl_image) {
             m_egl_image = s_egl.eglCreateImageKHR(
                 m_display, s_egl.eglGetCurrentContext(), EGL_GL_TEXTURE_2D_KHR,
                 (EGLClientBuffer)(void*)(uintptr_t)(m_fbo_tex), NULL);
         }
         if (m_egl_image) {
+            // The image may be sampled from any context, which can't see
+            // the commands of this one until they have completed.
+            if (m_fbo_tex_unfinished) {
+                s_gles2.glFinish();
+                m_fbo_tex_unfinished = false;
+            }
             return true;
         }
         else {
@@ -24,12 +24,15 @@
 #include <semaphore.h>
 #include <string>
 #include <shared_mutex>
+#include <vector>
 
 #define MAX_IMAGE_WIDTH         20000
 #define MAX_IMAGE_HEIGHT        20000
 #define KEY_SHM_DATA_INFO       0x68788898
 #define SEM_NAME_FOR_SHM        "sem_shm"
 #define SEM_NAME_FOR_GRAB       "sem_grab"
+// Number of pixel buffer objects used for streaming uploads.
+#define GRABBER_PBO_SLOTS       2
 
 enum PIX_FMT{
     PIX_FMT_UNKNOW = 0,
@@ -68,6 +71,15 @@ typedef struct {
     void *shm_data;
 }shm_handle;
 
+// A pixel buffer object together with the fence of the last GPU command
+// that used it. The slot can only be written by the CPU once the fence
+// has signaled.
+typedef struct {
+    GLuint pbo;
+    GLsync fence;
+    uint32_t size;
+}pbo_slot;
+
 class GrabberHelper
 {
 public:
@@ -164,8 +176,14 @@ private:
     bool BindFbo();
     void UnbindFbo();
     bool RenderToFboTex();
-    bool UpdateImageTex();
+    bool UpdateImageTex(bool *new_frame);
+    bool UploadImageViaPbo(shm_data_info *data_info, bool swizzle);
+    bool UploadImageDirect(shm_data_info *data_info);
     bool ReadFboTexPixel(int x, int y, int width, int height, GLenum p_format, GLenum p_type, void* pixels);
+    bool ReadFboTexPixelViaPbo(int x, int y, int width, int height, GLenum p_format, GLenum p_type, void* pixels);
+    bool PrepareSlot(pbo_slot &slot, GLenum target, uint32_t size, GLenum usage);
+    void WaitSlot(pbo_slot &slot);
+    void DestroySlot(pbo_slot &slot);
     bool GetShm(shm_handle &shm);
     bool CheckDataInfo(shm_data_info *data_info);
     bool GetSem();
@@ -183,7 +201,19 @@ private:
     uint32_t m_fbo, tmp_fbo;
 
     bool m_img_tex_ready;
+    bool m_fbo_tex_ready;
+    // |m_fbo_tex| has new content that was only flushed, not finished.
+    bool m_fbo_tex_unfinished;
     GLenum m_img_tex_gl_format, m_img_tex_data_type;
+
+    // Streaming through PBOs needs GLES 3.0; without it the helper falls
+    // back to glTexSubImage2D/glReadPixels on client memory.
+    bool m_use_pbo;
+    pbo_slot m_unpack_slots[GRABBER_PBO_SLOTS];
+    pbo_slot m_pack_slot;
+    uint32_t m_unpack_index;
+    // Client memory for UploadImageDirect() when PBOs can't be used.
+    std::vector<uint8_t> m_staging;
     shm_handle m_data_info;
     sem_t *m_sem_for_shm, *m_sem_for_grab;
 
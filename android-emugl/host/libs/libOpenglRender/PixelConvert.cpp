@@ -0,0 +1,871 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "PixelConvert.h"
+
+#include "android/base/system/System.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PIXEL_CONVERT_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define PIXEL_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace emugl {
+
+namespace {
+
+// Pixels are read and written as little endian uint32_t, so red is the low
+// byte and alpha the high one.
+constexpr uint32_t kOpaqueAlpha = 0xff000000u;
+
+// The kernels of one instruction set. Most of them handle one row; the
+// frame loops around them are shared.
+struct Kernels {
+    PixelSimd simd;
+    void (*swapRow)(const uint8_t* src, uint8_t* dst, uint32_t width,
+                    uint32_t alpha);
+    // Writes the pixels of |src| to |dst| in reverse order.
+    void (*reverseRow)(const uint8_t* src, uint8_t* dst, uint32_t width,
+                       uint32_t alpha);
+    void (*rotate90)(const uint8_t* src, ptrdiff_t srcStride,
+                     uint32_t width, uint32_t height,
+                     uint8_t* dst, ptrdiff_t dstStride, uint32_t alpha);
+    void (*rotate270)(const uint8_t* src, ptrdiff_t srcStride,
+                      uint32_t width, uint32_t height,
+                      uint8_t* dst, ptrdiff_t dstStride, uint32_t alpha);
+    void (*rgb565Row)(const uint8_t* src, uint8_t* dst, uint32_t width);
+    // Converts two rows to luma, and both together to one row of chroma.
+    // |y1| is null when the image ends with |src0|; |src1| is |src0| then.
+    void (*nv12Rows)(const uint8_t* src0, const uint8_t* src1, uint32_t width,
+                     uint8_t* y0, uint8_t* y1, uint8_t* uv);
+};
+
+inline uint32_t loadPixel(const uint8_t* p) {
+    uint32_t pixel;
+    memcpy(&pixel, p, sizeof(pixel));
+    return pixel;
+}
+
+inline void storePixel(uint8_t* p, uint32_t pixel) {
+    memcpy(p, &pixel, sizeof(pixel));
+}
+
+// BT.601 limited range; the rounding and the offsets of 16 and 128 are
+// folded into one constant each.
+inline uint8_t lumaOf(uint32_t r, uint32_t g, uint32_t b) {
+    return (66 * r + 129 * g + 25 * b + 4224) >> 8;
+}
+
+inline uint8_t chromaUOf(int32_t r, int32_t g, int32_t b) {
+    return (-38 * r - 74 * g + 112 * b + 32896) >> 8;
+}
+
+inline uint8_t chromaVOf(int32_t r, int32_t g, int32_t b) {
+    return (112 * r - 94 * g - 18 * b + 32896) >> 8;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Plain C++
+
+void swapRowC(const uint8_t* src, uint8_t* dst, uint32_t width,
+              uint32_t alpha) {
+    for (uint32_t x = 0; x < width; ++x) {
+        const uint32_t p = loadPixel(src + 4 * x);
+        storePixel(dst + 4 * x, (p & 0xff00ff00u) | ((p >> 16) & 0xffu) |
+                                        ((p & 0xffu) << 16) | alpha);
+    }
+}
+
+void reverseRowC(const uint8_t* src, uint8_t* dst, uint32_t width,
+                 uint32_t alpha) {
+    for (uint32_t x = 0; x < width; ++x) {
+        storePixel(dst + 4 * x, loadPixel(src + 4 * (width - 1 - x)) | alpha);
+    }
+}
+
+// Rotates the part of the image that ends up in rows [r0, r1) and columns
+// [c0, c1) of |dst|.
+void rotate90Rect(const uint8_t* src, ptrdiff_t srcStride, uint32_t height,
+                  uint8_t* dst, ptrdiff_t dstStride, uint32_t alpha,
+                  uint32_t r0, uint32_t r1, uint32_t c0, uint32_t c1) {
+    for (uint32_t r = r0; r < r1; ++r) {
+        uint8_t* row = dst + r * dstStride;
+        for (uint32_t c = c0; c < c1; ++c) {
+            storePixel(row + 4 * c,
+                       loadPixel(src + (height - 1 - c) * srcStride + 4 * r) |
+                               alpha);
+        }
+    }
+}
+
+void rotate270Rect(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+                   uint8_t* dst, ptrdiff_t dstStride, uint32_t alpha,
+                   uint32_t r0, uint32_t r1, uint32_t c0, uint32_t c1) {
+    for (uint32_t r = r0; r < r1; ++r) {
+        uint8_t* row = dst + r * dstStride;
+        for (uint32_t c = c0; c < c1; ++c) {
+            storePixel(row + 4 * c,
+                       loadPixel(src + c * srcStride + 4 * (width - 1 - r)) |
+                               alpha);
+        }
+    }
+}
+
+void rotate90C(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+               uint32_t height, uint8_t* dst, ptrdiff_t dstStride,
+               uint32_t alpha) {
+    rotate90Rect(src, srcStride, height, dst, dstStride, alpha,
+                 0, width, 0, height);
+}
+
+void rotate270C(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+                uint32_t height, uint8_t* dst, ptrdiff_t dstStride,
+                uint32_t alpha) {
+    rotate270Rect(src, srcStride, width, dst, dstStride, alpha,
+                  0, width, 0, height);
+}
+
+void rgb565RowC(const uint8_t* src, uint8_t* dst, uint32_t width) {
+    for (uint32_t x = 0; x < width; ++x) {
+        const uint8_t* p = src + 4 * x;
+        const uint16_t packed =
+                ((p[0] & 0xf8) << 8) | ((p[1] & 0xfc) << 3) | (p[2] >> 3);
+        memcpy(dst + 2 * x, &packed, sizeof(packed));
+    }
+}
+
+void lumaRowC(const uint8_t* src, uint8_t* y, uint32_t begin,
+              uint32_t width) {
+    for (uint32_t x = begin; x < width; ++x) {
+        const uint8_t* p = src + 4 * x;
+        y[x] = lumaOf(p[0], p[1], p[2]);
+    }
+}
+
+// Writes the chroma of the 2x2 blocks from |beginPair| on.
+void chromaRowC(const uint8_t* src0, const uint8_t* src1, uint8_t* uv,
+                uint32_t beginPair, uint32_t width) {
+    for (uint32_t x = 2 * beginPair; x < width; x += 2) {
+        const uint32_t right = std::min(x + 1, width - 1);
+        int32_t sum[3];
+        for (int i = 0; i < 3; ++i) {
+            sum[i] = (src0[4 * x + i] + src0[4 * right + i] +
+                      src1[4 * x + i] + src1[4 * right + i] + 2) >> 2;
+        }
+        uv[x] = chromaUOf(sum[0], sum[1], sum[2]);
+        uv[x + 1] = chromaVOf(sum[0], sum[1], sum[2]);
+    }
+}
+
+void nv12RowsC(const uint8_t* src0, const uint8_t* src1, uint32_t width,
+               uint8_t* y0, uint8_t* y1, uint8_t* uv) {
+    lumaRowC(src0, y0, 0, width);
+    if (y1) {
+        lumaRowC(src1, y1, 0, width);
+    }
+    chromaRowC(src0, src1, uv, 0, width);
+}
+
+constexpr Kernels kKernelsC = {
+        PixelSimd::Scalar, swapRowC,   reverseRowC, rotate90C,
+        rotate270C,      rgb565RowC, nv12RowsC,
+};
+
+////////////////////////////////////////////////////////////////////////////
+// SSSE3 and AVX2
+
+#ifdef PIXEL_CONVERT_X86
+
+#define PIXEL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define PIXEL_TARGET_AVX2 __attribute__((target("avx2")))
+
+PIXEL_TARGET_SSSE3
+void swapRowSsse3(const uint8_t* src, uint8_t* dst, uint32_t width,
+                  uint32_t alpha) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7,
+                                          10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i alphaMask = _mm_set1_epi32(alpha);
+    uint32_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const __m128i p = _mm_loadu_si128((const __m128i*)(src + 4 * x));
+        _mm_storeu_si128((__m128i*)(dst + 4 * x),
+                         _mm_or_si128(_mm_shuffle_epi8(p, shuffle), alphaMask));
+    }
+    swapRowC(src + 4 * x, dst + 4 * x, width - x, alpha);
+}
+
+PIXEL_TARGET_SSSE3
+void reverseRowSsse3(const uint8_t* src, uint8_t* dst, uint32_t width,
+                     uint32_t alpha) {
+    const __m128i alphaMask = _mm_set1_epi32(alpha);
+    uint32_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const __m128i p = _mm_loadu_si128(
+                (const __m128i*)(src + 4 * (width - 4 - x)));
+        _mm_storeu_si128(
+                (__m128i*)(dst + 4 * x),
+                _mm_or_si128(_mm_shuffle_epi32(p, _MM_SHUFFLE(0, 1, 2, 3)),
+                             alphaMask));
+    }
+    // What is left of |dst| is the reverse of the start of |src|.
+    reverseRowC(src, dst + 4 * x, width - x, alpha);
+}
+
+PIXEL_TARGET_SSSE3
+inline void transpose4x4(__m128i* r0, __m128i* r1, __m128i* r2, __m128i* r3) {
+    const __m128i t0 = _mm_unpacklo_epi32(*r0, *r1);
+    const __m128i t1 = _mm_unpacklo_epi32(*r2, *r3);
+    const __m128i t2 = _mm_unpackhi_epi32(*r0, *r1);
+    const __m128i t3 = _mm_unpackhi_epi32(*r2, *r3);
+    *r0 = _mm_unpacklo_epi64(t0, t1);
+    *r1 = _mm_unpackhi_epi64(t0, t1);
+    *r2 = _mm_unpacklo_epi64(t2, t3);
+    *r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Both rotations move 4x4 blocks, transposed on the way, and leave the
+// partial blocks at the edges to the plain version.
+PIXEL_TARGET_SSSE3
+void rotate90Ssse3(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+                   uint32_t height, uint8_t* dst, ptrdiff_t dstStride,
+                   uint32_t alpha) {
+    const __m128i alphaMask = _mm_set1_epi32(alpha);
+    const uint32_t blockRows = width & ~3u;
+    const uint32_t blockCols = height & ~3u;
+    for (uint32_t r = 0; r < blockRows; r += 4) {
+        for (uint32_t c = 0; c < blockCols; c += 4) {
+            const uint8_t* in = src + (height - 1 - c) * srcStride + 4 * r;
+            __m128i a0 = _mm_loadu_si128((const __m128i*)in);
+            __m128i a1 = _mm_loadu_si128((const __m128i*)(in - srcStride));
+            __m128i a2 = _mm_loadu_si128((const __m128i*)(in - 2 * srcStride));
+            __m128i a3 = _mm_loadu_si128((const __m128i*)(in - 3 * srcStride));
+            transpose4x4(&a0, &a1, &a2, &a3);
+            uint8_t* out = dst + r * dstStride + 4 * c;
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(a0, alphaMask));
+            _mm_storeu_si128((__m128i*)(out + dstStride),
+                             _mm_or_si128(a1, alphaMask));
+            _mm_storeu_si128((__m128i*)(out + 2 * dstStride),
+                             _mm_or_si128(a2, alphaMask));
+            _mm_storeu_si128((__m128i*)(out + 3 * dstStride),
+                             _mm_or_si128(a3, alphaMask));
+        }
+    }
+    rotate90Rect(src, srcStride, height, dst, dstStride, alpha,
+                 0, blockRows, blockCols, height);
+    rotate90Rect(src, srcStride, height, dst, dstStride, alpha,
+                 blockRows, width, 0, height);
+}
+
+PIXEL_TARGET_SSSE3
+void rotate270Ssse3(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+                    uint32_t height, uint8_t* dst, ptrdiff_t dstStride,
+                    uint32_t alpha) {
+    const __m128i alphaMask = _mm_set1_epi32(alpha);
+    const uint32_t blockRows = width & ~3u;
+    const uint32_t blockCols = height & ~3u;
+    for (uint32_t r = 0; r < blockRows; r += 4) {
+        for (uint32_t c = 0; c < blockCols; c += 4) {
+            const uint8_t* in = src + c * srcStride + 4 * (width - 4 - r);
+            __m128i a0 = _mm_loadu_si128((const __m128i*)in);
+            __m128i a1 = _mm_loadu_si128((const __m128i*)(in + srcStride));
+            __m128i a2 = _mm_loadu_si128((const __m128i*)(in + 2 * srcStride));
+            __m128i a3 = _mm_loadu_si128((const __m128i*)(in + 3 * srcStride));
+            transpose4x4(&a0, &a1, &a2, &a3);
+            // The last column of the block is the first row of |dst|.
+            uint8_t* out = dst + r * dstStride + 4 * c;
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(a3, alphaMask));
+            _mm_storeu_si128((__m128i*)(out + dstStride),
+                             _mm_or_si128(a2, alphaMask));
+            _mm_storeu_si128((__m128i*)(out + 2 * dstStride),
+                             _mm_or_si128(a1, alphaMask));
+            _mm_storeu_si128((__m128i*)(out + 3 * dstStride),
+                             _mm_or_si128(a0, alphaMask));
+        }
+    }
+    rotate270Rect(src, srcStride, width, dst, dstStride, alpha,
+                  0, blockRows, blockCols, height);
+    rotate270Rect(src, srcStride, width, dst, dstStride, alpha,
+                  blockRows, width, 0, height);
+}
+
+// The 565 value of each pixel, in the low half of its 32-bit lane.
+PIXEL_TARGET_SSSE3
+inline __m128i rgb565Of(__m128i p) {
+    const __m128i r = _mm_and_si128(_mm_slli_epi32(p, 8),
+                                    _mm_set1_epi32(0xf800));
+    const __m128i g = _mm_and_si128(_mm_srli_epi32(p, 5),
+                                    _mm_set1_epi32(0x07e0));
+    const __m128i b = _mm_and_si128(_mm_srli_epi32(p, 19),
+                                    _mm_set1_epi32(0x001f));
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+PIXEL_TARGET_SSSE3
+void rgb565RowSsse3(const uint8_t* src, uint8_t* dst, uint32_t width) {
+    const __m128i pack = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13,
+                                       -1, -1, -1, -1, -1, -1, -1, -1);
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i lo = rgb565Of(
+                _mm_loadu_si128((const __m128i*)(src + 4 * x)));
+        const __m128i hi = rgb565Of(
+                _mm_loadu_si128((const __m128i*)(src + 4 * x + 16)));
+        _mm_storeu_si128((__m128i*)(dst + 2 * x),
+                         _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, pack),
+                                            _mm_shuffle_epi8(hi, pack)));
+    }
+    rgb565RowC(src + 4 * x, dst + 2 * x, width - x);
+}
+
+// Dots each of the 4 pixels of |p| with |coef|, which holds the red, green,
+// blue and alpha weights twice.
+PIXEL_TARGET_SSSE3
+inline __m128i dot4(__m128i p, __m128i coef) {
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_hadd_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(p, zero), coef),
+                          _mm_madd_epi16(_mm_unpackhi_epi8(p, zero), coef));
+}
+
+PIXEL_TARGET_SSSE3
+void lumaRowSsse3(const uint8_t* src, uint8_t* y, uint32_t width) {
+    const __m128i coef = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+    const __m128i bias = _mm_set1_epi32(4224);
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i l[4];
+        for (int i = 0; i < 4; ++i) {
+            const __m128i p = _mm_loadu_si128(
+                    (const __m128i*)(src + 4 * x + 16 * i));
+            l[i] = _mm_srli_epi32(_mm_add_epi32(dot4(p, coef), bias), 8);
+        }
+        _mm_storeu_si128((__m128i*)(y + x),
+                         _mm_packus_epi16(_mm_packs_epi32(l[0], l[1]),
+                                          _mm_packs_epi32(l[2], l[3])));
+    }
+    lumaRowC(src, y, x, width);
+}
+
+// Averages the 2x2 blocks of 4 pixels from two rows, as 16-bit lanes.
+PIXEL_TARGET_SSSE3
+inline __m128i average2x2(__m128i a, __m128i b) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero),
+                                     _mm_unpacklo_epi8(b, zero));
+    const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero),
+                                     _mm_unpackhi_epi8(b, zero));
+    const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi),
+                                      _mm_unpackhi_epi64(lo, hi));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+
+PIXEL_TARGET_SSSE3
+void nv12RowsSsse3(const uint8_t* src0, const uint8_t* src1, uint32_t width,
+                   uint8_t* y0, uint8_t* y1, uint8_t* uv) {
+    lumaRowSsse3(src0, y0, width);
+    if (y1) {
+        lumaRowSsse3(src1, y1, width);
+    }
+
+    const __m128i uCoef = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+    const __m128i vCoef = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+    const __m128i bias = _mm_set1_epi32(32896);
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i left = average2x2(
+                _mm_loadu_si128((const __m128i*)(src0 + 4 * x)),
+                _mm_loadu_si128((const __m128i*)(src1 + 4 * x)));
+        const __m128i right = average2x2(
+                _mm_loadu_si128((const __m128i*)(src0 + 4 * x + 16)),
+                _mm_loadu_si128((const __m128i*)(src1 + 4 * x + 16)));
+        const __m128i u = _mm_srli_epi32(
+                _mm_add_epi32(_mm_hadd_epi32(_mm_madd_epi16(left, uCoef),
+                                             _mm_madd_epi16(right, uCoef)),
+                              bias),
+                8);
+        const __m128i v = _mm_srli_epi32(
+                _mm_add_epi32(_mm_hadd_epi32(_mm_madd_epi16(left, vCoef),
+                                             _mm_madd_epi16(right, vCoef)),
+                              bias),
+                8);
+        const __m128i interleaved =
+                _mm_packs_epi32(_mm_unpacklo_epi32(u, v),
+                                _mm_unpackhi_epi32(u, v));
+        _mm_storel_epi64((__m128i*)(uv + x),
+                         _mm_packus_epi16(interleaved, zero));
+    }
+    chromaRowC(src0, src1, uv, x / 2, width);
+}
+
+constexpr Kernels kKernelsSsse3 = {
+        PixelSimd::Ssse3, swapRowSsse3,   reverseRowSsse3, rotate90Ssse3,
+        rotate270Ssse3,   rgb565RowSsse3, nv12RowsSsse3,
+};
+
+PIXEL_TARGET_AVX2
+void swapRowAvx2(const uint8_t* src, uint8_t* dst, uint32_t width,
+                 uint32_t alpha) {
+    const __m256i shuffle = _mm256_setr_epi8(
+            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i alphaMask = _mm256_set1_epi32(alpha);
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256i p = _mm256_loadu_si256((const __m256i*)(src + 4 * x));
+        _mm256_storeu_si256(
+                (__m256i*)(dst + 4 * x),
+                _mm256_or_si256(_mm256_shuffle_epi8(p, shuffle), alphaMask));
+    }
+    swapRowSsse3(src + 4 * x, dst + 4 * x, width - x, alpha);
+}
+
+PIXEL_TARGET_AVX2
+void reverseRowAvx2(const uint8_t* src, uint8_t* dst, uint32_t width,
+                    uint32_t alpha) {
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i alphaMask = _mm256_set1_epi32(alpha);
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256i p = _mm256_loadu_si256(
+                (const __m256i*)(src + 4 * (width - 8 - x)));
+        _mm256_storeu_si256(
+                (__m256i*)(dst + 4 * x),
+                _mm256_or_si256(_mm256_permutevar8x32_epi32(p, reverse),
+                                alphaMask));
+    }
+    reverseRowSsse3(src, dst + 4 * x, width - x, alpha);
+}
+
+PIXEL_TARGET_AVX2
+inline __m256i rgb565Of(__m256i p) {
+    const __m256i r = _mm256_and_si256(_mm256_slli_epi32(p, 8),
+                                       _mm256_set1_epi32(0xf800));
+    const __m256i g = _mm256_and_si256(_mm256_srli_epi32(p, 5),
+                                       _mm256_set1_epi32(0x07e0));
+    const __m256i b = _mm256_and_si256(_mm256_srli_epi32(p, 19),
+                                       _mm256_set1_epi32(0x001f));
+    return _mm256_or_si256(_mm256_or_si256(r, g), b);
+}
+
+PIXEL_TARGET_AVX2
+void rgb565RowAvx2(const uint8_t* src, uint8_t* dst, uint32_t width) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m256i lo = rgb565Of(
+                _mm256_loadu_si256((const __m256i*)(src + 4 * x)));
+        const __m256i hi = rgb565Of(
+                _mm256_loadu_si256((const __m256i*)(src + 4 * x + 32)));
+        // Packing works on 128-bit lanes; put them back in order.
+        _mm256_storeu_si256(
+                (__m256i*)(dst + 2 * x),
+                _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi),
+                                         _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    rgb565RowSsse3(src + 4 * x, dst + 2 * x, width - x);
+}
+
+// The rotations and NV12 are bound by their loads and stores rather than
+// by arithmetic, and gain nothing from the wider registers.
+constexpr Kernels kKernelsAvx2 = {
+        PixelSimd::Avx2, swapRowAvx2,   reverseRowAvx2, rotate90Ssse3,
+        rotate270Ssse3,  rgb565RowAvx2, nv12RowsSsse3,
+};
+
+#endif  // PIXEL_CONVERT_X86
+
+////////////////////////////////////////////////////////////////////////////
+// NEON
+
+#ifdef PIXEL_CONVERT_NEON
+
+void swapRowNeon(const uint8_t* src, uint8_t* dst, uint32_t width,
+                 uint32_t alpha) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t p = vld4q_u8(src + 4 * x);
+        const uint8x16_t r = p.val[0];
+        p.val[0] = p.val[2];
+        p.val[2] = r;
+        if (alpha) {
+            p.val[3] = vdupq_n_u8(0xff);
+        }
+        vst4q_u8(dst + 4 * x, p);
+    }
+    swapRowC(src + 4 * x, dst + 4 * x, width - x, alpha);
+}
+
+inline uint32x4_t reverse4(uint32x4_t p) {
+    p = vrev64q_u32(p);
+    return vcombine_u32(vget_high_u32(p), vget_low_u32(p));
+}
+
+void reverseRowNeon(const uint8_t* src, uint8_t* dst, uint32_t width,
+                    uint32_t alpha) {
+    const uint32x4_t alphaMask = vdupq_n_u32(alpha);
+    uint32_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const uint32x4_t p = vld1q_u32(
+                (const uint32_t*)(src + 4 * (width - 4 - x)));
+        vst1q_u32((uint32_t*)(dst + 4 * x), vorrq_u32(reverse4(p), alphaMask));
+    }
+    reverseRowC(src, dst + 4 * x, width - x, alpha);
+}
+
+inline void transpose4x4(uint32x4_t* r0, uint32x4_t* r1, uint32x4_t* r2,
+                         uint32x4_t* r3) {
+    const uint32x4x2_t t01 = vtrnq_u32(*r0, *r1);
+    const uint32x4x2_t t23 = vtrnq_u32(*r2, *r3);
+    *r0 = vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]));
+    *r1 = vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]));
+    *r2 = vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]));
+    *r3 = vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]));
+}
+
+inline uint32x4_t loadRow4(const uint8_t* p) {
+    return vld1q_u32((const uint32_t*)p);
+}
+
+inline void storeRow4(uint8_t* p, uint32x4_t v, uint32x4_t alphaMask) {
+    vst1q_u32((uint32_t*)p, vorrq_u32(v, alphaMask));
+}
+
+void rotate90Neon(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+                  uint32_t height, uint8_t* dst, ptrdiff_t dstStride,
+                  uint32_t alpha) {
+    const uint32x4_t alphaMask = vdupq_n_u32(alpha);
+    const uint32_t blockRows = width & ~3u;
+    const uint32_t blockCols = height & ~3u;
+    for (uint32_t r = 0; r < blockRows; r += 4) {
+        for (uint32_t c = 0; c < blockCols; c += 4) {
+            const uint8_t* in = src + (height - 1 - c) * srcStride + 4 * r;
+            uint32x4_t a0 = loadRow4(in);
+            uint32x4_t a1 = loadRow4(in - srcStride);
+            uint32x4_t a2 = loadRow4(in - 2 * srcStride);
+            uint32x4_t a3 = loadRow4(in - 3 * srcStride);
+            transpose4x4(&a0, &a1, &a2, &a3);
+            uint8_t* out = dst + r * dstStride + 4 * c;
+            storeRow4(out, a0, alphaMask);
+            storeRow4(out + dstStride, a1, alphaMask);
+            storeRow4(out + 2 * dstStride, a2, alphaMask);
+            storeRow4(out + 3 * dstStride, a3, alphaMask);
+        }
+    }
+    rotate90Rect(src, srcStride, height, dst, dstStride, alpha,
+                 0, blockRows, blockCols, height);
+    rotate90Rect(src, srcStride, height, dst, dstStride, alpha,
+                 blockRows, width, 0, height);
+}
+
+void rotate270Neon(const uint8_t* src, ptrdiff_t srcStride, uint32_t width,
+                   uint32_t height, uint8_t* dst, ptrdiff_t dstStride,
+                   uint32_t alpha) {
+    const uint32x4_t alphaMask = vdupq_n_u32(alpha);
+    const uint32_t blockRows = width & ~3u;
+    const uint32_t blockCols = height & ~3u;
+    for (uint32_t r = 0; r < blockRows; r += 4) {
+        for (uint32_t c = 0; c < blockCols; c += 4) {
+            const uint8_t* in = src + c * srcStride + 4 * (width - 4 - r);
+            uint32x4_t a0 = loadRow4(in);
+            uint32x4_t a1 = loadRow4(in + srcStride);
+            uint32x4_t a2 = loadRow4(in + 2 * srcStride);
+            uint32x4_t a3 = loadRow4(in + 3 * srcStride);
+            transpose4x4(&a0, &a1, &a2, &a3);
+            uint8_t* out = dst + r * dstStride + 4 * c;
+            storeRow4(out, a3, alphaMask);
+            storeRow4(out + dstStride, a2, alphaMask);
+            storeRow4(out + 2 * dstStride, a1, alphaMask);
+            storeRow4(out + 3 * dstStride, a0, alphaMask);
+        }
+    }
+    rotate270Rect(src, srcStride, width, dst, dstStride, alpha,
+                  0, blockRows, blockCols, height);
+    rotate270Rect(src, srcStride, width, dst, dstStride, alpha,
+                  blockRows, width, 0, height);
+}
+
+inline uint16x8_t rgb565Of(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    uint16x8_t packed = vshll_n_u8(r, 8);
+    packed = vsriq_n_u16(packed, vshll_n_u8(g, 8), 5);
+    return vsriq_n_u16(packed, vshll_n_u8(b, 8), 11);
+}
+
+void rgb565RowNeon(const uint8_t* src, uint8_t* dst, uint32_t width) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16x4_t p = vld4q_u8(src + 4 * x);
+        vst1q_u16((uint16_t*)(dst + 2 * x),
+                  rgb565Of(vget_low_u8(p.val[0]), vget_low_u8(p.val[1]),
+                           vget_low_u8(p.val[2])));
+        vst1q_u16((uint16_t*)(dst + 2 * x + 16),
+                  rgb565Of(vget_high_u8(p.val[0]), vget_high_u8(p.val[1]),
+                           vget_high_u8(p.val[2])));
+    }
+    rgb565RowC(src + 4 * x, dst + 2 * x, width - x);
+}
+
+inline uint8x8_t lumaOf(uint8x8_t r, uint8x8_t g, uint8x8_t b) {
+    uint16x8_t y = vmull_u8(r, vdup_n_u8(66));
+    y = vmlal_u8(y, g, vdup_n_u8(129));
+    y = vmlal_u8(y, b, vdup_n_u8(25));
+    return vshrn_n_u16(vaddq_u16(y, vdupq_n_u16(4224)), 8);
+}
+
+void lumaRowNeon(const uint8_t* src, uint8_t* y, uint32_t width) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16x4_t p = vld4q_u8(src + 4 * x);
+        vst1q_u8(y + x,
+                 vcombine_u8(lumaOf(vget_low_u8(p.val[0]),
+                                    vget_low_u8(p.val[1]),
+                                    vget_low_u8(p.val[2])),
+                             lumaOf(vget_high_u8(p.val[0]),
+                                    vget_high_u8(p.val[1]),
+                                    vget_high_u8(p.val[2]))));
+    }
+    lumaRowC(src, y, x, width);
+}
+
+void nv12RowsNeon(const uint8_t* src0, const uint8_t* src1, uint32_t width,
+                  uint8_t* y0, uint8_t* y1, uint8_t* uv) {
+    lumaRowNeon(src0, y0, width);
+    if (y1) {
+        lumaRowNeon(src1, y1, width);
+    }
+
+    // Unsigned arithmetic is enough: with the bias added first, neither
+    // chroma value can go below zero on the way.
+    const uint16x8_t bias = vdupq_n_u16(32896);
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16x4_t a = vld4q_u8(src0 + 4 * x);
+        const uint8x16x4_t b = vld4q_u8(src1 + 4 * x);
+        uint16x8_t avg[3];
+        for (int i = 0; i < 3; ++i) {
+            avg[i] = vrshrq_n_u16(
+                    vpadalq_u8(vpaddlq_u8(a.val[i]), b.val[i]), 2);
+        }
+        uint16x8_t u = vmlaq_n_u16(bias, avg[2], 112);
+        u = vmlsq_n_u16(u, avg[0], 38);
+        u = vmlsq_n_u16(u, avg[1], 74);
+        uint16x8_t v = vmlaq_n_u16(bias, avg[0], 112);
+        v = vmlsq_n_u16(v, avg[1], 94);
+        v = vmlsq_n_u16(v, avg[2], 18);
+        uint8x8x2_t interleaved;
+        interleaved.val[0] = vshrn_n_u16(u, 8);
+        interleaved.val[1] = vshrn_n_u16(v, 8);
+        vst2_u8(uv + x, interleaved);
+    }
+    chromaRowC(src0, src1, uv, x / 2, width);
+}
+
+constexpr Kernels kKernelsNeon = {
+        PixelSimd::Neon, swapRowNeon,   reverseRowNeon, rotate90Neon,
+        rotate270Neon,   rgb565RowNeon, nv12RowsNeon,
+};
+
+#endif  // PIXEL_CONVERT_NEON
+
+////////////////////////////////////////////////////////////////////////////
+// Dispatch
+
+const Kernels* kernelsFor(PixelSimd simd) {
+    switch (simd) {
+        case PixelSimd::Scalar:
+            return &kKernelsC;
+#ifdef PIXEL_CONVERT_X86
+        case PixelSimd::Ssse3:
+            return __builtin_cpu_supports("ssse3") ? &kKernelsSsse3 : nullptr;
+        case PixelSimd::Avx2:
+            return __builtin_cpu_supports("avx2") ? &kKernelsAvx2 : nullptr;
+#endif
+#ifdef PIXEL_CONVERT_NEON
+        // NEON is part of every ARMv8 CPU.
+        case PixelSimd::Neon:
+            return &kKernelsNeon;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const Kernels* bestKernels() {
+    if (!android::base::System::getEnvironmentVariable(
+                 "ANDROID_EMUGL_DISABLE_PIXEL_SIMD")
+                 .empty()) {
+        return &kKernelsC;
+    }
+    for (PixelSimd simd : {PixelSimd::Avx2, PixelSimd::Ssse3, PixelSimd::Neon}) {
+        if (const Kernels* kernels = kernelsFor(simd)) {
+            return kernels;
+        }
+    }
+    return &kKernelsC;
+}
+
+std::atomic<const Kernels*> sKernels{nullptr};
+
+const Kernels& kernels() {
+    const Kernels* current = sKernels.load(std::memory_order_acquire);
+    if (!current) {
+        current = bestKernels();
+        sKernels.store(current, std::memory_order_release);
+    }
+    return *current;
+}
+
+}  // namespace
+
+PixelSimd getPixelSimd() {
+    return kernels().simd;
+}
+
+bool setPixelSimd(PixelSimd simd) {
+    const Kernels* wanted = kernelsFor(simd);
+    if (!wanted) {
+        return false;
+    }
+    sKernels.store(wanted, std::memory_order_release);
+    return true;
+}
+
+const char* getPixelSimdName(PixelSimd simd) {
+    switch (simd) {
+        case PixelSimd::Scalar:
+            return "scalar";
+        case PixelSimd::Ssse3:
+            return "ssse3";
+        case PixelSimd::Avx2:
+            return "avx2";
+        case PixelSimd::Neon:
+            return "neon";
+    }
+    return "unknown";
+}
+
+void swapRedBlue(const void* src, ptrdiff_t srcStride,
+                 void* dst, ptrdiff_t dstStride,
+                 uint32_t width, uint32_t height,
+                 bool opaque) {
+    const Kernels& k = kernels();
+    const uint32_t alpha = opaque ? kOpaqueAlpha : 0;
+    for (uint32_t y = 0; y < height; ++y) {
+        k.swapRow(static_cast<const uint8_t*>(src) + y * srcStride,
+                  static_cast<uint8_t*>(dst) + y * dstStride, width, alpha);
+    }
+}
+
+void flipVertical(const void* src, ptrdiff_t srcStride,
+                  void* dst, ptrdiff_t dstStride,
+                  uint32_t rowBytes, uint32_t height) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    if (in != out) {
+        // memcpy is as fast as copying gets already.
+        for (uint32_t y = 0; y < height; ++y) {
+            memcpy(out + y * dstStride, in + (height - 1 - y) * srcStride,
+                   rowBytes);
+        }
+        return;
+    }
+
+    // In place: swap the rows pairwise, a chunk at a time.
+    uint8_t chunk[4096];
+    for (uint32_t y = 0; y < height / 2; ++y) {
+        uint8_t* top = out + y * dstStride;
+        uint8_t* bottom = out + (height - 1 - y) * dstStride;
+        for (uint32_t x = 0; x < rowBytes; x += sizeof(chunk)) {
+            const size_t bytes = std::min<size_t>(sizeof(chunk), rowBytes - x);
+            memcpy(chunk, top + x, bytes);
+            memcpy(top + x, bottom + x, bytes);
+            memcpy(bottom + x, chunk, bytes);
+        }
+    }
+}
+
+void rotatePixels(const void* src, ptrdiff_t srcStride,
+                  uint32_t width, uint32_t height,
+                  void* dst, ptrdiff_t dstStride,
+                  SkinRotation rotation, bool opaque) {
+    const Kernels& k = kernels();
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    const uint32_t alpha = opaque ? kOpaqueAlpha : 0;
+    switch (rotation) {
+        case SKIN_ROTATION_0:
+            for (uint32_t y = 0; y < height; ++y) {
+                const uint8_t* inRow = in + y * srcStride;
+                uint8_t* outRow = out + y * dstStride;
+                if (!alpha) {
+                    if (inRow != outRow) {
+                        memcpy(outRow, inRow, 4 * width);
+                    }
+                    continue;
+                }
+                // Simple enough for the compiler to vectorize.
+                for (uint32_t x = 0; x < width; ++x) {
+                    storePixel(outRow + 4 * x, loadPixel(inRow + 4 * x) | alpha);
+                }
+            }
+            break;
+        case SKIN_ROTATION_90:
+            k.rotate90(in, srcStride, width, height, out, dstStride, alpha);
+            break;
+        case SKIN_ROTATION_180:
+            for (uint32_t y = 0; y < height; ++y) {
+                k.reverseRow(in + (height - 1 - y) * srcStride,
+                             out + y * dstStride, width, alpha);
+            }
+            break;
+        case SKIN_ROTATION_270:
+            k.rotate270(in, srcStride, width, height, out, dstStride, alpha);
+            break;
+    }
+}
+
+void rgbaToRgb565(const void* src, ptrdiff_t srcStride,
+                  void* dst, ptrdiff_t dstStride,
+                  uint32_t width, uint32_t height) {
+    const Kernels& k = kernels();
+    for (uint32_t y = 0; y < height; ++y) {
+        k.rgb565Row(static_cast<const uint8_t*>(src) + y * srcStride,
+                    static_cast<uint8_t*>(dst) + y * dstStride, width);
+    }
+}
+
+void rgbaToNv12(const void* src, ptrdiff_t srcStride,
+                uint32_t width, uint32_t height,
+                uint8_t* y, ptrdiff_t yStride,
+                uint8_t* uv, ptrdiff_t uvStride) {
+    const Kernels& k = kernels();
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    for (uint32_t row = 0; row < height; row += 2) {
+        const bool last = row + 1 == height;
+        const uint8_t* row0 = in + row * srcStride;
+        k.nv12Rows(row0, last ? row0 : row0 + srcStride, width,
+                   y + row * yStride,
+                   last ? nullptr : y + (row + 1) * yStride,
+                   uv + (row / 2) * uvStride);
+    }
+}
+
+}  // namespace emugl
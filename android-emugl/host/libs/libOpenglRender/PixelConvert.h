@@ -0,0 +1,93 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "android/skin/rect.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CPU kernels for the pixel shuffling that readbacks need after
+// glReadPixels: swapping red and blue, flipping and rotating, and packing
+// into the formats video encoders take.
+//
+// Images are passed as a pointer to their first row and a stride in bytes
+// between rows. The stride may be negative, e.g. to walk a bottom-up
+// glReadPixels result from its top row, so a vertical flip can be folded
+// into any of the conversions for free. Unless noted otherwise, |src| and
+// |dst| must not overlap.
+//
+// Each kernel has a plain C++ version and vectorized ones; the best one the
+// CPU supports is picked the first time a kernel runs.
+namespace emugl {
+
+// Instruction sets the kernels can be built for.
+enum class PixelSimd {
+    Scalar,
+    Ssse3,
+    Avx2,
+    Neon,
+};
+
+// The instruction set the kernels use: the best one the CPU has, or Scalar if
+// ANDROID_EMUGL_DISABLE_PIXEL_SIMD is set.
+PixelSimd getPixelSimd();
+
+// Makes the kernels use |simd|, for benchmarks. Returns false if the CPU
+// or the build doesn't support it.
+bool setPixelSimd(PixelSimd simd);
+
+const char* getPixelSimdName(PixelSimd simd);
+
+// Swaps the first and third byte of each 32-bit pixel, converting RGBA to
+// BGRA and back. With |opaque|, alpha is set to 0xff as well. |src| and
+// |dst| may be the same image.
+void swapRedBlue(const void* src, ptrdiff_t srcStride,
+                 void* dst, ptrdiff_t dstStride,
+                 uint32_t width, uint32_t height,
+                 bool opaque = false);
+
+// Copies |height| rows of |rowBytes| bytes, last row first. |src| and |dst|
+// may be the same image, which is then flipped in place.
+void flipVertical(const void* src, ptrdiff_t srcStride,
+                  void* dst, ptrdiff_t dstStride,
+                  uint32_t rowBytes, uint32_t height);
+
+// Rotates an image of 32-bit pixels clockwise, as seen with its first row
+// at the top. |width| and |height| are those of |src|; they are swapped in
+// |dst| for SKIN_ROTATION_90 and SKIN_ROTATION_270. With |opaque|, alpha is
+// set to 0xff. |src| and |dst| may be the same image for SKIN_ROTATION_0
+// only.
+void rotatePixels(const void* src, ptrdiff_t srcStride,
+                  uint32_t width, uint32_t height,
+                  void* dst, ptrdiff_t dstStride,
+                  SkinRotation rotation, bool opaque = false);
+
+// Packs RGBA8 pixels into RGB565, dropping the low bits of each channel.
+void rgbaToRgb565(const void* src, ptrdiff_t srcStride,
+                  void* dst, ptrdiff_t dstStride,
+                  uint32_t width, uint32_t height);
+
+// Converts RGBA8 pixels to NV12 with BT.601 limited range coefficients: a
+// full size Y plane followed by a half size plane of interleaved U and V,
+// each sample averaging a 2x2 block. Odd widths and heights repeat the last
+// column and row.
+void rgbaToNv12(const void* src, ptrdiff_t srcStride,
+                uint32_t width, uint32_t height,
+                uint8_t* y, ptrdiff_t yStride,
+                uint8_t* uv, ptrdiff_t uvStride);
+
+}  // namespace emugl
@@ -0,0 +1,150 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// Measures the readback pixel kernels on a 1080p frame, once per
+// instruction set the CPU supports; "scalar" is the plain C++ version. Frames
+// are walked bottom-up, the way glReadPixels results are.
+
+#include "PixelConvert.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kWidth = 1920;
+constexpr uint32_t kHeight = 1080;
+constexpr ptrdiff_t kStride = 4 * kWidth;
+
+const std::vector<uint8_t>& frame() {
+    static const std::vector<uint8_t> pixels = [] {
+        std::vector<uint8_t> p(kStride * kHeight);
+        for (size_t i = 0; i < p.size(); ++i) {
+            p[i] = static_cast<uint8_t>(i * 7 + (i >> 12));
+        }
+        return p;
+    }();
+    return pixels;
+}
+
+const uint8_t* lastRow() {
+    return frame().data() + (kHeight - 1) * kStride;
+}
+
+// Switches to the instruction set of the benchmark's argument.
+bool useSimd(benchmark::State& state) {
+    const auto simd = static_cast<emugl::PixelSimd>(state.range(0));
+    if (!emugl::setPixelSimd(simd)) {
+        state.SkipWithError("not supported by this CPU");
+        return false;
+    }
+    state.SetLabel(emugl::getPixelSimdName(simd));
+    return true;
+}
+
+void BM_SwapRedBlue(benchmark::State& state) {
+    if (!useSimd(state)) {
+        return;
+    }
+    std::vector<uint8_t> out(kStride * kHeight);
+    for (auto _ : state) {
+        emugl::swapRedBlue(lastRow(), -kStride, out.data(), kStride,
+                           kWidth, kHeight);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * kStride * kHeight);
+}
+
+void BM_FlipVertical(benchmark::State& state) {
+    std::vector<uint8_t> out(kStride * kHeight);
+    for (auto _ : state) {
+        emugl::flipVertical(frame().data(), kStride, out.data(), kStride,
+                            kStride, kHeight);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * kStride * kHeight);
+}
+
+void BM_Rotate(benchmark::State& state) {
+    if (!useSimd(state)) {
+        return;
+    }
+    const auto rotation = static_cast<SkinRotation>(state.range(1));
+    std::vector<uint8_t> out(kStride * kHeight);
+    const ptrdiff_t outStride =
+            (rotation == SKIN_ROTATION_90 || rotation == SKIN_ROTATION_270)
+                    ? 4 * kHeight
+                    : kStride;
+    for (auto _ : state) {
+        emugl::rotatePixels(lastRow(), -kStride, kWidth, kHeight, out.data(),
+                            outStride, rotation, true /* opaque */);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * kStride * kHeight);
+}
+
+void BM_RgbaToRgb565(benchmark::State& state) {
+    if (!useSimd(state)) {
+        return;
+    }
+    std::vector<uint8_t> out(2 * kWidth * kHeight);
+    for (auto _ : state) {
+        emugl::rgbaToRgb565(lastRow(), -kStride, out.data(), 2 * kWidth,
+                            kWidth, kHeight);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * kStride * kHeight);
+}
+
+void BM_RgbaToNv12(benchmark::State& state) {
+    if (!useSimd(state)) {
+        return;
+    }
+    std::vector<uint8_t> y(kWidth * kHeight);
+    std::vector<uint8_t> uv(kWidth * kHeight / 2);
+    for (auto _ : state) {
+        emugl::rgbaToNv12(lastRow(), -kStride, kWidth, kHeight, y.data(),
+                          kWidth, uv.data(), kWidth);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * kStride * kHeight);
+}
+
+void simdLevels(benchmark::internal::Benchmark* b) {
+    for (auto simd : {emugl::PixelSimd::Scalar, emugl::PixelSimd::Ssse3,
+                      emugl::PixelSimd::Avx2, emugl::PixelSimd::Neon}) {
+        b->Arg(static_cast<int>(simd));
+    }
+}
+
+void simdLevelsAndRotations(benchmark::internal::Benchmark* b) {
+    for (auto simd : {emugl::PixelSimd::Scalar, emugl::PixelSimd::Ssse3,
+                      emugl::PixelSimd::Avx2, emugl::PixelSimd::Neon}) {
+        for (int rotation = SKIN_ROTATION_0; rotation <= SKIN_ROTATION_270;
+             ++rotation) {
+            b->Args({static_cast<int>(simd), rotation});
+        }
+    }
+}
+
+BENCHMARK(BM_SwapRedBlue)->Apply(simdLevels);
+BENCHMARK(BM_FlipVertical);
+BENCHMARK(BM_Rotate)->Apply(simdLevelsAndRotations);
+BENCHMARK(BM_RgbaToRgb565)->Apply(simdLevels);
+BENCHMARK(BM_RgbaToNv12)->Apply(simdLevels);
+
+}  // namespace
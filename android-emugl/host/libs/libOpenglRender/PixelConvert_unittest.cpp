@@ -0,0 +1,233 @@
+// Copyright (C) 2024 The Android Open Source Project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Checks that every vectorized readback kernel the CPU supports produces
+// exactly what the plain C++ one does: on widths that leave a tail shorter
+// than a vector, on padded rows, and on images walked bottom-up through a
+// negative stride. The bytes around the images are compared as well, so a
+// kernel that writes past the end of a row is caught.
+
+#include "PixelConvert.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+namespace {
+
+using emugl::PixelSimd;
+
+// Widths around the 4, 8, 16 and 32 pixel steps of the kernels.
+const uint32_t kWidths[] = {1,  2,  3,  5,  7,  8,  9,  15, 16, 17,
+                            31, 32, 33, 47, 63, 64, 65, 100, 127};
+const uint32_t kHeights[] = {1, 2, 3, 4, 7};
+
+const uint8_t kGuard = 0xcd;
+
+// An image in a buffer with a guard band around every row. With |flipped|,
+// the first row is the last one in memory and the stride is negative.
+struct Image {
+    Image(uint32_t rowBytes, uint32_t height, bool flipped)
+        : stride(rowBytes + 13),
+          bytes(stride * height + 2 * kPad, kGuard),
+          flipped(flipped),
+          height(height) {
+        if (flipped) {
+            stride = -stride;
+        }
+    }
+
+    uint8_t* data() {
+        return bytes.data() + kPad + (flipped ? (height - 1) * -stride : 0);
+    }
+
+    void fill(uint32_t seed) {
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<uint8_t>(i * 131 + (i >> 5) + seed);
+        }
+    }
+
+    static const size_t kPad = 64;
+    ptrdiff_t stride;
+    std::vector<uint8_t> bytes;
+    bool flipped;
+    uint32_t height;
+};
+
+// Runs |convert| with the scalar kernels and then with each other instruction
+// set the CPU supports, and expects the same output every time.
+void expectSameAsScalar(const char* what,
+                        const std::function<std::vector<uint8_t>()>& convert) {
+    ASSERT_TRUE(emugl::setPixelSimd(PixelSimd::Scalar));
+    const std::vector<uint8_t> expected = convert();
+    for (PixelSimd simd :
+         {PixelSimd::Ssse3, PixelSimd::Avx2, PixelSimd::Neon}) {
+        if (!emugl::setPixelSimd(simd)) {
+            continue;
+        }
+        EXPECT_EQ(expected, convert())
+                << what << " with " << emugl::getPixelSimdName(simd);
+    }
+    emugl::setPixelSimd(PixelSimd::Scalar);
+}
+
+class PixelConvertTest : public ::testing::Test {
+protected:
+    // Calls |test| for every size, with the source and destination each
+    // walked top-down and bottom-up.
+    void forEachLayout(
+            const std::function<void(uint32_t, uint32_t, bool, bool)>& test) {
+        for (uint32_t width : kWidths) {
+            for (uint32_t height : kHeights) {
+                for (bool srcFlipped : {false, true}) {
+                    for (bool dstFlipped : {false, true}) {
+                        test(width, height, srcFlipped, dstFlipped);
+                    }
+                }
+            }
+        }
+    }
+};
+
+TEST_F(PixelConvertTest, SwapRedBlue) {
+    forEachLayout([](uint32_t width, uint32_t height, bool srcFlipped,
+                     bool dstFlipped) {
+        for (bool opaque : {false, true}) {
+            expectSameAsScalar("swapRedBlue", [&] {
+                Image src(4 * width, height, srcFlipped);
+                Image dst(4 * width, height, dstFlipped);
+                src.fill(width);
+                emugl::swapRedBlue(src.data(), src.stride, dst.data(),
+                                   dst.stride, width, height, opaque);
+                return dst.bytes;
+            });
+        }
+    });
+}
+
+TEST_F(PixelConvertTest, SwapRedBlueInPlace) {
+    forEachLayout([](uint32_t width, uint32_t height, bool flipped, bool) {
+        expectSameAsScalar("swapRedBlue in place", [&] {
+            Image image(4 * width, height, flipped);
+            image.fill(height);
+            emugl::swapRedBlue(image.data(), image.stride, image.data(),
+                               image.stride, width, height, true);
+            return image.bytes;
+        });
+    });
+}
+
+TEST_F(PixelConvertTest, FlipVertical) {
+    forEachLayout([](uint32_t width, uint32_t height, bool srcFlipped,
+                     bool dstFlipped) {
+        Image src(4 * width, height, srcFlipped);
+        Image dst(4 * width, height, dstFlipped);
+        src.fill(width);
+        emugl::flipVertical(src.data(), src.stride, dst.data(), dst.stride,
+                            4 * width, height);
+
+        Image image(4 * width, height, srcFlipped);
+        image.fill(width);
+        emugl::flipVertical(image.data(), image.stride, image.data(),
+                            image.stride, 4 * width, height);
+
+        for (uint32_t y = 0; y < height; ++y) {
+            const uint8_t* expected =
+                    src.data() + (height - 1 - y) * src.stride;
+            ASSERT_EQ(0, memcmp(expected, dst.data() + y * dst.stride,
+                                4 * width));
+            ASSERT_EQ(0, memcmp(expected, image.data() + y * image.stride,
+                                4 * width));
+        }
+    });
+}
+
+TEST_F(PixelConvertTest, RotatePixels) {
+    forEachLayout([](uint32_t width, uint32_t height, bool srcFlipped,
+                     bool dstFlipped) {
+        for (SkinRotation rotation : {SKIN_ROTATION_0, SKIN_ROTATION_90,
+                                      SKIN_ROTATION_180, SKIN_ROTATION_270}) {
+            const bool swapped = rotation == SKIN_ROTATION_90 ||
+                                 rotation == SKIN_ROTATION_270;
+            for (bool opaque : {false, true}) {
+                expectSameAsScalar("rotatePixels", [&] {
+                    Image src(4 * width, height, srcFlipped);
+                    Image dst(4 * (swapped ? height : width),
+                              swapped ? width : height, dstFlipped);
+                    src.fill(rotation);
+                    emugl::rotatePixels(src.data(), src.stride, width, height,
+                                        dst.data(), dst.stride, rotation,
+                                        opaque);
+                    return dst.bytes;
+                });
+            }
+        }
+    });
+}
+
+TEST_F(PixelConvertTest, RotatePixelsClockwise) {
+    // 3x2 pixels: a b c / d e f, one byte per pixel in the red channel.
+    const uint8_t src[] = {'a', 0, 0, 0, 'b', 0, 0, 0, 'c', 0, 0, 0,
+                           'd', 0, 0, 0, 'e', 0, 0, 0, 'f', 0, 0, 0};
+    uint8_t dst[sizeof(src)];
+    auto red = [&dst](int i) { return dst[4 * i]; };
+
+    emugl::rotatePixels(src, 12, 3, 2, dst, 8, SKIN_ROTATION_90);
+    EXPECT_EQ(std::string("daebfc"),
+              std::string({(char)red(0), (char)red(1), (char)red(2),
+                           (char)red(3), (char)red(4), (char)red(5)}));
+
+    emugl::rotatePixels(src, 12, 3, 2, dst, 8, SKIN_ROTATION_270);
+    EXPECT_EQ(std::string("cfbead"),
+              std::string({(char)red(0), (char)red(1), (char)red(2),
+                           (char)red(3), (char)red(4), (char)red(5)}));
+}
+
+TEST_F(PixelConvertTest, RgbaToRgb565) {
+    forEachLayout([](uint32_t width, uint32_t height, bool srcFlipped,
+                     bool dstFlipped) {
+        expectSameAsScalar("rgbaToRgb565", [&] {
+            Image src(4 * width, height, srcFlipped);
+            Image dst(2 * width, height, dstFlipped);
+            src.fill(width + height);
+            emugl::rgbaToRgb565(src.data(), src.stride, dst.data(),
+                                dst.stride, width, height);
+            return dst.bytes;
+        });
+    });
+}
+
+TEST_F(PixelConvertTest, RgbaToNv12) {
+    forEachLayout([](uint32_t width, uint32_t height, bool srcFlipped,
+                     bool dstFlipped) {
+        expectSameAsScalar("rgbaToNv12", [&] {
+            const uint32_t chromaHeight = (height + 1) / 2;
+            Image src(4 * width, height, srcFlipped);
+            Image y(width, height, dstFlipped);
+            Image uv(2 * ((width + 1) / 2), chromaHeight, dstFlipped);
+            src.fill(width * height);
+            emugl::rgbaToNv12(src.data(), src.stride, width, height,
+                              y.data(), y.stride, uv.data(), uv.stride);
+            std::vector<uint8_t> out = y.bytes;
+            out.insert(out.end(), uv.bytes.begin(), uv.bytes.end());
+            return out;
+        });
+    });
+}
+
+}  // namespace
@@ -8,6 +8,12 @@
 #include "OpenGLESDispatch/GLESv2Dispatch.h"
 #include "emugl/common/misc.h"
 
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
 #define POST_DEBUG 0
 #if POST_DEBUG >= 1
 #define DD(fmt, ...) \
@@ -21,6 +27,91 @@ PostWorker::PostWorker(PostWorker::BindSubwinCallback&& cb) :
     mFb(FrameBuffer::getFB()),
     mBindSubwin(cb) {}
 
+static bool isEmpty(const hwc_rect_t& r) {
+    return r.right <= r.left || r.bottom <= r.top;
+}
+
+static void unite(hwc_rect_t* r, const hwc_rect_t& other) {
+    if (isEmpty(other)) {
+        return;
+    }
+    if (isEmpty(*r)) {
+        *r = other;
+        return;
+    }
+    r->left = std::min(r->left, other.left);
+    r->top = std::min(r->top, other.top);
+    r->right = std::max(r->right, other.right);
+    r->bottom = std::max(r->bottom, other.bottom);
+}
+
+bool PostWorker::computeDamage(ColorBuffer* cb, uint64_t serial,
+                               const PresentState& state, int zRot,
+                               bool simpleLayout, hwc_rect_t* damage) {
+    if (!simpleLayout || state.cb != cb->getHndl() ||
+        state.viewportWidth != m_viewportWidth ||
+        state.viewportHeight != m_viewportHeight || state.zRot != zRot ||
+        state.maskSerial != mFb->getTextureDraw()->getScreenMaskSerial() ||
+        !cb->getWidth() || !cb->getHeight()) {
+        return false;
+    }
+
+    hwc_rect_t texDamage;
+    if (!cb->getDamage(state.serial, serial, &texDamage) ||
+        isEmpty(texDamage)) {
+        // Re-posting an unchanged buffer is a repaint request, the window
+        // contents may have been lost.
+        return false;
+    }
+
+    // Account for filtering (and TextureResize downscaling) by growing the
+    // damage one texel and one pixel. Texture row 0 is drawn at the top of
+    // the window, GL window coordinates start at the bottom.
+    const float sx = (float)m_viewportWidth / cb->getWidth();
+    const float sy = (float)m_viewportHeight / cb->getHeight();
+    damage->left = (int)floorf((texDamage.left - 1) * sx) - 1;
+    damage->right = (int)ceilf((texDamage.right + 1) * sx) + 1;
+    damage->top = (int)floorf(m_viewportHeight - (texDamage.bottom + 1) * sy) - 1;
+    damage->bottom = (int)ceilf(m_viewportHeight - (texDamage.top - 1) * sy) + 1;
+
+    damage->left = std::max(damage->left, 0);
+    damage->top = std::max(damage->top, 0);
+    damage->right = std::min(damage->right, m_viewportWidth);
+    damage->bottom = std::min(damage->bottom, m_viewportHeight);
+    return !isEmpty(*damage);
+}
+
+void PostWorker::recordPresent(PresentState* state, ColorBuffer* cb,
+                               uint64_t serial, int zRot,
+                               const hwc_rect_t& damage) {
+    state->cb = cb ? cb->getHndl() : 0;
+    state->serial = serial;
+    state->viewportWidth = m_viewportWidth;
+    state->viewportHeight = m_viewportHeight;
+    state->zRot = zRot;
+    state->maskSerial = mFb->getTextureDraw()->getScreenMaskSerial();
+    for (int i = kMaxBufferAge - 1; i > 0; --i) {
+        state->history[i] = state->history[i - 1];
+    }
+    state->history[0] = damage;
+    state->historySize = std::min(state->historySize + 1, kMaxBufferAge);
+}
+
+void PostWorker::forgetSurface(EGLSurface surface) {
+    android::base::AutoLock lock(mPresentLock);
+    mPresentStates.erase(surface);
+}
+
+PostWorker::PresentStats PostWorker::getPresentStats() const {
+    return {mPresentedFrames.load(std::memory_order_relaxed),
+            mPartialFrames.load(std::memory_order_relaxed),
+            mPresentedPixels.load(std::memory_order_relaxed),
+            mComposes.load(std::memory_order_relaxed),
+            mSkippedComposes.load(std::memory_order_relaxed),
+            mComposedLayers.load(std::memory_order_relaxed),
+            mComposeDraws.load(std::memory_order_relaxed)};
+}
+
 void PostWorker::fillMultiDisplayPostStruct(ComposeLayer* l,
                                             hwc_rect_t displayArea,
                                             hwc_frect_t cropArea,
@@ -60,6 +151,10 @@ void PostWorker::post(ColorBuffer* cb , EGLSurface surface , int Width , int Hei
     // finally, compute translation values
     float dx = px * fx;
     float dy = py * fy;
+
+    android::base::AutoLock presentLock(mPresentLock);
+    PresentState& state = mPresentStates[surface];
+    const hwc_rect_t fullDamage = {0, 0, m_viewportWidth, m_viewportHeight};
     //syslog(LOG_DEBUG, "[%s] windowWidth = %d, windowHeight = %d, m_viewportWidth = %d, m_viewportHeight = %d, dx = %f, dy = %f", 
     //    __func__, windowWidth, windowHeight, m_viewportWidth, m_viewportHeight, dx, dy);
     #ifdef KY_MULTI_DISPLAY
@@ -131,13 +226,83 @@ void PostWorker::post(ColorBuffer* cb , EGLSurface surface , int Width , int Hei
     else 
     #endif
     {
+        const bool simpleLayout = zRot == 0 && dx == 0.f && dy == 0.f &&
+                                  !cb->isDynamicSizeSupported();
+        // Take the content serial before drawing so that updates racing
+        // with this post are presented again next time.
+        const uint64_t serial = cb->getContentSerial();
+        hwc_rect_t damage;
+        const bool partial = computeDamage(cb, serial, state, zRot,
+                                           simpleLayout, &damage);
+
         // should not scale the texture when dynamic size supported !
-        GLuint tex = cb->isDynamicSizeSupported() ? cb->getTex() : cb->scale();
+        GLuint tex = cb->isDynamicSizeSupported()
+                ? cb->getTex()
+                : cb->scale(m_viewportWidth, m_viewportHeight);
+
+        // The back buffer holds the frame presented |age| frames ago;
+        // bring it up to date by redrawing what changed since.
+        hwc_rect_t repaint = fullDamage;
+        if (partial) {
+            EGLint age = 0;
+            s_egl.eglQuerySurface(mFb->getDisplay(), surface,
+                                  EGL_BUFFER_AGE_EXT, &age);
+            if (age > 0 && age - 1 <= state.historySize) {
+                repaint = damage;
+                for (int i = 0; i < age - 1; ++i) {
+                    unite(&repaint, state.history[i]);
+                }
+            }
+        }
+        const bool partialRedraw =
+                repaint.right - repaint.left < m_viewportWidth ||
+                repaint.bottom - repaint.top < m_viewportHeight;
+        if (partialRedraw) {
+            EGLint rect[4] = {repaint.left, repaint.top,
+                              repaint.right - repaint.left,
+                              repaint.bottom - repaint.top};
+            if (s_egl.eglSetDamageRegionKHR) {
+                s_egl.eglSetDamageRegionKHR(mFb->getDisplay(), surface, rect, 1);
+            }
+            s_gles2.glEnable(GL_SCISSOR_TEST);
+            s_gles2.glScissor(rect[0], rect[1], rect[2], rect[3]);
+        }
+
         // render the color buffer to the window and apply the overlay
         cb->postWithOverlay(tex, zRot, dx, dy, windowWidth, windowHeight);
+
+        if (partialRedraw) {
+            s_gles2.glDisable(GL_SCISSOR_TEST);
+        }
+
+        if (partial && s_egl.eglSwapBuffersWithDamageKHR) {
+            EGLint rect[4] = {damage.left, damage.top,
+                              damage.right - damage.left,
+                              damage.bottom - damage.top};
+            s_egl.eglSwapBuffersWithDamageKHR(mFb->getDisplay(), surface,
+                                              rect, 1);
+        } else {
+            s_egl.eglSwapBuffers(mFb->getDisplay(), surface);
+        }
+
+        recordPresent(&state, cb, serial, zRot, partial ? damage : fullDamage);
+        mPresentedFrames.fetch_add(1, std::memory_order_relaxed);
+        if (partialRedraw) {
+            mPartialFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        mPresentedPixels.fetch_add(
+                (uint64_t)(repaint.right - repaint.left) *
+                        (repaint.bottom - repaint.top),
+                std::memory_order_relaxed);
+        return;
     }
 
     s_egl.eglSwapBuffers(mFb->getDisplay(), surface);//mFb->getWindowSurface());
+    recordPresent(&state, nullptr, 0, zRot, fullDamage);
+    mPresentedFrames.fetch_add(1, std::memory_order_relaxed);
+    mPresentedPixels.fetch_add(
+            (uint64_t)m_viewportWidth * m_viewportHeight,
+            std::memory_order_relaxed);
 }
 
 // Called whenever the subwindow needs a refresh (FrameBuffer::setupSubWindow).
@@ -166,58 +331,76 @@ void PostWorker::clear(EGLSurface surface) {
                     GL_STENCIL_BUFFER_BIT);
     s_egl.eglSwapBuffers(mFb->getDisplay(), surface);
 #endif
+    forgetSurface(surface);
 }
 
 void PostWorker::compose(ComposeDevice* p) {
-    // bind the subwindow eglSurface
-    /*if (!m_initialized) {
-        m_initialized = mBindSubwin();
-    }*/
+    composeLayers(p->targetHandle, p->layer, p->numLayers);
+}
 
-    ComposeLayer* l = (ComposeLayer*)p->layer;
-    GLint vport[4] = { 0, };
-    s_gles2.glGetIntegerv(GL_VIEWPORT, vport);
-    s_gles2.glViewport(0, 0, mFb->getWidth(),mFb->getHeight());
-    if (!m_composeFbo) {
-        s_gles2.glGenFramebuffers(1, &m_composeFbo);
-    }
-    s_gles2.glBindFramebuffer(GL_FRAMEBUFFER, m_composeFbo);
-    s_gles2.glFramebufferTexture2D(GL_FRAMEBUFFER,
-                                   GL_COLOR_ATTACHMENT0_OES,
-                                   GL_TEXTURE_2D,
-                                   mFb->findColorBuffer(p->targetHandle)->getTexture(),
-                                   0);
+void PostWorker::compose(ComposeDevice_v2* p) {
+    composeLayers(p->targetHandle, p->layer, p->numLayers);
+}
 
-    DD("worker compose %d layers\n", p->numLayers);
-    mFb->getTextureDraw()->prepareForDrawLayer();
-    for (int i = 0; i < p->numLayers; i++, l++) {
-        DD("\tcomposeMode %d color %d %d %d %d blendMode "
-               "%d alpha %f transform %d %d %d %d %d "
-               "%f %f %f %f\n",
-               l->composeMode, l->color.r, l->color.g, l->color.b,
-               l->color.a, l->blendMode, l->alpha, l->transform,
-               l->displayFrame.left, l->displayFrame.top,
-               l->displayFrame.right, l->displayFrame.bottom,
-               l->crop.left, l->crop.top, l->crop.right,
-               l->crop.bottom);
-        composeLayer(l);
+bool PostWorker::isComposeUnchanged(uint32_t targetHandle, ColorBuffer* target,
+                                    const ComposeLayer* layers,
+                                    uint32_t numLayers,
+                                    std::vector<uint64_t>* serials) {
+    // Buffers written behind the damage tracking (guest rendering through
+    // EGLImages) can change without their serial moving.
+    bool tracked = target->isDamageTracked();
+    serials->clear();
+    for (uint32_t i = 0; i < numLayers; ++i) {
+        uint64_t serial = 0;
+        if (layers[i].composeMode == HWC2_COMPOSITION_DEVICE) {
+            ColorBufferPtr cb = mFb->findColorBuffer(layers[i].cbHandle);
+            if (cb && cb->isDamageTracked()) {
+                serial = cb->getContentSerial();
+            } else {
+                tracked = false;
+            }
+        }
+        serials->push_back(serial);
+    }
+    if (!tracked) {
+        return false;
     }
 
-    //mFb->findColorBuffer(p->targetHandle)->setSync();
-    s_gles2.glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    s_gles2.glViewport(vport[0], vport[1], vport[2], vport[3]);
-    mFb->getTextureDraw()->cleanupForDrawLayer();
+    auto it = mComposeStates.find(targetHandle);
+    if (it == mComposeStates.end()) {
+        return false;
+    }
+    const ComposeState& state = it->second;
+    return state.targetSerial == target->getContentSerial() &&
+           state.layers.size() == numLayers &&
+           !memcmp(state.layers.data(), layers,
+                   numLayers * sizeof(ComposeLayer)) &&
+           state.serials == *serials;
 }
 
-void PostWorker::compose(ComposeDevice_v2* p) {
+void PostWorker::composeLayers(uint32_t targetHandle, ComposeLayer* layers,
+                               uint32_t numLayers) {
     // bind the subwindow eglSurface
     /*if (!m_initialized) {
         m_initialized = mBindSubwin();
     }*/
 
-    ComposeLayer* l = (ComposeLayer*)p->layer;
-    GLint vport[4] = { 0, };
-    s_gles2.glGetIntegerv(GL_VIEWPORT, vport);
+    ColorBufferPtr target = mFb->findColorBuffer(targetHandle);
+    if (!target) {
+        ERR("%s: fail to find target colorbuffer %d\n", __FUNCTION__,
+            targetHandle);
+        return;
+    }
+
+    mComposes.fetch_add(1, std::memory_order_relaxed);
+    std::vector<uint64_t> serials;
+    if (isComposeUnchanged(targetHandle, target.get(), layers, numLayers,
+                           &serials)) {
+        // The target still holds this very composition.
+        mSkippedComposes.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
     s_gles2.glViewport(0, 0, mFb->getWidth(),mFb->getHeight());
     if (!m_composeFbo) {
         s_gles2.glGenFramebuffers(1, &m_composeFbo);
@@ -226,12 +409,16 @@ void PostWorker::compose(ComposeDevice_v2* p) {
     s_gles2.glFramebufferTexture2D(GL_FRAMEBUFFER,
                                    GL_COLOR_ATTACHMENT0_OES,
                                    GL_TEXTURE_2D,
-                                   mFb->findColorBuffer(p->targetHandle)->getTexture(),
+                                   target->getTexture(),
                                    0);
 
-    DD("worker compose %d layers\n", p->numLayers);
-    mFb->getTextureDraw()->prepareForDrawLayer();
-    for (int i = 0; i < p->numLayers; i++, l++) {
+    DD("worker compose %d layers\n", numLayers);
+    // Keep the layer buffers alive until drawn.
+    std::vector<ColorBufferPtr> cbs;
+    std::vector<ComposeLayer> drawnLayers;
+    std::vector<TextureDraw::LayerSource> sources;
+    for (uint32_t i = 0; i < numLayers; i++) {
+        const ComposeLayer* l = &layers[i];
         DD("\tcomposeMode %d color %d %d %d %d blendMode "
                "%d alpha %f transform %d %d %d %d %d "
                "%f %f %f %f\n",
@@ -241,13 +428,51 @@ void PostWorker::compose(ComposeDevice_v2* p) {
                l->displayFrame.right, l->displayFrame.bottom,
                l->crop.left, l->crop.top, l->crop.right,
                l->crop.bottom);
-        composeLayer(l);
+        TextureDraw::LayerSource source = {0, 1, 1};
+        if (l->composeMode == HWC2_COMPOSITION_DEVICE) {
+            ColorBufferPtr cb = mFb->findColorBuffer(l->cbHandle);
+            if (cb == nullptr) {
+                // bad colorbuffer handle
+                ERR("%s: fail to find colorbuffer %d\n", __FUNCTION__,
+                    l->cbHandle);
+                continue;
+            }
+            cb->waitSync();
+            source = {cb->getTex(), (int)cb->getWidth(),
+                      (int)cb->getHeight()};
+            cbs.push_back(cb);
+        }
+        drawnLayers.push_back(*l);
+        sources.push_back(source);
+    }
+
+    int draws = mFb->getTextureDraw()->drawLayers(
+            drawnLayers.data(), sources.data(), (int)sources.size(),
+            mFb->getWidth(), mFb->getHeight());
+    if (draws < 0) {
+        mFb->getTextureDraw()->prepareForDrawLayer();
+        for (uint32_t i = 0; i < numLayers; i++) {
+            composeLayer(&layers[i]);
+        }
+        mFb->getTextureDraw()->cleanupForDrawLayer();
+        draws = (int)numLayers;
     }
+    mComposedLayers.fetch_add(numLayers, std::memory_order_relaxed);
+    mComposeDraws.fetch_add(draws, std::memory_order_relaxed);
 
     //mFb->findColorBuffer(p->targetHandle)->setSync();
+    target->addFullDamage();
     s_gles2.glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    s_gles2.glViewport(vport[0], vport[1], vport[2], vport[3]);
-    mFb->getTextureDraw()->cleanupForDrawLayer();
+    // Back to the viewport set by viewport().
+    s_gles2.glViewport(0, 0, m_viewportWidth, m_viewportHeight);
+
+    if (mComposeStates.size() > kMaxComposeStates) {
+        mComposeStates.clear();
+    }
+    ComposeState& state = mComposeStates[targetHandle];
+    state.layers.assign(layers, layers + numLayers);
+    state.serials.swap(serials);
+    state.targetSerial = target->getContentSerial();
 }
 
 void PostWorker::composeLayer(ComposeLayer* l) {
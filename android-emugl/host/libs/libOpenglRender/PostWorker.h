@@ -4,7 +4,9 @@
 #include <GLES/gl.h>
 #include <GLES3/gl3.h>
 
+#include <atomic>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 #include "Hwc2.h"
@@ -25,8 +27,27 @@ public:
 
     // post: posts the next color buffer.
     // Assumes framebuffer lock is held.
+    // When |cb| is the buffer last presented on |surface| and only part of
+    // it changed since, only that part is redrawn (if the back buffer age
+    // is known) and presented (EGL_KHR_swap_buffers_with_damage).
     void post(ColorBuffer* cb, EGLSurface surface ,  int Width , int Height ,int zRot);
 
+    // Drop the partial presentation state of |surface| before it is
+    // destroyed.
+    void forgetSurface(EGLSurface surface);
+
+    // Totals since startup, for the perf stats.
+    struct PresentStats {
+        uint64_t frames;
+        uint64_t partialFrames;
+        uint64_t pixels;
+        uint64_t composes;
+        uint64_t skippedComposes;
+        uint64_t composedLayers;
+        uint64_t composeDraws;
+    };
+    PresentStats getPresentStats() const;
+
     // viewport: (re)initializes viewport dimensions.
     // Assumes framebuffer lock is held.
     // This is called whenever the subwindow needs a refresh
@@ -52,6 +73,40 @@ public:
                     void* pixels);
 
 private:
+    // Maximum back buffer age partial redraws are done for.
+    static constexpr int kMaxBufferAge = 4;
+
+    struct PresentState {
+        uint32_t cb = 0;  // handle of the buffer last presented
+        uint64_t serial = 0;
+        int viewportWidth = 0;
+        int viewportHeight = 0;
+        int zRot = 0;
+        uint64_t maskSerial = 0;  // overlay drawn on top
+        // Window damage of the last frames, most recent first. Rects are
+        // in GL window coordinates: |top| is the lower edge.
+        hwc_rect_t history[kMaxBufferAge] = {};
+        int historySize = 0;
+    };
+
+    // Window area (GL window coordinates, see PresentState) that changed
+    // since |state| was recorded. Returns false when all of it did.
+    bool computeDamage(ColorBuffer* cb, uint64_t serial,
+                       const PresentState& state, int zRot, bool simpleLayout,
+                       hwc_rect_t* damage);
+    void recordPresent(PresentState* state, ColorBuffer* cb, uint64_t serial,
+                       int zRot, const hwc_rect_t& damage);
+
+    // Composes the layers into |targetHandle| in as few draws as the
+    // TextureDraw batches allow, unless the target already holds that
+    // composition: same layers, and neither they nor the target changed
+    // since.
+    void composeLayers(uint32_t targetHandle, ComposeLayer* layers,
+                       uint32_t numLayers);
+    // Fills |serials| with the content serials of the layers.
+    bool isComposeUnchanged(uint32_t targetHandle, ColorBuffer* target,
+                            const ComposeLayer* layers, uint32_t numLayers,
+                            std::vector<uint64_t>* serials);
     void composeLayer(ComposeLayer* l);
     void fillMultiDisplayPostStruct(ComposeLayer* l,
                                     hwc_rect_t displayArea,
@@ -70,5 +125,24 @@ private:
     int m_viewportWidth = 0;
     int m_viewportHeight = 0;
     GLuint m_composeFbo = 0;
+
+    // Last composition of each target buffer.
+    struct ComposeState {
+        std::vector<ComposeLayer> layers;
+        std::vector<uint64_t> serials;
+        uint64_t targetSerial = 0;
+    };
+    static constexpr size_t kMaxComposeStates = 64;
+    std::unordered_map<uint32_t, ComposeState> mComposeStates;
+
+    android::base::Lock mPresentLock;
+    std::unordered_map<EGLSurface, PresentState> mPresentStates;
+    std::atomic<uint64_t> mPresentedFrames{0};
+    std::atomic<uint64_t> mPartialFrames{0};
+    std::atomic<uint64_t> mPresentedPixels{0};
+    std::atomic<uint64_t> mComposes{0};
+    std::atomic<uint64_t> mSkippedComposes{0};
+    std::atomic<uint64_t> mComposedLayers{0};
+    std::atomic<uint64_t> mComposeDraws{0};
     DISALLOW_COPY_AND_ASSIGN(PostWorker);
 };
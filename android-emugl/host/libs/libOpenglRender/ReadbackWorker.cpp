@@ -1,7 +1,8 @@
-
 #include "ReadbackWorker.h"
 
 #include <string.h>                           // for memcpy
+#include <stdlib.h>                           // for atoi
+#include <algorithm>                          // for max, min
 
 #include "ColorBuffer.h"                      // for ColorBuffer
 #include "DispatchTables.h"                   // for s_gles2
@@ -9,25 +10,106 @@
 #include "FrameBuffer.h"                      // for FrameBuffer
 #include "OpenGLESDispatch/EGLDispatch.h"     // for EGLDispatch, s_egl
 #include "OpenGLESDispatch/GLESv2Dispatch.h"  // for GLESv2Dispatch
+#include "android/base/system/System.h"       // for System
+#include "emugl/common/logging.h"             // for GL_LOG
 #include "emugl/common/misc.h"                // for getGlesVersion
 
+using android::base::System;
+
+// Three buffers let one frame be read back while the consumer copies the
+// previous one and a third one is ready for it next.
+static constexpr uint32_t kDefaultRingDepth = 3;
+static constexpr uint32_t kMinRingDepth = 2;
+static constexpr uint32_t kMaxRingDepth = 8;
+
+// How long |repaint| waits for the readback of the current frame.
+static constexpr GLuint64 kRepaintWaitNs = 100 * 1000 * 1000;
+
+// static
+uint32_t ReadbackWorker::getRingDepth() {
+    const std::string depth =
+            System::getEnvironmentVariable("ANDROID_EMUGL_READBACK_DEPTH");
+    if (depth.empty()) {
+        return kDefaultRingDepth;
+    }
+    return std::max<uint32_t>(
+            kMinRingDepth,
+            std::min<uint32_t>(std::max(0, atoi(depth.c_str())),
+                               kMaxRingDepth));
+}
+
 ReadbackWorker::recordDisplay::recordDisplay(uint32_t displayId, uint32_t w, uint32_t h)
-    : mBufferSize(4 * w * h /* RGBA8 (4 bpp) */),
-      mBuffers(4 /* mailbox */,
-               0),  // Note, last index is used for duplicating buffer on flush
+    : mWidth(w),
+      mHeight(h),
+      mBufferSize(4 * w * h /* RGBA8 (4 bpp) */),
+      mSlots(getRingDepth()),
       mDisplayId(displayId) {}
 
+void ReadbackWorker::recordDisplay::pollFences() {
+    const uint64_t now = System::get()->getHighResTimeUs();
+    for (Slot& slot : mSlots) {
+        if (slot.state != SlotState::Pending) {
+            continue;
+        }
+        if (slot.fence) {
+            const GLenum status = s_gles2.glClientWaitSync(slot.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED &&
+                status != GL_CONDITION_SATISFIED) {
+                continue;
+            }
+            s_gles2.glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        slot.state = SlotState::Ready;
+        mFramesReady++;
+        mCaptureLatencyUs += now - slot.issueTimeUs;
+    }
+
+    // Only the newest finished frame is worth keeping for the consumer.
+    Slot* newest = newestFrame();
+    for (Slot& slot : mSlots) {
+        if (slot.state == SlotState::Ready && &slot != newest) {
+            slot.state = SlotState::Free;
+            mFramesDropped++;
+        }
+    }
+}
+
+ReadbackWorker::recordDisplay::Slot*
+ReadbackWorker::recordDisplay::newestFrame() {
+    Slot* newest = nullptr;
+    for (Slot& slot : mSlots) {
+        if ((slot.state == SlotState::Ready ||
+             slot.state == SlotState::Mapped) &&
+            (!newest || slot.frameNumber > newest->frameNumber)) {
+            newest = &slot;
+        }
+    }
+    return newest;
+}
+
 void ReadbackWorker::initGL() {
     mFb = FrameBuffer::getFB();
     mFb->createAndBindTrivialSharedContext(&mContext, &mSurf);
     mFb->createAndBindTrivialSharedContext(&mFlushContext, &mFlushSurf);
 }
 
-ReadbackWorker::~ReadbackWorker() {
+static void deleteSlots(ReadbackWorker::recordDisplay* r) {
     s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    for (auto& slot : r->mSlots) {
+        if (slot.fence) {
+            s_gles2.glDeleteSync(slot.fence);
+        }
+        // Deleting a mapped buffer unmaps it.
+        s_gles2.glDeleteBuffers(1, &slot.buffer);
+    }
+    r->mSlots.clear();
+}
+
+ReadbackWorker::~ReadbackWorker() {
     for (auto& r : mRecordDisplays) {
-        s_gles2.glDeleteBuffers(r.second.mBuffers.size(), &r.second.mBuffers[0]);
+        deleteSlots(&r.second);
     }
     mFb->unbindAndDestroyTrivialSharedContext(mContext, mSurf);
     mFb->unbindAndDestroyTrivialSharedContext(mFlushContext, mFlushSurf);
@@ -38,18 +120,24 @@ void ReadbackWorker::setRecordDisplay(uint32_t displayId, uint32_t w, uint32_t h
     if (add) {
         mRecordDisplays.emplace(displayId, recordDisplay(displayId, w, h));
         recordDisplay& r = mRecordDisplays[displayId];
-        s_gles2.glGenBuffers(r.mBuffers.size(), &r.mBuffers[0]);
-        for (auto buffer : r.mBuffers) {
-            s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        for (auto& slot : r.mSlots) {
+            s_gles2.glGenBuffers(1, &slot.buffer);
+            s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
             s_gles2.glBufferData(GL_PIXEL_PACK_BUFFER, r.mBufferSize,
                              0 /* init, with no data */, GL_STREAM_READ);
         }
         s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     } else {
         recordDisplay& r = mRecordDisplays[displayId];
-        s_gles2.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, 0);
-        s_gles2.glDeleteBuffers(r.mBuffers.size(), &r.mBuffers[0]);
+        if (r.mFramesReady) {
+            GL_LOG("Readback of display %u: %llu frames ready, %llu dropped, "
+                   "%.3f ms average capture latency, %.3f ms CPU per frame",
+                   displayId, (unsigned long long)r.mFramesReady,
+                   (unsigned long long)r.mFramesDropped,
+                   r.mCaptureLatencyUs / 1000.0 / r.mFramesReady,
+                   r.mCpuTimeUs / 1000.0 / r.mFramesReady);
+        }
+        deleteSlots(&r);
         mRecordDisplays.erase(displayId);
     }
 }
@@ -59,129 +147,159 @@ void ReadbackWorker::doNextReadback(uint32_t displayId,
                                     void* fbImage,
                                     bool repaint,
                                     bool readbackBgra) {
-    // if |repaint|, make sure that the current frame is immediately sent down
-    // the pipeline and made available to the consumer by priming async
-    // readback; doing 4 consecutive reads in a row, which should be enough to
-    // fill the 3 buffers in the triple buffering setup and on the 4th, trigger
-    // a post callback.
-    int numIter = repaint ? 4 : 1;
-
-    // Mailbox-style triple buffering setup:
-    // We want to avoid glReadPixels while in the middle of doing
-    // memcpy to the consumer, but also want to avoid latency while
-    // that is going on.
-    //
-    // There are 3 buffer ids, A, B, and C.
-    // If we are not in the middle of copying out a frame,
-    // set glReadPixels to write to buffer A and copy from buffer B in
-    // alternation, so the consumer always gets the latest frame
-    // +1 frame of lag in order to not cause blocking on
-    // glReadPixels / glMapBufferRange.
-    // If we are in the middle of copying out a frame, reset A and B to
-    // not be the buffer being copied out, and continue glReadPixels to
-    // buffer A and B as before.
-    //
-    // The resulting invariants are:
-    // - glReadPixels is called on a different buffer every time
-    //   so we avoid introducing sync points there.
-    // - At no time are we mapping/copying a buffer and also doing
-    //   glReadPixels on it (avoid simultaneous map + glReadPixels)
-    // - glReadPixels and then immediately map/copy the same buffer
-    //   doesn't happen either (avoid sync point in glMapBufferRange)
-    for (int i = 0; i < numIter; i++) {
-        android::base::AutoLock lock(mLock);
-        recordDisplay& r = mRecordDisplays[displayId];
-        if (r.mIsCopying) {
-            switch (r.mMapCopyIndex) {
-                // To keep double buffering effect on
-                // glReadPixels, need to keep even/oddness of
-                // mReadPixelsIndexEven and mReadPixelsIndexOdd.
-                case 0:
-                    r.mReadPixelsIndexEven = 2;
-                    r.mReadPixelsIndexOdd = 1;
-                    break;
-                case 1:
-                    r.mReadPixelsIndexEven = 0;
-                    r.mReadPixelsIndexOdd = 2;
-                    break;
-                case 2:
-                    r.mReadPixelsIndexEven = 0;
-                    r.mReadPixelsIndexOdd = 1;
-                    break;
-            }
-        } else {
-            r.mReadPixelsIndexEven = 0;
-            r.mReadPixelsIndexOdd = 1;
-            r.mMapCopyIndex = r.mPrevReadPixelsIndex;
-        }
+    const uint64_t startUs = System::get()->getHighResTimeUs();
+    // The fences have to be checked with a context of the share group
+    // current; readbackAsync() uses the same one.
+    ColorBuffer::RecursiveScopedHelperContext context(
+            mFb->getColorBufferHelper());
+    if (!context.isOk()) {
+        return;
+    }
+
+    android::base::AutoLock lock(mLock);
+    const auto it = mRecordDisplays.find(displayId);
+    if (it == mRecordDisplays.end()) {
+        return;
+    }
+    recordDisplay& r = it->second;
+    r.pollFences();
 
-        // Double buffering on buffer A / B part
-        uint32_t readAt;
-        if (r.m_readbackCount % 2 == 0) {
-            readAt = r.mReadPixelsIndexEven;
-        } else {
-            readAt = r.mReadPixelsIndexOdd;
+    // Ring buffer of fenced readbacks:
+    // glReadPixels goes into a free buffer every time, so it never waits
+    // for a buffer that is still being read back or mapped, and a buffer
+    // is only mapped once its fence says the readback is done, so mapping
+    // never waits for the GPU. If the consumer or the GPU falls behind and
+    // no buffer is free, this frame is dropped instead.
+    recordDisplay::Slot* slot = nullptr;
+    for (auto& candidate : r.mSlots) {
+        if (candidate.state == recordDisplay::SlotState::Free) {
+            slot = &candidate;
+            break;
         }
-        r.m_readbackCount++;
-        r.mPrevReadPixelsIndex = readAt;
-
-        cb->readbackAsync(r.mBuffers[readAt], readbackBgra);
-
-        // It's possible to post callback before any of the async readbacks
-        // have written any data yet, which results in a black frame.  Safer
-        // option to avoid this glitch is to wait until all 3 potential
-        // buffers in our triple buffering setup have had chances to readback.
-        lock.unlock();
-        if (r.m_readbackCount > 3) {
-            mFb->doPostCallback(fbImage, r.mDisplayId);
+    }
+    if (slot) {
+        slot->fence = cb->readbackAsync(slot->buffer, readbackBgra,
+                                        &slot->swapRedBlue);
+        slot->state = recordDisplay::SlotState::Pending;
+        slot->frameNumber = r.mNextFrameNumber++;
+        slot->issueTimeUs = System::get()->getHighResTimeUs();
+
+        if (repaint && slot->fence) {
+            s_gles2.glClientWaitSync(slot->fence,
+                                     GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     kRepaintWaitNs);
+            r.pollFences();
         }
+    } else {
+        r.mNextFrameNumber++;
+        r.mFramesDropped++;
+    }
+
+    // Only tell the consumer about frames it hasn't seen yet.
+    const recordDisplay::Slot* newest = r.newestFrame();
+    const bool post =
+            newest && newest->frameNumber > r.mLastPostedFrameNumber;
+    if (post) {
+        r.mLastPostedFrameNumber = newest->frameNumber;
+    }
+    r.mCpuTimeUs += System::get()->getHighResTimeUs() - startUs;
+    lock.unlock();
+    context.release();
+
+    if (post) {
+        mFb->doPostCallback(fbImage, displayId);
     }
 }
 
 void ReadbackWorker::flushPipeline(uint32_t displayId) {
     android::base::AutoLock lock(mLock);
-    recordDisplay& r = mRecordDisplays[displayId];
-    if (r.mIsCopying) {
-        // No need to make the last frame available,
-        // we are currently being read.
+    const auto it = mRecordDisplays.find(displayId);
+    if (it == mRecordDisplays.end()) {
         return;
     }
-
-    auto src = r.mBuffers[r.mPrevReadPixelsIndex];
-    auto dst = r.mBuffers.back();
+    recordDisplay& r = it->second;
 
     // This is not called from a renderthread, so let's activate
     // the context.
     s_egl.eglMakeCurrent(mFb->getDisplay(), mFlushSurf, mFlushSurf, mFlushContext);
-
-    // We now copy the last frame into slot 4, where no other thread
-    // ever writes.
-    s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, src);
-    s_gles2.glBindBuffer(GL_COPY_WRITE_BUFFER, dst);
-    s_gles2.glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
-                                r.mBufferSize);
+    r.pollFences();
     s_egl.eglMakeCurrent(mFb->getDisplay(), EGL_NO_SURFACE, EGL_NO_SURFACE,
                          EGL_NO_CONTEXT);
 
-    r.mMapCopyIndex = r.mBuffers.size() - 1;
+    // The last frame stays in its buffer until a newer one replaces it, so
+    // there is nothing to copy; just post it if the consumer hasn't seen it.
+    const recordDisplay::Slot* newest = r.newestFrame();
+    if (!newest || newest->frameNumber <= r.mLastPostedFrameNumber) {
+        return;
+    }
+    r.mLastPostedFrameNumber = newest->frameNumber;
     lock.unlock();
-    mFb->doPostCallback(nullptr, r.mDisplayId);
+    mFb->doPostCallback(nullptr, displayId);
 }
 
-void ReadbackWorker::getPixels(uint32_t displayId, void* buf, uint32_t bytes) {
+ReadbackFramePtr ReadbackWorker::acquireFrame(uint32_t displayId) {
     android::base::AutoLock lock(mLock);
-    recordDisplay& r = mRecordDisplays[displayId];
-    r.mIsCopying = true;
-    lock.unlock();
+    const auto it = mRecordDisplays.find(displayId);
+    if (it == mRecordDisplays.end()) {
+        return nullptr;
+    }
+    recordDisplay& r = it->second;
+    r.pollFences();
+    recordDisplay::Slot* slot = r.newestFrame();
+    if (!slot) {
+        return nullptr;
+    }
 
-    GLuint buffer = r.mBuffers[r.mMapCopyIndex];
-    s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, buffer);
-    void* pixels = s_gles2.glMapBufferRange(GL_COPY_READ_BUFFER, 0, bytes,
-                                            GL_MAP_READ_BIT);
-    memcpy(buf, pixels, bytes);
-    s_gles2.glUnmapBuffer(GL_COPY_READ_BUFFER);
+    if (slot->state == recordDisplay::SlotState::Ready) {
+        const uint64_t startUs = System::get()->getHighResTimeUs();
+        s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, slot->buffer);
+        slot->pixels = s_gles2.glMapBufferRange(GL_COPY_READ_BUFFER, 0,
+                                                r.mBufferSize, GL_MAP_READ_BIT);
+        s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        r.mCpuTimeUs += System::get()->getHighResTimeUs() - startUs;
+        if (!slot->pixels) {
+            return nullptr;
+        }
+        slot->state = recordDisplay::SlotState::Mapped;
+    }
+    slot->refs++;
 
-    lock.lock();
-    r.mIsCopying = false;
-    lock.unlock();
+    const uint32_t index = static_cast<uint32_t>(slot - r.mSlots.data());
+    FrameBuffer* fb = mFb;
+    return ReadbackFramePtr(
+            new ReadbackFrame{displayId, r.mWidth, r.mHeight, r.mBufferSize,
+                              slot->pixels, slot->frameNumber,
+                              slot->swapRedBlue},
+            [fb, index](const ReadbackFrame* frame) {
+                fb->releaseReadbackFrame(frame->displayId, index,
+                                         frame->frameNumber);
+                delete frame;
+            });
+}
+
+void ReadbackWorker::releaseFrame(uint32_t displayId,
+                                  uint32_t index,
+                                  uint64_t frameNumber) {
+    android::base::AutoLock lock(mLock);
+    const auto it = mRecordDisplays.find(displayId);
+    if (it == mRecordDisplays.end()) {
+        return;
+    }
+    recordDisplay& r = it->second;
+    if (index >= r.mSlots.size()) {
+        return;
+    }
+    recordDisplay::Slot& slot = r.mSlots[index];
+    if (slot.state != recordDisplay::SlotState::Mapped ||
+        slot.frameNumber != frameNumber || --slot.refs > 0) {
+        return;
+    }
+
+    s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, slot.buffer);
+    s_gles2.glUnmapBuffer(GL_COPY_READ_BUFFER);
+    s_gles2.glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    slot.pixels = nullptr;
+    // Keep the frame around if nothing newer has been read back since.
+    slot.state = r.newestFrame() == &slot ? recordDisplay::SlotState::Ready
+                                          : recordDisplay::SlotState::Free;
 }
@@ -3,6 +3,7 @@
 #include <EGL/egl.h>                            // for EGLContext, EGLSurface
 #include <GLES3/gl3.h>                          // for GLuint
 #include <map>                                  // for map
+#include <memory>                               // for shared_ptr
 #include <stdint.h>                             // for uint32_t
 #include <vector>                               // for vector
 
@@ -13,6 +14,25 @@ class ColorBuffer;
 class FrameBuffer;
 struct RenderThreadInfo;
 
+// A frame read back for a recording display, mapped for reading. The mapping
+// stays valid for as long as a reference to the frame is held, so consumers
+// can read |pixels| in place instead of copying them out. References must
+// be dropped before the display stops recording.
+struct ReadbackFrame {
+    uint32_t displayId;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytes;
+    const void* pixels;
+    // Counts the readbacks of the display, including dropped ones.
+    uint64_t frameNumber;
+    // Set when the GPU couldn't produce the BGRA the display asked for, and
+    // |pixels| are RGBA; emugl::swapRedBlue() turns them into BGRA while
+    // copying them out.
+    bool swapRedBlue;
+};
+using ReadbackFramePtr = std::shared_ptr<const ReadbackFrame>;
+
 // This class implements async readback of emugl ColorBuffers.
 // It is meant to run on both the emugl framebuffer posting thread
 // and a separate GL thread, with two main points of interaction:
@@ -27,45 +47,87 @@ public:
 
     // doNextReadback(): Call this from the emugl FrameBuffer::post thread
     // or similar rendering thread.
-    // This will trigger an async glReadPixels of the current framebuffer.
-    // The post callback of Framebuffer will also be triggered, but
-    // in async mode it should do minimal work that involves |fbImage|.
-    // |repaint|: flag to prime async readback with multiple iterations
-    // so that the consumer of readback doesn't lag behind.
+    // This will trigger an async glReadPixels of the current framebuffer
+    // into the next free buffer of the display's ring, fenced so that the
+    // readback is only mapped once the GPU is done with it. The post
+    // callback of Framebuffer is triggered whenever a newer frame has
+    // become ready, but in async mode it should do minimal work that
+    // involves |fbImage|.
+    // If every buffer is still being read back or held by a consumer, the
+    // frame is dropped rather than stalling the post thread.
+    // |repaint|: flag to make the current frame available to the consumer
+    // right away, waiting for its readback to finish.
     // |readbackBgra|: Whether to force the readback format as GL_BGRA_EXT,
     // so that we get (depending on driver quality, heh) a gpu conversion of the
     // readback image that is suitable for webrtc, which expects formats like that.
     void doNextReadback(uint32_t displayId, ColorBuffer* cb, void* fbImage, bool repaint, bool readbackBgra);
 
-    // getPixels(): Run this on a separate GL thread. This retrieves the
-    // latest framebuffer that has been posted and read with doNextReadback.
-    // This is meant for apps like video encoding to use as input; they will
-    // need to do synchronized communication with the thread ReadbackWorker
-    // is running on.
-    void getPixels(uint32_t displayId, void* out, uint32_t bytes);
+    // acquireFrame(): Run this on a separate GL thread. Returns a reference
+    // to the latest frame whose readback has finished, or null if there is
+    // none yet. This is meant for apps like video encoding to use as input;
+    // they will need to do synchronized communication with the thread
+    // ReadbackWorker is running on. Releasing the last reference goes
+    // through FrameBuffer::releaseReadbackFrame(), which calls
+    // releaseFrame() on the same thread.
+    ReadbackFramePtr acquireFrame(uint32_t displayId);
+    void releaseFrame(uint32_t displayId, uint32_t slot, uint64_t frameNumber);
 
-    // Duplicates the last frame and generates a post events if
-    // there are no read events active.
+    // Generates a post event for the last frame if its readback has
+    // finished since.
     // This is usually called when there was no doNextReadback activity
     // for a few ms, to guarantee that end users see the final frame.
     void flushPipeline(uint32_t displayId);
 
     void setRecordDisplay(uint32_t displayId, uint32_t w, uint32_t h, bool add);
 
+    // The ring depth, from ANDROID_EMUGL_READBACK_DEPTH.
+    static uint32_t getRingDepth();
+
     class recordDisplay {
     public:
         recordDisplay() = default;
         recordDisplay(uint32_t displayId, uint32_t w, uint32_t h);
+
+        enum class SlotState {
+            Free,
+            // glReadPixels was issued, |fence| signals when it's done.
+            Pending,
+            // Done reading back, not mapped.
+            Ready,
+            // Mapped for the consumers that hold references to it.
+            Mapped,
+        };
+        struct Slot {
+            GLuint buffer = 0;
+            GLsync fence = nullptr;
+            SlotState state = SlotState::Free;
+            uint64_t frameNumber = 0;
+            uint64_t issueTimeUs = 0;
+            const void* pixels = nullptr;
+            int refs = 0;
+            bool swapRedBlue = false;
+        };
+
+        // Moves the slots whose fences have signaled to Ready, and frees the
+        // Ready ones a newer frame supersedes. Needs a current GL context.
+        void pollFences();
+        // The Ready or Mapped slot with the newest frame, if any.
+        Slot* newestFrame();
+
     public:
-        uint32_t mReadPixelsIndexEven = 0;
-        uint32_t mReadPixelsIndexOdd = 1;
-        uint32_t mPrevReadPixelsIndex = 1;
-        uint32_t mMapCopyIndex = 0;
-        bool mIsCopying = false;
+        uint32_t mWidth = 0;
+        uint32_t mHeight = 0;
         uint32_t mBufferSize = 0;
-        std::vector<GLuint> mBuffers = {};
-        uint32_t m_readbackCount = 0;
+        std::vector<Slot> mSlots = {};
+        uint64_t mNextFrameNumber = 1;
+        uint64_t mLastPostedFrameNumber = 0;
         uint32_t mDisplayId = 0;
+
+        // Statistics, logged when the display stops recording.
+        uint64_t mFramesReady = 0;
+        uint64_t mFramesDropped = 0;
+        uint64_t mCaptureLatencyUs = 0;
+        uint64_t mCpuTimeUs = 0;
     };
 
 private:
@@ -30,7 +30,9 @@
 //#include "vulkan/VkDecoderGlobalState.h"
 #include "android/utils/debug.h"
 #include "android/base/StringView.h"
+#include "android/base/StringFormat.h"
 #include "android/base/Tracing.h"
+#include "android/base/synchronization/ConditionVariable.h"
 #include "emugl/common/feature_control.h"
 #include "emugl/common/lazy_instance.h"
 #include "emugl/common/sync_device.h"
@@ -39,6 +41,7 @@
 #include "emugl/common/thread.h"
 #include "math.h"
 
+#include <algorithm>
 #include <atomic>
 #include <inttypes.h>
 #include <string.h>
@@ -46,6 +49,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <sstream>
 
 //#include <boost/format.hpp>
@@ -127,40 +131,141 @@ public:
         // to be bad. lockState tracks how many color buffer locks there are.
         // If lockState < 0, it means we definitely have an unlock before lock
         // sort of situation, and should give up.
-        lockState = 0;
+        //
+        // The lock is kept per color buffer: posting one app's window
+        // buffer must not wait for another app's CPU update of an
+        // unrelated buffer. Lock and unlock may arrive on different
+        // render threads, so the state is a counter guarded by mLock
+        // rather than an OS read/write lock.
     }
 
     // lockColorBufferPrepare is designed to handle
-    // gralloc_lock/unlock requests, and uses the read lock.
+    // gralloc_lock/unlock requests, and takes |colorBuffer| for reading.
     // When rcFlushWindowColorBuffer is called (when frames are posted),
-    // we use the write lock (see GrallocSyncPostLock).
-    void lockColorBufferPrepare() {
-        int newLockState = ++lockState;
-        if (mEnabled && newLockState == 1) {
-            mGrallocColorBufferLock.lockRead();
-        } else if (mEnabled) {
+    // the buffer is taken for writing (see GrallocSyncPostLock).
+    void lockColorBufferPrepare(uint32_t colorBuffer) {
+        if (!mEnabled) return;
+        AutoLock lock(mLock);
+        BufferState& state = mStates[colorBuffer];
+        int newLockState = ++state.lockState;
+        if (newLockState == 1) {
+            if (state.posting) {
+                waitLocked(&lock, state,
+                           [&state] { return !state.posting; });
+            }
+        } else {
             GRSYNC_DPRINT("warning: recursive/multiple locks from guest!");
         }
     }
-    void unlockColorBufferPrepare() {
-        int newLockState = --lockState;
-        if (mEnabled && newLockState == 0) mGrallocColorBufferLock.unlockRead();
+    void unlockColorBufferPrepare(uint32_t colorBuffer) {
+        if (!mEnabled) return;
+        AutoLock lock(mLock);
+        BufferState& state = mStates[colorBuffer];
+        int newLockState = --state.lockState;
+        if (newLockState == 0) {
+            mCv.broadcast();
+        }
+        maybeEraseLocked(colorBuffer, state);
+    }
+
+    void lockColorBufferPost(uint32_t colorBuffer) {
+        if (!mEnabled) return;
+        AutoLock lock(mLock);
+        BufferState& state = mStates[colorBuffer];
+        if (state.posting || state.lockState > 0) {
+            waitLocked(&lock, state, [&state] {
+                return !state.posting && state.lockState <= 0;
+            });
+        }
+        state.posting = true;
+    }
+    void unlockColorBufferPost(uint32_t colorBuffer) {
+        if (!mEnabled) return;
+        AutoLock lock(mLock);
+        BufferState& state = mStates[colorBuffer];
+        state.posting = false;
+        // An unlock that arrived before its lock left the state negative.
+        // The post is done with the buffer, start over from a clean state so
+        // the entry can go away.
+        if (state.lockState < 0) {
+            state.lockState = 0;
+        }
+        mCv.broadcast();
+        maybeEraseLocked(colorBuffer, state);
+    }
+
+    // Number of lock requests that had to wait for another user of the
+    // same color buffer.
+    uint64_t getContendedCount() const {
+        AutoLock lock(mLock);
+        return mContendedCount;
     }
-    android::base::ReadWriteLock mGrallocColorBufferLock;
+
 private:
+    struct BufferState {
+        int lockState = 0;
+        bool posting = false;
+        int waiters = 0;
+    };
+
+    // Waits until |ready| holds for |state|. The other user of the buffer
+    // may need the decoding lock to get there, so the wait happens without
+    // it; |lock| is dropped around that to keep the lock order. The waiter
+    // count keeps |state| in the map meanwhile.
+    template <class Predicate>
+    void waitLocked(AutoLock* lock, BufferState& state, Predicate ready) {
+        ++mContendedCount;
+        ++state.waiters;
+        lock->unlock();
+        {
+            ScopedBlockingWait blocking(true /* dropDecodeLock */);
+            lock->lock();
+            mCv.wait(lock, ready);
+            lock->unlock();
+        }
+        lock->lock();
+        --state.waiters;
+    }
+
+    void maybeEraseLocked(uint32_t colorBuffer, const BufferState& state) {
+        if (!state.lockState && !state.posting && !state.waiters) {
+            mStates.erase(colorBuffer);
+        }
+    }
+
     bool mEnabled;
-    std::atomic<int> lockState;
+    mutable Lock mLock;
+    android::base::ConditionVariable mCv;
+    // Entries only exist while a buffer is locked, posted or waited for,
+    // or while its lock state is bad until the next post of it.
+    std::unordered_map<uint32_t, BufferState> mStates;
+    uint64_t mContendedCount = 0;
     DISALLOW_COPY_ASSIGN_AND_MOVE(GrallocSync);
 };
 
-class GrallocSyncPostLock : public android::base::AutoWriteLock {
+class GrallocSyncPostLock {
 public:
-    GrallocSyncPostLock(GrallocSync& grallocsync) :
-        android::base::AutoWriteLock(grallocsync.mGrallocColorBufferLock) { }
+    GrallocSyncPostLock(GrallocSync& grallocsync, uint32_t colorBuffer) :
+        mGrallocSync(grallocsync), mColorBuffer(colorBuffer) {
+        mGrallocSync.lockColorBufferPost(mColorBuffer);
+    }
+    ~GrallocSyncPostLock() {
+        mGrallocSync.unlockColorBufferPost(mColorBuffer);
+    }
+private:
+    GrallocSync& mGrallocSync;
+    uint32_t mColorBuffer;
+    DISALLOW_COPY_ASSIGN_AND_MOVE(GrallocSyncPostLock);
 };
 
 static ::emugl::LazyInstance<GrallocSync> sGrallocSync = LAZY_INSTANCE_INIT;
 
+std::string printGrallocSyncStats() {
+    return android::base::StringFormat(
+            "Gralloc sync: %llu contended locks",
+            (unsigned long long)sGrallocSync->getContendedCount());
+}
+
 static const GLint rendererVersion = 1;
 
 // GLAsyncSwap version history:
@@ -997,14 +1102,13 @@ static void rcCloseColorBuffer(uint32_t colorbuffer)
 static int rcFlushWindowColorBuffer(uint32_t windowSurface)
 {
     GRSYNC_DPRINT("waiting for gralloc cb lock");
-    GrallocSyncPostLock lock(sGrallocSync.get());
-    GRSYNC_DPRINT("lock gralloc cb lock {");
-
     FrameBuffer *fb = FrameBuffer::getFB();
     if (!fb) {
-        GRSYNC_DPRINT("unlock gralloc cb lock");
         return -1;
     }
+    GrallocSyncPostLock lock(sGrallocSync.get(),
+                             fb->getWindowSurfaceColorBufferHandle(windowSurface));
+    GRSYNC_DPRINT("lock gralloc cb lock {");
 
     #ifdef KY_ENABLE_VULKAN
     // Update from Vulkan if necessary
@@ -1095,7 +1199,11 @@ static void rcFBPost(uint32_t colorBuffer)
 
 static void rcFBSetSwapInterval(EGLint interval)
 {
-   // XXX: TBD - should be implemented
+    // eglSwapInterval applies to the guest's current draw surface.
+    RenderThreadInfo *tInfo = RenderThreadInfo::get();
+    if (tInfo && tInfo->currDrawSurf) {
+        tInfo->currDrawSurf->setSwapInterval(std::max(interval, 0));
+    }
 }
 
 static void rcBindTexture(uint32_t colorBuffer)
@@ -1130,7 +1238,7 @@ static EGLint rcColorBufferCacheFlush(uint32_t colorBuffer,
 {
     // gralloc_lock() on the guest calls rcColorBufferCacheFlush
     GRSYNC_DPRINT("waiting for gralloc cb lock");
-    sGrallocSync->lockColorBufferPrepare();
+    sGrallocSync->lockColorBufferPrepare(colorBuffer);
     GRSYNC_DPRINT("lock gralloc cb lock {");
     return 0;
 }
@@ -1160,7 +1268,7 @@ static int rcUpdateColorBuffer(uint32_t colorBuffer,
 
     if (!fb) {
         GRSYNC_DPRINT("unlock gralloc cb lock");
-        sGrallocSync->unlockColorBufferPrepare();
+        sGrallocSync->unlockColorBufferPrepare(colorBuffer);
         return -1;
     }
     #ifdef KY_ENABLE_VULKAN
@@ -1171,7 +1279,7 @@ static int rcUpdateColorBuffer(uint32_t colorBuffer,
     fb->updateColorBuffer(colorBuffer, x, y, width, height, format, type, pixels);
 
     GRSYNC_DPRINT("unlock gralloc cb lock");
-    sGrallocSync->unlockColorBufferPrepare();
+    sGrallocSync->unlockColorBufferPrepare(colorBuffer);
 
     #ifdef KY_ENABLE_VULKAN
     // Update to Vulkan if necessary
@@ -1190,7 +1298,7 @@ static int rcUpdateColorBufferDMA(uint32_t colorBuffer,
 
     if (!fb) {
         GRSYNC_DPRINT("unlock gralloc cb lock");
-        sGrallocSync->unlockColorBufferPrepare();
+        sGrallocSync->unlockColorBufferPrepare(colorBuffer);
         return -1;
     }
     #ifdef KY_ENABLE_VULKAN
@@ -1202,7 +1310,7 @@ static int rcUpdateColorBufferDMA(uint32_t colorBuffer,
                           format, type, pixels);
 
     GRSYNC_DPRINT("unlock gralloc cb lock");
-    sGrallocSync->unlockColorBufferPrepare();
+    sGrallocSync->unlockColorBufferPrepare(colorBuffer);
      #ifdef KY_ENABLE_VULKAN
     // Update to Vulkan if necessary
     goldfish_vk::updateVkImageFromColorBuffer(colorBuffer);
@@ -1248,13 +1356,11 @@ static void rcTriggerWait(uint64_t eglsync_ptr,
         SyncThread::get()->triggerWait(0, timeline);
     }
 
-    FenceSync* fenceSync = (FenceSync*)(uintptr_t)eglsync_ptr;
     EGLSYNC_DPRINT("eglsync=0x%llx "
-                   "fenceSync=%p "
                    "thread_ptr=0x%llx "
                    "timeline=0x%llx",
-                   eglsync_ptr, fenceSync, thread_ptr, timeline);
-    SyncThread::get()->triggerWait(fenceSync, timeline);
+                   eglsync_ptr, thread_ptr, timeline);
+    SyncThread::get()->triggerWait(eglsync_ptr, timeline);
 }
 
 // |rcCreateSyncKHR| implements the guest's |eglCreateSyncKHR| by calling the
@@ -1280,8 +1386,8 @@ static void rcCreateSyncKHR(EGLenum type,
     // guaranteed, and we need to make sure
     // rcTriggerWait is registered.
     emugl_sync_register_trigger_wait(rcTriggerWait);
-    FenceSync* fenceSync = new FenceSync(hasNativeFence,
-                                         destroy_when_signaled);
+    FenceSync* fenceSync = FenceSync::create(hasNativeFence,
+                                             destroy_when_signaled);
 
     // This MUST be present, or we get a deadlock effect.
     s_gles2.glFlush();
@@ -1290,7 +1396,7 @@ static void rcCreateSyncKHR(EGLenum type,
         reinterpret_cast<uint64_t>(SyncThread::get());
 
     if (eglsync_out) {
-        uint64_t res = (uint64_t)(uintptr_t)fenceSync;
+        uint64_t res = fenceSync ? fenceSync->handle() : 0;
         *eglsync_out = res;
         EGLSYNC_DPRINT("send out eglsync 0x%llx", res);
     }
@@ -1330,6 +1436,11 @@ static EGLint rcClientWaitSyncKHR(uint64_t handle,
         // This context is then cleaned up when the render thread exits.
     }
 
+    if (!timeout) {
+        return fenceSync->wait(0);
+    }
+    // Only the GPU has to get there, so the decoding lock is kept.
+    ScopedBlockingWait blocking(false /* dropDecodeLock */);
     return fenceSync->wait(timeout);
 }
 
@@ -1595,6 +1706,8 @@ static void rcSetTracingForPuid(uint64_t puid, uint32_t enable, uint64_t time) {
 struct VirtualDisplay_t {
     uint32_t id;
     uint32_t bo_name;
+    int32_t width;
+    int32_t height;
     int32_t orientation;
 };
 
@@ -1604,6 +1717,8 @@ static void rcPostVirtualDisplay (const char* name, uint32_t id, uint32_t bo_nam
     VirtualDisplay_t display{
         id,
         bo_name,
+        width,
+        height,
         orientation,
     };
 
@@ -1618,10 +1733,25 @@ static void rcPostAllVirtualDisplaysDone() {
         return;
     }
 
-    for (auto display : virtual_display_ts) {
-        fb->post(display.id, display.bo_name, 540, 960, display.orientation, true);
+    // Only the last frame of each display in the batch is shown.
+    std::vector<FrameBuffer::DisplayPost> posts;
+    for (size_t i = 0; i < virtual_display_ts.size(); ++i) {
+        const VirtualDisplay_t& display = virtual_display_ts[i];
+        bool superseded = false;
+        for (size_t j = i + 1; j < virtual_display_ts.size(); ++j) {
+            if (virtual_display_ts[j].id == display.id) {
+                superseded = true;
+                break;
+            }
+        }
+        if (superseded) {
+            continue;
+        }
+        posts.push_back({static_cast<int>(display.id), display.bo_name,
+                         display.width, display.height, display.orientation});
     }
     virtual_display_ts.clear();
+    fb->postDisplays(posts);
     return ;
 }
 
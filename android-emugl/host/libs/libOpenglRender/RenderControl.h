@@ -18,7 +18,12 @@
 
 #include "renderControl_dec.h"
 
+#include <string>
+
 void initRenderControlContext(renderControl_decoder_context_t *dec);
 void registerTriggerWait();
 
+// Per color buffer gralloc lock statistics for the perf stats dump.
+std::string printGrallocSyncStats();
+
 #endif
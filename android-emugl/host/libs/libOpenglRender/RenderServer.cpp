@@ -16,6 +16,7 @@
 #include "RenderServer.h"
 #include "FrameBuffer.h"
 #include "RenderThread.h"
+#include "RenderWorkerPool.h"
 #include "UnixStream.h"
 #include <signal.h>
 #include <pthread.h>
@@ -100,6 +101,15 @@ intptr_t RenderServer::main() {
     sigfillset(&set);
     pthread_sigmask(SIG_SETMASK, &set, NULL);
 #endif
+    const int workerCount = RenderWorkerPool::getWorkerCountFromEnv();
+    if (workerCount > 0) {
+        m_workers.reset(new RenderWorkerPool(&m_lock, workerCount));
+        if (!m_workers->start()) {
+            fprintf(stderr,"Failed to start render workers, using a thread per connection\n");
+            m_workers.reset();
+        }
+    }
+
     int count = 1;
     while(1) {
         ChannelStream *stream = m_listenSock->accept();
@@ -146,6 +156,11 @@ intptr_t RenderServer::main() {
             delete stream;
             break;
         }
+        if (m_workers) {
+            m_workers->addConnection(stream);
+            continue;
+        }
+
         //syslog(LOG_DEBUG,"TTTT RenderThread::create count = %d",count);
         RenderThread *rt = RenderThread::create(stream, &m_lock);
         if (!rt) {
@@ -203,6 +218,7 @@ intptr_t RenderServer::main() {
         delete (*t);
     }
     threads.clear();
+    m_workers.reset();
 
     return 0;
 }
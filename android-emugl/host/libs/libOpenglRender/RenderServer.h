@@ -19,10 +19,13 @@
 #include "ChannelStream.h"
 #include "emugl/common/mutex.h"
 #include "emugl/common/thread.h"
+
+#include <memory>
 #define IOSTREAM_CLIENT_EXIT_SERVER      1
 namespace emugl {
     
 class    ChannelStream;
+class    RenderWorkerPool;
     
 class RenderServer : public emugl::Thread
 {
@@ -40,6 +43,9 @@ private:
 private:
     emugl::Mutex m_lock;
     ChannelStream *m_listenSock;
+    // Serves the connections when ANDROID_EMUGL_RENDER_WORKERS is set,
+    // instead of a RenderThread each.
+    std::unique_ptr<RenderWorkerPool> m_workers;
     bool m_exiting;
 };
 }  // namespace emugl
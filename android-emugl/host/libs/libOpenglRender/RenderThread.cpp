@@ -16,6 +16,7 @@
 #include "RenderThread.h"
 
 #include "ChannelStream.h"
+#include "DecodeAheadReader.h"
 #include "RingStream.h"
 #include "UnixStream.h"
 #include "ErrorLog.h"
@@ -65,6 +66,12 @@ static bool getBenchmarkEnabledFromEnv() {
     return false;
 }
 
+static bool getDecodeAheadEnabledFromEnv() {
+    auto decodeAhead = android::base::System::getEnvironmentVariable("ANDROID_EMUGL_RENDERTHREAD_DECODE_AHEAD");
+    if (decodeAhead == "1") return true;
+    return false;
+}
+
 static uint64_t currTimeUs(bool enable) {
     if (enable) {
         return android::base::System::get()->getHighResTimeUs();
@@ -254,6 +261,108 @@ RenderThread* RenderThread::create(ChannelStream *stream, emugl::Mutex *lock) {
     return new RenderThread(stream, lock);
 }
 
+size_t RenderThread::decodeCommands(RenderThreadInfo* tInfo,
+                                    ChecksumCalculator* checksumCalc,
+                                    IOStream* stream,
+                                    emugl::Mutex* lock,
+                                    unsigned char* buf,
+                                    size_t size,
+                                    bool* packetLen_error) {
+    size_t consumed = 0;
+    bool progress;
+    do {
+        progress = false;
+        lock->lock();
+        // try to process some of the command buffer using the GLESv1
+        // decoder
+        //
+        // DRIVER WORKAROUND:
+        // On Linux with NVIDIA GPU's at least, we need to avoid performing
+        // GLES ops while someone else holds the FrameBuffer write lock.
+        //
+        // To be more specific, on Linux with NVIDIA Quadro K2200 v361.xx,
+        // we get a segfault in the NVIDIA driver when glTexSubImage2D
+        // is called at the same time as glXMake(Context)Current.
+        //
+        // To fix, this driver workaround avoids calling
+        // any sort of GLES call when we are creating/destroying EGL
+        // contexts.
+        {                
+            FrameBuffer::getFB()->lockContextStructureRead();
+        }
+        int last;
+
+        {                
+            last = tInfo->m_glDec.decode(
+                    buf + consumed, size - consumed, stream, checksumCalc);
+            if (last > 0) {
+                progress = true;
+                consumed += last;
+            }
+            else if (last < 0)
+            {
+                *packetLen_error = true;
+            }
+            
+        }
+
+        //
+        // try to process some of the command buffer using the GLESv2
+        // decoder
+        //
+        {                
+            last = tInfo->m_gl2Dec.decode(buf + consumed, size - consumed,
+                                         stream, checksumCalc);
+
+            if (last > 0) {
+                progress = true;
+                consumed += last;
+            }
+            else if (last < 0)
+            {
+                *packetLen_error = true;
+            }
+            
+        }
+
+        FrameBuffer::getFB()->unlockContextStructureRead();
+        //
+        // try to process some of the command buffer using the
+        // renderControl decoder
+        //
+        {                
+            last = tInfo->m_rcDec.decode(buf + consumed, size - consumed,
+                                        stream, checksumCalc);
+            if (last > 0) {
+                consumed += last;
+                progress = true;
+            }
+            else if (last < 0)
+            {
+                *packetLen_error = true;
+            }
+            
+        }
+        lock->unlock();
+
+        #ifdef KY_ENABLE_VULKAN
+        //
+        // try to process some of the command buffer using the
+        // Vulkan decoder
+        //
+        {                
+            last = tInfo->m_vkDec.decode(buf + consumed, size - consumed,
+                                        ioStream);
+            if (last > 0) {
+                consumed += last;
+                progress = true;
+            }
+        }
+        #endif
+    } while (progress);
+    return consumed;
+}
+
 intptr_t RenderThread::main() {
     if (mFinished.load(std::memory_order_relaxed)) {
         DBG("Error: fail loading a RenderThread @%p\n", this);
@@ -261,6 +370,7 @@ intptr_t RenderThread::main() {
     }
 
     RenderThreadInfo tInfo;
+    tInfo.m_decodeLock = m_lock;
     ChecksumCalculatorThreadInfo tChecksumInfo;
     ChecksumCalculator& checksumCalc = tChecksumInfo.get();
     bool needRestoreFromSnapshot = false;
@@ -286,8 +396,47 @@ intptr_t RenderThread::main() {
     auto stats_t0 = android::base::System::get()->getHighResTimeUs() / 1000;
     bool benchmarkEnabled = getBenchmarkEnabledFromEnv();
 
+    // With decode-ahead, another thread receives and frames the packets
+    // while this one waits for its turn on the decoding lock.
+    std::unique_ptr<DecodeAheadReader> decodeAhead;
+    DecodeAheadReader::Batch batch;
+    uint64_t stats_dataWaitTimeUs = 0;
+    if (getDecodeAheadEnabledFromEnv()) {
+        decodeAhead.reset(new DecodeAheadReader(m_stream));
+        if (!decodeAhead->start()) {
+            ERR("RenderThread: could not start decode-ahead reader\n");
+            decodeAhead.reset();
+        }
+    }
+
     while (1) {
         bool packetLen_error = false;
+        if (decodeAhead) {
+            const auto waitStart = currTimeUs(benchmarkEnabled);
+            if (!decodeAhead->next(&batch)) {
+                D("Warning: render thread could not read data from stream");
+                break;
+            }
+            stats_dataWaitTimeUs += currTimeUs(benchmarkEnabled) - waitStart;
+
+            // Batches only hold complete packets, so the decoders stop short
+            // of the end only on an opcode none of them knows.
+            const size_t consumed =
+                    decodeCommands(&tInfo, &checksumCalc, m_stream, m_lock,
+                                   batch.data(), batch.size(),
+                                   &packetLen_error);
+            if (consumed < batch.size() && !packetLen_error) {
+                fprintf(stderr, "ERROR: RenderThread, unknown opcode %d\n",
+                        *(const int32_t*)(batch.data() + consumed));
+                packetLen_error = true;
+            }
+            if (packetLen_error) {
+                syslog(LOG_DEBUG,"ERROR: RenderThread, decode-ahead packet error");
+                break;
+            }
+            continue;
+        }
+
         // Let's make sure we read enough data for at least some processing
         int packetSize;
         if (readBuf.validData() >= 8) {
@@ -348,103 +497,30 @@ intptr_t RenderThread::main() {
 
         auto progressStart = currTimeUs(benchmarkEnabled);
         */
-        bool progress;
-        do {
-            progress = false;
-            m_lock->lock();
-            // try to process some of the command buffer using the GLESv1
-            // decoder
-            //
-            // DRIVER WORKAROUND:
-            // On Linux with NVIDIA GPU's at least, we need to avoid performing
-            // GLES ops while someone else holds the FrameBuffer write lock.
-            //
-            // To be more specific, on Linux with NVIDIA Quadro K2200 v361.xx,
-            // we get a segfault in the NVIDIA driver when glTexSubImage2D
-            // is called at the same time as glXMake(Context)Current.
-            //
-            // To fix, this driver workaround avoids calling
-            // any sort of GLES call when we are creating/destroying EGL
-            // contexts.
-            {                
-                FrameBuffer::getFB()->lockContextStructureRead();
-            }
-            int last;
-
-            {                
-                last = tInfo.m_glDec.decode(
-                        readBuf.buf(), readBuf.validData(), m_stream, &checksumCalc);
-                if (last > 0) {
-                    progress = true;
-                    readBuf.consume(last);
-                }
-                else if (last < 0)
-                {
-                    packetLen_error = true;
-                }
-                
-            }
-
-            //
-            // try to process some of the command buffer using the GLESv2
-            // decoder
-            //
-            {                
-                last = tInfo.m_gl2Dec.decode(readBuf.buf(), readBuf.validData(),
-                                             m_stream, &checksumCalc);
-
-                if (last > 0) {
-                    progress = true;
-                    readBuf.consume(last);
-                }
-                else if (last < 0)
-                {
-                    packetLen_error = true;
-                }
-                
-            }
-
-            FrameBuffer::getFB()->unlockContextStructureRead();
-            //
-            // try to process some of the command buffer using the
-            // renderControl decoder
-            //
-            {                
-                last = tInfo.m_rcDec.decode(readBuf.buf(), readBuf.validData(),
-                                            m_stream, &checksumCalc);
-                if (last > 0) {
-                    readBuf.consume(last);
-                    progress = true;
-                }
-                else if (last < 0)
-                {
-                    packetLen_error = true;
-                }
-                
-            }
-            m_lock->unlock();
-
-            #ifdef KY_ENABLE_VULKAN
-            //
-            // try to process some of the command buffer using the
-            // Vulkan decoder
-            //
-            {                
-                last = tInfo.m_vkDec.decode(readBuf.buf(), readBuf.validData(),
-                                            ioStream);
-                if (last > 0) {
-                    readBuf.consume(last);
-                    progress = true;
-                }
-            }
-            #endif
-        } while (progress);
+        readBuf.consume(decodeCommands(&tInfo, &checksumCalc, m_stream, m_lock,
+                                       readBuf.buf(), readBuf.validData(),
+                                       &packetLen_error));
         if(packetLen_error) {
             fprintf(stderr,"ERROR: RenderThread,readBuf get packetLen_error\n");
             syslog(LOG_DEBUG,"ERROR: RenderThread,readBuf get packetLen_error");
             break;
         }
     }
+    if (decodeAhead) {
+        if (benchmarkEnabled) {
+            printf("RenderThread: decode-ahead framed %llu packets in %llu "
+                   "batches (%llu bytes), waited %.3f ms for data\n",
+                   (unsigned long long)decodeAhead->packets(),
+                   (unsigned long long)decodeAhead->batches(),
+                   (unsigned long long)decodeAhead->bytes(),
+                   stats_dataWaitTimeUs / 1000.0);
+        }
+        // The reader may still be blocked on the socket if we bailed out.
+        decodeAhead->stop();
+        m_stream->forceStop();
+        decodeAhead.reset();
+    }
+
     /*if (dumpFP) {
         fclose(dumpFP);
     }*/
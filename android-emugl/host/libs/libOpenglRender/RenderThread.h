@@ -26,6 +26,10 @@
 #include <atomic>
 #include <memory>
 
+class ChecksumCalculator;
+class IOStream;
+struct RenderThreadInfo;
+
 namespace emugl {
 
 class RenderChannelImpl;
@@ -57,6 +61,17 @@ public:
     void resume();
     void save(android::base::Stream* stream);
     static RenderThread* create(ChannelStream* stream, emugl::Mutex* mutex);
+
+    // Runs the decoders of |tInfo| over |size| bytes of commands at |buf|,
+    // under |lock|, for as long as they make progress. Returns how much they
+    // consumed; |*packetLen_error| is set if a packet was malformed.
+    static size_t decodeCommands(RenderThreadInfo* tInfo,
+                                 ChecksumCalculator* checksumCalc,
+                                 IOStream* stream,
+                                 emugl::Mutex* lock,
+                                 unsigned char* buf,
+                                 size_t size,
+                                 bool* packetLen_error);
     unsigned long int gettid();
 private:
     virtual intptr_t main();
@@ -29,7 +29,7 @@ using android::base::Stream;
 
 static thread_local RenderThreadInfo* s_threadInfoPtr;
 
-RenderThreadInfo::RenderThreadInfo() {
+RenderThreadInfo::RenderThreadInfo() : m_colorBufferOwner(pthread_self()) {
     s_threadInfoPtr = this;
 }
 
@@ -41,6 +41,30 @@ RenderThreadInfo* RenderThreadInfo::get() {
     return s_threadInfoPtr;
 }
 
+void RenderThreadInfo::setCurrent(RenderThreadInfo* info) {
+    s_threadInfoPtr = info;
+}
+
+ScopedBlockingWait::ScopedBlockingWait(bool dropDecodeLock) {
+    RenderThreadInfo* const info = RenderThreadInfo::get();
+    if (!info) {
+        return;
+    }
+    if (info->m_beforeBlocking) {
+        info->m_beforeBlocking();
+    }
+    if (dropDecodeLock && info->m_decodeLock) {
+        mDroppedLock = info->m_decodeLock;
+        mDroppedLock->unlock();
+    }
+}
+
+ScopedBlockingWait::~ScopedBlockingWait() {
+    if (mDroppedLock) {
+        mDroppedLock->lock();
+    }
+}
+
 void RenderThreadInfo::onSave(Stream* stream) {
     if (currContext) {
         stream->putBe32(currContext->getHndl());
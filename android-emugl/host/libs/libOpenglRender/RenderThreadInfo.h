@@ -16,6 +16,7 @@
 #ifndef _LIB_OPENGL_RENDER_THREAD_INFO_H
 #define _LIB_OPENGL_RENDER_THREAD_INFO_H
 
+#include "android/base/Compiler.h"
 #include "android/base/files/Stream.h"
 #include "RenderContext.h"
 #include "WindowSurface.h"
@@ -26,8 +27,13 @@
 #include "StalePtrRegistry.h"
 #include "SyncThread.h"
 
+#include "emugl/common/mutex.h"
+
+#include <functional>
 #include <unordered_set>
 
+#include <pthread.h>
+
 typedef uint32_t HandleType;
 typedef std::unordered_set<HandleType> ThreadContextSet;
 typedef std::unordered_set<HandleType> WindowSurfaceSet;
@@ -45,6 +51,10 @@ struct RenderThreadInfo {
     // Return the current thread's instance, if any, or NULL.
     static RenderThreadInfo* get();
 
+    // Make |info| the current thread's instance. Render workers that serve
+    // several guest connections switch between their instances this way.
+    static void setCurrent(RenderThreadInfo* info);
+
     // Current EGL context, draw surface and read surface.
     RenderContextPtr currContext;
     WindowSurfacePtr currDrawSurf;
@@ -67,10 +77,39 @@ struct RenderThreadInfo {
     // The unique id of owner guest process of this render thread
     uint64_t                        m_puid = 0;
 
+    // The key FrameBuffer files the color buffers created here under, see
+    // FrameBuffer::closePthreadAloneColorBuffer(). The creating thread by
+    // default; render workers give each connection a key of its own.
+    pthread_t                       m_colorBufferOwner;
+
+    // The lock taken around decoding, see RenderThread::decodeCommands().
+    // Commands that wait for another guest connection drop it meanwhile.
+    emugl::Mutex*                   m_decodeLock = nullptr;
+
+    // Called on the thread decoding a command that is about to block. Set
+    // by render workers, which hand their other connections to another
+    // thread then, see RenderWorkerPool.
+    std::function<void()>           m_beforeBlocking;
+
     // Functions to save / load a snapshot
     // They must be called after Framebuffer snapshot
     void onSave(android::base::Stream* stream);
     bool onLoad(android::base::Stream* stream);
 };
 
+// Brackets a wait of a renderControl command. A render worker hands its
+// other connections to another thread first, see RenderWorkerPool. With
+// |dropDecodeLock|, other threads may decode meanwhile too; waits for
+// something only another guest connection can do, like unlocking a color
+// buffer, need that, or that connection could never be decoded.
+class ScopedBlockingWait {
+public:
+    explicit ScopedBlockingWait(bool dropDecodeLock);
+    ~ScopedBlockingWait();
+
+private:
+    emugl::Mutex* mDroppedLock = nullptr;
+    DISALLOW_COPY_ASSIGN_AND_MOVE(ScopedBlockingWait);
+};
+
 #endif
@@ -0,0 +1,608 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "RenderWorkerPool.h"
+
+#include "ChannelStream.h"
+#include "DispatchTables.h"
+#include "ErrorLog.h"
+#include "FrameBuffer.h"
+#include "ReadBuffer.h"
+#include "RenderControl.h"
+#include "RenderThread.h"
+#include "RenderThreadInfo.h"
+
+#include "OpenGLESDispatch/GLESv1Dispatch.h"
+#include "OpenGLESDispatch/GLESv2Dispatch.h"
+#include "../../../shared/OpenglCodecCommon/ChecksumCalculatorThreadInfo.h"
+
+#include "android/base/synchronization/ConditionVariable.h"
+#include "android/base/synchronization/Lock.h"
+#include "android/base/system/System.h"
+#include "android/base/threads/FunctorThread.h"
+
+#include "emugl/common/crash_reporter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using android::base::AutoLock;
+
+namespace emugl {
+
+// Start with a smaller buffer to not waste memory on a low-used connections.
+static constexpr int kStreamBufferSize = 128 * 1024;
+
+static constexpr int kMaxEvents = 64;
+
+static constexpr int kMaxWorkers = 64;
+
+// Threads a worker may have: the one serving the epoll set, the ones blocked
+// in a command of a connection that was handed off, and spare ones.
+static constexpr int kMaxThreadsPerWorker = 8;
+
+// How long a spare thread waits to take over the epoll set before it exits.
+static constexpr uint64_t kSpareThreadTimeoutUs = 10 * 1000 * 1000;
+
+namespace {
+
+// What a RenderThread keeps on its stack, for one guest connection.
+struct Connection {
+    explicit Connection(ChannelStream* stream)
+        : stream(stream), readBuf(kStreamBufferSize) {}
+
+    bool hasContext() const {
+        return tInfo.currContext || tInfo.currDrawSurf || tInfo.currReadSurf;
+    }
+
+    std::unique_ptr<ChannelStream> stream;
+    ReadBuffer readBuf;
+    // Both bind themselves to the thread that creates them.
+    RenderThreadInfo tInfo;
+    ChecksumCalculatorThreadInfo checksumInfo;
+    // Set while the thread decoding the connection is out of the epoll set,
+    // see Worker::handOff().
+    bool handedOff = false;
+};
+
+}  // namespace
+
+class RenderWorkerPool::Worker {
+public:
+    explicit Worker(emugl::Mutex* decodeLock) : mDecodeLock(decodeLock) {}
+
+    ~Worker() {
+        {
+            AutoLock lock(mLock);
+            mStopping = true;
+            mLeaderCv.broadcast();
+        }
+        if (mWakeFd >= 0) {
+            wake();
+        }
+        // Threads blocked in a command of a handed off connection finish it
+        // and close the connection themselves.
+        for (;;) {
+            std::unique_ptr<android::base::FunctorThread> thread;
+            {
+                AutoLock lock(mLock);
+                if (!mExited.empty()) {
+                    thread = std::move(mExited.back());
+                    mExited.pop_back();
+                } else if (!mThreads.empty()) {
+                    thread = std::move(mThreads.begin()->second);
+                    mThreads.erase(mThreads.begin());
+                } else {
+                    break;
+                }
+            }
+            thread->wait();
+        }
+        for (ChannelStream* stream : mPending) {
+            delete stream;
+        }
+        for (Connection* conn : mReturned) {
+            delete conn;
+        }
+        if (mWakeFd >= 0) {
+            ::close(mWakeFd);
+        }
+        if (mEpollFd >= 0) {
+            ::close(mEpollFd);
+        }
+    }
+
+    bool start() {
+        mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        mWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (mEpollFd < 0 || mWakeFd < 0) {
+            ERR("RenderWorkerPool: epoll setup failed: %s\n", strerror(errno));
+            return false;
+        }
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeFd, &event) < 0) {
+            ERR("RenderWorkerPool: epoll setup failed: %s\n", strerror(errno));
+            return false;
+        }
+        AutoLock lock(mLock);
+        return startThreadLocked(true /* leader */);
+    }
+
+    void addConnection(ChannelStream* stream) {
+        mConnectionCount.fetch_add(1, std::memory_order_relaxed);
+        {
+            AutoLock lock(mLock);
+            mPending.push_back(stream);
+        }
+        wake();
+    }
+
+    int connectionCount() const {
+        return mConnectionCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    void wake() {
+        const uint64_t one = 1;
+        if (::write(mWakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+            ERR("RenderWorkerPool: wake failed: %s\n", strerror(errno));
+        }
+    }
+
+    // Starts a thread that serves the epoll set right away if |leader|, or
+    // waits as a spare otherwise. Must be called with |mLock| held.
+    bool startThreadLocked(bool leader) {
+        const int id = mNextThreadId++;
+        std::unique_ptr<android::base::FunctorThread> thread(
+                new android::base::FunctorThread(
+                        [this, id, leader] { threadMain(id, leader); }));
+        if (!thread->start()) {
+            return false;
+        }
+        mThreads.emplace(id, std::move(thread));
+        return true;
+    }
+
+    void threadMain(int id, bool leader) {
+        // Framebuffer initialization is asynchronous, so we need to make
+        // sure it's completely initialized before running any GL commands.
+        FrameBuffer::waitUntilInitialized();
+        while (leader || waitForLeadership()) {
+            leader = false;
+            if (!loop()) {
+                break;
+            }
+        }
+        RenderThreadInfo::setCurrent(nullptr);
+        ChecksumCalculatorThreadInfo::setCurrent(nullptr);
+
+        // The thread serving the epoll set joins this one.
+        {
+            AutoLock lock(mLock);
+            auto it = mThreads.find(id);
+            if (it != mThreads.end()) {
+                mExited.push_back(std::move(it->second));
+                mThreads.erase(it);
+            }
+        }
+        wake();
+    }
+
+    // Waits as a spare thread until the epoll set needs a new thread.
+    // Returns false if the worker stops or nobody needed this thread for
+    // kSpareThreadTimeoutUs.
+    bool waitForLeadership() {
+        AutoLock lock(mLock);
+        ++mSpareThreads;
+        const uint64_t deadlineUs =
+                android::base::System::get()->getUnixTimeUs() +
+                kSpareThreadTimeoutUs;
+        while (!mLeaderWanted && !mStopping) {
+            if (!mLeaderCv.timedWait(&mLock, deadlineUs) && !mLeaderWanted) {
+                break;
+            }
+        }
+        --mSpareThreads;
+        if (!mLeaderWanted || mStopping) {
+            return false;
+        }
+        mLeaderWanted = false;
+        return true;
+    }
+
+    // Serves the connections in the epoll set. Returns true when this
+    // thread handed the set to another one while decoding a connection,
+    // false once the worker stops.
+    bool loop() {
+        epoll_event events[kMaxEvents];
+        for (;;) {
+            const int count = epoll_wait(mEpollFd, events, kMaxEvents, -1);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ERR("RenderWorkerPool: epoll_wait failed: %s\n",
+                    strerror(errno));
+                break;
+            }
+            bool stopping = false;
+            for (int i = 0; i < count; ++i) {
+                if (events[i].data.ptr) {
+                    if (!serve(static_cast<Connection*>(events[i].data.ptr))) {
+                        // Another thread has the epoll set now; the events
+                        // left are still pending there.
+                        return true;
+                    }
+                } else {
+                    stopping = takePending();
+                }
+            }
+            if (stopping) {
+                break;
+            }
+        }
+
+        {
+            AutoLock lock(mLock);
+            for (Connection* conn : mReturned) {
+                mConnections.emplace(conn, std::unique_ptr<Connection>(conn));
+            }
+            mReturned.clear();
+        }
+        while (!mConnections.empty()) {
+            closeConnection(mConnections.begin()->first);
+        }
+        return false;
+    }
+
+    // Opens the connections that were handed over since the last call and
+    // takes back the ones whose blocking command is done. Returns true if
+    // the worker is being stopped.
+    bool takePending() {
+        uint64_t value;
+        while (::read(mWakeFd, &value, sizeof(value)) > 0) {}
+
+        std::vector<ChannelStream*> pending;
+        std::vector<Connection*> returned;
+        std::vector<std::unique_ptr<android::base::FunctorThread>> exited;
+        {
+            AutoLock lock(mLock);
+            if (mStopping) {
+                return true;
+            }
+            pending.swap(mPending);
+            returned.swap(mReturned);
+            exited.swap(mExited);
+        }
+        for (auto& thread : exited) {
+            thread->wait();
+        }
+        for (Connection* conn : returned) {
+            mConnections.emplace(conn, std::unique_ptr<Connection>(conn));
+            watchConnection(conn);
+        }
+        for (ChannelStream* stream : pending) {
+            openConnection(stream);
+        }
+        return false;
+    }
+
+    void openConnection(ChannelStream* stream) {
+        auto conn = new Connection(stream);
+        // The new connection's thread infos are bound now, but it has no
+        // context yet: whatever is current on this thread is someone else's.
+        if (mBound && mBound->hasContext()) {
+            restoreContext();
+        }
+        mBound = conn;
+        conn->tInfo.m_colorBufferOwner = (pthread_t)(uintptr_t)conn;
+        conn->tInfo.m_decodeLock = mDecodeLock;
+        conn->tInfo.m_beforeBlocking = [this, conn] { handOff(conn); };
+        conn->tInfo.m_glDec.initGL(gles1_dispatch_get_proc_func, nullptr);
+        conn->tInfo.m_gl2Dec.initGL(gles2_dispatch_get_proc_func, nullptr);
+        initRenderControlContext(&conn->tInfo.m_rcDec);
+
+        mConnections.emplace(conn, std::unique_ptr<Connection>(conn));
+        watchConnection(conn);
+    }
+
+    // Adds |conn|, which is in |mConnections|, to the epoll set.
+    void watchConnection(Connection* conn) {
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.ptr = conn;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, conn->stream->getSocket(),
+                      &event) < 0) {
+            ERR("RenderWorkerPool: can't watch connection: %s\n",
+                strerror(errno));
+            closeConnection(conn);
+        }
+    }
+
+    // Makes |conn| the connection the GL and decoder state of this thread
+    // belongs to.
+    void switchTo(Connection* conn) {
+        RenderThreadInfo::setCurrent(&conn->tInfo);
+        ChecksumCalculatorThreadInfo::setCurrent(&conn->checksumInfo);
+        if (mBound == conn) {
+            return;
+        }
+        // Nothing to do if neither the last connection nor this one has
+        // anything current.
+        if (conn->hasContext() || (mBound && mBound->hasContext())) {
+            restoreContext();
+        }
+        mBound = conn;
+    }
+
+    // Makes the context of the connection switched to current. Like
+    // rcMakeCurrent, this happens under the decoding lock.
+    void restoreContext() {
+        mDecodeLock->lock();
+        FrameBuffer::getFB()->restoreContext();
+        mDecodeLock->unlock();
+    }
+
+    // Called on the thread decoding |conn| when one of its commands is
+    // about to block, e.g. on a color buffer another connection has locked.
+    // That connection may well be one of this worker's, so the others can't
+    // wait for this one: |conn| leaves the epoll set and a spare or new
+    // thread takes the set over. This thread returns |conn| once it is done
+    // with the packets at hand, see returnConnection(). With
+    // kMaxThreadsPerWorker threads busy already, the other connections wait.
+    void handOff(Connection* conn) {
+        if (conn->handedOff) {
+            return;
+        }
+        AutoLock lock(mLock);
+        if (mStopping) {
+            return;
+        }
+        const bool haveSpare = mSpareThreads > 0;
+        if (!haveSpare && (int)mThreads.size() >= kMaxThreadsPerWorker) {
+            if (!mWarnedThreadLimit) {
+                ERR("RenderWorkerPool: all %d threads busy, blocking the "
+                    "worker\n", kMaxThreadsPerWorker);
+                mWarnedThreadLimit = true;
+            }
+            return;
+        }
+        // Done before the next thread runs, which then owns these.
+        epoll_ctl(mEpollFd, EPOLL_CTL_DEL, conn->stream->getSocket(), nullptr);
+        auto it = mConnections.find(conn);
+        it->second.release();
+        mConnections.erase(it);
+        // The next thread has nothing current yet.
+        Connection* const bound = mBound;
+        mBound = nullptr;
+        conn->handedOff = true;
+
+        if (haveSpare) {
+            mLeaderWanted = true;
+            mLeaderCv.signal();
+        } else if (!startThreadLocked(true /* leader */)) {
+            ERR("RenderWorkerPool: can't start a thread, blocking the "
+                "worker\n");
+            conn->handedOff = false;
+            mBound = bound;
+            mConnections.emplace(conn, std::unique_ptr<Connection>(conn));
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.ptr = conn;
+            epoll_ctl(mEpollFd, EPOLL_CTL_ADD, conn->stream->getSocket(),
+                      &event);
+        }
+    }
+
+    // Called on the thread |conn| was handed off with, once the packets it
+    // was decoding are done. Gives |conn| back to the thread serving the
+    // epoll set, or closes it if |close| or if the worker is stopping.
+    void returnConnection(Connection* conn, bool close) {
+        {
+            AutoLock lock(mLock);
+            close = close || mStopping;
+        }
+        if (close) {
+            releaseConnection(conn);
+            RenderThreadInfo::setCurrent(nullptr);
+            ChecksumCalculatorThreadInfo::setCurrent(nullptr);
+            delete conn;
+            mConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+        // A context can only be current on one thread. This leaves the
+        // connection's state alone; it is made current again when the
+        // connection is served next.
+        if (conn->hasContext()) {
+            s_egl.eglMakeCurrent(FrameBuffer::getFB()->getDisplay(),
+                                 EGL_NO_SURFACE, EGL_NO_SURFACE,
+                                 EGL_NO_CONTEXT);
+        }
+        RenderThreadInfo::setCurrent(nullptr);
+        ChecksumCalculatorThreadInfo::setCurrent(nullptr);
+        {
+            AutoLock lock(mLock);
+            conn->handedOff = false;
+            mReturned.push_back(conn);
+        }
+        wake();
+    }
+
+    // Returns false if there is a bad packet at the head of |readBuf|.
+    static bool checkPacket(ReadBuffer& readBuf) {
+        if (readBuf.validData() < 8) {
+            return true;
+        }
+        // We know that packet size is the second int32_t from the start.
+        const int32_t packetSize = *(const int32_t*)(readBuf.buf() + 4);
+        if (!packetSize) {
+            // Same as RenderThread: the decoders would get live-stuck on it.
+            emugl::emugl_crash_reporter(
+                    "Guest should never send a size-0 GL packet\n");
+        }
+        if (packetSize < 8 || packetSize <= (int)readBuf.validData()) {
+            // A complete packet that no decoder takes would never go.
+            ERR("RenderWorkerPool: bad packet, opcode %d size %d\n",
+                *(const int32_t*)readBuf.buf(), packetSize);
+            return false;
+        }
+        return true;
+    }
+
+    // Decodes what the guest has sent on |conn| so far. Returns false if
+    // |conn| was handed off meanwhile and this thread no longer serves the
+    // epoll set.
+    bool serve(Connection* conn) {
+        ReadBuffer& readBuf = conn->readBuf;
+        int available = 0;
+        if (ioctl(conn->stream->getSocket(), FIONREAD, &available) < 0 ||
+            available <= 0) {
+            // Readable with nothing to read: the guest has hung up.
+            closeConnection(conn);
+            return true;
+        }
+        // The data is there already, so this doesn't block.
+        if (readBuf.getData(conn->stream.get(),
+                            readBuf.validData() + available) <= 0) {
+            closeConnection(conn);
+            return true;
+        }
+
+        switchTo(conn);
+        bool packetLen_error = false;
+        readBuf.consume(RenderThread::decodeCommands(
+                &conn->tInfo, &conn->checksumInfo.get(), conn->stream.get(),
+                mDecodeLock, readBuf.buf(), readBuf.validData(),
+                &packetLen_error));
+        bool bad = false;
+        if (packetLen_error) {
+            ERR("RenderWorkerPool: packet length error, closing connection\n");
+            bad = true;
+        } else if (!checkPacket(readBuf)) {
+            bad = true;
+        }
+        if (conn->handedOff) {
+            returnConnection(conn, bad);
+            return false;
+        }
+        if (bad) {
+            closeConnection(conn);
+        }
+        return true;
+    }
+
+    void closeConnection(Connection* conn) {
+        epoll_ctl(mEpollFd, EPOLL_CTL_DEL, conn->stream->getSocket(), nullptr);
+        switchTo(conn);
+        releaseConnection(conn);
+        mBound = nullptr;
+        mConnections.erase(conn);
+        mConnectionCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Releases what the guest left behind on |conn|, which must be the
+    // connection this thread is switched to.
+    static void releaseConnection(Connection* conn) {
+        if (FrameBuffer::getFB()->isShuttingDown()) {
+            return;
+        }
+        // Release references to the connection's context/surfaces if any
+        FrameBuffer::getFB()->bindContext(0, 0, 0);
+        if (conn->hasContext()) {
+            ERR("RenderWorkerPool: closing a connection with current "
+                "context/surfaces\n");
+        }
+        FrameBuffer::getFB()->drainWindowSurface();
+        FrameBuffer::getFB()->drainRenderContext();
+        FrameBuffer::getFB()->closePthreadAloneColorBuffer(
+                conn->tInfo.m_colorBufferOwner);
+    }
+
+    emugl::Mutex* mDecodeLock;
+    int mEpollFd = -1;
+    int mWakeFd = -1;
+
+    android::base::Lock mLock;
+    std::vector<ChannelStream*> mPending;
+    // Handed off connections whose blocking command is done.
+    std::vector<Connection*> mReturned;
+    bool mStopping = false;
+    // Threads of this worker by id; at most one serves the epoll set at a
+    // time. Exited ones wait in |mExited| to be joined.
+    std::unordered_map<int, std::unique_ptr<android::base::FunctorThread>>
+            mThreads;
+    std::vector<std::unique_ptr<android::base::FunctorThread>> mExited;
+    int mNextThreadId = 0;
+    int mSpareThreads = 0;
+    // Set to have a spare thread take over the epoll set.
+    bool mLeaderWanted = false;
+    android::base::ConditionVariable mLeaderCv;
+    bool mWarnedThreadLimit = false;
+
+    std::atomic<int> mConnectionCount{0};
+
+    // Only touched by the thread serving the epoll set.
+    std::unordered_map<Connection*, std::unique_ptr<Connection>> mConnections;
+    // The connection whose context is current on that thread.
+    Connection* mBound = nullptr;
+};
+
+RenderWorkerPool::RenderWorkerPool(emugl::Mutex* decodeLock, int workerCount) {
+    for (int i = 0; i < workerCount; ++i) {
+        mWorkers.emplace_back(new Worker(decodeLock));
+    }
+}
+
+RenderWorkerPool::~RenderWorkerPool() = default;
+
+bool RenderWorkerPool::start() {
+    for (auto& worker : mWorkers) {
+        if (!worker->start()) {
+            return false;
+        }
+    }
+    return !mWorkers.empty();
+}
+
+void RenderWorkerPool::addConnection(ChannelStream* stream) {
+    const auto worker = std::min_element(
+            mWorkers.begin(), mWorkers.end(),
+            [](const std::unique_ptr<Worker>& a,
+               const std::unique_ptr<Worker>& b) {
+                return a->connectionCount() < b->connectionCount();
+            });
+    (*worker)->addConnection(stream);
+}
+
+// static
+int RenderWorkerPool::getWorkerCountFromEnv() {
+    const std::string workers = android::base::System::getEnvironmentVariable(
+            "ANDROID_EMUGL_RENDER_WORKERS");
+    return std::max(0, std::min(atoi(workers.c_str()), kMaxWorkers));
+}
+
+}  // namespace emugl
@@ -0,0 +1,80 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#pragma once
+
+#include "android/base/Compiler.h"
+
+#include "emugl/common/mutex.h"
+
+#include <memory>
+#include <vector>
+
+namespace emugl {
+
+class ChannelStream;
+
+// Serves guest connections on a fixed number of worker threads instead of
+// a RenderThread per connection.
+//
+// Android opens a connection per process and per HWUI thread, and most of
+// them sit idle. Each worker parks its connections in an epoll set and
+// decodes the commands of whichever ones have data, one turn each: a turn
+// takes what has arrived on the socket and decodes the complete packets in
+// it. epoll hands ready connections out round-robin, so a busy one can't
+// starve the others.
+//
+// A connection stays on the worker it was given, so its EGL context is
+// never current on two threads. When a worker moves on to a connection that
+// has a different context, or one of them has a context at all, it makes
+// that connection's context current again.
+//
+// Some renderControl commands block, e.g. posting a color buffer that an
+// app connection has locked, until another connection's commands are
+// decoded. Before such a command blocks, the connection leaves the epoll
+// set and a spare or new thread takes over the worker's other connections;
+// the blocked thread puts the connection back once it is done with the
+// packets at hand and becomes a spare itself. A worker has at most a few
+// threads, spare ones exit when they stay unused. Unless
+// ANDROID_EMUGL_RENDER_WORKERS is set, there is still a RenderThread per
+// connection.
+class RenderWorkerPool {
+public:
+    // |decodeLock| is the lock RenderThreads take around decoding, which
+    // the workers share with them.
+    RenderWorkerPool(emugl::Mutex* decodeLock, int workerCount);
+
+    // Closes the remaining connections and stops the workers.
+    ~RenderWorkerPool();
+
+    bool start();
+
+    // Hands |stream| to the worker with the fewest connections, which takes
+    // ownership of it.
+    void addConnection(ChannelStream* stream);
+
+    // The number of workers ANDROID_EMUGL_RENDER_WORKERS asks for, or 0 for
+    // a RenderThread per connection.
+    static int getWorkerCountFromEnv();
+
+private:
+    class Worker;
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    DISALLOW_COPY_ASSIGN_AND_MOVE(RenderWorkerPool);
+};
+
+}  // namespace emugl
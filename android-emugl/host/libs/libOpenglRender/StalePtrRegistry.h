@@ -15,128 +15,234 @@
 */
 #pragma once
 
-#include "android/base/containers/Lookup.h"
 #include "android/base/files/Stream.h"
 #include "android/base/files/StreamSerializing.h"
 #include "android/base/synchronization/Lock.h"
 #include "android/base/Compiler.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <unordered_map>
-
-// The purpose of StalePtrRegistry is to track integers corresponding to
-// host-side pointers that may be invalidated after snapshots.
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The purpose of StalePtrRegistry is to own host-side objects that the guest
+// refers to by 64-bit handles, and to make sure that handles from before a
+// snapshot load never resolve to objects created after it.
+//
+// Objects live in slabs of fixed-size slots that are allocated on demand and
+// never freed, so creating and destroying objects doesn't hit malloc once the
+// slots are there. A handle is the slot index in the low 32 bits and a
+// serial number in the high 32 bits, and a slot remembers the handle it was
+// last given out under. Resolving a handle is thus a lookup in the slab table
+// plus a single atomic load to validate it, without taking any lock; only
+// adding and removing objects lock the free list.
+//
+// Since the slot memory stays valid, a handle that is resolved while another
+// thread removes its object yields a destroyed object rather than freed
+// memory; the objects' own reference counting is what prevents that.
 template <class T>
 class StalePtrRegistry {
 public:
-    StalePtrRegistry() = default;
+    static constexpr uint32_t kSlabSize = 256;
+    static constexpr uint32_t kMaxSlabs = 4096;
+    static constexpr uint32_t kMaxObjects = kSlabSize * kMaxSlabs;
 
-    void addPtr(T* ptr) {
-        android::base::AutoWriteLock lock(mLock);
-        mPtrs[asHandle(ptr)] = { ptr, Staleness::Live };
-    }
+    StalePtrRegistry() = default;
 
-    void removePtr(T* ptr) {
-        android::base::AutoWriteLock lock(mLock);
-        uint64_t handle = asHandle(ptr);
-        mPtrs.erase(handle);
+    ~StalePtrRegistry() {
+        // Objects that are still alive are leaked, not destroyed.
+        for (auto& slab : mSlabs) {
+            delete slab.load(std::memory_order_relaxed);
+        }
     }
 
-    void remapStalePtr(uint64_t handle, T* newptr) {
-        android::base::AutoWriteLock lock(mLock);
-        mPtrs[handle] = { newptr, Staleness::PrevSnapshot };
+    // Constructs a T from |args| in a free slot and gives it a new handle.
+    // Returns nullptr if all kMaxObjects slots are in use.
+    template <class... Args>
+    T* add(Args&&... args) {
+        Slot* slot = allocateSlot();
+        if (!slot) {
+            return nullptr;
+        }
+        T* ptr = new (&slot->storage) T(std::forward<Args>(args)...);
+        slot->handle.store(makeHandle(nextSerial(), slot->index),
+                           std::memory_order_release);
+        return ptr;
     }
 
-    T* getPtr(uint64_t handle, T* defaultPtr = nullptr,
-              bool removeFromStaleOnGet = false) {
-        android::base::AutoReadLock lock(mLock);
-
-        // return |defaultPtr| if not found.
-        T* res = defaultPtr;
+    // Destroys |ptr|, which must come from add(). Its handle stops resolving
+    // before the destructor runs.
+    void remove(T* ptr) {
+        Slot* slot = slotOf(ptr);
+        slot->handle.store(0, std::memory_order_release);
+        ptr->~T();
 
-        Entry* it = nullptr;
+        android::base::AutoLock lock(mLock);
+        slot->nextFree = mFirstFree;
+        mFirstFree = slot->index;
+    }
 
-        if ((it = android::base::find(mPtrs, handle)))
-            res = it->ptr;
+    // Returns the handle of |ptr|, or 0 if it doesn't resolve anymore
+    // because a snapshot was loaded since it was added.
+    uint64_t getHandle(const T* ptr) const {
+        return slotOf(ptr)->handle.load(std::memory_order_acquire);
+    }
 
-        if (removeFromStaleOnGet &&
-            it && it->staleness == Staleness::PrevSnapshot) {
-            lock.unlockRead();
-            android::base::AutoWriteLock wrlock(mLock);
-            mPtrs.erase(handle);
+    // Returns the object behind |handle|, or nullptr if it's unknown, was
+    // removed or is from before a snapshot load.
+    T* getPtr(uint64_t handle) const {
+        const uint32_t index = static_cast<uint32_t>(handle);
+        if (!handle || index >= kMaxObjects) {
+            return nullptr;
         }
+        Slab* slab =
+                mSlabs[index / kSlabSize].load(std::memory_order_acquire);
+        if (!slab) {
+            return nullptr;
+        }
+        Slot& slot = slab->slots[index % kSlabSize];
+        if (slot.handle.load(std::memory_order_acquire) != handle) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(&slot.storage);
+    }
 
-        return res;
+    size_t numLiveEntries() const {
+        android::base::AutoLock lock(mLock);
+        size_t count = 0;
+        forEachSlot([&count](Slot& slot) {
+            if (slot.handle.load(std::memory_order_relaxed)) {
+                ++count;
+            }
+        });
+        return count;
     }
 
-    void makeCurrentPtrsStale() {
-        android::base::AutoWriteLock lock(mLock);
-        for (auto& it : mPtrs) {
-            it.second.staleness =
-                Staleness::PrevSnapshot;
+    void onSave(android::base::Stream* stream) {
+        std::vector<uint64_t> handles;
+        {
+            android::base::AutoLock lock(mLock);
+            forEachSlot([&handles](Slot& slot) {
+                if (const uint64_t handle =
+                            slot.handle.load(std::memory_order_relaxed)) {
+                    handles.push_back(handle);
+                }
+            });
         }
+        saveCollection(stream, handles,
+                       [](android::base::Stream* stream, uint64_t handle) {
+                           stream->putBe64(handle);
+                       });
     }
 
-    size_t numCurrEntries() const {
-        return countWithStaleness(Staleness::Live);
-    }
+    // After a load, the saved handles don't resolve to anything and new
+    // handles don't collide with them. Objects that are alive right now keep
+    // resolving, so their owners can still release them; one that happens to
+    // hold a saved handle is moved to a new serial instead.
+    void onLoad(android::base::Stream* stream) {
+        // The format is the one saveCollection() writes.
+        std::vector<uint64_t> saved(stream->getBe32());
+        uint32_t maxSerial = 0;
+        for (auto& handle : saved) {
+            handle = stream->getBe64();
+            maxSerial = std::max(maxSerial, serialOf(handle));
+        }
+        std::sort(saved.begin(), saved.end());
 
-    size_t numStaleEntries() const {
-        return countWithStaleness(Staleness::PrevSnapshot);
+        android::base::AutoLock lock(mLock);
+        if (maxSerial > mNextSerial.load(std::memory_order_relaxed)) {
+            mNextSerial.store(maxSerial, std::memory_order_relaxed);
+        }
+        forEachSlot([this, &saved](Slot& slot) {
+            const uint64_t handle = slot.handle.load(std::memory_order_relaxed);
+            if (handle &&
+                std::binary_search(saved.begin(), saved.end(), handle)) {
+                slot.handle.store(makeHandle(nextSerial(), slot.index),
+                                  std::memory_order_release);
+            }
+        });
     }
 
-    void onSave(android::base::Stream* stream) {
-        android::base::AutoReadLock lock(mLock);
-        saveCollection(
-                stream, mPtrs,
-                [](android::base::Stream* stream,
-                   const std::pair<uint64_t, Entry>& entry) {
-                    stream->putBe64(entry.first);
-                });
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        std::atomic<uint64_t> handle{0};
+        uint32_t index = 0;
+        uint32_t nextFree = kNoSlot;
+    };
+
+    struct Slab {
+        Slot slots[kSlabSize];
+    };
+
+    static uint64_t makeHandle(uint32_t serial, uint32_t index) {
+        return (uint64_t(serial) << 32) | index;
     }
 
-    void onLoad(android::base::Stream* stream) {
-        android::base::AutoWriteLock lock(mLock);
-        loadCollection(
-                stream, &mPtrs,
-                [](android::base::Stream* stream) {
-                    uint64_t handle = stream->getBe64();
-                    return std::make_pair(
-                               handle,
-                               (Entry){ nullptr, Staleness::PrevSnapshot });
-                });
+    static uint32_t serialOf(uint64_t handle) {
+        return static_cast<uint32_t>(handle >> 32);
     }
-private:
-    static uint64_t asHandle(const T* ptr) {
-        return (uint64_t)(uintptr_t)ptr;
+
+    static Slot* slotOf(const T* ptr) {
+        // |storage| is the first member of Slot.
+        return reinterpret_cast<Slot*>(const_cast<T*>(ptr));
     }
 
-    static T* asPtr(uint64_t handle) {
-        return (T*)(uintptr_t)handle;
+    // Serial 0 is never used, so that no handle is 0.
+    uint32_t nextSerial() {
+        uint32_t serial;
+        do {
+            serial = ++mNextSerial;
+        } while (!serial);
+        return serial;
     }
 
-    enum class Staleness {
-        Live,
-        PrevSnapshot,
-    };
-    struct Entry {
-        T* ptr;
-        Staleness staleness;
-    };
+    Slot* allocateSlot() {
+        android::base::AutoLock lock(mLock);
+        if (mFirstFree != kNoSlot) {
+            Slot* slot = slotAt(mFirstFree);
+            mFirstFree = slot->nextFree;
+            return slot;
+        }
+        if (mNumSlots == kMaxObjects) {
+            return nullptr;
+        }
+        const uint32_t index = mNumSlots++;
+        if (index % kSlabSize == 0) {
+            Slab* slab = new Slab;
+            for (uint32_t i = 0; i < kSlabSize; ++i) {
+                slab->slots[i].index = index + i;
+            }
+            mSlabs[index / kSlabSize].store(slab, std::memory_order_release);
+        }
+        return slotAt(index);
+    }
 
-    using PtrMap = std::unordered_map<uint64_t, Entry>;
+    Slot* slotAt(uint32_t index) const {
+        return &mSlabs[index / kSlabSize]
+                        .load(std::memory_order_relaxed)
+                        ->slots[index % kSlabSize];
+    }
 
-    size_t countWithStaleness(Staleness check) const {
-        android::base::AutoReadLock lock(mLock);
-        return std::count_if(mPtrs.begin(), mPtrs.end(),
-                   [check](const typename PtrMap::value_type& entry) {
-                       return entry.second.staleness == check;
-                   });
+    // Requires |mLock|.
+    template <class Func>
+    void forEachSlot(Func&& func) const {
+        for (uint32_t i = 0; i < mNumSlots; ++i) {
+            func(*slotAt(i));
+        }
     }
 
-    mutable android::base::ReadWriteLock mLock;
-    PtrMap mPtrs;
+    std::atomic<Slab*> mSlabs[kMaxSlabs] = {};
+    std::atomic<uint32_t> mNextSerial{0};
+
+    mutable android::base::Lock mLock;
+    uint32_t mNumSlots = 0;
+    uint32_t mFirstFree = kNoSlot;
 
     DISALLOW_COPY_AND_ASSIGN(StalePtrRegistry);
 };
@@ -0,0 +1,134 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+// Measures the fence churn of a guest that creates a sync object per frame
+// and polls it a few times before destroying it, as rcCreateSyncKHR,
+// rcIsSyncSignaled and rcDestroySyncKHR do, from several render threads at
+// once. "Map" is what StalePtrRegistry used to be: pointers as handles, in an
+// unordered_map behind a read-write lock.
+
+#include "StalePtrRegistry.h"
+
+#include "android/base/containers/Lookup.h"
+#include "android/base/synchronization/Lock.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace {
+
+constexpr int kPollsPerFence = 4;
+
+// Stands in for FenceSync, which needs an EGL display.
+struct Fence {
+    std::atomic<int> count{1};
+    uint64_t sync = 0;
+};
+
+class MapRegistry {
+public:
+    Fence* add() {
+        Fence* fence = new Fence;
+        android::base::AutoWriteLock lock(mLock);
+        mPtrs[(uint64_t)(uintptr_t)fence] = fence;
+        return fence;
+    }
+
+    void remove(Fence* fence) {
+        {
+            android::base::AutoWriteLock lock(mLock);
+            mPtrs.erase((uint64_t)(uintptr_t)fence);
+        }
+        delete fence;
+    }
+
+    uint64_t getHandle(const Fence* fence) const {
+        return (uint64_t)(uintptr_t)fence;
+    }
+
+    Fence* getPtr(uint64_t handle) const {
+        android::base::AutoReadLock lock(mLock);
+        Fence* const* fence = android::base::find(mPtrs, handle);
+        return fence ? *fence : nullptr;
+    }
+
+private:
+    mutable android::base::ReadWriteLock mLock;
+    std::unordered_map<uint64_t, Fence*> mPtrs;
+};
+
+template <class Registry>
+void churn(benchmark::State& state, Registry* registry) {
+    for (auto _ : state) {
+        Fence* fence = registry->add();
+        const uint64_t handle = registry->getHandle(fence);
+        for (int i = 0; i < kPollsPerFence; ++i) {
+            benchmark::DoNotOptimize(registry->getPtr(handle));
+        }
+        registry->remove(fence);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Each benchmark keeps a few fences alive for the whole run, as the guest's
+// swap chain fences are.
+template <class Registry>
+void polls(benchmark::State& state, Registry* registry) {
+    Fence* fences[8];
+    uint64_t handles[8];
+    for (int i = 0; i < 8; ++i) {
+        fences[i] = registry->add();
+        handles[i] = registry->getHandle(fences[i]);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry->getPtr(handles[i++ % 8]));
+    }
+    for (Fence* fence : fences) {
+        registry->remove(fence);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+StalePtrRegistry<Fence> sSlabRegistry;
+MapRegistry sMapRegistry;
+
+void BM_FenceChurn_Slab(benchmark::State& state) {
+    churn(state, &sSlabRegistry);
+}
+
+void BM_FenceChurn_Map(benchmark::State& state) {
+    churn(state, &sMapRegistry);
+}
+
+void BM_FencePoll_Slab(benchmark::State& state) {
+    polls(state, &sSlabRegistry);
+}
+
+void BM_FencePoll_Map(benchmark::State& state) {
+    polls(state, &sMapRegistry);
+}
+
+BENCHMARK(BM_FenceChurn_Slab)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_FenceChurn_Map)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_FencePoll_Slab)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_FencePoll_Map)->ThreadRange(1, 8)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -77,7 +77,7 @@ SyncThread::~SyncThread() {
     cleanup();
 }
 
-void SyncThread::triggerWait(FenceSync* fenceSync,
+void SyncThread::triggerWait(uint64_t fenceSync,
                              uint64_t timeline) {
     DPRINT("fenceSyncInfo=0x%llx timeline=0x%lx ...",
             fenceSync, timeline);
@@ -90,7 +90,7 @@ void SyncThread::triggerWait(FenceSync* fenceSync,
     DPRINT("exit");
 }
 
-void SyncThread::triggerBlockedWaitNoTimeline(FenceSync* fenceSync) {
+void SyncThread::triggerBlockedWaitNoTimeline(uint64_t fenceSync) {
     DPRINT("fenceSyncInfo=0x%llx timeline=0x%lx ...",
             fenceSync, timeline);
     SyncThreadCmd to_send;
@@ -206,8 +206,7 @@ void SyncThread::doSyncContextInit() {
 void SyncThread::doSyncWait(SyncThreadCmd* cmd) {
     DPRINT("enter");
 
-    FenceSync* fenceSync =
-        FenceSync::getFromHandle((uint64_t)(uintptr_t)cmd->fenceSync);
+    FenceSync* fenceSync = FenceSync::getFromHandle(cmd->fenceSync);
 
     if (!fenceSync) {
         emugl::emugl_sync_timeline_inc(cmd->timeline, kTimelineInterval);
@@ -216,8 +215,8 @@ void SyncThread::doSyncWait(SyncThreadCmd* cmd) {
 
     EGLint wait_result = 0x0;
 
-    DPRINT("wait on sync obj: %p", cmd->fenceSync);
-    wait_result = cmd->fenceSync->wait(kDefaultTimeoutNsecs);
+    DPRINT("wait on sync obj: %p", fenceSync);
+    wait_result = fenceSync->wait(kDefaultTimeoutNsecs);
 
     DPRINT("done waiting, with wait result=0x%x. "
            "increment timeline (and signal fence)",
@@ -265,8 +264,7 @@ void SyncThread::doSyncWait(SyncThreadCmd* cmd) {
 void SyncThread::doSyncBlockedWaitNoTimeline(SyncThreadCmd* cmd) {
     DPRINT("enter");
 
-    FenceSync* fenceSync =
-        FenceSync::getFromHandle((uint64_t)(uintptr_t)cmd->fenceSync);
+    FenceSync* fenceSync = FenceSync::getFromHandle(cmd->fenceSync);
 
     if (!fenceSync) {
         return;
@@ -274,8 +272,8 @@ void SyncThread::doSyncBlockedWaitNoTimeline(SyncThreadCmd* cmd) {
 
     EGLint wait_result = 0x0;
 
-    DPRINT("wait on sync obj: %p", cmd->fenceSync);
-    wait_result = cmd->fenceSync->wait(kDefaultTimeoutNsecs);
+    DPRINT("wait on sync obj: %p", fenceSync);
+    wait_result = fenceSync->wait(kDefaultTimeoutNsecs);
 
     DPRINT("done waiting, with wait result=0x%x. "
            "increment timeline (and signal fence)",
@@ -50,7 +50,8 @@ enum SyncThreadOpCode {
 struct SyncThreadCmd {
     SyncThreadOpCode opCode = SYNC_THREAD_INIT;
     bool needReply = false;
-    FenceSync* fenceSync = nullptr;
+    // Handle of the FenceSync object, see FenceSync::getFromHandle().
+    uint64_t fenceSync = 0;
     uint64_t timeline = 0;
 };
 
@@ -69,12 +70,12 @@ public:
     // which should signal the guest-side fence FD.
     // This method is how the goldfish sync virtual device
     // knows when to increment timelines / signal native fence FD's.
-    void triggerWait(FenceSync* fenceSync,
+    void triggerWait(uint64_t fenceSync,
                      uint64_t timeline);
 
     // for use with the virtio-gpu path; is meant to have a current context
     // while waiting.
-    void triggerBlockedWaitNoTimeline(FenceSync* fenceSync);
+    void triggerBlockedWaitNoTimeline(uint64_t fenceSync);
 
     // |cleanup|: for use with destructors and other cleanup functions.
     // it destroys the sync context and exits the sync thread.
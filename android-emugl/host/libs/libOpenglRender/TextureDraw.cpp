@@ -15,15 +15,29 @@
 #include "TextureDraw.h"
 
 #include "DispatchTables.h"
+#include "GLErrorCheck.h"
 
+#include "android/base/memory/ScopedPtr.h"
 #include "emugl/common/crash_reporter.h"
 #include <syslog.h>
+#include <algorithm>
 #include <string>
 #include <assert.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #define ERR(...)  fprintf(stderr, __VA_ARGS__)
 
+static void checkGlError(const char* function, const char* what) {
+    if (!shouldCheckPostGlErrors()) {
+        return;
+    }
+    GLenum err = s_gles2.glGetError();
+    if (err != GL_NO_ERROR) {
+        ERR("%s: Could not %s error=0x%x\n", function, what, err);
+    }
+}
+
 namespace {
 
 // Helper function to create a new shader.
@@ -172,6 +186,78 @@ const GLubyte kIndices[] = {
 const GLint kIndicesLen = sizeof(kIndices) / sizeof(kIndices[0]);
 const GLint kIndicesPerDraw = 6;
 
+// Batched composition: layers are turned into quads in framebuffer space
+// on the CPU, so that any number of them can go in one draw. |slot| is 0
+// for solid color layers, else 1 + the texture unit to sample; |color| is
+// what the texel (or 1 for solid colors) gets multiplied by.
+const char kBatchVertexShaderSource[] =
+    "attribute vec2 position;\n"
+    "attribute vec2 inCoord;\n"
+    "attribute vec4 color;\n"
+    "attribute float slot;\n"
+    "varying vec2 outCoord;\n"
+    "varying vec4 outColor;\n"
+    "varying float outSlot;\n"
+
+    "void main(void) {\n"
+    "  gl_Position = vec4(position, 0.0, 1.0);\n"
+    "  outCoord = inCoord;\n"
+    "  outColor = color;\n"
+    "  outSlot = slot;\n"
+    "}\n";
+
+// Samplers can only be indexed with constants in GLSL ES 1.00.
+const char kBatchFragmentShaderSource[] =
+    "precision mediump float;\n"
+    "varying vec2 outCoord;\n"
+    "varying vec4 outColor;\n"
+    "varying float outSlot;\n"
+    "uniform sampler2D tex[8];\n"
+
+    "void main(void) {\n"
+    "  if (outSlot < 0.5) {\n"
+    "    gl_FragColor = outColor;\n"
+    "  } else if (outSlot < 1.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[0], outCoord);\n"
+    "  } else if (outSlot < 2.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[1], outCoord);\n"
+    "  } else if (outSlot < 3.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[2], outCoord);\n"
+    "  } else if (outSlot < 4.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[3], outCoord);\n"
+    "  } else if (outSlot < 5.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[4], outCoord);\n"
+    "  } else if (outSlot < 6.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[5], outCoord);\n"
+    "  } else if (outSlot < 7.5) {\n"
+    "    gl_FragColor = outColor * texture2D(tex[6], outCoord);\n"
+    "  } else {\n"
+    "    gl_FragColor = outColor * texture2D(tex[7], outCoord);\n"
+    "  }\n"
+    "}\n";
+
+// Index of the kVertices quad drawLayer() uses for |transform|.
+int transformQuad(hwc_transform_t transform) {
+    switch (transform) {
+        case HWC_TRANSFORM_ROT_90:
+            return 1;
+        case HWC_TRANSFORM_ROT_180:
+            return 2;
+        case HWC_TRANSFORM_ROT_270:
+            return 3;
+        case HWC_TRANSFORM_FLIP_H:
+            return 4;
+        case HWC_TRANSFORM_FLIP_V:
+            return 5;
+        case HWC_TRANSFORM_FLIP_H_ROT_90:
+            return 6;
+        case HWC_TRANSFORM_FLIP_V_ROT_90:
+            return 7;
+        default:
+            return 0;
+    }
+}
+
 }  // namespace
 
 TextureDraw::TextureDraw()
@@ -194,6 +280,25 @@ TextureDraw::TextureDraw()
       mClipWidthRatio(0),
       mClipHeightRatio(0),
       mShouldReallocateTexture(true) {
+    // GL objects are created lazily by initGL() on the first draw, so that
+    // building the FrameBuffer does not pay for the shader compilation.
+}
+
+bool TextureDraw::initGL() {
+    if (mGLInitialized.load(std::memory_order_acquire)) {
+        return mProgram != 0;
+    }
+    android::base::AutoLock lock(mInitLock);
+    if (mGLInitialized.load(std::memory_order_relaxed)) {
+        return mProgram != 0;
+    }
+    // Set on every exit path, including failure, so that a broken program
+    // is not rebuilt on every frame.
+    auto markInitialized = android::base::makeCustomScopedPtr(
+            &mGLInitialized, [](std::atomic<bool>* flag) {
+                flag->store(true, std::memory_order_release);
+            });
+
     // Create shaders and program.
     mVertexShader = createShader(GL_VERTEX_SHADER, kVertexShaderSource);
     mFragmentShader = createShader(GL_FRAGMENT_SHADER, kFragmentShaderSource);
@@ -212,7 +317,7 @@ TextureDraw::TextureDraw()
         ERR("%s: Could not create/link program: %s\n", __FUNCTION__, messages);
         s_gles2.glDeleteProgram(mProgram);
         mProgram = 0;
-        return;
+        return false;
     }
 
     s_gles2.glUseProgram(mProgram);
@@ -237,7 +342,7 @@ TextureDraw::TextureDraw()
     s_gles2.glUniform1f(mAlpha, 1.0);
     s_gles2.glUniform1i(mComposeMode, 2);
     s_gles2.glUniform2f(mTranslationSlot, 0.0, 0.0);
-    s_gles2.glUniform2f(mScaleSlot, 1.0, 1.0);
+    setScale(1.0, 1.0);
     s_gles2.glUniform2f(mCoordTranslation, 0.0, 0.0);
     s_gles2.glUniform2f(mCoordScale, 1.0, 1.0);
 
@@ -273,10 +378,17 @@ TextureDraw::TextureDraw()
 
     // Create a texture handle for use with an overlay mask
     s_gles2.glGenTextures(1, &mMaskTexture);
+    return true;
+}
+
+void TextureDraw::setScale(GLfloat x, GLfloat y) {
+    mScale[0] = x;
+    mScale[1] = y;
+    s_gles2.glUniform2f(mScaleSlot, x, y);
 }
 
 bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, bool wantOverlay, float clipWidthRatio, float clipHeightRatio) {
-    if (!mProgram) {
+    if (!initGL()) {
         ERR("%s: no program\n", __FUNCTION__);
         return false;
     }
@@ -285,13 +397,7 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
 
     s_gles2.glUseProgram(mProgram);
 
-#ifndef NDEBUG
-    GLenum err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not use program error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "use program");
 
     // Setup the |position| attribute values.
     if ((clipWidthRatio > 0) && (clipHeightRatio > 0)) {
@@ -313,13 +419,7 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
         s_gles2.glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
     }
 
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not bind GL_ARRAY_BUFFER error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "bind GL_ARRAY_BUFFER");
 
     s_gles2.glEnableVertexAttribArray(mPositionSlot);
     s_gles2.glVertexAttribPointer(mPositionSlot,
@@ -329,13 +429,7 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
                                   sizeof(Vertex),
                                   0);
 
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could glVertexAttribPointer with mPositionSlot error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "glVertexAttribPointer with mPositionSlot");
 
     // Setup the |inCoord| attribute values.
     s_gles2.glEnableVertexAttribArray(mInCoordSlot);
@@ -356,29 +450,23 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
     // setup the |translation| uniform value.
     s_gles2.glUniform2f(mTranslationSlot, dx, dy);
 
-#ifndef NDEBUG
-    // Validate program, just to be sure.
-    s_gles2.glValidateProgram(mProgram);
-    GLint validState = 0;
-    s_gles2.glGetProgramiv(mProgram, GL_VALIDATE_STATUS, &validState);
-    if (validState == GL_FALSE) {
-        GLchar messages[256] = {};
-        s_gles2.glGetProgramInfoLog(
-                mProgram, sizeof(messages), 0, &messages[0]);
-        ERR("%s: Could not run program: '%s'\n", __FUNCTION__, messages);
-        return false;
+    if (shouldCheckPostGlErrors()) {
+        // Validate program, just to be sure.
+        s_gles2.glValidateProgram(mProgram);
+        GLint validState = 0;
+        s_gles2.glGetProgramiv(mProgram, GL_VALIDATE_STATUS, &validState);
+        if (validState == GL_FALSE) {
+            GLchar messages[256] = {};
+            s_gles2.glGetProgramInfoLog(
+                    mProgram, sizeof(messages), 0, &messages[0]);
+            ERR("%s: Could not run program: '%s'\n", __FUNCTION__, messages);
+            return false;
+        }
     }
-#endif
 
     // Do the rendering.
     s_gles2.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not glBindBuffer(GL_ELEMENT_ARRAY_BUFFER) error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "glBindBuffer(GL_ELEMENT_ARRAY_BUFFER)");
 
     // We may only get 0, 90, 180, 270 in |rotation| so far.
     const int intRotation = ((int)rotation)/90;
@@ -403,18 +491,14 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
                            (const GLvoid*)indexShift);
 
     bool shouldDrawMask = false;
-    GLfloat scale[2];
-    s_gles2.glGetUniformfv(mProgram, mScaleSlot, scale);
+    const GLfloat* scale = mScale;
     GLfloat overlayScale[2];
     {
         android::base::AutoLock lock(mMaskLock);
         if (wantOverlay && mHaveNewMask) {
             // Create a texture from the mask image and make it
-            // available to be blended
-            GLint prevUnpackAlignment;
-            s_gles2.glGetIntegerv(GL_UNPACK_ALIGNMENT, &prevUnpackAlignment);
-            s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
+            // available to be blended. Its RGBA rows are always 4 byte
+            // aligned, so the unpack alignment in place does not matter.
             s_gles2.glBindTexture(GL_TEXTURE_2D, mMaskTexture);
 
             s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -441,8 +525,6 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
             s_gles2.glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             s_gles2.glEnable(GL_BLEND);
 
-            s_gles2.glPixelStorei(GL_UNPACK_ALIGNMENT, prevUnpackAlignment);
-
             mHaveNewMask = false;
             mMaskIsValid = true;
         }
@@ -470,13 +552,7 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
         s_gles2.glUniform2f(mScaleSlot, scale[0], scale[1]);
     }
 
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not glDrawElements() error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "glDrawElements()");
 
     // TODO(digit): Restore previous program state.
     // For now, reset back to zero and assume other users will
@@ -491,6 +567,9 @@ bool TextureDraw::drawImpl(GLuint texture, float rotation, float dx, float dy, b
 }
 
 TextureDraw::~TextureDraw() {
+    if (!mGLInitialized.load(std::memory_order_acquire)) {
+        return;
+    }
     s_gles2.glDeleteBuffers(1, &mIndexBuffer);
     s_gles2.glDeleteBuffers(1, &mVertexBuffer);
     s_gles2.glDeleteBuffers(1, &mVertexBufferClip);
@@ -505,10 +584,221 @@ TextureDraw::~TextureDraw() {
     if (mMaskTexture) {
         s_gles2.glDeleteTextures(1, &mMaskTexture);
     }
+    if (mBatchProgram) {
+        s_gles2.glDeleteProgram(mBatchProgram);
+        s_gles2.glDeleteBuffers(1, &mBatchVertexBuffer);
+    }
+}
+
+bool TextureDraw::initBatchGL() {
+    if (mBatchInitialized) {
+        return mBatchProgram != 0;
+    }
+    mBatchInitialized = true;
+    if (!initGL()) {
+        return false;
+    }
+
+    GLuint vertexShader =
+            createShader(GL_VERTEX_SHADER, kBatchVertexShaderSource);
+    GLuint fragmentShader =
+            createShader(GL_FRAGMENT_SHADER, kBatchFragmentShaderSource);
+    if (!vertexShader || !fragmentShader) {
+        s_gles2.glDeleteShader(vertexShader);
+        s_gles2.glDeleteShader(fragmentShader);
+        return false;
+    }
+    GLuint program = s_gles2.glCreateProgram();
+    s_gles2.glAttachShader(program, vertexShader);
+    s_gles2.glAttachShader(program, fragmentShader);
+    s_gles2.glLinkProgram(program);
+    // The program keeps them alive as long as it needs them.
+    s_gles2.glDeleteShader(vertexShader);
+    s_gles2.glDeleteShader(fragmentShader);
+
+    GLint success = GL_FALSE;
+    s_gles2.glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE) {
+        GLchar messages[256] = {};
+        s_gles2.glGetProgramInfoLog(program, sizeof(messages), 0,
+                                    &messages[0]);
+        ERR("%s: Could not create/link program: %s\n", __FUNCTION__,
+            messages);
+        s_gles2.glDeleteProgram(program);
+        return false;
+    }
+
+    mBatchPositionSlot = s_gles2.glGetAttribLocation(program, "position");
+    mBatchInCoordSlot = s_gles2.glGetAttribLocation(program, "inCoord");
+    mBatchColorSlot = s_gles2.glGetAttribLocation(program, "color");
+    mBatchTextureSlot = s_gles2.glGetAttribLocation(program, "slot");
+
+    GLint units[kMaxBatchTextures];
+    for (int i = 0; i < kMaxBatchTextures; ++i) {
+        units[i] = i;
+    }
+    s_gles2.glUseProgram(program);
+    s_gles2.glUniform1iv(s_gles2.glGetUniformLocation(program, "tex"),
+                         kMaxBatchTextures, units);
+    s_gles2.glUseProgram(0);
+
+    s_gles2.glGenBuffers(1, &mBatchVertexBuffer);
+    mBatchProgram = program;
+    return true;
+}
+
+int TextureDraw::drawLayers(const ComposeLayer* layers,
+                            const LayerSource* sources,
+                            int count,
+                            int frameWidth,
+                            int frameHeight) {
+    if (!initBatchGL()) {
+        return -1;
+    }
+
+    // Build the quads of every layer, and split them into draws.
+    mBatchVertices.clear();
+    mBatches.clear();
+    for (int i = 0; i < count; ++i) {
+        const ComposeLayer* l = &layers[i];
+        if (l->composeMode != HWC2_COMPOSITION_DEVICE &&
+            l->composeMode != HWC2_COMPOSITION_SOLID_COLOR) {
+            ERR("%s: invalid composition mode %d", __FUNCTION__,
+                l->composeMode);
+            continue;
+        }
+        if (l->blendMode != HWC2_BLEND_MODE_NONE &&
+            l->blendMode != HWC2_BLEND_MODE_PREMULTIPLIED) {
+            ERR("%s: invalid blendMode %d", __FUNCTION__, l->blendMode);
+            continue;
+        }
+        const bool blend = l->blendMode == HWC2_BLEND_MODE_PREMULTIPLIED;
+        const GLuint texture = l->composeMode == HWC2_COMPOSITION_DEVICE
+                                       ? sources[i].texture
+                                       : 0;
+
+        if (mBatches.empty() || mBatches.back().blend != blend) {
+            mBatches.push_back({(GLint)mBatchVertices.size(), 0, blend, 0,
+                                {}});
+        }
+        float slot = 0;
+        if (texture) {
+            Batch* batch = &mBatches.back();
+            int unit = 0;
+            while (unit < batch->numTextures &&
+                   batch->textures[unit] != texture) {
+                ++unit;
+            }
+            if (unit == kMaxBatchTextures) {
+                mBatches.push_back({(GLint)mBatchVertices.size(), 0, blend,
+                                    0, {}});
+                batch = &mBatches.back();
+                unit = 0;
+            }
+            if (unit == batch->numTextures) {
+                batch->textures[batch->numTextures++] = texture;
+            }
+            slot = unit + 1;
+        }
+
+        // Same mapping as drawLayer() does with its uniforms.
+        const float left = -1 + 2.0f * l->displayFrame.left / frameWidth;
+        const float top = -1 + 2.0f * l->displayFrame.top / frameHeight;
+        const float right = -1 + 2.0f * l->displayFrame.right / frameWidth;
+        const float bottom = -1 + 2.0f * l->displayFrame.bottom / frameHeight;
+        const float cropLeft = l->crop.left / sources[i].width;
+        const float cropTop = l->crop.top / sources[i].height;
+        const float cropRight = l->crop.right / sources[i].width;
+        const float cropBottom = l->crop.bottom / sources[i].height;
+
+        BatchVertex color;
+        if (texture) {
+            color.color[0] = color.color[1] = color.color[2] =
+                    color.color[3] = l->alpha;
+        } else {
+            color.color[0] = l->alpha * l->color.r / 255.0f;
+            color.color[1] = l->alpha * l->color.g / 255.0f;
+            color.color[2] = l->alpha * l->color.b / 255.0f;
+            color.color[3] = l->alpha * l->color.a / 255.0f;
+        }
+
+        const Vertex* quad = &kVertices[4 * transformQuad(l->transform)];
+        for (int j = 0; j < kIndicesPerDraw; ++j) {
+            const Vertex& v = quad[kIndices[j]];
+            BatchVertex out = color;
+            out.pos[0] = v.pos[0] > 0 ? right : left;
+            out.pos[1] = v.pos[1] > 0 ? top : bottom;
+            out.coord[0] = cropLeft + v.coord[0] * (cropRight - cropLeft);
+            out.coord[1] = cropBottom + v.coord[1] * (cropTop - cropBottom);
+            out.slot = slot;
+            mBatchVertices.push_back(out);
+        }
+        mBatches.back().count += kIndicesPerDraw;
+    }
+
+    s_gles2.glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (mBatchVertices.empty()) {
+        return 0;
+    }
+
+    s_gles2.glUseProgram(mBatchProgram);
+    s_gles2.glBindBuffer(GL_ARRAY_BUFFER, mBatchVertexBuffer);
+    s_gles2.glBufferData(GL_ARRAY_BUFFER,
+                         mBatchVertices.size() * sizeof(BatchVertex),
+                         mBatchVertices.data(), GL_STREAM_DRAW);
+    const GLsizei stride = sizeof(BatchVertex);
+    s_gles2.glEnableVertexAttribArray(mBatchPositionSlot);
+    s_gles2.glVertexAttribPointer(
+            mBatchPositionSlot, 2, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<GLvoid*>(offsetof(BatchVertex, pos)));
+    s_gles2.glEnableVertexAttribArray(mBatchInCoordSlot);
+    s_gles2.glVertexAttribPointer(
+            mBatchInCoordSlot, 2, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<GLvoid*>(offsetof(BatchVertex, coord)));
+    s_gles2.glEnableVertexAttribArray(mBatchColorSlot);
+    s_gles2.glVertexAttribPointer(
+            mBatchColorSlot, 4, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<GLvoid*>(offsetof(BatchVertex, color)));
+    s_gles2.glEnableVertexAttribArray(mBatchTextureSlot);
+    s_gles2.glVertexAttribPointer(
+            mBatchTextureSlot, 1, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<GLvoid*>(offsetof(BatchVertex, slot)));
+    s_gles2.glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    int maxUnits = 0;
+    for (const Batch& batch : mBatches) {
+        for (int unit = 0; unit < batch.numTextures; ++unit) {
+            s_gles2.glActiveTexture(GL_TEXTURE0 + unit);
+            s_gles2.glBindTexture(GL_TEXTURE_2D, batch.textures[unit]);
+        }
+        maxUnits = std::max(maxUnits, batch.numTextures);
+        if (batch.blend) {
+            s_gles2.glEnable(GL_BLEND);
+        } else {
+            s_gles2.glDisable(GL_BLEND);
+        }
+        s_gles2.glDrawArrays(GL_TRIANGLES, batch.first, batch.count);
+    }
+    checkGlError(__FUNCTION__, "glDrawArrays()");
+
+    // Leave the state prepareForDrawLayer() / drawImpl() expect.
+    for (int unit = maxUnits - 1; unit >= 0; --unit) {
+        s_gles2.glActiveTexture(GL_TEXTURE0 + unit);
+        s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    s_gles2.glEnable(GL_BLEND);
+    s_gles2.glDisableVertexAttribArray(mBatchPositionSlot);
+    s_gles2.glDisableVertexAttribArray(mBatchInCoordSlot);
+    s_gles2.glDisableVertexAttribArray(mBatchColorSlot);
+    s_gles2.glDisableVertexAttribArray(mBatchTextureSlot);
+    s_gles2.glBindBuffer(GL_ARRAY_BUFFER, 0);
+    s_gles2.glUseProgram(0);
+    return (int)mBatches.size();
 }
 
 void TextureDraw::setScreenMask(int width, int height, const unsigned char* rgbaData) {
     android::base::AutoLock lock(mMaskLock);
+    ++mMaskSerial;
     if (width <= 0 || height <= 0 || rgbaData == nullptr) {
         mMaskIsValid = false;
         return;
@@ -528,35 +818,17 @@ void TextureDraw::setScreenMask(int width, int height, const unsigned char* rgba
 }
 
 void TextureDraw::prepareForDrawLayer() {
-    if (!mProgram) {
+    if (!initGL()) {
         ERR("%s: no program\n", __FUNCTION__);
         return;
     }
     s_gles2.glUseProgram(mProgram);
-#ifndef NDEBUG
-    GLenum err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not use program error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "use program");
 
     s_gles2.glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not bind GL_ARRAY_BUFFER error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "bind GL_ARRAY_BUFFER");
     s_gles2.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not glBindBuffer(GL_ELEMENT_ARRAY_BUFFER) error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "glBindBuffer(GL_ELEMENT_ARRAY_BUFFER)");
 
     s_gles2.glEnableVertexAttribArray(mPositionSlot);
     s_gles2.glVertexAttribPointer(mPositionSlot,
@@ -575,13 +847,7 @@ void TextureDraw::prepareForDrawLayer() {
                                   reinterpret_cast<GLvoid*>(
                                         static_cast<uintptr_t>(
                                                 sizeof(float) * 3)));
-#ifndef NDEBUG
-    err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could glVertexAttribPointer with mPositionSlot error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "glVertexAttribPointer with mPositionSlot");
 
    // set composition default
     s_gles2.glUniform1i(mComposeMode, 2);
@@ -647,8 +913,7 @@ void TextureDraw::drawLayer(ComposeLayer* l, int frameWidth, int frameHeight,
     // setup the |translation| uniform value.
     s_gles2.glUniform2f(mTranslationSlot, (-edges[2] - edges[0])/2,
                         (-edges[3] - edges[1])/2);
-    s_gles2.glUniform2f(mScaleSlot, (edges[2] - edges[0])/2,
-                        (edges[1] - edges[3])/2);
+    setScale((edges[2] - edges[0])/2, (edges[1] - edges[3])/2);
     s_gles2.glUniform2f(mCoordTranslation, crop[0], crop[3]);
     s_gles2.glUniform2f(mCoordScale, crop[2] - crop[0], crop[1] - crop[3]);
 
@@ -680,13 +945,7 @@ void TextureDraw::drawLayer(ComposeLayer* l, int frameWidth, int frameHeight,
     }
     s_gles2.glDrawElements(GL_TRIANGLES, kIndicesPerDraw, GL_UNSIGNED_BYTE,
                            (const GLvoid*)indexShift);
-#ifndef NDEBUG
-    GLenum err = s_gles2.glGetError();
-    if (err != GL_NO_ERROR) {
-        ERR("%s: Could not glDrawElements() error=0x%x\n",
-            __FUNCTION__, err);
-    }
-#endif
+    checkGlError(__FUNCTION__, "glDrawElements()");
 
     // restore the default value for the next draw layer
     if (l->composeMode != HWC2_COMPOSITION_DEVICE) {
@@ -704,7 +963,7 @@ void TextureDraw::cleanupForDrawLayer() {
     s_gles2.glUniform1f(mAlpha, 1.0);
     s_gles2.glUniform1i(mComposeMode, HWC2_COMPOSITION_DEVICE);
     s_gles2.glUniform2f(mTranslationSlot, 0.0, 0.0);
-    s_gles2.glUniform2f(mScaleSlot, 1.0, 1.0);
+    setScale(1.0, 1.0);
     s_gles2.glUniform2f(mCoordTranslation, 0.0, 0.0);
     s_gles2.glUniform2f(mCoordScale, 1.0, 1.0);
 }
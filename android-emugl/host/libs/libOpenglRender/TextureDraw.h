@@ -22,11 +22,16 @@
 #include "android/base/synchronization/Lock.h"
 #include "emugl/common/mutex.h"
 
+#include <atomic>
+#include <vector>
+
 
 // Helper class used to draw a simple texture to the current framebuffer.
 // Usage is pretty simple:
 //
-//   1) Create a TextureDraw instance.
+//   1) Create a TextureDraw instance. This does not touch GL; the program
+//      is built in the context current at the first draw, which must share
+//      with the contexts of all later draws.
 //
 //   2) Each time you want to draw a texture, call draw(texture, rotation),
 //      where |texture| is the name of a GLES 2.x texture object, and
@@ -56,34 +61,65 @@ public:
     }
 
     void setScreenMask(int width, int height, const unsigned char* rgbaData);
+    // Bumped whenever the overlay changes.
+    uint64_t getScreenMaskSerial() const { return mMaskSerial.load(); }
     void drawLayer(ComposeLayer* l, int frameWidth, int frameHeight,
                    int cbWidth, int cbHeight, GLuint texture);
     void prepareForDrawLayer();
     void cleanupForDrawLayer();
 
+    // Texture and size of the buffer behind a layer passed to drawLayers();
+    // |texture| is ignored for solid color layers.
+    struct LayerSource {
+        GLuint texture;
+        int width;
+        int height;
+    };
+    // Clears the bound framebuffer of |frameWidth| x |frameHeight| and
+    // composes |count| layers into it like drawLayer() does, in as few
+    // draws as possible: a draw covers consecutive layers with the same
+    // blend mode and up to kMaxBatchTextures different textures. Returns
+    // the number of draws, or -1 if the batch program is unavailable and
+    // drawLayer() must be used instead. Only called on the post thread.
+    int drawLayers(const ComposeLayer* layers, const LayerSource* sources,
+                   int count, int frameWidth, int frameHeight);
+
 private:
+    // Create the program and buffers in the current context. Runs once;
+    // returns false if the program could not be built.
+    bool initGL();
+
     bool drawImpl(GLuint texture, float rotationDegrees, float dx, float dy, bool wantOverlay, 
         float clipWidthRatio = 0, float clipHeightRatio = 0);
 
+    // Sets the |scale| uniform, keeping a copy so that it never has to be
+    // read back from the GPU.
+    void setScale(GLfloat x, GLfloat y);
+
+    bool initBatchGL();
+
+    emugl::Mutex mInitLock;
+    std::atomic<bool> mGLInitialized{false};
     GLuint mVertexShader;
     GLuint mFragmentShader;
     GLuint mProgram;
-    GLint mAlpha;
-    GLint mComposeMode;
-    GLint mColor;
+    GLint mAlpha = -1;
+    GLint mComposeMode = -1;
+    GLint mColor = -1;
     GLint mCoordTranslation;
     GLint mCoordScale;
     GLint mPositionSlot;
     GLint mInCoordSlot;
     GLint mScaleSlot;
+    GLfloat mScale[2] = {1.0f, 1.0f};
     GLint mTextureSlot;
     GLint mTranslationSlot;
-    GLuint mVertexBuffer;
-    GLuint mVertexBufferClip;
+    GLuint mVertexBuffer = 0;
+    GLuint mVertexBufferClip = 0;
     float *mClipVertexData;
     float mClipWidthRatio;
     float mClipHeightRatio;
-    GLuint mIndexBuffer;
+    GLuint mIndexBuffer = 0;
 
     emugl::Mutex mMaskLock;
     GLuint mMaskTexture;
@@ -99,6 +135,32 @@ private:
     // The size of mMaskPixels are always of size mMaskWidth * mMaskHeight * 4 bytes
     std::vector<unsigned char> mMaskPixels;
     bool   mBlendResetNeeded = false;
+    std::atomic<uint64_t> mMaskSerial{0};
+
+    // drawLayers() state, only touched on the post thread.
+    static constexpr int kMaxBatchTextures = 8;
+    struct BatchVertex {
+        float pos[2];
+        float coord[2];
+        float color[4];
+        float slot;
+    };
+    struct Batch {
+        GLint first;
+        GLsizei count;
+        bool blend;
+        int numTextures;
+        GLuint textures[kMaxBatchTextures];
+    };
+    bool mBatchInitialized = false;
+    GLuint mBatchProgram = 0;
+    GLuint mBatchVertexBuffer = 0;
+    GLint mBatchPositionSlot = -1;
+    GLint mBatchInCoordSlot = -1;
+    GLint mBatchColorSlot = -1;
+    GLint mBatchTextureSlot = -1;
+    std::vector<BatchVertex> mBatchVertices;
+    std::vector<Batch> mBatches;
 };
 
 #endif  // TEXTURE_DRAW_H
@@ -18,6 +18,7 @@
 
 #include "DispatchTables.h"
 #include "FrameBuffer.h"
+#include "GLErrorCheck.h"
 #include "android/utils/debug.h"
 
 #include "emugl/common/misc.h"
@@ -289,6 +290,14 @@ TextureResize::TextureResize(GLuint width, GLuint height) :
     s_gles2.glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
     s_gles2.glBufferData(GL_ARRAY_BUFFER, sizeof(kVertexData), kVertexData, GL_STATIC_DRAW);
 
+    int glesMaj = 2, glesMin = 0;
+    emugl::getGlesVersion(&glesMaj, &glesMin);
+    if (glesMaj >= 3 && s_gles2.glGenSamplers && s_gles2.glBindSampler) {
+        s_gles2.glGenSamplers(1, &mNearestSampler);
+        s_gles2.glSamplerParameteri(mNearestSampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        s_gles2.glSamplerParameteri(mNearestSampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    }
+
     // Clear bindings.
     s_gles2.glBindTexture(GL_TEXTURE_2D, 0);
     s_gles2.glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -308,15 +317,16 @@ TextureResize::~TextureResize() {
     s_gles2.glDeleteProgram(mFBHeight.program);
 
     s_gles2.glDeleteBuffers(1, &mVertexBuffer);
-}
 
-GLuint TextureResize::update(GLuint texture) {
-    // Store the viewport. The viewport is clobbered due to the framebuffers.
-    GLint vport[4] = { 0, };
-    s_gles2.glGetIntegerv(GL_VIEWPORT, vport);
+    if (mNearestSampler) {
+        s_gles2.glDeleteSamplers(1, &mNearestSampler);
+    }
+}
 
+GLuint TextureResize::update(GLuint texture, int viewportWidth,
+                             int viewportHeight) {
     // Correctly deal with rotated screens.
-    GLint tWidth = vport[2], tHeight = vport[3];
+    GLint tWidth = viewportWidth, tHeight = viewportHeight;
     if ((mWidth < mHeight) != (tWidth < tHeight)) {
         std::swap(tWidth, tHeight);
     }
@@ -333,16 +343,23 @@ GLuint TextureResize::update(GLuint texture) {
         return texture;
     }
 
-    s_gles2.glGetError(); // Clear any GL errors.
+    // Errors are only looked for when the framebuffers get (re)allocated,
+    // which is what may fail; glGetError() stalls on the GPU.
+    const bool checkErrors = factor != mFactor || shouldCheckPostGlErrors();
+    if (checkErrors) {
+        s_gles2.glGetError(); // Clear any GL errors.
+    }
     setupFramebuffers(factor);
     resize(texture);
-    s_gles2.glViewport(vport[0], vport[1], vport[2], vport[3]); // Restore the viewport.
+    s_gles2.glViewport(0, 0, viewportWidth, viewportHeight); // Restore the viewport.
 
     // If there was an error while resizing, just use the unscaled texture.
-    GLenum error = s_gles2.glGetError();
-    if (error != GL_NO_ERROR) {
-        V("GL error while resizing: 0x%x (ignored)\n", error);
-        return texture;
+    if (checkErrors) {
+        GLenum error = s_gles2.glGetError();
+        if (error != GL_NO_ERROR) {
+            V("GL error while resizing: 0x%x (ignored)\n", error);
+            return texture;
+        }
     }
 
     return mFBHeight.texture;
@@ -355,6 +372,21 @@ GLuint TextureResize::update(GLuint texture, int width, int height, SkinRotation
     return mGenericResizer->draw(texture, width, height, rotation);
 }
 
+size_t TextureResize::getResidentBytes() const {
+    size_t bytes = mGenericResizer ? mGenericResizer->getResidentBytes() : 0;
+    if (mFactor > 1) {
+        size_t texelBytes = 3;
+        if (mTextureDataType == GL_FLOAT) {
+            texelBytes = 12;
+        } else if (mTextureDataType == GL_HALF_FLOAT_OES) {
+            texelBytes = 6;
+        }
+        const size_t scaledWidth = mWidth / mFactor;
+        bytes += scaledWidth * (mHeight + mHeight / mFactor) * texelBytes;
+    }
+    return bytes;
+}
+
 void TextureResize::setupFramebuffers(unsigned int factor) {
     if (factor == mFactor) {
         // The factor hasn't changed, no need to update the framebuffers.
@@ -405,18 +437,27 @@ void TextureResize::resize(GLuint texture) {
     s_gles2.glVertexAttribPointer(mFBWidth.aPosition, 2, GL_FLOAT, GL_FALSE, 0, 0);
     s_gles2.glBindTexture(GL_TEXTURE_2D, texture);
 
-    // Store the current texture filters and set to nearest for scaling.
-    GLint mag_filter, min_filter;
-    s_gles2.glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &mag_filter);
-    s_gles2.glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &min_filter);
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    // Sample with nearest filtering for scaling. The input texture is the
+    // guest's, so its own filters are left alone: a sampler overrides them
+    // where available, otherwise they are saved and restored.
+    GLint mag_filter = GL_LINEAR, min_filter = GL_LINEAR;
+    if (mNearestSampler) {
+        s_gles2.glBindSampler(0, mNearestSampler);
+    } else {
+        s_gles2.glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &mag_filter);
+        s_gles2.glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &min_filter);
+        s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    }
     s_gles2.glUniform1i(mFBWidth.uTexture, 0);
     s_gles2.glDrawArrays(GL_TRIANGLES, 0, sizeof(kVertexData) / (2 * sizeof(float)));
 
-    // Restore the previous texture filters.
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
-    s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+    if (mNearestSampler) {
+        s_gles2.glBindSampler(0, 0);
+    } else {
+        s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
+        s_gles2.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
+    }
     s_gles2.glFramebufferTexture2D(
         GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
     // Secondly, scale the vertical dimension using the second framebuffer.
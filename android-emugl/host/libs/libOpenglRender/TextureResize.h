@@ -20,16 +20,23 @@
 #include <GLES2/gl2.h>
 #include <memory>
 
+#include <stddef.h>
+
 class TextureResize {
 public:
     TextureResize(GLuint width, GLuint height);
     ~TextureResize();
 
-    // Scales the given texture for the current viewport and returns the scaled
-    // texture. May return the input if no scaling is required.
-    GLuint update(GLuint texture);
+    // Scales the given texture for the current viewport, which must be
+    // (0, 0, |viewportWidth|, |viewportHeight|), and returns the scaled
+    // texture. May return the input if no scaling is required. |texture|
+    // is expected to use linear filtering.
+    GLuint update(GLuint texture, int viewportWidth, int viewportHeight);
     GLuint update(GLuint texture, int width, int height, SkinRotation rotation);
 
+    // Approximate GPU memory held by the intermediate textures.
+    size_t getResidentBytes() const;
+
     struct Framebuffer {
         GLuint texture;
         GLuint framebuffer;
@@ -47,6 +54,8 @@ public:
         // |width| and |height| are the dimensions of the texture.
         GLuint draw(GLuint texture, int width, int height, SkinRotation rotation);
 
+        size_t getResidentBytes() const { return (size_t)mWidth * mHeight * 3; }
+
     private:
         GLuint mProgram;
         GLuint mVertexBuffer;
@@ -72,6 +81,9 @@ private:
     GLuint mVertexBuffer;
     GLenum mTextureDataType;
     GLenum mTextureFilteringMode = GL_LINEAR;
+    // Samples the input texture with nearest filtering without touching
+    // its own parameters, which the guest may rely on. 0 before GLES 3.
+    GLuint mNearestSampler = 0;
     std::unique_ptr<GenericResizer> mGenericResizer;
 };
 
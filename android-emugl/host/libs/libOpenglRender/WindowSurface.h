@@ -23,6 +23,7 @@
 
 #include <EGL/egl.h>
 #include <GLES/gl.h>
+#include <atomic>
 #include <set>
 
 // A class used to model a guest-side window surface. The implementation
@@ -89,6 +90,12 @@ public:
     GLuint getWidth() const;
     GLuint getHeight() const;
 
+    // The swap interval the guest set for this surface, or -1 if none, in
+    // which case frames posted while it is current get the default. See
+    // FramePacer.
+    void setSwapInterval(int interval) { mSwapInterval = interval; }
+    int getSwapInterval() const { return mSwapInterval; }
+
     void onSave(android::base::Stream* stream) const;
     static WindowSurface *onLoad(android::base::Stream* stream,
             EGLDisplay display);
@@ -114,6 +121,8 @@ private:
     EGLDisplay mDisplay = EGL_NO_DISPLAY;
     HandleType mHndl;
     std::set<HandleType> mColorBuffers;
+    // Set and read on different render threads.
+    std::atomic<int> mSwapInterval{-1};
 };
 
 typedef emugl::SmartPtr<WindowSurface> WindowSurfacePtr;
@@ -41,6 +41,27 @@ typedef unsigned int tsize_t; // Target "size_t", which is 32-bit for now. It ma
 using namespace emugl;
 
 int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
+    const bool useTracing = android::base::shouldEnableTracing();
+    unsigned char *ptr = (unsigned char *)buf;
+    size_t done = 0;
+    // Commands may change the checksum mode; decodeImpl() stops after them
+    // and the rest goes to the matching instantiation.
+    while (done < len) {
+        const int res = checksumCalc->checksumByteSize() > 0
+            ? (useTracing ? decodeImpl<true, true>(ptr + done, len - done, stream, checksumCalc)
+                          : decodeImpl<true, false>(ptr + done, len - done, stream, checksumCalc))
+            : (useTracing ? decodeImpl<false, true>(ptr + done, len - done, stream, checksumCalc)
+                          : decodeImpl<false, false>(ptr + done, len - done, stream, checksumCalc));
+        if (res <= 0) {
+            return done ? (int)done : res;
+        }
+        done += res;
+    }
+    return done;
+}
+
+template <bool useChecksum, bool useTracing>
+int renderControl_decoder_context_t::decodeImpl(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
     if (len < 8) return 0; 
 #ifdef CHECK_GL_ERRORS
     char lastCall[256] = {0};
@@ -55,10 +76,13 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             return -1;
         }
         if (end - ptr < packetLen) return ptr - (unsigned char*)buf;
+        currentDecoderOpcode() = opcode;
         // Do this on every iteration, as some commands may change the checksum
         // calculation parameters.
         const size_t checksumSize = checksumCalc->checksumByteSize();
-        const bool useChecksum = checksumSize > 0;
+        if ((checksumSize > 0) != useChecksum) {
+            return ptr - (unsigned char*)buf;
+        }
 
 #ifdef CHECK_GL_OPCODE_TIME_USE
         struct timeval start;
@@ -71,7 +95,7 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
 
         switch(opcode) {
         case OP_rcGetRendererVersion: {
-            android::base::beginTrace("rcGetRendererVersion decode");
+            if (useTracing) android::base::beginTrace("rcGetRendererVersion decode");
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8, ptr + 8, checksumSize, 
                     "renderControl_decoder_context_t::decode, OP_rcGetRendererVersion: GL checksumCalculator failure\n");
@@ -85,11 +109,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetRendererVersion");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetEGLVersion: {
-            android::base::beginTrace("rcGetEGLVersion decode");
+            if (useTracing) android::base::beginTrace("rcGetEGLVersion decode");
             uint32_t size_major __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_minor __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -111,11 +135,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetEGLVersion");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcQueryEGLString: {
-            android::base::beginTrace("rcQueryEGLString decode");
+            if (useTracing) android::base::beginTrace("rcQueryEGLString decode");
             EGLenum var_name = Unpack<EGLenum,uint32_t>(ptr + 8);
             uint32_t size_buffer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             EGLint var_bufferSize = Unpack<EGLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -135,11 +159,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcQueryEGLString");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetGLString: {
-            android::base::beginTrace("rcGetGLString decode");
+            if (useTracing) android::base::beginTrace("rcGetGLString decode");
             EGLenum var_name = Unpack<EGLenum,uint32_t>(ptr + 8);
             uint32_t size_buffer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             EGLint var_bufferSize = Unpack<EGLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -159,11 +183,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetGLString");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetNumConfigs: {
-            android::base::beginTrace("rcGetNumConfigs decode");
+            if (useTracing) android::base::beginTrace("rcGetNumConfigs decode");
             uint32_t size_numAttribs __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -181,11 +205,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetNumConfigs");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetConfigs: {
-            android::base::beginTrace("rcGetConfigs decode");
+            if (useTracing) android::base::beginTrace("rcGetConfigs decode");
             uint32_t var_bufSize = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_buffer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -204,11 +228,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetConfigs");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcChooseConfig: {
-            android::base::beginTrace("rcChooseConfig decode");
+            if (useTracing) android::base::beginTrace("rcChooseConfig decode");
             uint32_t size_attribs __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             InputBuffer inptr_attribs(ptr + 8 + 4, size_attribs);
             uint32_t var_attribs_size = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + size_attribs);
@@ -230,11 +254,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcChooseConfig");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetFBParam: {
-            android::base::beginTrace("rcGetFBParam decode");
+            if (useTracing) android::base::beginTrace("rcGetFBParam decode");
             EGLint var_param = Unpack<EGLint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -249,11 +273,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetFBParam");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateContext: {
-            android::base::beginTrace("rcCreateContext decode");
+            if (useTracing) android::base::beginTrace("rcCreateContext decode");
             uint32_t var_config = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_share = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             uint32_t var_glVersion = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -270,11 +294,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateContext");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcDestroyContext: {
-            android::base::beginTrace("rcDestroyContext decode");
+            if (useTracing) android::base::beginTrace("rcDestroyContext decode");
             uint32_t var_context = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -282,11 +306,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcDestroyContext(var_context);
             SET_LASTCALL("rcDestroyContext");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateWindowSurface: {
-            android::base::beginTrace("rcCreateWindowSurface decode");
+            if (useTracing) android::base::beginTrace("rcCreateWindowSurface decode");
             uint32_t var_config = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_width = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             uint32_t var_height = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -303,11 +327,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateWindowSurface");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcDestroyWindowSurface: {
-            android::base::beginTrace("rcDestroyWindowSurface decode");
+            if (useTracing) android::base::beginTrace("rcDestroyWindowSurface decode");
             uint32_t var_windowSurface = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -315,11 +339,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcDestroyWindowSurface(var_windowSurface);
             SET_LASTCALL("rcDestroyWindowSurface");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateColorBuffer: {
-            android::base::beginTrace("rcCreateColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcCreateColorBuffer decode");
             uint32_t var_width = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_height = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             GLenum var_internalFormat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -336,11 +360,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcOpenColorBuffer: {
-            android::base::beginTrace("rcOpenColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcOpenColorBuffer decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -348,11 +372,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcOpenColorBuffer(var_colorbuffer);
             SET_LASTCALL("rcOpenColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCloseColorBuffer: {
-            android::base::beginTrace("rcCloseColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcCloseColorBuffer decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -360,11 +384,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcCloseColorBuffer(var_colorbuffer);
             SET_LASTCALL("rcCloseColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetWindowColorBuffer: {
-            android::base::beginTrace("rcSetWindowColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcSetWindowColorBuffer decode");
             uint32_t var_windowSurface = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -373,11 +397,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcSetWindowColorBuffer(var_windowSurface, var_colorBuffer);
             SET_LASTCALL("rcSetWindowColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcFlushWindowColorBuffer: {
-            android::base::beginTrace("rcFlushWindowColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcFlushWindowColorBuffer decode");
             uint32_t var_windowSurface = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -392,11 +416,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcFlushWindowColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcMakeCurrent: {
-            android::base::beginTrace("rcMakeCurrent decode");
+            if (useTracing) android::base::beginTrace("rcMakeCurrent decode");
             uint32_t var_context = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_drawSurf = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             uint32_t var_readSurf = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -413,11 +437,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcMakeCurrent");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcFBPost: {
-            android::base::beginTrace("rcFBPost decode");
+            if (useTracing) android::base::beginTrace("rcFBPost decode");
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -425,11 +449,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcFBPost(var_colorBuffer);
             SET_LASTCALL("rcFBPost");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcFBSetSwapInterval: {
-            android::base::beginTrace("rcFBSetSwapInterval decode");
+            if (useTracing) android::base::beginTrace("rcFBSetSwapInterval decode");
             EGLint var_interval = Unpack<EGLint,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -437,11 +461,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcFBSetSwapInterval(var_interval);
             SET_LASTCALL("rcFBSetSwapInterval");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcBindTexture: {
-            android::base::beginTrace("rcBindTexture decode");
+            if (useTracing) android::base::beginTrace("rcBindTexture decode");
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -449,11 +473,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcBindTexture(var_colorBuffer);
             SET_LASTCALL("rcBindTexture");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcBindRenderbuffer: {
-            android::base::beginTrace("rcBindRenderbuffer decode");
+            if (useTracing) android::base::beginTrace("rcBindRenderbuffer decode");
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -461,11 +485,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcBindRenderbuffer(var_colorBuffer);
             SET_LASTCALL("rcBindRenderbuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcColorBufferCacheFlush: {
-            android::base::beginTrace("rcColorBufferCacheFlush decode");
+            if (useTracing) android::base::beginTrace("rcColorBufferCacheFlush decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             EGLint var_postCount = Unpack<EGLint,uint32_t>(ptr + 8 + 4);
             int var_forRead = Unpack<int,uint32_t>(ptr + 8 + 4 + 4);
@@ -482,11 +506,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcColorBufferCacheFlush");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcReadColorBuffer: {
-            android::base::beginTrace("rcReadColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcReadColorBuffer decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -510,11 +534,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcReadColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcUpdateColorBuffer: {
-            android::base::beginTrace("rcUpdateColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcUpdateColorBuffer decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -523,7 +547,7 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             GLenum var_format = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4);
             GLenum var_type = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4);
             uint32_t size_pixels __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4);
-            InputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
+            ByteInputBuffer inptr_pixels(ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4, size_pixels);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, ptr + 8 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + 4 + size_pixels, checksumSize, 
                     "renderControl_decoder_context_t::decode, OP_rcUpdateColorBuffer: GL checksumCalculator failure\n");
@@ -537,11 +561,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcUpdateColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcOpenColorBuffer2: {
-            android::base::beginTrace("rcOpenColorBuffer2 decode");
+            if (useTracing) android::base::beginTrace("rcOpenColorBuffer2 decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -556,11 +580,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcOpenColorBuffer2");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateClientImage: {
-            android::base::beginTrace("rcCreateClientImage decode");
+            if (useTracing) android::base::beginTrace("rcCreateClientImage decode");
             uint32_t var_context = Unpack<uint32_t,uint32_t>(ptr + 8);
             EGLenum var_target = Unpack<EGLenum,uint32_t>(ptr + 8 + 4);
             GLuint var_buffer = Unpack<GLuint,uint32_t>(ptr + 8 + 4 + 4);
@@ -577,11 +601,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateClientImage");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcDestroyClientImage: {
-            android::base::beginTrace("rcDestroyClientImage decode");
+            if (useTracing) android::base::beginTrace("rcDestroyClientImage decode");
             uint32_t var_image = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -596,11 +620,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcDestroyClientImage");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSelectChecksumHelper: {
-            android::base::beginTrace("rcSelectChecksumHelper decode");
+            if (useTracing) android::base::beginTrace("rcSelectChecksumHelper decode");
             uint32_t var_newProtocol = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_reserved = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -609,11 +633,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcSelectChecksumHelper(var_newProtocol, var_reserved);
             SET_LASTCALL("rcSelectChecksumHelper");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateSyncKHR: {
-            android::base::beginTrace("rcCreateSyncKHR decode");
+            if (useTracing) android::base::beginTrace("rcCreateSyncKHR decode");
             EGLenum var_type = Unpack<EGLenum,uint32_t>(ptr + 8);
             uint32_t size_attribs __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_attribs(ptr + 8 + 4 + 4, size_attribs);
@@ -639,11 +663,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateSyncKHR");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcClientWaitSyncKHR: {
-            android::base::beginTrace("rcClientWaitSyncKHR decode");
+            if (useTracing) android::base::beginTrace("rcClientWaitSyncKHR decode");
             uint64_t var_sync = Unpack<uint64_t,uint64_t>(ptr + 8);
             EGLint var_flags = Unpack<EGLint,uint32_t>(ptr + 8 + 8);
             uint64_t var_timeout = Unpack<uint64_t,uint64_t>(ptr + 8 + 8 + 4);
@@ -660,11 +684,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcClientWaitSyncKHR");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcFlushWindowColorBufferAsync: {
-            android::base::beginTrace("rcFlushWindowColorBufferAsync decode");
+            if (useTracing) android::base::beginTrace("rcFlushWindowColorBufferAsync decode");
             uint32_t var_windowSurface = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -672,11 +696,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcFlushWindowColorBufferAsync(var_windowSurface);
             SET_LASTCALL("rcFlushWindowColorBufferAsync");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcDestroySyncKHR: {
-            android::base::beginTrace("rcDestroySyncKHR decode");
+            if (useTracing) android::base::beginTrace("rcDestroySyncKHR decode");
             uint64_t var_sync = Unpack<uint64_t,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -691,11 +715,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcDestroySyncKHR");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetPuid: {
-            android::base::beginTrace("rcSetPuid decode");
+            if (useTracing) android::base::beginTrace("rcSetPuid decode");
             uint64_t var_puid = Unpack<uint64_t,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -703,11 +727,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcSetPuid(var_puid);
             SET_LASTCALL("rcSetPuid");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcUpdateColorBufferDMA: {
-            android::base::beginTrace("rcUpdateColorBufferDMA decode");
+            if (useTracing) android::base::beginTrace("rcUpdateColorBufferDMA decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -733,11 +757,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcUpdateColorBufferDMA");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateColorBufferDMA: {
-            android::base::beginTrace("rcCreateColorBufferDMA decode");
+            if (useTracing) android::base::beginTrace("rcCreateColorBufferDMA decode");
             uint32_t var_width = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_height = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             GLenum var_internalFormat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -755,11 +779,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateColorBufferDMA");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcWaitSyncKHR: {
-            android::base::beginTrace("rcWaitSyncKHR decode");
+            if (useTracing) android::base::beginTrace("rcWaitSyncKHR decode");
             uint64_t var_sync = Unpack<uint64_t,uint64_t>(ptr + 8);
             EGLint var_flags = Unpack<EGLint,uint32_t>(ptr + 8 + 8);
             if (useChecksum) {
@@ -768,11 +792,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcWaitSyncKHR(var_sync, var_flags);
             SET_LASTCALL("rcWaitSyncKHR");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCompose: {
-            android::base::beginTrace("rcCompose decode");
+            if (useTracing) android::base::beginTrace("rcCompose decode");
             uint32_t var_bufferSize = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_buffer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             InputBuffer inptr_buffer(ptr + 8 + 4 + 4, size_buffer);
@@ -789,11 +813,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCompose");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateDisplay: {
-            android::base::beginTrace("rcCreateDisplay decode");
+            if (useTracing) android::base::beginTrace("rcCreateDisplay decode");
             uint32_t size_displayId __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -811,11 +835,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateDisplay");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcDestroyDisplay: {
-            android::base::beginTrace("rcDestroyDisplay decode");
+            if (useTracing) android::base::beginTrace("rcDestroyDisplay decode");
             uint32_t var_displayId = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -830,11 +854,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcDestroyDisplay");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetDisplayColorBuffer: {
-            android::base::beginTrace("rcSetDisplayColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcSetDisplayColorBuffer decode");
             uint32_t var_displayId = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -850,11 +874,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcSetDisplayColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetDisplayColorBuffer: {
-            android::base::beginTrace("rcGetDisplayColorBuffer decode");
+            if (useTracing) android::base::beginTrace("rcGetDisplayColorBuffer decode");
             uint32_t var_displayId = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_colorBuffer __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -873,11 +897,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetDisplayColorBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetColorBufferDisplay: {
-            android::base::beginTrace("rcGetColorBufferDisplay decode");
+            if (useTracing) android::base::beginTrace("rcGetColorBufferDisplay decode");
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_displayId __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -896,11 +920,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetColorBufferDisplay");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcGetDisplayPose: {
-            android::base::beginTrace("rcGetDisplayPose decode");
+            if (useTracing) android::base::beginTrace("rcGetDisplayPose decode");
             uint32_t var_displayId = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t size_x __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             uint32_t size_y __attribute__((unused)) = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -931,11 +955,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcGetDisplayPose");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetDisplayPose: {
-            android::base::beginTrace("rcSetDisplayPose decode");
+            if (useTracing) android::base::beginTrace("rcSetDisplayPose decode");
             uint32_t var_displayId = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -954,11 +978,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcSetDisplayPose");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetColorBufferVulkanMode: {
-            android::base::beginTrace("rcSetColorBufferVulkanMode decode");
+            if (useTracing) android::base::beginTrace("rcSetColorBufferVulkanMode decode");
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_mode = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -974,11 +998,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcSetColorBufferVulkanMode");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcReadColorBufferYUV: {
-            android::base::beginTrace("rcReadColorBufferYUV decode");
+            if (useTracing) android::base::beginTrace("rcReadColorBufferYUV decode");
             uint32_t var_colorbuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             GLint var_x = Unpack<GLint,uint32_t>(ptr + 8 + 4);
             GLint var_y = Unpack<GLint,uint32_t>(ptr + 8 + 4 + 4);
@@ -1001,11 +1025,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcReadColorBufferYUV");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcIsSyncSignaled: {
-            android::base::beginTrace("rcIsSyncSignaled decode");
+            if (useTracing) android::base::beginTrace("rcIsSyncSignaled decode");
             uint64_t var_sync = Unpack<uint64_t,uint64_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 8, ptr + 8 + 8, checksumSize, 
@@ -1020,11 +1044,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcIsSyncSignaled");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateColorBufferWithHandle: {
-            android::base::beginTrace("rcCreateColorBufferWithHandle decode");
+            if (useTracing) android::base::beginTrace("rcCreateColorBufferWithHandle decode");
             uint32_t var_width = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_height = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             GLenum var_internalFormat = Unpack<GLenum,uint32_t>(ptr + 8 + 4 + 4);
@@ -1035,11 +1059,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcCreateColorBufferWithHandle(var_width, var_height, var_internalFormat, var_handle);
             SET_LASTCALL("rcCreateColorBufferWithHandle");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateBuffer: {
-            android::base::beginTrace("rcCreateBuffer decode");
+            if (useTracing) android::base::beginTrace("rcCreateBuffer decode");
             uint32_t var_size = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1054,11 +1078,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCloseBuffer: {
-            android::base::beginTrace("rcCloseBuffer decode");
+            if (useTracing) android::base::beginTrace("rcCloseBuffer decode");
             uint32_t var_buffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             if (useChecksum) {
                 ChecksumCalculatorThreadInfo::validOrDie(checksumCalc, ptr, 8 + 4, ptr + 8 + 4, checksumSize, 
@@ -1066,11 +1090,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcCloseBuffer(var_buffer);
             SET_LASTCALL("rcCloseBuffer");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetColorBufferVulkanMode2: {
-            android::base::beginTrace("rcSetColorBufferVulkanMode2 decode");
+            if (useTracing) android::base::beginTrace("rcSetColorBufferVulkanMode2 decode");
             uint32_t var_colorBuffer = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_mode = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             uint32_t var_memoryProperty = Unpack<uint32_t,uint32_t>(ptr + 8 + 4 + 4);
@@ -1087,11 +1111,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcSetColorBufferVulkanMode2");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcMapGpaToBufferHandle: {
-            android::base::beginTrace("rcMapGpaToBufferHandle decode");
+            if (useTracing) android::base::beginTrace("rcMapGpaToBufferHandle decode");
             uint32_t var_bufferHandle = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint64_t var_gpa = Unpack<uint64_t,uint64_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1107,11 +1131,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcMapGpaToBufferHandle");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcCreateBuffer2: {
-            android::base::beginTrace("rcCreateBuffer2 decode");
+            if (useTracing) android::base::beginTrace("rcCreateBuffer2 decode");
             uint64_t var_size = Unpack<uint64_t,uint64_t>(ptr + 8);
             uint32_t var_memoryProperty = Unpack<uint32_t,uint32_t>(ptr + 8 + 8);
             if (useChecksum) {
@@ -1127,11 +1151,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcCreateBuffer2");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcMapGpaToBufferHandle2: {
-            android::base::beginTrace("rcMapGpaToBufferHandle2 decode");
+            if (useTracing) android::base::beginTrace("rcMapGpaToBufferHandle2 decode");
             uint32_t var_bufferHandle = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint64_t var_gpa = Unpack<uint64_t,uint64_t>(ptr + 8 + 4);
             uint64_t var_size = Unpack<uint64_t,uint64_t>(ptr + 8 + 4 + 8);
@@ -1148,11 +1172,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             stream->flush();
             SET_LASTCALL("rcMapGpaToBufferHandle2");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcFlushWindowColorBufferAsyncWithFrameNumber: {
-            android::base::beginTrace("rcFlushWindowColorBufferAsyncWithFrameNumber decode");
+            if (useTracing) android::base::beginTrace("rcFlushWindowColorBufferAsyncWithFrameNumber decode");
             uint32_t var_windowSurface = Unpack<uint32_t,uint32_t>(ptr + 8);
             uint32_t var_frameNumber = Unpack<uint32_t,uint32_t>(ptr + 8 + 4);
             if (useChecksum) {
@@ -1161,11 +1185,11 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcFlushWindowColorBufferAsyncWithFrameNumber(var_windowSurface, var_frameNumber);
             SET_LASTCALL("rcFlushWindowColorBufferAsyncWithFrameNumber");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcSetTracingForPuid: {
-            android::base::beginTrace("rcSetTracingForPuid decode");
+            if (useTracing) android::base::beginTrace("rcSetTracingForPuid decode");
             uint64_t var_puid = Unpack<uint64_t,uint64_t>(ptr + 8);
             uint32_t var_enable = Unpack<uint32_t,uint32_t>(ptr + 8 + 8);
             uint64_t var_guestTime = Unpack<uint64_t,uint64_t>(ptr + 8 + 8 + 4);
@@ -1175,7 +1199,7 @@ int renderControl_decoder_context_t::decode(void *buf, size_t len, IOStream *str
             }
             this->rcSetTracingForPuid(var_puid, var_enable, var_guestTime);
             SET_LASTCALL("rcSetTracingForPuid");
-            android::base::endTrace();
+            if (useTracing) android::base::endTrace();
             break;
         }
         case OP_rcTransferAppStatus: {        
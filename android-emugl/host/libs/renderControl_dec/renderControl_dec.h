@@ -16,6 +16,11 @@ struct renderControl_decoder_context_t : public renderControl_server_context_t {
 
     int decode(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);
 
+private:
+    // decode() for a given checksum and tracing mode.
+    template <bool useChecksum, bool useTracing>
+    int decodeImpl(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);
+
 };
 
 #endif  // GUARD_renderControl_decoder_context_t
@@ -391,6 +391,28 @@ enum class EncodingSizeFlags {
     UseExistingVar = 4,
 };
 
+// Whether |var| points to data GL handles as raw bytes. The decoder passes
+// such payloads through in place instead of realigning them. void pointers
+// are not included by type: they often carry typed data (indices, vertex
+// attributes, GLfloat params) that is read with aligned loads downstream,
+// so a void payload only qualifies when its .attrib marks it rawBytes.
+static bool isBytePointer(const Var* var) {
+    if (var->isRawBytes()) {
+        return true;
+    }
+    const VarType* type = var->type();
+    if (!type->isPointer()) {
+        return false;
+    }
+    std::string pointee = type->name();
+    if (pointee.compare(0, 6, "const ") == 0) {
+        pointee = pointee.substr(6);
+    }
+    pointee = trim(pointee.substr(0, pointee.rfind('*')));
+    return pointee == "char" || pointee == "GLchar" || pointee == "GLubyte" ||
+           pointee == "unsigned char" || pointee == "uint8_t";
+}
+
 static int getVarEncodingSizeExpression(
         Var& var, EntryPoint* e, char* buff, size_t bufflen,
         EncodingSizeFlags flags)
@@ -900,6 +922,10 @@ int ApiGen::genDecoderHeader(const std::string &filename)
     fprintf(fp, "struct %s : public %s_%s_context_t {\n\n",
             classname.c_str(), m_basename.c_str(), sideString(SERVER_SIDE));
     fprintf(fp, "\tsize_t decode(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);\n");
+    fprintf(fp, "\nprivate:\n");
+    fprintf(fp, "\t// decode() for a given checksum and tracing mode.\n");
+    fprintf(fp, "\ttemplate <bool useChecksum, bool useTracing>\n");
+    fprintf(fp, "\tsize_t decodeImpl(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);\n");
     fprintf(fp, "\n};\n\n");
     fprintf(fp, "#endif  // GUARD_%s\n", classname.c_str());
 
@@ -989,8 +1015,40 @@ int ApiGen::genDecoderImpl(const std::string &filename)
     // helper templates
     fprintf(fp, "using namespace emugl;\n\n");
 
-    // decoder switch;
+    // Dispatch to the decoder instantiated for the current checksum and
+    // tracing modes, so the per-packet code doesn't test them.
     fprintf(fp, "size_t %s::decode(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {\n", classname.c_str());
+    fprintf(fp, "\tconst bool useTracing = android::base::shouldEnableTracing();\n");
+    if (changesChecksum) {
+        // Commands may change the checksum mode; decodeImpl() stops after
+        // them and the rest goes to the matching instantiation.
+        fprintf(fp,
+"\tunsigned char *ptr = (unsigned char *)buf;\n\
+\tsize_t done = 0;\n\
+\twhile (done < len) {\n\
+\t\tconst size_t res = checksumCalc->checksumByteSize() > 0\n\
+\t\t\t? (useTracing ? decodeImpl<true, true>(ptr + done, len - done, stream, checksumCalc)\n\
+\t\t\t              : decodeImpl<true, false>(ptr + done, len - done, stream, checksumCalc))\n\
+\t\t\t: (useTracing ? decodeImpl<false, true>(ptr + done, len - done, stream, checksumCalc)\n\
+\t\t\t              : decodeImpl<false, false>(ptr + done, len - done, stream, checksumCalc));\n\
+\t\tif (!res) break;\n\
+\t\tdone += res;\n\
+\t}\n\
+\treturn done;\n");
+    } else {
+        fprintf(fp,
+"\tif (checksumCalc->checksumByteSize() > 0) {\n\
+\t\treturn useTracing ? decodeImpl<true, true>(buf, len, stream, checksumCalc)\n\
+\t\t                  : decodeImpl<true, false>(buf, len, stream, checksumCalc);\n\
+\t}\n\
+\treturn useTracing ? decodeImpl<false, true>(buf, len, stream, checksumCalc)\n\
+\t                  : decodeImpl<false, false>(buf, len, stream, checksumCalc);\n");
+    }
+    fprintf(fp, "}\n\n");
+
+    // decoder switch;
+    fprintf(fp, "template <bool useChecksum, bool useTracing>\n");
+    fprintf(fp, "size_t %s::decodeImpl(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {\n", classname.c_str());
     fprintf(fp,
 "\tif (len < 8) return 0; \n\
 #ifdef CHECK_GL_ERRORS\n\
@@ -1001,20 +1059,22 @@ int ApiGen::genDecoderImpl(const std::string &filename)
     if (!changesChecksum) {
         fprintf(fp,
 R"(    const size_t checksumSize = checksumCalc->checksumByteSize();
-    const bool useChecksum = checksumSize > 0;
 )");
     }
     fprintf(fp,
 "\twhile (end - ptr >= 8) {\n\
 \t\tuint32_t opcode = *(uint32_t *)ptr;   \n\
 \t\tint32_t packetLen = *(int32_t *)(ptr + 4);\n\
-\t\tif (end - ptr < packetLen) return ptr - (unsigned char*)buf;\n");
+\t\tif (end - ptr < packetLen) return ptr - (unsigned char*)buf;\n\
+\t\tcurrentDecoderOpcode() = opcode;\n");
     if (changesChecksum) {
         fprintf(fp,
 R"(        // Do this on every iteration, as some commands may change the checksum
         // calculation parameters.
         const size_t checksumSize = checksumCalc->checksumByteSize();
-        const bool useChecksum = checksumSize > 0;
+        if ((checksumSize > 0) != useChecksum) {
+            return ptr - (unsigned char*)buf;
+        }
 )");
     }
     fprintf(fp, "\t\tswitch(opcode) {\n");
@@ -1042,7 +1102,7 @@ R"(        // Do this on every iteration, as some commands may change the checks
 
         // TODO - add for return value;
         fprintf(fp, "\t\tcase OP_%s: {\n", e->name().c_str());
-        fprintf(fp, "\t\t\tandroid::base::beginTrace(\"%s decode\");\n", e->name().c_str());
+        fprintf(fp, "\t\t\tif (useTracing) android::base::beginTrace(\"%s decode\");\n", e->name().c_str());
 
 #if INSTRUMENT_TIMING_HOST
         fprintf(fp, "\t\t\tstruct timespec ts0, ts1, ts2;\n");
@@ -1173,7 +1233,9 @@ R"(        // Do this on every iteration, as some commands may change the checks
                         if (pass == PASS_VariableDeclarations) {
     #if USE_ALIGNED_BUFFERS
                             fprintf(fp,
-                                    "\t\t\tInputBuffer inptr_%s(ptr + %s + 4, size_%s);\n",
+                                    "\t\t\t%s inptr_%s(ptr + %s + 4, size_%s);\n",
+                                    isBytePointer(v) ? "ByteInputBuffer"
+                                                     : "InputBuffer",
                                     var_name,
                                     varoffset.c_str(),
                                     var_name);
@@ -1265,7 +1327,9 @@ R"(        // Do this on every iteration, as some commands may change the checks
                         } else if (pass == PASS_MemAlloc) {
     #if USE_ALIGNED_BUFFERS
                             fprintf(fp,
-                                    "\t\t\tOutputBuffer outptr_%s(&tmpBuf[%s], size_%s);\n",
+                                    "\t\t\t%s outptr_%s(&tmpBuf[%s], size_%s);\n",
+                                    isBytePointer(v) ? "ByteOutputBuffer"
+                                                     : "OutputBuffer",
                                     var_name,
                                     tmpBufOffset[j].c_str(),
                                     var_name);
@@ -1440,7 +1504,7 @@ R"(        // Do this on every iteration, as some commands may change the checks
                     "ts1.tv_sec, ts1.tv_nsec/1000, timeDiff, timeDiff2);\n", e->name().c_str());
 #endif
         fprintf(fp, "\t\t\tSET_LASTCALL(\"%s\");\n", e->name().c_str());
-        fprintf(fp, "\t\t\tandroid::base::endTrace();\n");
+        fprintf(fp, "\t\t\tif (useTracing) android::base::endTrace();\n");
         fprintf(fp, "\t\t\tbreak;\n");
         fprintf(fp, "\t\t}\n");
 
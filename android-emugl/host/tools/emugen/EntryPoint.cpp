@@ -289,6 +289,13 @@ int EntryPoint::setAttribute(const std::string &line, size_t lc)
                 }
             } else if (flag == "DMA") {
                 v->setDMA(true);
+            } else if (flag == "rawBytes") {
+                if (v->isPointer()) {
+                    v->setRawBytes(true);
+                } else {
+                    fprintf(stderr, "WARNING: %u: setting rawBytes flag for a non-pointer variable %s\n",
+                            (unsigned int) lc, v->name().c_str());
+                }
             } else {
                 fprintf(stderr, "WARNING: %u: unknow flag %s\n", (unsigned int)lc, flag.c_str());
             }
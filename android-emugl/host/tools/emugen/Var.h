@@ -96,9 +96,11 @@ public:
     void setNullAllowed(bool state) { m_nullAllowed = state; }
     void setIsLarge(bool state) { m_isLarge = state; }
     void setDMA(bool state) { m_isDMA = state; }
+    void setRawBytes(bool state) { m_isRawBytes = state; }
     bool nullAllowed() const { return m_nullAllowed; }
     bool isLarge() const { return m_isLarge; }
     bool isDMA() const { return m_isDMA; }
+    bool isRawBytes() const { return m_isRawBytes; }
     void printType(FILE *fp) { fprintf(fp, "%s", m_type->name().c_str()); }
     void printTypeName(FILE *fp) { printType(fp); fprintf(fp, " %s", m_name.c_str()); }
 
@@ -110,6 +112,7 @@ private:
     bool m_nullAllowed = false;
     bool m_isLarge = false;
     bool m_isDMA = false;
+    bool m_isRawBytes = false; // payload is only ever read as bytes
     std::string m_packExpression; // an expression to pack data into the stream
     std::string m_unpackExpression; // an expression to unpack data that has arrived from the stream
     std::string m_host_packTmpAllocExpression; // an expression to create temporaries for getting into packed form for readbacks
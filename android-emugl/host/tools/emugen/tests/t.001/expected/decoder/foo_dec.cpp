@@ -25,6 +25,17 @@ typedef unsigned int tsize_t; // Target "size_t", which is 32-bit for now. It ma
 using namespace emugl;
 
 size_t foo_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
+	const bool useTracing = android::base::shouldEnableTracing();
+	if (checksumCalc->checksumByteSize() > 0) {
+		return useTracing ? decodeImpl<true, true>(buf, len, stream, checksumCalc)
+		                  : decodeImpl<true, false>(buf, len, stream, checksumCalc);
+	}
+	return useTracing ? decodeImpl<false, true>(buf, len, stream, checksumCalc)
+	                  : decodeImpl<false, false>(buf, len, stream, checksumCalc);
+}
+
+template <bool useChecksum, bool useTracing>
+size_t foo_decoder_context_t::decodeImpl(void *buf, size_t len, IOStream *stream, ChecksumCalculator* checksumCalc) {
 	if (len < 8) return 0; 
 #ifdef CHECK_GL_ERRORS
 	char lastCall[256] = {0};
@@ -32,11 +43,11 @@ size_t foo_decoder_context_t::decode(void *buf, size_t len, IOStream *stream, Ch
 	unsigned char *ptr = (unsigned char *)buf;
 	const unsigned char* const end = (const unsigned char*)buf + len;
     const size_t checksumSize = checksumCalc->checksumByteSize();
-    const bool useChecksum = checksumSize > 0;
 	while (end - ptr >= 8) {
 		uint32_t opcode = *(uint32_t *)ptr;   
 		int32_t packetLen = *(int32_t *)(ptr + 4);
 		if (end - ptr < packetLen) return ptr - (unsigned char*)buf;
+		currentDecoderOpcode() = opcode;
 		switch(opcode) {
 		case OP_fooAlphaFunc: {
 			FooInt var_func = Unpack<FooInt,uint32_t>(ptr + 8);
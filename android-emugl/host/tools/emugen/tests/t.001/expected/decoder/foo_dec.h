@@ -15,6 +15,11 @@ struct foo_decoder_context_t : public foo_server_context_t {
 
 	size_t decode(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);
 
+private:
+	// decode() for a given checksum and tracing mode.
+	template <bool useChecksum, bool useTracing>
+	size_t decodeImpl(void *buf, size_t bufsize, IOStream *stream, ChecksumCalculator* checksumCalc);
+
 };
 
 #endif  // GUARD_foo_decoder_context_t
@@ -57,6 +57,11 @@ ChecksumCalculatorThreadInfo::~ChecksumCalculatorThreadInfo() {
     s_tls->set(nullptr);
 }
 
+void ChecksumCalculatorThreadInfo::setCurrent(
+        ChecksumCalculatorThreadInfo* info) {
+    s_tls->set(info);
+}
+
 ChecksumCalculator& ChecksumCalculatorThreadInfo::get() {
     return getChecksumCalculatorThreadInfo()->m_protocol;
 }
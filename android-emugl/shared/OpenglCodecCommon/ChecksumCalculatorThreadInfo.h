@@ -29,6 +29,10 @@ public:
 
     ChecksumCalculator& get();
 
+    // Make |info| the current thread's instance, for threads that serve
+    // several guest connections in turn.
+    static void setCurrent(ChecksumCalculatorThreadInfo* info);
+
     static bool setVersion(uint32_t version);
 
     static uint32_t getMaxVersion();
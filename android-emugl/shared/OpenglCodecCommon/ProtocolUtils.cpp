@@ -0,0 +1,171 @@
+/*
+* Copyright (C) 2024 The Android Open Source Project
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "ProtocolUtils.h"
+
+#include "android/base/StringFormat.h"
+#include "android/base/synchronization/Lock.h"
+#include "android/base/system/System.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+using android::base::AutoLock;
+using android::base::Lock;
+using android::base::StringAppendFormat;
+using android::base::System;
+
+namespace emugl {
+
+// Opcodes of all the decoders fit below this; anything else is accounted
+// to slot 0.
+static const size_t kMaxOpcodes = 32768;
+
+static std::atomic<uint64_t> sCopyBytes[kMaxOpcodes];
+
+void recordDecoderCopy(size_t bytes) {
+    uint32_t opcode = currentDecoderOpcode();
+    if (opcode >= kMaxOpcodes) {
+        opcode = 0;
+    }
+    sCopyBytes[opcode].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+std::string printDecoderCopyStats(size_t maxOpcodes) {
+    static Lock sLock;
+    static uint64_t sLastBytes[kMaxOpcodes];
+    static uint64_t sLastTimeUs = 0;
+
+    AutoLock lock(sLock);
+    const uint64_t nowUs = System::get()->getHighResTimeUs();
+    const uint64_t elapsedUs = sLastTimeUs ? nowUs - sLastTimeUs : 0;
+    sLastTimeUs = nowUs;
+
+    std::vector<std::pair<uint64_t, uint32_t>> deltas;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kMaxOpcodes; ++i) {
+        const uint64_t bytes = sCopyBytes[i].load(std::memory_order_relaxed);
+        if (bytes != sLastBytes[i]) {
+            deltas.emplace_back(bytes - sLastBytes[i], (uint32_t)i);
+            total += bytes - sLastBytes[i];
+            sLastBytes[i] = bytes;
+        }
+    }
+    if (!elapsedUs) {
+        return "Decoder copies: -";
+    }
+
+    std::sort(deltas.begin(), deltas.end(),
+              [](const std::pair<uint64_t, uint32_t>& a,
+                 const std::pair<uint64_t, uint32_t>& b) {
+                  return a.first > b.first;
+              });
+    const float toMbPerSec = 1e6f / ((float)elapsedUs * 1048576.0f);
+    std::string res;
+    StringAppendFormat(&res, "Decoder copies: %.2f mb/s", total * toMbPerSec);
+    for (size_t i = 0; i < deltas.size() && i < maxOpcodes; ++i) {
+        StringAppendFormat(&res, "%s opcode %u %.2f mb/s", i ? "," : ";",
+                           deltas[i].second, deltas[i].first * toMbPerSec);
+    }
+    return res;
+}
+
+// Largest block a thread keeps around; bigger copies use the heap directly.
+static const size_t kMaxScratchSize = 16 * 1024 * 1024;
+// A block grown past this size by an oversized call shrinks back to it once
+// kShrinkAfterCalls consecutive calls have fit under it, so a burst of large
+// uploads doesn't pin the memory for the rest of the render thread's life.
+static const size_t kRetainedScratchSize = 256 * 1024;
+static const uint32_t kShrinkAfterCalls = 64;
+
+namespace {
+
+class ScratchBlock {
+public:
+    ~ScratchBlock() { free(mBase); }
+
+    void* alloc(size_t size) {
+        size = (size + 7) & ~size_t(7);
+        if (mUsed + size > mSize) {
+            if (mUsed || size > kMaxScratchSize) {
+                return malloc(size);
+            }
+            free(mBase);
+            mSize = std::max(size, std::min(2 * mSize, kMaxScratchSize));
+            mBase = (unsigned char*)malloc(mSize);
+            if (!mBase) {
+                mSize = 0;
+                return malloc(size);
+            }
+        }
+        void* res = mBase + mUsed;
+        mUsed += size;
+        mPeak = std::max(mPeak, mUsed);
+        return res;
+    }
+
+    void release(void* ptr) {
+        unsigned char* p = (unsigned char*)ptr;
+        if (p >= mBase && p < mBase + mSize) {
+            mUsed = p - mBase;
+            if (!mUsed) {
+                onCallDone();
+            }
+        } else {
+            free(ptr);
+        }
+    }
+
+private:
+    void onCallDone() {
+        if (mSize <= kRetainedScratchSize || mPeak > kRetainedScratchSize) {
+            mSmallCalls = 0;
+        } else if (++mSmallCalls >= kShrinkAfterCalls) {
+            free(mBase);
+            mBase = (unsigned char*)malloc(kRetainedScratchSize);
+            mSize = mBase ? kRetainedScratchSize : 0;
+            mSmallCalls = 0;
+        }
+        mPeak = 0;
+    }
+
+    unsigned char* mBase = nullptr;
+    size_t mSize = 0;
+    size_t mUsed = 0;
+    size_t mPeak = 0;
+    uint32_t mSmallCalls = 0;
+};
+
+}  // namespace
+
+static ScratchBlock& sScratch() {
+    static thread_local ScratchBlock block;
+    return block;
+}
+
+// static
+void* DecoderScratch::alloc(size_t size) {
+    return sScratch().alloc(size);
+}
+
+// static
+void DecoderScratch::release(void* ptr) {
+    sScratch().release(ptr);
+}
+
+}  // namespace emugl
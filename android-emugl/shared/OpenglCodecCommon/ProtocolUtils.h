@@ -2,6 +2,8 @@
 
 #include "android/base/Tracing.h"
 
+#include <string>
+
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -90,7 +92,34 @@ inline T Unpack(const void* ptr) {
 // Both classes try to minimize heap usage as much as possible - the first
 // template argument defines the size of an internal array Generic*Buffer-s use
 // if the |ptr|'s |size| is small enough. If it doesn't fit into the internal
-// array, an aligned copy is allocated on the heap and freed in the dtor.
+// array, the aligned copy comes from the calling thread's DecoderScratch.
+//
+// Every copy is accounted to the opcode being decoded, see
+// printDecoderCopyStats().
+
+// The opcode the current thread is decoding; set by the generated decoders
+// at the start of each packet.
+inline uint32_t& currentDecoderOpcode() {
+    static thread_local uint32_t opcode = 0;
+    return opcode;
+}
+
+// Records |bytes| copied to realign an argument of currentDecoderOpcode().
+void recordDecoderCopy(size_t bytes);
+
+// Copy throughput per opcode since the previous call, busiest first.
+std::string printDecoderCopyStats(size_t maxOpcodes);
+
+// Per-thread scratch memory for the aligned copies that don't fit the
+// buffers' inline arrays. The buffers live for a single decoded call and are
+// destroyed in reverse order, so allocations are carved from one block that
+// is kept between calls; only requests that don't fit it go to the heap.
+// Pointers are aligned on 8 bytes.
+class DecoderScratch {
+public:
+    static void* alloc(size_t size);
+    static void release(void* ptr);
+};
 
 template <size_t StackSize = 1024, size_t Align = 8>
 class GenericInputBuffer {
@@ -105,15 +134,16 @@ public:
             if (size <= StackSize) {
                 mPtr = &mArray[0];
             } else {
-                mPtr = malloc(size);
+                mPtr = DecoderScratch::alloc(size);
             }
             memcpy(mPtr, input, size);
+            recordDecoderCopy(size);
         }
     }
 
     ~GenericInputBuffer() {
         if (mPtr != mOrigBuff && mPtr != &mArray[0]) {
-            free(mPtr);
+            DecoderScratch::release(mPtr);
         }
     }
 
@@ -143,14 +173,15 @@ public:
             if (size <= StackSize) {
                 mPtr = &mArray[0];
             } else {
-                mPtr = calloc(1, size);
+                mPtr = DecoderScratch::alloc(size);
+                memset(mPtr, 0, size);
             }
         }
     }
 
     ~GenericOutputBuffer() {
         if (mPtr != mOrigBuff && mPtr != &mArray[0]) {
-            free(mPtr);
+            DecoderScratch::release(mPtr);
         }
     }
 
@@ -159,6 +190,7 @@ public:
     void flush() {
         if (mPtr != mOrigBuff) {
             memcpy(mOrigBuff, mPtr, mSize);
+            recordDecoderCopy(mSize);
         }
     }
 
@@ -178,4 +210,28 @@ private:
 using InputBuffer = GenericInputBuffer<>;
 using OutputBuffer = GenericOutputBuffer<>;
 
+// ByteInputBuffer and ByteOutputBuffer are used instead for arguments GL
+// reads or writes as raw bytes (pixels, buffer data, strings), which have no
+// alignment requirement. They always pass |ptr| through, so large payloads
+// such as glTexImage2D or glBufferData data and glReadPixels results are
+// never copied, wherever they land in the stream.
+class ByteInputBuffer {
+public:
+    ByteInputBuffer(const void* input, size_t) : mPtr(input) {}
+    const void* get() const { return mPtr; }
+
+private:
+    const void* mPtr;
+};
+
+class ByteOutputBuffer {
+public:
+    ByteOutputBuffer(unsigned char* ptr, size_t) : mPtr(ptr) {}
+    void* get() const { return mPtr; }
+    void flush() {}
+
+private:
+    unsigned char* mPtr;
+};
+
 }  // namespace emugl
@@ -0,0 +1,265 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/decoder/block_decoder.h"
+#include "src/base/bit_stream.h"
+#include "src/base/math_utils.h"
+#include "src/base/uint128.h"
+#include "src/decoder/endpoint_codec.h"
+#include "src/decoder/integer_sequence_codec.h"
+#include "src/decoder/intermediate_astc_block.h"
+#include "src/decoder/partition.h"
+#include "src/decoder/quantization.h"
+#include "src/decoder/weight_infill.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <memory>
+
+namespace astc_codec {
+
+namespace {
+
+// The largest footprint is 12x12, and C.2.24 limits a block to 64 weights,
+// 18 color values and four partitions.
+constexpr int kMaxTexels = 12 * 12;
+constexpr int kMaxWeights = 64;
+constexpr int kMaxColorValues = 18;
+constexpr int kMaxPartitions = 4;
+
+// Weight grids are between 2x2 and 12x12, and partition IDs have 10 bits.
+constexpr int kMaxWeightGridDim = 12;
+constexpr int kNumPartitionIDs = 1 << 10;
+
+constexpr int kNumFootprints = Footprint::NumValidFootprints();
+
+using PartitionTable = std::array<uint8_t, kMaxTexels>;
+using InfillTable = std::array<WeightInfillTaps, kMaxTexels>;
+
+// Tables are built on first use. Entries are never freed once published, so
+// lookups only need an acquire load.
+std::atomic<const PartitionTable*>
+    partition_tables[kNumFootprints][kMaxPartitions - 1][kNumPartitionIDs];
+std::atomic<const InfillTable*>
+    infill_tables[kNumFootprints][kMaxWeightGridDim + 1][kMaxWeightGridDim + 1];
+
+// Stores |table| in |slot| unless another thread got there first, and returns
+// the table that ended up in the slot.
+template<typename T>
+const T* PublishTable(std::atomic<const T*>* slot, std::unique_ptr<T> table) {
+  const T* current = nullptr;
+  if (slot->compare_exchange_strong(current, table.get(),
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+    return table.release();
+  }
+  return current;
+}
+
+const PartitionTable& GetPartitionTable(const Footprint& footprint,
+                                        int num_parts, int partition_id) {
+  assert(num_parts >= 2 && num_parts <= kMaxPartitions);
+  assert(partition_id >= 0 && partition_id < kNumPartitionIDs);
+
+  std::atomic<const PartitionTable*>* slot =
+      &partition_tables[static_cast<int>(footprint.Type())][num_parts - 2]
+                       [partition_id];
+  const PartitionTable* table = slot->load(std::memory_order_acquire);
+  if (table) {
+    return *table;
+  }
+
+  const Partition part = GetASTCPartition(footprint, num_parts, partition_id);
+  std::unique_ptr<PartitionTable> result(new PartitionTable());
+  std::copy(part.assignment.begin(), part.assignment.end(), result->begin());
+  return *PublishTable(slot, std::move(result));
+}
+
+const InfillTable& GetInfillTable(const Footprint& footprint, int dim_x,
+                                  int dim_y) {
+  assert(dim_x >= 2 && dim_x <= kMaxWeightGridDim);
+  assert(dim_y >= 2 && dim_y <= kMaxWeightGridDim);
+
+  std::atomic<const InfillTable*>* slot =
+      &infill_tables[static_cast<int>(footprint.Type())][dim_x][dim_y];
+  const InfillTable* table = slot->load(std::memory_order_acquire);
+  if (table) {
+    return *table;
+  }
+
+  std::unique_ptr<InfillTable> result(new InfillTable());
+  auto taps = result->begin();
+  for (int t = 0; t < footprint.Height(); ++t) {
+    for (int s = 0; s < footprint.Width(); ++s) {
+      *(taps++) = GetWeightInfillTaps(footprint, s, t, dim_x, dim_y);
+    }
+  }
+  return *PublishTable(slot, std::move(result));
+}
+
+// Infills the weight of a texel from every |stride|-th entry of |weights|.
+inline int InfillWeight(const WeightInfillTaps& taps, const int* weights,
+                        int stride) {
+  const int weight = weights[taps.points[0] * stride] * taps.factors[0] +
+                     weights[taps.points[1] * stride] * taps.factors[1] +
+                     weights[taps.points[2] * stride] * taps.factors[2] +
+                     weights[taps.points[3] * stride] * taps.factors[3];
+  return (weight + 8) >> 4;
+}
+
+// Interpolates between two endpoints expanded to 16 bits and converts the
+// result to UNORM8, according to C.2.19.
+inline uint8_t InterpolateChannel(int c0, int c1, int weight) {
+  const int c = (c0 * (64 - weight) + c1 * weight + 32) / 64;
+  // TODO(google): Handle conversion to sRGB or FP16 per C.2.19.
+  return static_cast<uint8_t>(((c * 255) + 32767) / 65536);
+}
+
+bool DecodeVoidExtentBlock(const PhysicalASTCBlock& pb, int columns, int rows,
+                           uint8_t* out, size_t out_stride) {
+  base::Optional<VoidExtentData> ve = UnpackVoidExtent(pb);
+  if (!ve) {
+    return false;
+  }
+
+  const VoidExtentData& data = ve.value();
+  const uint8_t texel[4] = {
+    static_cast<uint8_t>((data.r * 255) / 65535),
+    static_cast<uint8_t>((data.g * 255) / 65535),
+    static_cast<uint8_t>((data.b * 255) / 65535),
+    static_cast<uint8_t>((data.a * 255) / 65535),
+  };
+
+  for (int x = 0; x < columns; ++x) {
+    memcpy(out + x * sizeof(texel), texel, sizeof(texel));
+  }
+  for (int y = 1; y < rows; ++y) {
+    memcpy(out + y * out_stride, out, columns * sizeof(texel));
+  }
+  return true;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool DecodeBlockToRGBA8(const Footprint& footprint, const PhysicalASTCBlock& pb,
+                        int columns, int rows, uint8_t* out,
+                        size_t out_stride) {
+  assert(columns > 0 && columns <= footprint.Width());
+  assert(rows > 0 && rows <= footprint.Height());
+
+  PhysicalASTCBlock::BlockInfo info;
+  if (!pb.GetBlockInfo(&info)) {
+    if (pb.IsVoidExtent()) {
+      return DecodeVoidExtentBlock(pb, columns, rows, out, out_stride);
+    }
+    return false;
+  }
+
+  // Decode the color endpoints of each partition, expanded to 16 bits. This
+  // follows UnpackIntermediateBlock and the LogicalASTCBlock constructor.
+  assert(info.num_color_values <= kMaxColorValues);
+  std::array<int, kMaxColorValues + IntegerSequenceDecoder::kMaxDecodeOverrun>
+      colors;
+  {
+    const base::UInt128 color_bits_mask =
+        (base::UInt128(1) << info.num_color_bits) - 1;
+    const base::UInt128 color_bits =
+        (pb.GetBlockBits() >> info.color_start_bit) & color_bits_mask;
+    base::BitStream<base::UInt128> bit_src(color_bits, 128);
+    IntegerSequenceDecoder(info.color_range).Decode(info.num_color_values,
+                                                    &bit_src, colors.data());
+  }
+
+  std::array<std::array<int, 4>, kMaxPartitions> endpoint_low;
+  std::array<std::array<int, 4>, kMaxPartitions> endpoint_high;
+  const int* color_vals = colors.data();
+  for (int i = 0; i < info.num_partitions; ++i) {
+    const ColorEndpointMode mode = info.endpoint_modes[i];
+    RgbaColor low, high;
+    DecodeColorsForMode(color_vals, info.color_range, mode, &low, &high);
+    color_vals += NumColorValuesForEndpointMode(mode);
+
+    for (int channel = 0; channel < 4; ++channel) {
+      assert(low[channel] >= 0 && low[channel] < 256);
+      assert(high[channel] >= 0 && high[channel] < 256);
+      endpoint_low[i][channel] = (low[channel] << 8) | low[channel];
+      endpoint_high[i][channel] = (high[channel] << 8) | high[channel];
+    }
+  }
+
+  // Decode and unquantize the weight grid. With a dual plane, the weights of
+  // the two planes are interleaved.
+  const int dual_channel = info.dual_plane_channel;
+  const int weight_stride = (dual_channel >= 0) ? 2 : 1;
+  const int num_weights =
+      info.weight_grid_dim_x * info.weight_grid_dim_y * weight_stride;
+  assert(num_weights <= kMaxWeights);
+
+  std::array<int, kMaxWeights + IntegerSequenceDecoder::kMaxDecodeOverrun>
+      weights;
+  {
+    const base::UInt128 weight_bits_mask =
+        (base::UInt128(1) << info.num_weight_bits) - 1;
+    const base::UInt128 weight_bits =
+        base::ReverseBits(pb.GetBlockBits()) & weight_bits_mask;
+    base::BitStream<base::UInt128> bit_src(weight_bits, 128);
+    IntegerSequenceDecoder(info.weight_range).Decode(num_weights, &bit_src,
+                                                     weights.data());
+  }
+  for (int i = 0; i < num_weights; ++i) {
+    weights[i] = UnquantizeWeightFromRange(weights[i], info.weight_range);
+  }
+
+  const InfillTable& infill = GetInfillTable(
+      footprint, info.weight_grid_dim_x, info.weight_grid_dim_y);
+  const uint8_t* assignment = nullptr;
+  if (info.num_partitions > 1) {
+    assignment =
+        GetPartitionTable(footprint, info.num_partitions, info.partition_id)
+            .data();
+  }
+
+  for (int y = 0; y < rows; ++y) {
+    const int row_start = y * footprint.Width();
+    uint8_t* texel = out + y * out_stride;
+    for (int x = 0; x < columns; ++x, texel += 4) {
+      const int texel_idx = row_start + x;
+      const WeightInfillTaps& taps = infill[texel_idx];
+      const int part = assignment ? assignment[texel_idx] : 0;
+      const std::array<int, 4>& low = endpoint_low[part];
+      const std::array<int, 4>& high = endpoint_high[part];
+
+      const int weight = InfillWeight(taps, weights.data(), weight_stride);
+      for (int channel = 0; channel < 4; ++channel) {
+        texel[channel] = InterpolateChannel(low[channel], high[channel],
+                                            weight);
+      }
+
+      if (dual_channel >= 0) {
+        const int dual_weight =
+            InfillWeight(taps, weights.data() + 1, weight_stride);
+        texel[dual_channel] = InterpolateChannel(
+            low[dual_channel], high[dual_channel], dual_weight);
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace astc_codec
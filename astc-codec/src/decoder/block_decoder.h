@@ -0,0 +1,44 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ASTC_CODEC_DECODER_BLOCK_DECODER_H_
+#define ASTC_CODEC_DECODER_BLOCK_DECODER_H_
+
+#include "src/decoder/footprint.h"
+#include "src/decoder/physical_astc_block.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace astc_codec {
+
+// Decodes |pb|, a block of the given |footprint|, straight into 8-bit RGBA
+// texels. Only the top-left |columns| x |rows| texels of the block are
+// written, so that blocks on the edge of an image can be clipped. Texels are
+// written starting at |out|, with rows |out_stride| bytes apart.
+//
+// The result is identical to UnpackLogicalBlock() followed by
+// LogicalASTCBlock::ColorAt() for every texel, but nothing is allocated:
+// intermediate values live in fixed-size arrays on the stack, and partition
+// assignments and weight infill filters come from tables that are built the
+// first time a footprint needs them and are shared by all threads.
+//
+// Returns false if the block is not a legal encoding.
+bool DecodeBlockToRGBA8(const Footprint& footprint, const PhysicalASTCBlock& pb,
+                        int columns, int rows, uint8_t* out,
+                        size_t out_stride);
+
+}  // namespace astc_codec
+
+#endif  // ASTC_CODEC_DECODER_BLOCK_DECODER_H_
@@ -14,9 +14,10 @@
 
 #include "src/decoder/codec.h"
 #include "src/base/uint128.h"
-#include "src/decoder/logical_astc_block.h"
+#include "src/decoder/block_decoder.h"
 #include "src/decoder/physical_astc_block.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace astc_codec {
@@ -69,32 +70,17 @@ bool DecompressToImage(const uint8_t* astc_data, size_t astc_data_size,
     const size_t block_y = block_index / blocks_wide;
     memcpy(&block, astc_data + i, sizeof(block));
 
-    PhysicalASTCBlock physical_block(block);
-    auto lb = UnpackLogicalBlock(footprint, physical_block);
-    if (!lb) {
-      return false;
-    }
-
-    LogicalASTCBlock logical_block = lb.value();
-
-    for (size_t y = 0; y < block_height; ++y) {
-      const size_t py = block_height * block_y + y;
-      uint8_t* out_row = out_buffer + py * out_buffer_stride;
+    // Clip blocks on the right and bottom edges of the image.
+    const size_t px = block_width * block_x;
+    const size_t py = block_height * block_y;
+    const int columns = static_cast<int>(std::min(block_width, width - px));
+    const int rows = static_cast<int>(std::min(block_height, height - py));
 
-      for (size_t x = 0; x < block_width; ++x) {
-        const size_t px = block_width * block_x + x;
-
-        // Skip out of bounds.
-        if (px >= width || py >= height) {
-          continue;
-        }
-
-        uint8_t* pixel = out_row + px * kBytesPerPixelUNORM8;
-        const RgbaColor decoded_color = logical_block.ColorAt(x, y);
-        for (size_t i = 0; i < kBytesPerPixelUNORM8; ++i) {
-          pixel[i] = static_cast<uint8_t>(decoded_color[i]);
-        }
-      }
+    uint8_t* out = out_buffer + py * out_buffer_stride +
+                   px * kBytesPerPixelUNORM8;
+    if (!DecodeBlockToRGBA8(footprint, PhysicalASTCBlock(block), columns, rows,
+                            out, out_buffer_stride)) {
+      return false;
     }
   }
 
@@ -764,6 +764,14 @@ void DecodeColorsForMode(const std::vector<int>& vals,
                          RgbaColor* const endpoint_low_rgba,
                          RgbaColor* const endpoint_high_rgba) {
   assert(vals.size() >= NumColorValuesForEndpointMode(mode));
+  DecodeColorsForMode(vals.data(), max_value, mode, endpoint_low_rgba,
+                      endpoint_high_rgba);
+}
+
+void DecodeColorsForMode(const int* vals,
+                         int max_value, ColorEndpointMode mode,
+                         RgbaColor* const endpoint_low_rgba,
+                         RgbaColor* const endpoint_high_rgba) {
   switch (mode) {
     case ColorEndpointMode::kLDRLumaDirect: {
       const int l0 = UnquantizeCEValueFromRange(vals[0], max_value);
@@ -791,7 +799,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           NumColorValuesForEndpointMode(ColorEndpointMode::kLDRLumaAlphaDirect);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       *endpoint_low_rgba = {{ v[0], v[0], v[0], v[2] }};
@@ -804,7 +812,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           ColorEndpointMode::kLDRLumaAlphaBaseOffset);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       BitTransferSigned(&v[1], &v[0]);
@@ -824,7 +832,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           NumColorValuesForEndpointMode(ColorEndpointMode::kLDRRGBBaseScale);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       *endpoint_high_rgba = {{ v[0], v[1], v[2], 255 }};
@@ -841,7 +849,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           NumColorValuesForEndpointMode(ColorEndpointMode::kLDRRGBDirect);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       const int s0 = v[0] + v[2] + v[4];
@@ -863,7 +871,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           NumColorValuesForEndpointMode(ColorEndpointMode::kLDRRGBBaseOffset);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       BitTransferSigned(&v[1], &v[0]);
@@ -889,7 +897,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           ColorEndpointMode::kLDRRGBBaseScaleTwoA);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       // Base
@@ -912,7 +920,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           NumColorValuesForEndpointMode(ColorEndpointMode::kLDRRGBADirect);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       const int s0 = v[0] + v[2] + v[4];
@@ -934,7 +942,7 @@ void DecodeColorsForMode(const std::vector<int>& vals,
           NumColorValuesForEndpointMode(ColorEndpointMode::kLDRRGBABaseOffset);
 
       std::array<int, kNumVals> v;
-      std::copy(vals.begin(), vals.end(), v.begin());
+      std::copy(vals, vals + kNumVals, v.begin());
       Unquantize(&v, max_value);
 
       BitTransferSigned(&v[1], &v[0]);
@@ -80,6 +80,13 @@ void DecodeColorsForMode(const std::vector<int>& vals,
                          RgbaColor* endpoint_low_rgba,
                          RgbaColor* endpoint_high_rgba);
 
+// Same as above, but reads the NumColorValuesForEndpointMode(mode) values
+// starting at |vals|.
+void DecodeColorsForMode(const int* vals,
+                         int max_value, ColorEndpointMode mode,
+                         RgbaColor* endpoint_low_rgba,
+                         RgbaColor* endpoint_high_rgba);
+
 // Returns true if the quantized |vals| in the range [0, max_value] use the
 // 'blue_contract' modification during decoding for the given |mode|.
 bool UsesBlueContract(int max_value, ColorEndpointMode mode,
@@ -479,6 +479,18 @@ int IntegerSequenceCodec::EncodedBlockSize() const {
 
 std::vector<int> IntegerSequenceDecoder::Decode(
     int num_vals, base::BitStream<base::UInt128> *bit_src) const {
+  std::vector<int> result(num_vals + kMaxDecodeOverrun);
+  Decode(num_vals, bit_src, result.data());
+
+  // Resize result to only contain as many values as requested
+  result.resize(num_vals);
+
+  // Encoded all the values
+  return result;
+}
+
+void IntegerSequenceDecoder::Decode(
+    int num_vals, base::BitStream<base::UInt128> *bit_src, int* out) const {
   int trits = (encoding_ == kTritEncoding)? 1 : 0;
   int quints = (encoding_ == kQuintEncoding)? 1 : 0;
   const int total_num_bits = GetBitCount(num_vals, trits, quints, bits_);
@@ -486,7 +498,7 @@ std::vector<int> IntegerSequenceDecoder::Decode(
   assert(bits_per_block < 64);
 
   int bits_left = total_num_bits;
-  std::vector<int> result;
+  int* const out_end = out + num_vals + kMaxDecodeOverrun;
   while (bits_left > 0) {
     uint64_t block_bits;
     {
@@ -497,30 +509,27 @@ std::vector<int> IntegerSequenceDecoder::Decode(
     switch (encoding_) {
       case kTritEncoding: {
         auto trit_vals = DecodeISEBlock<3>(block_bits, bits_);
-        result.insert(result.end(), trit_vals.begin(), trit_vals.end());
+        assert(out + trit_vals.size() <= out_end);
+        out = std::copy(trit_vals.begin(), trit_vals.end(), out);
       }
       break;
 
       case kQuintEncoding: {
         auto quint_vals = DecodeISEBlock<5>(block_bits, bits_);
-        result.insert(result.end(), quint_vals.begin(), quint_vals.end());
+        assert(out + quint_vals.size() <= out_end);
+        out = std::copy(quint_vals.begin(), quint_vals.end(), out);
       }
       break;
 
       case kBitEncoding:
-        result.push_back(static_cast<int>(block_bits));
+        assert(out < out_end);
+        *(out++) = static_cast<int>(block_bits);
         break;
     }
 
     bits_left -= bits_per_block;
   }
-
-  // Resize result to only contain as many values as requested
-  assert(result.size() >= static_cast<size_t>(num_vals));
-  result.resize(num_vals);
-
-  // Encoded all the values
-  return result;
+  (void)out_end;
 }
 
 void IntegerSequenceEncoder::Encode(base::BitStream<base::UInt128>* bit_sink) const {
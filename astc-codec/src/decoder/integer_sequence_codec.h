@@ -128,6 +128,16 @@ class IntegerSequenceDecoder : public IntegerSequenceCodec {
   // always contains exactly num_vals.
   std::vector<int> Decode(int num_vals,
                           base::BitStream<base::UInt128>* bit_src) const;
+
+  // Values are decoded a whole ISE block at a time, so the last block may
+  // produce up to this many values past the ones that were asked for.
+  static constexpr int kMaxDecodeOverrun = 4;
+
+  // Same as above, but writes the values to |out| instead of allocating a
+  // vector. |out| must have room for num_vals + kMaxDecodeOverrun values;
+  // anything past the first num_vals is scratch.
+  void Decode(int num_vals, base::BitStream<base::UInt128>* bit_src,
+              int* out) const;
 };
 
 // The integer sequence encoder. The encoder accepts values one by one and
@@ -473,6 +473,57 @@ int DecodeNumColorValues(const base::UInt128 astc_bits) {
   return num_color_values;
 }
 
+// The number of bits and the range used for the color values of a block.
+struct ColorValuesInfo {
+  int bits;
+  int range;
+};
+
+// Returns the largest range, and the number of bits it needs, with which
+// |num_color_values| fit into |max_color_bits|. This only depends on the two
+// counts, so the answers are computed once and then looked up.
+const ColorValuesInfo& GetColorValuesInfoFor(int num_color_values,
+                                             int max_color_bits) {
+  constexpr int kMaxColorValues = 18;
+  using ColorValuesInfoTable = std::array<
+      std::array<ColorValuesInfo, kASTCBlockSizeBits + 1>, kMaxColorValues + 1>;
+  static const ColorValuesInfoTable kTable = []() {
+    ColorValuesInfoTable table;
+    for (int num_vals = 0; num_vals <= kMaxColorValues; ++num_vals) {
+      for (int max_bits = 0; max_bits <= kASTCBlockSizeBits; ++max_bits) {
+        // Any range takes as many bits as the next ISE range up from it, so
+        // the largest range that fits is always one of the ISE ranges.
+        ColorValuesInfo info = { 0, 0 };
+        for (auto it = ISERangeEnd(); it != ISERangeBegin();) {
+          const int range = *(--it);
+          if (range > 255) {
+            continue;
+          }
+
+          const int bitcount =
+              IntegerSequenceCodec::GetBitCountForRange(num_vals, range);
+          if (bitcount <= max_bits) {
+            info = { bitcount, range };
+            break;
+          }
+        }
+        table[num_vals][max_bits] = info;
+      }
+    }
+    return table;
+  }();
+
+  assert(num_color_values >= 0 && num_color_values <= kMaxColorValues);
+  assert(max_color_bits >= 0 && max_color_bits <= kASTCBlockSizeBits);
+
+  const ColorValuesInfo& info = kTable[num_color_values][max_color_bits];
+  assert(info.range > 0 &&
+         "This means that even if we have a range of one there aren't "
+         "enough bits to store the color values, and our encoding is "
+         "illegal.");
+  return info;
+}
+
 }  // namespace
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -674,25 +725,16 @@ void PhysicalASTCBlock::GetColorValuesInfo(int* const color_bits,
   const int dual_plane_start_pos = DecodeDualPlaneBitStartPos(astc_bits_);
   const int max_color_bits = dual_plane_start_pos - ColorStartBit().value();
   const int num_color_values = NumColorValues().value();
-  for (int range = 255; range > 0; --range) {
-    const int bitcount =
-        IntegerSequenceCodec::GetBitCountForRange(num_color_values, range);
-    if (bitcount <= max_color_bits) {
-      if (color_bits != nullptr) {
-        *color_bits = bitcount;
-      }
+  const ColorValuesInfo& info =
+      GetColorValuesInfoFor(num_color_values, max_color_bits);
 
-      if (color_range != nullptr) {
-        *color_range = range;
-      }
-      return;
-    }
+  if (color_bits != nullptr) {
+    *color_bits = info.bits;
   }
 
-  assert(false &&
-         "This means that even if we have a range of one there aren't "
-         "enough bits to store the color values, and our encoding is "
-         "illegal.");
+  if (color_range != nullptr) {
+    *color_range = info.range;
+  }
 }
 
 base::Optional<int> PhysicalASTCBlock::NumColorBits() const {
@@ -758,4 +800,53 @@ base::Optional<ColorEndpointMode> PhysicalASTCBlock::GetEndpointMode(
   return DecodeEndpointMode(astc_bits_, partition);
 }
 
+bool PhysicalASTCBlock::GetBlockInfo(BlockInfo* const info) const {
+  assert(info != nullptr);
+
+  if (IsIllegalEncoding()) return false;
+  if (DecodeBlockMode(astc_bits_) == BlockMode::kVoidExtent) return false;
+
+  // The block is legal, so none of the following can fail.
+  std::string error;
+  const WeightGridProperties weight_props =
+      DecodeWeightProps(astc_bits_, &error).value();
+  const bool dual_plane = DecodeDualPlaneBit(astc_bits_);
+
+  info->weight_grid_dim_x = weight_props.width;
+  info->weight_grid_dim_y = weight_props.height;
+  info->weight_range = weight_props.range;
+  info->num_weight_bits = IntegerSequenceCodec::GetBitCountForRange(
+      weight_props.width * weight_props.height * (dual_plane ? 2 : 1),
+      weight_props.range);
+
+  const int dual_plane_start_pos = kASTCBlockSizeBits
+      - info->num_weight_bits
+      - DecodeNumExtraCEMBits(astc_bits_)
+      - (dual_plane ? 2 : 0);
+  info->dual_plane_channel = dual_plane
+      ? static_cast<int>(
+            base::GetBits(astc_bits_, dual_plane_start_pos, 2).LowBits())
+      : -1;
+
+  info->num_partitions = DecodeNumPartitions(astc_bits_);
+  info->partition_id = (info->num_partitions > 1)
+      ? static_cast<int>(base::GetBits(astc_bits_.LowBits(), 13, 10))
+      : 0;
+
+  info->num_color_values = 0;
+  for (int i = 0; i < info->num_partitions; ++i) {
+    info->endpoint_modes[i] = DecodeEndpointMode(astc_bits_, i);
+    info->num_color_values +=
+        NumColorValuesForEndpointMode(info->endpoint_modes[i]);
+  }
+
+  info->color_start_bit = (info->num_partitions == 1) ? 17 : 29;
+  const ColorValuesInfo& color_info = GetColorValuesInfoFor(
+      info->num_color_values, dual_plane_start_pos - info->color_start_bit);
+  info->num_color_bits = color_info.bits;
+  info->color_range = color_info.range;
+
+  return true;
+}
+
 }  // namespace astc_codec
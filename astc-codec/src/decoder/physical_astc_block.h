@@ -23,6 +23,7 @@
 #include "src/base/uint128.h"
 #include "src/decoder/types.h"
 
+#include <array>
 #include <string>
 
 namespace astc_codec {
@@ -114,6 +115,34 @@ class PhysicalASTCBlock {
   // represent the color endpoints can take.
   base::Optional<int> ColorValuesRange() const;
 
+  // The values of the accessors above that are needed to decode a block
+  // that is neither illegal nor a void extent block.
+  struct BlockInfo {
+    int weight_grid_dim_x;
+    int weight_grid_dim_y;
+    int weight_range;
+    int num_weight_bits;
+
+    // The dual plane channel, or -1 if the block has a single plane.
+    int dual_plane_channel;
+
+    int num_partitions;
+    // Zero if the block has a single partition.
+    int partition_id;
+    // Only the first num_partitions modes are set.
+    std::array<ColorEndpointMode, 4> endpoint_modes;
+
+    int num_color_values;
+    int color_start_bit;
+    int num_color_bits;
+    int color_range;
+  };
+
+  // Fills |info| in a single pass, rather than validating the encoding again
+  // in every accessor. Returns false, leaving |info| untouched, if the block
+  // is an illegal encoding or a void extent block.
+  bool GetBlockInfo(BlockInfo* info) const;
+
  private:
   const base::UInt128 astc_bits_;
 
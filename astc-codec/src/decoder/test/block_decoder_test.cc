@@ -0,0 +1,192 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/decoder/block_decoder.h"
+#include "src/decoder/astc_file.h"
+#include "src/decoder/logical_astc_block.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace astc_codec {
+
+namespace {
+
+using ::testing::TestWithParam;
+using ::testing::ValuesIn;
+
+constexpr int kBytesPerTexel = 4;
+
+// Decodes |pb| with UnpackLogicalBlock into a tightly packed RGBA8 block.
+bool DecodeLogicalBlock(const Footprint& footprint, const PhysicalASTCBlock& pb,
+                        std::vector<uint8_t>* result) {
+  auto lb = UnpackLogicalBlock(footprint, pb);
+  if (!lb) {
+    return false;
+  }
+
+  result->resize(footprint.NumPixels() * kBytesPerTexel);
+  for (int y = 0; y < footprint.Height(); ++y) {
+    for (int x = 0; x < footprint.Width(); ++x) {
+      const RgbaColor color = lb.value().ColorAt(x, y);
+      for (int c = 0; c < kBytesPerTexel; ++c) {
+        (*result)[(y * footprint.Width() + x) * kBytesPerTexel + c] =
+            static_cast<uint8_t>(color[c]);
+      }
+    }
+  }
+  return true;
+}
+
+// Checks that DecodeBlockToRGBA8 agrees with the logical block decoder on
+// whether |pb| is valid and, if it is, on every texel.
+void ExpectSameAsLogicalBlock(const Footprint& footprint,
+                              const PhysicalASTCBlock& pb) {
+  std::vector<uint8_t> expected;
+  const bool expected_ok = DecodeLogicalBlock(footprint, pb, &expected);
+
+  std::vector<uint8_t> actual(footprint.NumPixels() * kBytesPerTexel);
+  const bool actual_ok = DecodeBlockToRGBA8(
+      footprint, pb, footprint.Width(), footprint.Height(), actual.data(),
+      footprint.Width() * kBytesPerTexel);
+
+  ASSERT_EQ(expected_ok, actual_ok);
+  if (expected_ok) {
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+class BlockDecoderTest : public TestWithParam<std::string> { };
+
+// Test that every block of the test images decodes exactly like it does
+// through LogicalASTCBlock.
+TEST_P(BlockDecoderTest, MatchesLogicalBlock) {
+  const std::string& image_name = GetParam();
+
+  std::string error;
+  std::unique_ptr<ASTCFile> image_file = ASTCFile::LoadFile(
+      std::string("src/decoder/testdata/") + image_name + ".astc", &error);
+  ASSERT_TRUE(image_file) << "Failed to load " << image_name << ": " << error;
+  ASSERT_TRUE(image_file->GetFootprint());
+
+  const Footprint footprint = image_file->GetFootprint().value();
+  for (size_t i = 0; i < image_file->NumBlocks(); ++i) {
+    SCOPED_TRACE(i);
+    ExpectSameAsLogicalBlock(footprint, image_file->GetBlock(i));
+  }
+}
+
+std::vector<std::string> GetTestImages() {
+  return {
+    "atlas_small_4x4",
+    "atlas_small_5x5",
+    "atlas_small_6x6",
+    "atlas_small_8x8",
+    "checkerboard",
+    "checkered_4",
+    "checkered_5",
+    "checkered_6",
+    "checkered_7",
+    "checkered_8",
+    "checkered_9",
+    "checkered_10",
+    "checkered_11",
+    "checkered_12",
+    "footprint_4x4",
+    "footprint_5x4",
+    "footprint_5x5",
+    "footprint_6x5",
+    "footprint_6x6",
+    "footprint_8x5",
+    "footprint_8x6",
+    "footprint_8x8",
+    "footprint_10x5",
+    "footprint_10x6",
+    "footprint_10x8",
+    "footprint_10x10",
+    "footprint_12x10",
+    "footprint_12x12",
+    "rgb_4x4",
+    "rgb_5x4",
+    "rgb_6x6",
+    "rgb_8x8",
+    "rgb_12x12",
+  };
+}
+
+INSTANTIATE_TEST_CASE_P(Images, BlockDecoderTest, ValuesIn(GetTestImages()));
+
+// Test that random bits, most of which are illegal encodings or use unusual
+// block modes, are rejected or decoded the same way as LogicalASTCBlock.
+TEST(BlockDecoderTest, MatchesLogicalBlockOnRandomBlocks) {
+  std::mt19937_64 rng(0xA57C);
+  for (int f = 0; f < Footprint::NumValidFootprints(); ++f) {
+    const Footprint footprint =
+        Footprint::FromFootprintType(static_cast<FootprintType>(f)).value();
+    SCOPED_TRACE(footprint.Width());
+    SCOPED_TRACE(footprint.Height());
+
+    for (int i = 0; i < 2000; ++i) {
+      const uint64_t low = rng();
+      const uint64_t high = rng();
+      ExpectSameAsLogicalBlock(footprint,
+                               PhysicalASTCBlock(base::UInt128(high, low)));
+    }
+  }
+}
+
+// Test that clipped blocks only write the requested texels, and that the
+// texels they do write respect the output stride.
+TEST(BlockDecoderTest, ClipsToColumnsAndRows) {
+  std::string error;
+  std::unique_ptr<ASTCFile> image_file = ASTCFile::LoadFile(
+      "src/decoder/testdata/footprint_6x5.astc", &error);
+  ASSERT_TRUE(image_file) << error;
+
+  const Footprint footprint = image_file->GetFootprint().value();
+  const PhysicalASTCBlock pb = image_file->GetBlock(0);
+
+  std::vector<uint8_t> full;
+  ASSERT_TRUE(DecodeLogicalBlock(footprint, pb, &full));
+
+  const int columns = 4;
+  const int rows = 3;
+  const size_t stride = 64;
+  std::vector<uint8_t> clipped(stride * footprint.Height(), 0xCD);
+  ASSERT_TRUE(
+      DecodeBlockToRGBA8(footprint, pb, columns, rows, clipped.data(), stride));
+
+  for (int y = 0; y < footprint.Height(); ++y) {
+    for (size_t b = 0; b < stride; ++b) {
+      const int x = b / kBytesPerTexel;
+      const uint8_t value = clipped[y * stride + b];
+      if (y < rows && x < columns) {
+        EXPECT_EQ(full[(y * footprint.Width() + x) * kBytesPerTexel +
+                       b % kBytesPerTexel],
+                  value);
+      } else {
+        EXPECT_EQ(0xCD, value);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+}  // namespace astc_codec
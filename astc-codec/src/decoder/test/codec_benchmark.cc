@@ -0,0 +1,131 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how fast the test images decode, both through DecompressToImage
+// and through LogicalASTCBlock, which is what DecompressToImage used to do
+// for every block. Run from the project directory so that the test data can
+// be found, e.g.:
+//
+//   ./codec_benchmark --benchmark_filter=12x12
+
+#include "src/decoder/astc_file.h"
+#include "src/decoder/codec.h"
+#include "src/decoder/logical_astc_block.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astc_codec {
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+std::unique_ptr<ASTCFile> LoadImage(benchmark::State& state,
+                                    const std::string& image_name) {
+  std::string error;
+  std::unique_ptr<ASTCFile> file = ASTCFile::LoadFile(
+      "src/decoder/testdata/" + image_name + ".astc", &error);
+  if (!file || !file->GetFootprint()) {
+    state.SkipWithError(("Failed to load " + image_name + ": " + error).c_str());
+    return nullptr;
+  }
+  return file;
+}
+
+void SetPixelsProcessed(benchmark::State& state, const ASTCFile& file) {
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          file.GetWidth() * file.GetHeight());
+}
+
+void BM_DecompressToImage(benchmark::State& state,
+                          const std::string& image_name) {
+  std::unique_ptr<ASTCFile> file = LoadImage(state, image_name);
+  if (!file) {
+    return;
+  }
+
+  const size_t stride = file->GetWidth() * kBytesPerPixel;
+  std::vector<uint8_t> image(stride * file->GetHeight());
+  for (auto _ : state) {
+    if (!DecompressToImage(*file, image.data(), image.size(), stride)) {
+      state.SkipWithError("Decoding failed");
+      return;
+    }
+    benchmark::DoNotOptimize(image.data());
+  }
+  SetPixelsProcessed(state, *file);
+}
+
+void BM_LogicalBlocks(benchmark::State& state, const std::string& image_name) {
+  std::unique_ptr<ASTCFile> file = LoadImage(state, image_name);
+  if (!file) {
+    return;
+  }
+
+  const Footprint footprint = file->GetFootprint().value();
+  const size_t blocks_wide =
+      (file->GetWidth() + footprint.Width() - 1) / footprint.Width();
+  const size_t stride = file->GetWidth() * kBytesPerPixel;
+  std::vector<uint8_t> image(stride * file->GetHeight());
+  for (auto _ : state) {
+    for (size_t i = 0; i < file->NumBlocks(); ++i) {
+      auto lb = UnpackLogicalBlock(footprint, file->GetBlock(i));
+      if (!lb) {
+        state.SkipWithError("Decoding failed");
+        return;
+      }
+
+      const size_t block_x = (i % blocks_wide) * footprint.Width();
+      const size_t block_y = (i / blocks_wide) * footprint.Height();
+      for (int y = 0; y < footprint.Height(); ++y) {
+        const size_t py = block_y + y;
+        for (int x = 0; x < footprint.Width(); ++x) {
+          const size_t px = block_x + x;
+          if (px >= file->GetWidth() || py >= file->GetHeight()) {
+            continue;
+          }
+
+          const RgbaColor color = lb.value().ColorAt(x, y);
+          uint8_t* pixel = image.data() + py * stride + px * kBytesPerPixel;
+          for (size_t c = 0; c < kBytesPerPixel; ++c) {
+            pixel[c] = static_cast<uint8_t>(color[c]);
+          }
+        }
+      }
+    }
+    benchmark::DoNotOptimize(image.data());
+  }
+  SetPixelsProcessed(state, *file);
+}
+
+#define ASTC_CODEC_BENCHMARK_IMAGE(image_name)                            \
+  BENCHMARK_CAPTURE(BM_DecompressToImage, image_name, #image_name);      \
+  BENCHMARK_CAPTURE(BM_LogicalBlocks, image_name, #image_name)
+
+ASTC_CODEC_BENCHMARK_IMAGE(atlas_small_4x4);
+ASTC_CODEC_BENCHMARK_IMAGE(atlas_small_8x8);
+ASTC_CODEC_BENCHMARK_IMAGE(footprint_6x6);
+ASTC_CODEC_BENCHMARK_IMAGE(footprint_12x12);
+ASTC_CODEC_BENCHMARK_IMAGE(rgb_4x4);
+ASTC_CODEC_BENCHMARK_IMAGE(rgb_12x12);
+
+}  // namespace
+
+}  // namespace astc_codec
+
+BENCHMARK_MAIN();
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
 #include <string>
 #include <vector>
 
@@ -358,4 +359,45 @@ TEST(PhysicalASTCBlockTest, TestColorStartBits) {
   EXPECT_EQ(PhysicalASTCBlock(0x4000000000AAAD44ULL).ColorStartBit(), 29);
 }
 
+// Test that GetBlockInfo reports the same values as the individual accessors,
+// and that it rejects the same blocks.
+TEST(PhysicalASTCBlockTest, TestBlockInfo) {
+  PhysicalASTCBlock::BlockInfo info;
+  EXPECT_FALSE(kErrorBlock.GetBlockInfo(&info));
+  EXPECT_FALSE(PhysicalASTCBlock(0xFFF8003FFE000DFCULL).GetBlockInfo(&info));
+
+  std::mt19937_64 rng(0xB10C);
+  int num_legal_blocks = 0;
+  for (int i = 0; i < 100000; ++i) {
+    const uint64_t high = rng();
+    const uint64_t low = rng();
+    const PhysicalASTCBlock blk(UInt128(high, low));
+    if (!blk.GetBlockInfo(&info)) {
+      EXPECT_TRUE(blk.IsIllegalEncoding() || blk.IsVoidExtent());
+      continue;
+    }
+
+    ++num_legal_blocks;
+    ASSERT_FALSE(blk.IsIllegalEncoding());
+    ASSERT_FALSE(blk.IsVoidExtent());
+    EXPECT_EQ(blk.WeightGridDims()->at(0), info.weight_grid_dim_x);
+    EXPECT_EQ(blk.WeightGridDims()->at(1), info.weight_grid_dim_y);
+    EXPECT_EQ(blk.WeightRange(), info.weight_range);
+    EXPECT_EQ(blk.NumWeightBits(), info.num_weight_bits);
+    EXPECT_EQ(blk.DualPlaneChannel().valueOr(-1), info.dual_plane_channel);
+    EXPECT_EQ(blk.NumPartitions(), info.num_partitions);
+    EXPECT_EQ(blk.PartitionID().valueOr(0), info.partition_id);
+    for (int p = 0; p < info.num_partitions; ++p) {
+      EXPECT_EQ(blk.GetEndpointMode(p), info.endpoint_modes[p]);
+    }
+    EXPECT_EQ(blk.NumColorValues(), info.num_color_values);
+    EXPECT_EQ(blk.ColorStartBit(), info.color_start_bit);
+    EXPECT_EQ(blk.NumColorBits(), info.num_color_bits);
+    EXPECT_EQ(blk.ColorValuesRange(), info.color_range);
+  }
+
+  // Make sure that the test actually covered some blocks.
+  EXPECT_GT(num_legal_blocks, 0);
+}
+
 }  // namespace
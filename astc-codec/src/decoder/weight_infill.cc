@@ -99,18 +99,12 @@ std::vector<int> InfillWeights(const std::vector<int>& weights,
   result.reserve(footprint.NumPixels());
   for (int t = 0; t < footprint.Height(); ++t) {
     for (int s = 0; s < footprint.Width(); ++s) {
-      const auto grid_space_coords =
-          GetGridSpaceCoordinates(footprint, s, t, dim_x, dim_y);
-      const auto grid_pts =
-          BilerpGridPointsForWeight(grid_space_coords, dim_x);
-      const auto grid_factors =
-          BilerpGridPointFactorsForWeight(grid_space_coords);
+      const WeightInfillTaps taps =
+          GetWeightInfillTaps(footprint, s, t, dim_x, dim_y);
 
       int weight = 0;
       for (int i = 0; i < 4; ++i) {
-        if (grid_pts[i] < dim_x * dim_y) {
-          weight += weights.at(grid_pts[i]) * grid_factors[i];
-        }
+        weight += weights.at(taps.points[i]) * taps.factors[i];
       }
       result.push_back((weight + 8) >> 4);
     }
@@ -119,4 +113,21 @@ std::vector<int> InfillWeights(const std::vector<int>& weights,
   return result;
 }
 
+WeightInfillTaps GetWeightInfillTaps(Footprint footprint, int s, int t,
+                                     int dim_x, int dim_y) {
+  const auto grid_space_coords =
+      GetGridSpaceCoordinates(footprint, s, t, dim_x, dim_y);
+  const auto grid_pts = BilerpGridPointsForWeight(grid_space_coords, dim_x);
+  const auto grid_factors = BilerpGridPointFactorsForWeight(grid_space_coords);
+
+  WeightInfillTaps taps;
+  for (int i = 0; i < 4; ++i) {
+    // Grid points past the end of the grid are ignored.
+    const bool in_grid = grid_pts[i] < dim_x * dim_y;
+    taps.points[i] = in_grid ? grid_pts[i] : 0;
+    taps.factors[i] = in_grid ? grid_factors[i] : 0;
+  }
+  return taps;
+}
+
 }  // namespace astc_codec
@@ -17,10 +17,21 @@
 
 #include "src/decoder/footprint.h"
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 namespace astc_codec {
 
+// The bilinear filter that weight infill applies to a single texel: the
+// indices of the four weight grid points it samples and the factor (out of
+// 16) for each of them. Points outside of the weight grid have a factor of
+// zero.
+struct WeightInfillTaps {
+  std::array<uint8_t, 4> points;
+  std::array<uint8_t, 4> factors;
+};
+
 // Returns the number of bits used to represent the weight grid at the target
 // dimensions and weight range.
 int CountBitsForWeights(int weight_dim_x, int weight_dim_y,
@@ -33,6 +44,13 @@ int CountBitsForWeights(int weight_dim_x, int weight_dim_y,
 std::vector<int> InfillWeights(const std::vector<int>& weights,
                                Footprint footprint, int dim_x, int dim_y);
 
+// Returns the filter that InfillWeights uses for the texel at (s, t) of
+// |footprint| when the weight grid is |dim_x * dim_y|. The infilled weight is
+// the sum of weights[points[i]] * factors[i], plus eight, shifted right by
+// four.
+WeightInfillTaps GetWeightInfillTaps(Footprint footprint, int s, int t,
+                                     int dim_x, int dim_y);
+
 }  // namespace astc_codec
 
 #endif  // ASTC_CODEC_DECODER_WEIGHT_INFILL_H_